@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+
+"""
+  Updating many material points from python: a python loop over
+  update_sd, the same loop writing into reused out= buffers, and a single
+  update_sd_vec call, for a cheap and an expensive model.
+
+  Usage: batch_update.py [points] [threads]
+
+  Run from the repository root with PYTHONPATH set to the directory
+  containing the built neml package.
+"""
+
+import sys
+import time
+
+import numpy as np
+
+from neml import parse
+
+def arrays(model, n):
+  rng = np.random.default_rng(0)
+  e_np1 = rng.uniform(-0.01, 0.01, (n,6))
+  return (e_np1, np.zeros((n,6)), np.full((n,), 500.0), np.full((n,), 500.0),
+      np.ones((n,)), np.zeros((n,)), np.zeros((n,6)),
+      np.array([model.init_store()] * n), np.zeros((n,)), np.zeros((n,)))
+
+def best(f, repeats = 3):
+  times = []
+  for i in range(repeats):
+    t = time.perf_counter()
+    f()
+    times.append(time.perf_counter() - t)
+  return min(times)
+
+if __name__ == "__main__":
+  n = int(sys.argv[1]) if len(sys.argv) > 1 else 10000
+  threads = int(sys.argv[2]) if len(sys.argv) > 2 else 0
+
+  print("%-20s %12s %12s %12s %12s %9s" % ("model", "loop us", "out us",
+    "vec us", "threads us", "speedup"))
+  for name in ["test_j2iso", "test_rd_chaboche"]:
+    model = parse.parse_xml("test/examples.xml", name)
+    args = arrays(model, n)
+
+    def loop():
+      for i in range(n):
+        model.update_sd(*[a[i] for a in args])
+
+    out = (np.zeros((6,)), np.zeros((model.nstore,)), np.zeros((6,6)))
+    def loop_out():
+      for i in range(n):
+        model.update_sd(*[a[i] for a in args], out)
+
+    tl = best(loop) / n * 1e6
+    to = best(loop_out) / n * 1e6
+    tv = best(lambda: model.update_sd_vec(*args)) / n * 1e6
+    tt = best(lambda: model.update_sd_vec(*args, nthreads = threads)) / n * 1e6
+    print("%-20s %12.2f %12.2f %12.2f %12.2f %8.1fx" % (name, tl, to, tv, tt,
+      tl / tt))
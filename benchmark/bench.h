@@ -0,0 +1,61 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Minimal timing helpers shared by the benchmarks
+
+namespace bench {
+
+/// Average wall time per call of f, in nanoseconds
+template <class F>
+double time_ns(F f, long n)
+{
+  // Warm up
+  for (long i = 0; i < n / 10 + 1; i++) f();
+
+  auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < n; i++) f();
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+/// Print a baseline/new comparison line
+inline void report(const std::string & name, double base, double fast)
+{
+  std::cout << std::left << std::setw(24) << name << std::right
+      << std::setw(12) << std::fixed << std::setprecision(1) << base
+      << std::setw(12) << fast 
+      << std::setw(10) << std::setprecision(2) << base / fast << "x" 
+      << std::endl;
+}
+
+/// Bytes currently allocated on the heap (0 if we can't tell)
+inline double heap_bytes()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+  return (double) mallinfo2().uordblks;
+#else
+  return 0.0;
+#endif
+}
+
+/// Print the header for report
+inline void header(const std::string & base, const std::string & fast)
+{
+  std::cout << std::left << std::setw(24) << "operation" << std::right
+      << std::setw(12) << base + " ns" << std::setw(12) << fast + " ns"
+      << std::setw(11) << "speedup" << std::endl;
+}
+
+}
+
+#endif // BENCH_H
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+
+"""
+  Evaluating a least squares calibration objective over tensile, cyclic,
+  and creep tests: simulated one test at a time from python, through
+  neml.drivers and neml.cdrivers, against a single call to a native
+  neml.calibrate.CalibrationObjective.  Then fitting three Chaboche
+  parameters to synthetic data with scipy.
+
+  Usage: calibration.py [threads]
+
+  Run from the repository root with PYTHONPATH set to the directory
+  containing the built neml package.
+"""
+
+import sys
+import time
+
+import numpy as np
+import scipy.optimize as opt
+
+from neml import parse, drivers, cdrivers, ensemble, calibrate, tunable
+
+def best(f, repeats = 3):
+  times = []
+  for i in range(repeats):
+    t = time.perf_counter()
+    f()
+    times.append(time.perf_counter() - t)
+  return min(times)
+
+# Each test: the loading program, its arguments, and the compared results
+tests = [("uniaxial_test", (1.0e-4,), dict(T = T, emax = 0.02, nsteps = 50),
+  "strain", "stress", np.linspace(0.001, 0.019, 20))
+  for T in (300.0, 400.0, 500.0, 600.0)] + [
+    ("strain_cyclic", (0.01, -1, 1.0e-4, 10), dict(T = T, nsteps = 20),
+      None, "max", None) for T in (400.0, 600.0)] + [
+    ("creep", (s, 10.0, 1000.0), dict(T = 500.0, nsteps = 50,
+      nsteps_up = 20), "rtime", "rstrain", np.linspace(10.0, 900.0, 20))
+    for s in (150.0, 200.0)]
+
+def measure(model):
+  """
+    Synthetic data from the model
+  """
+  data = []
+  for program, args, kwargs, x, y, xdata in tests:
+    res = getattr(cdrivers, program)(model, *args, **kwargs)
+    data.append(res[y] if x is None else np.interp(xdata, res[x], res[y]))
+  return data
+
+def python_objective(model, names, data, run):
+  clone = model.clone()
+  params = tunable.TunableParameters(clone)
+  def objective(p):
+    for n, v in zip(names, p):
+      params[n] = v
+    r = []
+    for (program, args, kwargs, x, y, xdata), yd in zip(tests, data):
+      res = getattr(run, program)(clone, *args, **kwargs)
+      ys = res[y] if x is None else np.interp(xdata, res[x], res[y])
+      r.append(ys - yd)
+    return np.sum(np.concatenate(r)**2.0)
+  return objective
+
+if __name__ == "__main__":
+  nthreads = int(sys.argv[1]) if len(sys.argv) > 1 else 0
+
+  model = parse.parse_xml("test/examples.xml", "test_rd_chaboche")
+  names = ["rule.flow.hardening.iso.R", "rule.flow.hardening.C[0]",
+      "rule.flow.fluidity.eta"]
+  params = tunable.TunableParameters(model)
+  p_true = np.array([params[n] for n in names])
+  data = measure(model)
+
+  objective = calibrate.CalibrationObjective(model, names,
+      nthreads = nthreads)
+  for (program, args, kwargs, x, y, xdata), yd in zip(tests, data):
+    objective.add_dataset(getattr(ensemble, program)(*args, **kwargs), x, y,
+        xdata, yd)
+
+  p = p_true * 1.1
+  print("One evaluation of %i tests" % len(tests))
+  for name, f in (("drivers loop", python_objective(model, names, data,
+    drivers)), ("cdrivers loop", python_objective(model, names, data,
+      cdrivers))):
+    print("  %-20s %10.1f ms" % (name, best(lambda: f(p), repeats = 1) * 1e3))
+  # Alternate the parameters so nothing is cached
+  ps = [p, p * 1.01]
+  print("  %-20s %10.1f ms" % ("CalibrationObjective",
+    best(lambda: [objective(q) for q in ps]) / 2 * 1e3))
+
+  print("Fitting from 1.3 times the parameters")
+  t = time.perf_counter()
+  sol = opt.least_squares(objective.residuals, p_true * 1.3,
+      jac = objective.jacobian, x_scale = np.abs(p_true))
+  print("  least_squares: %i evaluations, %.2f s, relative error %.1e" % (
+    sol.nfev + sol.njev, time.perf_counter() - t,
+    np.max(np.abs(sol.x / p_true - 1))))
@@ -0,0 +1,64 @@
+// Cost of making per thread copies of a model: parsing it again against
+// NEMLObject::clone, with and without sharing the interpolates, in time
+// and in heap memory per copy
+//
+// Usage: clone_models [file.xml] [model] [copies]
+
+#include "bench.h"
+
+#include "parse.h"
+
+#include <cstdlib>
+#include <functional>
+
+using namespace neml;
+
+namespace {
+
+// Heap bytes per copy of the model
+double memory_per_copy(std::function<std::shared_ptr<NEMLObject>()> f,
+                       int copies)
+{
+  std::vector<std::shared_ptr<NEMLObject>> keep;
+  keep.reserve(copies);
+  double start = bench::heap_bytes();
+  for (int i = 0; i < copies; i++) keep.push_back(f());
+  return (bench::heap_bytes() - start) / copies;
+}
+
+}
+
+int main(int argc, char ** argv)
+{
+  std::string fname = "test/examples.xml";
+  std::string mname = "test_rd_chaboche";
+  int copies = 1000;
+  if (argc > 1) fname = argv[1];
+  if (argc > 2) mname = argv[2];
+  if (argc > 3) copies = std::atoi(argv[3]);
+
+  std::shared_ptr<NEMLModel> model = parse_xml(fname, mname);
+
+  auto parse = [&]() -> std::shared_ptr<NEMLObject>
+  {
+    return parse_xml(fname, mname);
+  };
+  auto deep = [&]() {return model->clone();};
+  auto shared = [&]() {return model->clone(true);};
+
+  bench::header("parse", "clone");
+  double tp = bench::time_ns(parse, copies);
+  bench::report("deep copy", tp, bench::time_ns(deep, copies));
+  bench::report("share interpolates", tp, bench::time_ns(shared, copies));
+
+  double mp = memory_per_copy(parse, copies);
+  double md = memory_per_copy(deep, copies);
+  double ms = memory_per_copy(shared, copies);
+  if (mp > 0.0) {
+    std::cout << std::endl << "heap bytes per copy: parse " << mp
+        << ", deep clone " << md << ", shared interpolates " << ms
+        << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+// Compare the runtime GeneralIntegrator against the same model written
+// with the compile time composition layer in compose.h
+//
+// Usage: compose_chaboche [file.xml] [model] [n]
+//
+// Exits with a nonzero status if the two models disagree
+
+#include "bench.h"
+
+#include "parse.h"
+#include "compose.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace neml;
+
+namespace {
+
+typedef compose::Integrator<compose::TVP<compose::ChabocheFlow<
+    compose::IsoKinJ2, compose::Chaboche<compose::Voce, 3>>>> Composed;
+
+// Keep the compiler from discarding results
+volatile double sink;
+
+double rel_diff(const double * a, const double * b, int n)
+{
+  double num = 0.0;
+  double den = 0.0;
+  for (int i = 0; i < n; i++) {
+    num = std::max(num, std::fabs(a[i] - b[i]));
+    den = std::max(den, std::fabs(b[i]));
+  }
+  return num / std::max(den, 1.0e-12);
+}
+
+// Strain controlled uniaxial cycles in a general direction
+void strain_history(std::vector<double> & e, int steps)
+{
+  double dir[6] = {1.0, -0.45, -0.35, 0.2, -0.1, 0.15};
+  e.assign(6 * (steps + 1), 0.0);
+  for (int i = 1; i <= steps; i++) {
+    double f = 0.01 * std::sin(4.0 * M_PI * i / steps);
+    for (int j = 0; j < 6; j++) e[6*i+j] = f * dir[j];
+  }
+}
+
+}
+
+int main(int argc, char ** argv)
+{
+  std::string fname = "test/examples.xml";
+  std::string mname = "test_rd_chaboche";
+  long n = 20;
+  if (argc > 1) fname = argv[1];
+  if (argc > 2) mname = argv[2];
+  if (argc > 3) n = std::atol(argv[3]);
+
+  std::shared_ptr<NEMLModel> model = parse_xml(fname, mname);
+  NEMLModel_sd * runtime = dynamic_cast<NEMLModel_sd*>(model.get());
+  Composed composed(*model);
+
+  const int nh = Composed::nhist;
+  if (runtime->nhist() != nh) {
+    std::cerr << "History size mismatch" << std::endl;
+    return 1;
+  }
+
+  int steps = 200;
+  double dt = 1.0;
+  double T = 300.0;
+  std::vector<double> e;
+  strain_history(e, steps);
+
+  // Runtime and composed histories
+  std::vector<double> s1(6 * (steps + 1), 0.0), s2(s1);
+  std::vector<double> h1(nh * (steps + 1)), h2(h1);
+  std::vector<double> A1(36 * steps), A2(A1);
+  runtime->init_hist(&h1[0]);
+  composed.init_hist(&h2[0]);
+
+  auto run = [&](bool use_composed) {
+    double u = 0.0, p = 0.0;
+    for (int i = 1; i <= steps; i++) {
+      double un, pn;
+      int ier;
+      if (use_composed) {
+        ier = composed.update_sd(&e[6*i], &e[6*(i-1)], T, T, i*dt, (i-1)*dt,
+                                 &s2[6*i], &s2[6*(i-1)], &h2[nh*i],
+                                 &h2[nh*(i-1)], &A2[36*(i-1)], un, u, pn, p);
+      }
+      else {
+        ier = runtime->update_sd(&e[6*i], &e[6*(i-1)], T, T, i*dt, (i-1)*dt,
+                                 &s1[6*i], &s1[6*(i-1)], &h1[nh*i],
+                                 &h1[nh*(i-1)], &A1[36*(i-1)], un, u, pn, p);
+      }
+      if (ier != 0) {
+        std::cerr << "Update failed with code " << ier << std::endl;
+        std::exit(1);
+      }
+      u = un;
+      p = pn;
+    }
+    sink = u + p;
+  };
+
+  run(false);
+  run(true);
+
+  double ds = rel_diff(&s2[0], &s1[0], s1.size());
+  double dh = rel_diff(&h2[0], &h1[0], h1.size());
+  double dA = rel_diff(&A2[0], &A1[0], A1.size());
+
+  std::cout << "max relative difference: stress " << std::scientific
+      << ds << ", history " << dh << ", tangent " << dA << std::endl;
+
+  bench::header("runtime", "composed");
+  double tr = bench::time_ns([&]{run(false);}, n) / steps;
+  double tc = bench::time_ns([&]{run(true);}, n) / steps;
+  bench::report("update_sd " + mname, tr, tc);
+
+  if (std::max(ds, std::max(dh, dA)) > 1.0e-8) {
+    std::cerr << "Composed model does not match the runtime model"
+        << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
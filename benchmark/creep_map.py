@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+
+"""
+  Evaluating a creep rate map, an interpolate, and a yield surface over
+  many points from python: one call per point against a single call to
+  the _vec version.
+
+  Usage: creep_map.py [points per side]
+
+  Run from the repository root with PYTHONPATH set to the directory
+  containing the built neml package.
+"""
+
+import sys
+import time
+
+import numpy as np
+
+from neml import creep, interpolate, surfaces
+
+def best(f, repeats = 3):
+  times = []
+  for i in range(repeats):
+    t = time.perf_counter()
+    f()
+    times.append(time.perf_counter() - t)
+  return min(times)
+
+if __name__ == "__main__":
+  n = int(sys.argv[1]) if len(sys.argv) > 1 else 1000
+
+  A = interpolate.PiecewiseLinearInterpolate([300.0, 600.0], [1.0e-20, 1.0e-16])
+  rule = creep.PowerLawCreep(A, interpolate.PolynomialInterpolate([0.01, 1.0]))
+  surface = surfaces.IsoKinJ2()
+
+  s = np.linspace(10.0, 300.0, n)
+  T = np.linspace(300.0, 600.0, n)
+  stresses = np.random.default_rng(0).normal(size = (n * n, 6)) * 100.0
+  h = np.zeros((surface.nhist,))
+
+  cases = [
+      ("PiecewiseLinear.value",
+        lambda: [A.value(x) for x in np.tile(T, n)],
+        lambda: A.value_vec(np.tile(T, n))),
+      ("PowerLawCreep.g",
+        lambda: [rule.g(si, 0.0, 0.0, Ti) for si in s for Ti in T],
+        lambda: rule.g_vec(s[:,None], 0.0, 0.0, T[None,:])),
+      ("IsoKinJ2.f",
+        lambda: [surface.f(si, h, 300.0) for si in stresses],
+        lambda: surface.f_vec(stresses, h, 300.0))
+      ]
+
+  print("%d points" % (n * n))
+  print("%-24s %12s %12s %9s" % ("function", "loop ns", "vec ns", "speedup"))
+  for name, loop, vec in cases:
+    tl = best(loop) / n**2 * 1e9
+    tv = best(vec) / n**2 * 1e9
+    print("%-24s %12.1f %12.1f %8.1fx" % (name, tl, tv, tl / tv))
@@ -0,0 +1,87 @@
+// Thread scaling of the ensemble runner: a grid of uniaxial tests over
+// temperature, strain rate, and yield stress for the examples/ models,
+// run one at a time on a tuned clone and all at once through run_ensemble
+// on an increasing number of threads.  The C++ counterpart of
+// ensemble_sweep.py.
+//
+// Usage: ensemble_sweep [max threads] [examples directory]
+
+#include "bench.h"
+
+#include "ensemble.h"
+#include "parse.h"
+
+#include <cstdlib>
+#include <thread>
+
+using namespace neml;
+
+int main(int argc, char ** argv)
+{
+  unsigned nmax = 8;
+  std::string dir = "examples";
+  if (argc > 1) nmax = (unsigned) std::atoi(argv[1]);
+  if (argc > 2) dir = argv[2];
+
+  struct Example {
+    std::string file, name, s0;
+  };
+  std::vector<Example> examples = {
+    {"example.xml", "model_1", "rule.flow.hardening.s0"},
+    {"example.xml", "model_2", "flow.hardening.iso.s0"},
+    {"tutorial.xml", "tutorial_model", "rule.flow.hardening.s0"}};
+
+  double emax = 0.02;
+  int nsteps = 100;
+
+  std::cout << std::thread::hardware_concurrency() << " hardware threads"
+      << std::endl;
+
+  for (auto & ex : examples) {
+    std::shared_ptr<NEMLModel> model = parse_xml(dir + "/" + ex.file,
+                                                 ex.name);
+    double s0 = TunableParameters(model).get(ex.s0);
+
+    std::vector<EnsembleCase> cases;
+    for (double T : {300.0, 400.0, 500.0, 600.0}) {
+      for (double erate : {1.0e-5, 1.0e-4, 1.0e-3}) {
+        for (double f : {0.8, 1.0, 1.2}) {
+          EnsembleCase c;
+          c.program = [=](std::shared_ptr<NEMLModel> m, DriverResults & res)
+          {
+            return uniaxial_test(m, erate, res, T, emax, nsteps);
+          };
+          c.parameters[ex.s0] = f * s0;
+          cases.push_back(c);
+        }
+      }
+    }
+
+    auto clone = std::dynamic_pointer_cast<NEMLModel>(model->clone());
+    TunableParameters tunable(clone);
+    double tl = bench::time_ns([&]{
+      for (auto & c : cases) {
+        DriverResults res;
+        tunable.set(ex.s0, c.parameters.at(ex.s0));
+        c.program(clone, res);
+      }}, 3) / 1.0e6;
+
+    std::cout << ex.name << " (" << cases.size() << " cases)" << std::endl;
+    std::cout << "  " << std::left << std::setw(22) << "loop" << std::right
+        << std::setw(10) << std::fixed << std::setprecision(1) << tl
+        << " ms" << std::endl;
+
+    for (unsigned nt = 1; nt <= nmax; nt *= 2) {
+      TunedModelPool pool(model);
+      double te = bench::time_ns([&]{run_ensemble(pool, cases, nt);}, 3)
+          / 1.0e6;
+      std::cout << "  " << std::left << std::setw(22)
+          << ("ensemble, " + std::to_string(nt) + " threads") << std::right
+          << std::setw(10) << std::setprecision(1) << te << " ms"
+          << std::setw(8) << std::setprecision(2) << tl / te << "x"
+          << std::endl;
+    }
+  }
+
+  return 0;
+}
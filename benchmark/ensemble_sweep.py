@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+
+"""
+  A grid of uniaxial tests over temperature, strain rate, and yield
+  stress for the examples/ models, run one at a time through
+  neml.drivers and neml.cdrivers and all at once through neml.ensemble
+  on an increasing number of threads.
+
+  Usage: ensemble_sweep.py [max threads]
+
+  Run from the repository root with PYTHONPATH set to the directory
+  containing the built neml package.
+"""
+
+import sys
+import time
+
+import numpy as np
+
+from neml import parse, drivers, cdrivers, ensemble, tunable
+
+def best(f, repeats = 3):
+  times = []
+  for i in range(repeats):
+    t = time.perf_counter()
+    f()
+    times.append(time.perf_counter() - t)
+  return min(times)
+
+def sweep(model, s0_name, s0s):
+  """
+    The loading cases and the model changes for each
+  """
+  grid = [(T, erate, s0) for T in np.linspace(300.0, 600.0, 4)
+      for erate in (1.0e-5, 1.0e-4, 1.0e-3) for s0 in s0s]
+  kwargs = dict(emax = 0.02, nsteps = 100)
+  cases = [ensemble.uniaxial_test(erate, T = T, parameters = {s0_name: s0},
+    **kwargs) for T, erate, s0 in grid]
+
+  def one_by_one(run):
+    clone = model.clone()
+    params = tunable.TunableParameters(clone)
+    for T, erate, s0 in grid:
+      params[s0_name] = s0
+      run(clone, erate, T = T, **kwargs)
+
+  return cases, one_by_one
+
+if __name__ == "__main__":
+  nmax = int(sys.argv[1]) if len(sys.argv) > 1 else 8
+
+  models = [
+      ("examples/example.xml", "model_1", "rule.flow.hardening.s0"),
+      ("examples/example.xml", "model_2", "flow.hardening.iso.s0"),
+      ("examples/tutorial.xml", "tutorial_model", "rule.flow.hardening.s0")]
+
+  for fname, name, s0_name in models:
+    model = parse.parse_xml(fname, name)
+    s0 = tunable.TunableParameters(model)[s0_name]
+    cases, one_by_one = sweep(model, s0_name, s0 * np.array([0.8, 1.0, 1.2]))
+
+    print("%s (%i cases)" % (name, len(cases)))
+    tp = best(lambda: one_by_one(drivers.uniaxial_test), repeats = 1)
+    tc = best(lambda: one_by_one(cdrivers.uniaxial_test))
+    print("  %-20s %10.1f ms" % ("drivers loop", tp * 1e3))
+    print("  %-20s %10.1f ms" % ("cdrivers loop", tc * 1e3))
+    nt = 1
+    while nt <= nmax:
+      te = best(lambda: ensemble.run(model, cases, nthreads = nt))
+      print("  %-20s %10.1f ms %8.1fx %8.1fx" % ("ensemble, %i threads" % nt,
+        te * 1e3, tp / te, tc / te))
+      nt *= 2
@@ -0,0 +1,95 @@
+// Compare loading models from a large XML material library against
+// loading them from the equivalent binary image and through the indexed
+// XMLLibrary
+//
+// Usage: load_library [copies]
+
+#include "bench.h"
+
+#include "parse.h"
+#include "serialize.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace neml;
+
+namespace {
+
+const std::vector<std::string> models = {
+  "test_powerdamage", "test_j2iso", "test_j2isocomb", "test_creep_plasticity",
+  "test_j2comb", "test_nonassri", "test_yaguchi", "test_rd_chaboche",
+  "test_perzyna", "test_perfect", "test_pcreep"};
+
+// Library with copies of each of the example models
+std::vector<std::string> make_library(const std::string & src,
+                                      const std::string & fname, int copies)
+{
+  std::ifstream is(src);
+  std::stringstream ss;
+  ss << is.rdbuf();
+  std::string text = ss.str();
+
+  std::vector<std::string> names;
+  std::ofstream os(fname);
+  os << "<materials>" << std::endl;
+  for (int k = 0; k < copies; k++) {
+    for (auto & m : models) {
+      size_t start = text.find("<" + m + " ");
+      std::string close = "</" + m + ">";
+      size_t end = text.find(close, start);
+      std::string body = text.substr(start + m.size() + 1,
+                                     end - start - m.size() - 1);
+      std::string name = m + "_" + std::to_string(k);
+      os << "<" << name << body << "</" << name << ">" << std::endl;
+      names.push_back(name);
+    }
+  }
+  os << "</materials>" << std::endl;
+
+  return names;
+}
+
+}
+
+int main(int argc, char ** argv)
+{
+  int copies = 100;
+  if (argc > 1) copies = std::atoi(argv[1]);
+
+  std::string xml = "load_library.xml";
+  std::string bin = "load_library.nemlbin";
+  auto names = make_library("test/examples.xml", xml, copies);
+  xml_to_binary(xml, bin, names);
+
+  std::cout << names.size() << " models" << std::endl;
+
+  bench::header("XML", "binary");
+
+  // One model out of the library, as each rank of a parallel job would do
+  std::string last = names.back();
+  double tx = bench::time_ns([&]{parse_xml(xml, last);}, 20);
+  double tb = bench::time_ns([&]{parse_binary(bin, last);}, 20);
+  bench::report("load one model", tx, tb);
+
+  // Every model in the library, time per model
+  tx = bench::time_ns([&]{
+    for (auto & n : names) parse_xml(xml, n);}, 1);
+  tb = bench::time_ns([&]{
+    for (auto & n : names) parse_binary(bin, n);}, 1);
+  bench::report("load all, per model", tx / names.size(), tb / names.size());
+
+  // Indexed XML, after the first run has written the index
+  XMLLibrary(xml).names();
+  bench::header("XML", "indexed");
+  tx = bench::time_ns([&]{parse_xml(xml, last);}, 20);
+  double ti = bench::time_ns([&]{XMLLibrary(xml).parse(last);}, 20);
+  bench::report("load one model", tx, ti);
+
+  std::remove(xml.c_str());
+  std::remove((xml + ".index").c_str());
+  std::remove(bin.c_str());
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+// Compare the fixed size Mandel kernels in mandel.h against the BLAS
+// calls nemlmath used to make for the same 6 and 9 dimensional operations
+
+#include "bench.h"
+
+#include "nemlmath.h"
+
+#include <cstdlib>
+
+using namespace neml;
+
+namespace {
+
+void fill(double * a, int n)
+{
+  for (int i = 0; i < n; i++) a[i] = (double) std::rand() / RAND_MAX;
+}
+
+// Keep the compiler from discarding results
+volatile double sink;
+
+}
+
+int main(int argc, char ** argv)
+{
+  long n = 1000000;
+  if (argc > 1) n = std::atol(argv[1]);
+
+  double a[9], b[9], c[9];
+  double A[81], B[81], C[81];
+  fill(a, 9);
+  fill(b, 9);
+  fill(A, 81);
+  fill(B, 81);
+  fill(C, 81);
+
+  bench::header("BLAS", "fixed");
+
+  double tb = bench::time_ns([&]{
+    dgemv_("T", 6, 6, 1.0, A, 6, b, 1, 0.0, c, 1); sink = c[0];}, n);
+  double tf = bench::time_ns([&]{
+    fixed::mat_vec<6,6>(A, b, c); sink = c[0];}, n);
+  bench::report("mat_vec 6x6", tb, tf);
+
+  tb = bench::time_ns([&]{
+    dgemv_("N", 6, 6, 1.0, A, 6, b, 1, 0.0, c, 1); sink = c[0];}, n);
+  tf = bench::time_ns([&]{
+    fixed::mat_vec_trans<6,6>(A, b, c); sink = c[0];}, n);
+  bench::report("mat_vec_trans 6x6", tb, tf);
+
+  tb = bench::time_ns([&]{
+    dgemm_("N", "N", 6, 6, 6, 1.0, B, 6, A, 6, 0.0, C, 6); sink = C[0];}, n);
+  tf = bench::time_ns([&]{
+    fixed::mat_mat<6,6,6>(A, B, C); sink = C[0];}, n);
+  bench::report("mat_mat 6x6x6", tb, tf);
+
+  tb = bench::time_ns([&]{
+    dgemm_("N", "N", 9, 9, 9, 1.0, B, 9, A, 9, 0.0, C, 9); sink = C[0];}, n);
+  tf = bench::time_ns([&]{
+    fixed::mat_mat<9,9,9>(A, B, C); sink = C[0];}, n);
+  bench::report("mat_mat 9x9x9", tb, tf);
+
+  tb = bench::time_ns([&]{
+    dger_(6, 6, 1.0e-9, b, 1, a, 1, C, 6); sink = C[0];}, n);
+  tf = bench::time_ns([&]{
+    fixed::outer_update<6,6>(1.0e-9, a, b, C); sink = C[0];}, n);
+  bench::report("outer_update 6x6", tb, tf);
+
+  // Generic loops with a runtime size, as nemlmath had before
+  int sz = 6;
+  if (argc > 2) sz = std::atoi(argv[2]);
+  tb = bench::time_ns([&]{
+    double s = 0.0; for (int i = 0; i < sz; i++) s += a[i] * b[i];
+    sink = s;}, n);
+  tf = bench::time_ns([&]{ sink = fixed::dot<6>(a, b);}, n);
+  bench::report("dot 6 (runtime size)", tb, tf);
+
+  Sym6 D;
+  Skew3 W;
+  Mat66 M;
+  fill(D.v, 6);
+  fill(W.v, 3);
+  fill(M.v, 36);
+  tb = bench::time_ns([&]{
+    Mat99 R = truesdell_mat(D, W); sink = R.v[0];}, n);
+  tf = bench::time_ns([&]{
+    Mat99 R = mandel2full(M); sink = R.v[0];}, n);
+  std::cout << std::endl;
+  std::cout << "truesdell_mat: " << tb << " ns" << std::endl;
+  std::cout << "mandel2full:   " << tf << " ns" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+
+"""
+  Running the standard loading programs through neml.drivers against the
+  native versions in neml.cdrivers.
+
+  Usage: native_drivers.py [model]
+
+  Run from the repository root with PYTHONPATH set to the directory
+  containing the built neml package.
+"""
+
+import sys
+import time
+
+import numpy as np
+
+from neml import parse, drivers, cdrivers
+
+def best(f, repeats = 3):
+  times = []
+  for i in range(repeats):
+    t = time.perf_counter()
+    f()
+    times.append(time.perf_counter() - t)
+  return min(times)
+
+if __name__ == "__main__":
+  name = sys.argv[1] if len(sys.argv) > 1 else "test_rd_chaboche"
+  model = parse.parse_xml("test/examples.xml", name)
+
+  ttime = np.linspace(0, 1000.0, 200)
+  temperature = np.linspace(500.0, 600.0, 200)
+  tstrain = 0.005 * np.sin(ttime / 100.0)
+
+  cases = [
+      ("uniaxial_test", (1.0e-4,), dict(T = 500.0)),
+      ("strain_cyclic", (0.01, -1, 1.0e-4, 10), dict(T = 500.0,
+        hold_time = 10.0)),
+      ("stress_cyclic", (150.0, -1, 1.0, 10), dict(T = 500.0,
+        hold_time = 10.0)),
+      ("stress_relaxation", (0.01, 1.0e-4, 1000.0), dict(T = 500.0)),
+      ("creep", (150.0, 10.0, 1000.0), dict(T = 500.0)),
+      ("thermomechanical_strain_raw", (ttime, temperature, tstrain), {}),
+      ("rate_jump_test", ([1.0e-4, 1.0e-2, 1.0e-3],), dict(T = 500.0))
+      ]
+
+  print(name)
+  print("%-28s %10s %10s %9s" % ("program", "python ms", "native ms",
+    "speedup"))
+  for program, args, kwargs in cases:
+    tp = best(lambda: getattr(drivers, program)(model, *args, **kwargs))
+    tn = best(lambda: getattr(cdrivers, program)(model, *args, **kwargs))
+    print("%-28s %10.1f %10.1f %8.1fx" % (program, tp * 1e3, tn * 1e3,
+      tp / tn))
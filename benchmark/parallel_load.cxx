@@ -0,0 +1,97 @@
+// Loading every model in a library: one parse_xml call per model against
+// parse_xml_parallel, which reads the file once and builds the models on
+// several threads
+//
+// Usage: parallel_load [models] [max threads]
+
+#include "bench.h"
+
+#include "parse.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace neml;
+
+namespace {
+
+// A temperature table with n points
+std::string table(const std::string & name, double v0, int n)
+{
+  std::stringstream ss;
+  ss << "<" << name << " type=\"PiecewiseLinearInterpolate\"><points>";
+  for (int i = 0; i < n; i++) ss << " " << 20.0 + 10.0 * i;
+  ss << "</points><values>";
+  for (int i = 0; i < n; i++) ss << " " << v0 * (1.0 - 0.001 * i);
+  ss << "</values></" << name << ">";
+  return ss.str();
+}
+
+// Chaboche models, each with its own constants
+std::vector<std::string> write_library(const std::string & fname, int models)
+{
+  std::vector<std::string> names;
+  std::ofstream os(fname);
+  os << "<materials>" << std::endl;
+  for (int i = 0; i < models; i++) {
+    double f = 1.0 + 0.001 * i;
+    std::stringstream elastic;
+    elastic << "<elastic type=\"IsotropicLinearElasticModel\">"
+        << table("m1", 60384.61 * f, 20) << "<m1_type>shear</m1_type>"
+        << table("m2", 130833.3 * f, 20) << "<m2_type>bulk</m2_type>"
+        << "</elastic>";
+    std::string name = "model" + std::to_string(i);
+    os << "<" << name << " type=\"GeneralIntegrator\">" << elastic.str()
+        << "<rule type=\"TVPFlowRule\">" << elastic.str()
+        << "<flow type=\"ChabocheFlowRule\"><surface type=\"IsoKinJ2\"/>"
+        << "<hardening type=\"Chaboche\">"
+        << "<iso type=\"VoceIsotropicHardeningRule\">"
+        << table("s0", 100.0 * f, 20) << table("R", -80.0 * f, 20)
+        << "<d>3.0</d></iso>"
+        << "<C>" << table("C1", 135.0e3 * f, 20) << table("C2", 61.0e3 * f, 20)
+        << "</C><gmodels><g1 type=\"ConstantGamma\"><g>5.0e4</g></g1>"
+        << "<g2 type=\"ConstantGamma\"><g>1100.0</g></g2></gmodels>"
+        << "<A><A1>0.0</A1><A2>0.0</A2></A><a><a1>1.0</a1><a2>1.0</a2></a>"
+        << "</hardening><fluidity type=\"ConstantFluidity\"><eta>"
+        << 700.0 * f << "</eta></fluidity><n>10.5</n></flow></rule></"
+        << name << ">" << std::endl;
+    names.push_back(name);
+  }
+  os << "</materials>" << std::endl;
+  return names;
+}
+
+}
+
+int main(int argc, char ** argv)
+{
+  int models = 400;
+  unsigned max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  if (argc > 1) models = std::atoi(argv[1]);
+  if (argc > 2) max_threads = std::atoi(argv[2]);
+
+  std::string fname = "parallel_load.xml";
+  std::vector<std::string> names = write_library(fname, models);
+
+  auto each = [&]()
+  {
+    for (auto & n : names) parse_xml(fname, n);
+  };
+  double base = bench::time_ns(each, 3) / models;
+
+  std::cout << models << " models, " << std::thread::hardware_concurrency()
+      << " hardware threads" << std::endl << std::endl;
+  bench::header("parse_xml", "parallel");
+  for (unsigned n = 1; n <= max_threads; n *= 2) {
+    auto parallel = [&]() {parse_xml_parallel(fname, names, n);};
+    bench::report(std::to_string(n) + " threads, per model", base,
+                  bench::time_ns(parallel, 3) / models);
+  }
+
+  std::remove(fname.c_str());
+
+  return 0;
+}
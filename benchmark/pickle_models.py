@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+
+"""
+  Getting a model into a worker process: pickling it against parsing it
+  again from an XML library, per model and through a multiprocessing
+  pool.
+
+  Usage: pickle_models.py [models in the library] [workers]
+
+  Run from the repository root with PYTHONPATH set to the directory
+  containing the built neml package.
+"""
+
+import multiprocessing
+import os.path
+import pickle
+import re
+import sys
+import tempfile
+import time
+
+from neml import parse
+
+def library(fname, n):
+  """
+    Write renamed copies of the models in the test examples, returning
+    the names of n good ones
+  """
+  with open("test/examples.xml") as f:
+    text = f.read()
+  body = text[text.index("<materials>") + 11:text.index("</materials>")]
+  names = re.findall(r"^  <(\w+) type=", body, re.M)
+  models = []
+  with open(fname, "w") as f:
+    f.write("<materials>\n")
+    for i in range(n // len(names) + 1):
+      copy = body
+      for name in names:
+        copy = re.sub(r"(</?)%s\b" % name, r"\g<1>%s_%i" % (name, i), copy)
+        if not name.startswith("test_bad"):
+          models.append("%s_%i" % (name, i))
+      f.write(copy)
+    f.write("</materials>\n")
+  return models[:n]
+
+def best(f, repeats = 3):
+  times = []
+  for i in range(repeats):
+    t = time.perf_counter()
+    f()
+    times.append(time.perf_counter() - t)
+  return min(times)
+
+def parse_one(args):
+  fname, name = args
+  return parse.parse_xml(fname, name).nstore
+
+def use_model(model):
+  return model.nstore
+
+if __name__ == "__main__":
+  n = int(sys.argv[1]) if len(sys.argv) > 1 else 200
+  workers = int(sys.argv[2]) if len(sys.argv) > 2 else 2
+
+  with tempfile.TemporaryDirectory() as tmp:
+    fname = os.path.join(tmp, "library.xml")
+    names = library(fname, n)
+    models = [parse.parse_xml(fname, name) for name in names]
+    images = [pickle.dumps(m) for m in models]
+
+    tp = best(lambda: [parse.parse_xml(fname, name) for name in names])
+    td = best(lambda: [pickle.dumps(m) for m in models])
+    tl = best(lambda: [pickle.loads(i) for i in images])
+
+    print("%d models, %.1f kB pickled on average" % (n,
+      sum(len(i) for i in images) / n / 1000.0))
+    print("%-28s %12s" % ("operation", "us/model"))
+    print("%-28s %12.1f" % ("parse_xml", tp / n * 1e6))
+    print("%-28s %12.1f" % ("pickle.dumps", td / n * 1e6))
+    print("%-28s %12.1f" % ("pickle.loads", tl / n * 1e6))
+
+    with multiprocessing.Pool(workers) as pool:
+      tpp = best(lambda: pool.map(parse_one, [(fname, m) for m in names]))
+      tpm = best(lambda: pool.map(use_model, models))
+    print("%-28s %12.1f" % ("pool, workers parse", tpp / n * 1e6))
+    print("%-28s %12.1f" % ("pool, models pickled", tpm / n * 1e6))
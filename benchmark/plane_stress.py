@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+
+"""
+  Plane stress updates: iterating on the out of plane strains around
+  update_sd from python, as a host code would, against the native
+  MixedControlModel.
+
+  Usage: plane_stress.py [model] [steps]
+
+  Run from the repository root with PYTHONPATH set to the directory
+  containing the built neml package.
+"""
+
+import sys
+import time
+
+import numpy as np
+import numpy.linalg as la
+
+from neml import parse, models
+
+control = [2,3,4]
+
+def host_update(model, e_np1, e_n, T, t_np1, t_n, s_n, h_n, rtol = 1.0e-6,
+    atol = 1.0e-10, miter = 20):
+  """
+    Newton iteration on the controlled strains, with the controlled strains
+    carried in the first entries of the history
+  """
+  e = np.copy(e_np1)
+  en = np.copy(e_n)
+  e[control] = h_n[:3]
+  en[control] = h_n[:3]
+  s, h, A, u, p = model.update_sd(e, en, T, T, t_np1, t_n, s_n, h_n[3:],
+      0.0, 0.0)
+  nR0 = la.norm(s[control])
+  nR = nR0
+  i = 0
+  while nR > rtol * nR0 and nR > atol:
+    e[control] -= la.solve(A[np.ix_(control,control)], s[control])
+    s, h, A, u, p = model.update_sd(e, en, T, T, t_np1, t_n, s_n, h_n[3:],
+        0.0, 0.0)
+    nR = la.norm(s[control])
+    i += 1
+    if i > miter:
+      raise RuntimeError("Too many iterations")
+  return s, np.concatenate((e[control], h))
+
+def run(update, h0, steps):
+  e_n = np.zeros((6,))
+  s_n = np.zeros((6,))
+  h_n = h0
+  for i in range(steps):
+    e_np1 = np.array([0.02, -0.01, 0, 0, 0, 0.01]) * (i + 1) / steps
+    s_n, h_n = update(e_np1, e_n, i + 1.0, float(i), s_n, h_n)
+    e_n = e_np1
+  return s_n
+
+if __name__ == "__main__":
+  name = sys.argv[1] if len(sys.argv) > 1 else "test_j2iso"
+  steps = int(sys.argv[2]) if len(sys.argv) > 2 else 1000
+  base = parse.parse_xml("test/examples.xml", name)
+  wrapped = models.MixedControlModel(base)
+  T = 500.0
+
+  def host(e_np1, e_n, t_np1, t_n, s_n, h_n):
+    return host_update(base, e_np1, e_n, T, t_np1, t_n, s_n, h_n)
+
+  def native(e_np1, e_n, t_np1, t_n, s_n, h_n):
+    s, h, A, u, p = wrapped.update_sd(e_np1, e_n, T, T, t_np1, t_n, s_n, h_n,
+        0.0, 0.0)
+    return s, h
+
+  h0 = np.concatenate((np.zeros((3,)), base.init_store()))
+  t = time.perf_counter()
+  s1 = run(host, h0, steps)
+  th = time.perf_counter() - t
+  t = time.perf_counter()
+  s2 = run(native, wrapped.init_store(), steps)
+  tn = time.perf_counter() - t
+
+  print("%s, %d steps, max stress difference %.2e" % (name, steps,
+    np.max(np.abs(s1 - s2))))
+  print("%-24s %10.1f us/step" % ("host iteration", th / steps * 1e6))
+  print("%-24s %10.1f us/step" % ("MixedControlModel", tn / steps * 1e6))
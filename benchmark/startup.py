@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+
+"""
+  Startup cost of NEML: loading the shared library and importing the
+  python package, each timed in a fresh interpreter.
+
+  Usage: startup.py [path/to/libneml.so] [repeats]
+
+  The package is imported from the normal python path, so set PYTHONPATH
+  to the directory containing the built neml package.
+"""
+
+import os.path
+import subprocess
+import sys
+
+load_lib = """
+import ctypes, time
+t = time.perf_counter()
+ctypes.CDLL(%r)
+print(time.perf_counter() - t)
+"""
+
+import_neml = """
+import time
+t = time.perf_counter()
+from neml import (nemlmath, solvers, objects, interpolate, elasticity,
+    surfaces, hardening, ri_flow, visco_flow, general_flow, creep, models,
+    damage, parse, serialize)
+print(time.perf_counter() - t)
+"""
+
+def median_ms(code, n):
+  times = sorted(float(subprocess.check_output([sys.executable, "-c", code]))
+      for i in range(n))
+  return 1000.0 * times[n // 2]
+
+if __name__ == "__main__":
+  lib = sys.argv[1] if len(sys.argv) > 1 else os.path.join("lib", "libneml.so")
+  n = int(sys.argv[2]) if len(sys.argv) > 2 else 21
+
+  print("%-24s%10s" % ("operation", "ms"))
+  print("%-24s%10.2f" % ("load libneml", median_ms(load_lib % os.path.abspath(lib), n)))
+  print("%-24s%10.2f" % ("import neml", median_ms(import_neml, n)))
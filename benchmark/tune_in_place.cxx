@@ -0,0 +1,38 @@
+// Cost of trying a new parameter vector in a calibration loop: parse the
+// model again from XML against changing the constants in place
+//
+// Usage: tune_in_place [file.xml] [model] [n]
+
+#include "bench.h"
+
+#include "parse.h"
+#include "tunable.h"
+
+#include <cstdlib>
+
+using namespace neml;
+
+int main(int argc, char ** argv)
+{
+  std::string fname = "test/examples.xml";
+  std::string mname = "test_rd_chaboche";
+  long n = 1000;
+  if (argc > 1) fname = argv[1];
+  if (argc > 2) mname = argv[2];
+  if (argc > 3) n = std::atol(argv[3]);
+
+  std::shared_ptr<NEMLModel> model = parse_xml(fname, mname);
+  TunableParameters tunable(model);
+  std::vector<double> values = tunable.values();
+
+  std::cout << tunable.size() << " tunable constants" << std::endl;
+
+  bench::header("parse", "in place");
+  double tp = bench::time_ns([&]{parse_xml(fname, mname);}, n);
+  double ti = bench::time_ns([&]{
+    for (auto & v : values) v *= 1.0000001;
+    tunable.set_values(values);}, n);
+  bench::report("new parameters", tp, ti);
+
+  return 0;
+}
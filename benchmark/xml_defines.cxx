@@ -0,0 +1,133 @@
+// Memory used by a library of models that all use the same elasticity and
+// hardening, written once in the defines section and referred to by name
+// (and shared between the models with share_definitions) compared with
+// writing them out in full in every model
+//
+// Usage: xml_defines [models] [points]
+
+#include "bench.h"
+
+#include "parse.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+using namespace neml;
+
+namespace {
+
+// A temperature table with n points
+std::string table(const std::string & name, double v0, int n)
+{
+  std::stringstream ss;
+  ss << "<" << name << " type=\"PiecewiseLinearInterpolate\"><points>";
+  for (int i = 0; i < n; i++) ss << " " << 20.0 + 10.0 * i;
+  ss << "</points><values>";
+  for (int i = 0; i < n; i++) ss << " " << v0 * (1.0 - 0.001 * i);
+  ss << "</values></" << name << ">";
+  return ss.str();
+}
+
+std::string elastic(const std::string & name, int n)
+{
+  return "<" + name + " type=\"IsotropicLinearElasticModel\">" +
+      table("m1", 60384.61, n) + "<m1_type>shear</m1_type>" +
+      table("m2", 130833.3, n) + "<m2_type>bulk</m2_type></" + name + ">";
+}
+
+std::string hardening(const std::string & name, int n)
+{
+  std::stringstream ss;
+  ss << "<" << name << " type=\"Chaboche\">"
+      << "<iso type=\"VoceIsotropicHardeningRule\">" << table("s0", 100.0, n)
+      << table("R", -80.0, n) << "<d>3.0</d></iso>"
+      << "<C>" << table("C1", 135.0e3, n) << table("C2", 61.0e3, n)
+      << table("C3", 11.0e3, n) << "</C>"
+      << "<gmodels><g1 type=\"ConstantGamma\"><g>5.0e4</g></g1>"
+      << "<g2 type=\"ConstantGamma\"><g>1100.0</g></g2>"
+      << "<g3 type=\"ConstantGamma\"><g>1.0</g></g3></gmodels>"
+      << "<A><A1>0.0</A1><A2>0.0</A2><A3>0.0</A3></A>"
+      << "<a><a1>1.0</a1><a2>1.0</a2><a3>1.0</a3></a>"
+      << "</" << name << ">";
+  return ss.str();
+}
+
+// Models differing only in their rate sensitivity
+void write_library(const std::string & fname, int models, int points,
+                   bool shared)
+{
+  std::ofstream os(fname);
+  os << "<materials>" << std::endl;
+  if (shared) {
+    os << "<defines>" << elastic("elastic", points)
+        << hardening("hardening", points) << "</defines>" << std::endl;
+  }
+  for (int i = 0; i < models; i++) {
+    std::string e = shared ? "<elastic ref=\"elastic\"/>" :
+        elastic("elastic", points);
+    std::string h = shared ? "<hardening ref=\"hardening\"/>" :
+        hardening("hardening", points);
+    os << "<model" << i << " type=\"GeneralIntegrator\">" << e
+        << "<rule type=\"TVPFlowRule\">" << e
+        << "<flow type=\"ChabocheFlowRule\"><surface type=\"IsoKinJ2\"/>" << h
+        << "<fluidity type=\"ConstantFluidity\"><eta>" << 700.0 + i
+        << "</eta></fluidity><n>10.5</n></flow></rule></model" << i << ">"
+        << std::endl;
+  }
+  os << "</materials>" << std::endl;
+}
+
+// Load every model, returning the heap bytes they use and the time taken
+void load_all(const std::string & fname, double & bytes, double & ns)
+{
+  XMLLibrary library(fname, "", true, true);
+  std::vector<std::shared_ptr<NEMLModel>> keep;
+  std::vector<std::string> names = library.names();
+  keep.reserve(names.size());
+
+  double start = bench::heap_bytes();
+  auto t0 = std::chrono::steady_clock::now();
+  for (auto & name : names) keep.push_back(library.parse(name));
+  auto t1 = std::chrono::steady_clock::now();
+  bytes = bench::heap_bytes() - start;
+  ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+}
+
+int main(int argc, char ** argv)
+{
+  int models = 500;
+  int points = 20;
+  if (argc > 1) models = std::atoi(argv[1]);
+  if (argc > 2) points = std::atoi(argv[2]);
+
+  std::string inline_file = "xml_defines_inline.xml";
+  std::string shared_file = "xml_defines_shared.xml";
+  write_library(inline_file, models, points, false);
+  write_library(shared_file, models, points, true);
+
+  double bi, ti, bs, ts;
+  load_all(inline_file, bi, ti);
+  load_all(shared_file, bs, ts);
+
+  std::cout << models << " models, tables of " << points << " points"
+      << std::endl << std::endl;
+  bench::header("inline", "defines");
+  bench::report("load all", ti, ts);
+  if (bi > 0.0) {
+    std::cout << std::setprecision(0) << std::endl << "heap bytes: inline "
+        << bi << " (" << bi / models << " per model), defines " << bs << " ("
+        << bs / models << " per model), " << std::setprecision(1) << bi / bs
+        << "x less" << std::endl;
+  }
+
+  for (auto & f : {inline_file, shared_file}) {
+    std::remove(f.c_str());
+    std::remove((f + ".index").c_str());
+  }
+
+  return 0;
+}
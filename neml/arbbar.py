@@ -1,12 +1,9 @@
 import numpy as np
-import numpy.linalg as la
 import networkx as nx
 
 import warnings
 
-import scipy.optimize as opt
-
-from neml import uniaxial
+from neml import uniaxial, barnetwork
 
 class BarModel(nx.MultiGraph):
   """
@@ -30,14 +27,14 @@ class BarModel(nx.MultiGraph):
       They can be imposed forces or imposed displacements
       They are specified as functions of time
 
-      Additionally, temperature histories can be assigned to 
+      Additionally, temperature histories can be assigned to
       each bar using the bar object
 
     Loading:
       Calling solve(dt) advances the model from t_n to t_n + dt
 
     Solution history:
-      Each bar maintains its own history internally, 
+      Each bar provides its own history,
         as defined in the bar class
       Each node has properties:
           "displacements"
@@ -51,14 +48,25 @@ class BarModel(nx.MultiGraph):
           "time"
           "energy"
           "dissipation"
-        are tracked 
+        are tracked
+
+    Solver:
+      The first solve flattens the graph into the native
+      barnetwork.BarNetwork, which updates all the bars at once and
+      solves the equilibrium equations with a sparse direct solver.
+      Bars and boundary conditions should not be added after that.
   """
-  def __init__(self, *args, **kwargs):
+  def __init__(self, *args, nthreads = 1, **kwargs):
+    """
+      Optional:
+        nthreads    threads for the bar updates, 0 for all
+    """
     super(nx.MultiGraph, self).__init__(*args, **kwargs)
     self.time = np.array([0.0])
     self.energy = np.array([0.0])
     self.dissipation = np.array([0.0])
     self.validated = False
+    self.nthreads = nthreads
 
     # Sign convention
     self.sign = [-1.0,1.0]
@@ -72,16 +80,14 @@ class BarModel(nx.MultiGraph):
         dt      time increment
 
       Optional:
-        ndiv    max number of adaptive subdivisions
-        dfact   what to divided by (SHOULD BE AN INTEGER)
-        verbose dump a lot of solver info
+        ndiv        max number of adaptive subdivisions
+        dfact       what to divided by (SHOULD BE AN INTEGER)
+        verbose     print the substepping
+        extrapolate extrapolate the displacements for the initial guess
     """
     if not self.validated:
       self.validate()
-    
-    free_nodes, fixed_nodes = self.free_fixed_nodes()
 
-    dt_total = dt
     dt_attempt = dt
     step_total = dfact**ndiv
     step_attempt = dfact**ndiv
@@ -90,13 +96,11 @@ class BarModel(nx.MultiGraph):
     ef = 1.0
 
     while step_curr < step_total:
-      solveme = lambda d: self.RJ(d, free_nodes, dt_attempt)
-      d_guess = self.make_guess(free_nodes, extrapolate = extrapolate,
-          value = ef)   
+      d_guess = self.make_guess(extrapolate = extrapolate, value = ef)
       try:
-        d = newton(solveme, d_guess, verbose = verbose, fail_iter = True)
+        update = self.take_step(d_guess, dt_attempt)
         step_curr += step_attempt
-      except Exception as e:
+      except RuntimeError as e:
         dtried += 1
         if verbose:
           print("Substepping: %i" % dtried)
@@ -106,112 +110,93 @@ class BarModel(nx.MultiGraph):
         dt_attempt /= dfact
         ef /= dfact
         continue
-      self.apply_update(d, free_nodes, dt_attempt)
+      self.apply_update(update, dt_attempt)
       ef = 1.0
 
-  def apply_update(self, d, free_nodes, dt):
+  def take_step(self, d, dt):
+    """
+      Solve for the state after a time increment, without recording it
+
+      Parameters:
+        d           guess for the nodal displacements
+        dt          time increment
+    """
+    t_next = self.time[-1] + dt
+
+    T_next = np.array([bar.T(t_next) for bar in self.bars])
+    f_ext = np.zeros((len(self.node_list),))
+    d = np.copy(d)
+    for i,n in enumerate(self.node_list):
+      if 'displacement bc' in self.nodes[n]:
+        d[i] = self.nodes[n]['displacement bc'](t_next)
+      elif 'force bc' in self.nodes[n]:
+        f_ext[i] = self.nodes[n]['force bc'](t_next)
+
+    r = self.records
+    return self.network.step(t_next, self.time[-1], T_next,
+        r['temperature'][-1], f_ext, d, r['tstrain'][-1], r['mstrain'][-1],
+        r['stress'][-1], r['history'][-1], r['energy'][-1],
+        r['dissipation'][-1])
+
+  def apply_update(self, update, dt):
     """
       Actually apply the results of an update
 
       Parameters:
-        d           free displacements
-        free_nodes  the list of free nodes
+        update      results of take_step
         dt          time increment
     """
     t_next = self.time[-1] + dt
-    
-    for n in self.nodes():
-      # This gets summed below
-      self.node[n]['forces'] = np.append(self.node[n]['forces'], 0.0)
-      if n in free_nodes:
-        self.node[n]['displacements'] = np.append(
-            self.node[n]['displacements'], d[free_nodes.index(n)])
-      else:
-        self.node[n]['displacements'] = np.append(
-            self.node[n]['displacements'], 
-            self.node[n]['displacement bc'](t_next))
-    
-    e_sum = 0.0
-    p_sum = 0.0
-    for i,j,data in self.edges(data=True):
-      me = data['object']
-      for ni,n in enumerate((i,j)):
-        self.node[n]['forces'][-1] += self.sign[ni] * me.stress_next * me.A
-      e_sum += me.energy_next * me.A * me.l
-      p_sum += me.dissipation_next * me.A * me.l
-      me.advance_step()
+    (d, f, strain, tstrain, mstrain, estrain, stress, history, energy,
+        dissipation) = update
+
+    self.records['displacements'].append(d)
+    self.records['forces'].append(f)
+    self.records['strain'].append(strain)
+    self.records['tstrain'].append(tstrain)
+    self.records['mstrain'].append(mstrain)
+    self.records['estrain'].append(estrain)
+    self.records['stress'].append(stress)
+    self.records['history'].append(history)
+    self.records['energy'].append(energy)
+    self.records['dissipation'].append(dissipation)
+    self.records['temperature'].append(np.array([bar.T(t_next)
+      for bar in self.bars]))
+
+    for i,n in enumerate(self.node_list):
+      self.nodes[n]['displacements'] = self.records['displacements'].values[:,i]
+      self.nodes[n]['forces'] = self.records['forces'].values[:,i]
+
+    e_sum = np.sum(energy * self.areas * self.lengths)
+    p_sum = np.sum(dissipation * self.areas * self.lengths)
 
     self.time = np.append(self.time, t_next)
     self.energy = np.append(self.energy, e_sum)
-    self.dissipation = np.append(self.dissipation, e_sum)
-  
-  def make_guess(self, free_nodes, extrapolate = True, value = 1.0):
+    self.dissipation = np.append(self.dissipation, p_sum)
+
+  def make_guess(self, extrapolate = True, value = 1.0):
     """
-      Make a displacement guess
+      Make a displacement guess, for all the nodes
 
-      Parameters:
-        free_nodes  the list of free nodes (this sets dof numbering)
+      Optional:
+        extrapolate extrapolate from the last two steps
+        value       fraction of the last increment to extrapolate
     """
-    if (not extrapolate) or (len(self.time) < 2):
-      return np.array([self.node[n]['displacements'][-1] for n in free_nodes])
+    d = self.records['displacements'].values
+    if (not extrapolate) or (len(d) < 2):
+      return np.copy(d[-1])
     else:
-      xprev = np.array([self.node[n]['displacements'][-1] for n in free_nodes])
-      xprevprev = np.array([self.node[n]['displacements'][-2] for n in free_nodes])
-      return xprev + value * (xprev - xprevprev)
-  
+      return d[-1] + value * (d[-1] - d[-2])
+
   def free_fixed_nodes(self):
     """
       Return lists of the free and fixed nodes
     """
-    free = [n for n in self.nodes() if 'displacement bc' not in self.node[n]]
-    fixed = [n for n in self.nodes() if 'displacement bc' in self.node[n]]
+    free = [n for n in self.nodes() if 'displacement bc' not in self.nodes[n]]
+    fixed = [n for n in self.nodes() if 'displacement bc' in self.nodes[n]]
 
     return free, fixed
 
-  def RJ(self, d, free_nodes, dt):
-    """
-      Compute the residual equilibrium equation and the Jacobian
-
-      Parameters:
-        d           current free displacements
-        free_nodes  listing of free nodes (sets the dof order)
-        dt          time increment
-    """
-    R = np.zeros((len(free_nodes),))
-    J = np.zeros((len(free_nodes), len(free_nodes)))
-
-    t_next = self.time[-1] + dt
-
-    # External forces
-    for i,n in enumerate(free_nodes):
-      if 'force bc' in self.node[n]:
-        R[i] -= self.node[n]['force bc'](t_next)
-      
-    for i,j,data in self.edges(data=True):
-      # Delta d
-      dd = 0.0
-      for index, node in enumerate((i,j)):
-        if node in free_nodes:
-          dd += self.sign[index]*d[free_nodes.index(node)]
-        else:
-          dd += self.sign[index]*self.node[node]['displacement bc'](t_next)
-      
-      # Force update
-      f, A = data['object'].update_force(dd, t_next, self.time[-1])
-
-      # Assemble internal forces and derivative
-      for index_i, node_i in enumerate((i,j)):
-        if node_i in free_nodes:
-          idx_i = free_nodes.index(node_i)
-          R[idx_i] += self.sign[index_i] * f
-
-          for index_j, node_j in enumerate((i,j)):
-            if node_j in free_nodes:
-              idx_j = free_nodes.index(node_j)
-              J[idx_i, idx_j] += (self.sign[index_i]*self.sign[index_j] * A)
-     
-    return R, J
-
   def add_force_bc(self, node, bfn):
     """
       Add a force boundary condition
@@ -220,12 +205,12 @@ class BarModel(nx.MultiGraph):
         node        node to add to
         bfn         force as a function of time
     """
-    if 'force bc' in self.node[node] or 'displacement bc' in self.node[node]:
+    if 'force bc' in self.nodes[node] or 'displacement bc' in self.nodes[node]:
       warnings.warn("Overriding previous boundary condition")
-    if 'displacement bc' in self.node[node]:
-      del self.node[node]['displacement bc']
+    if 'displacement bc' in self.nodes[node]:
+      del self.nodes[node]['displacement bc']
 
-    self.node[node]['force bc'] = bfn
+    self.nodes[node]['force bc'] = bfn
 
   def add_displacement_bc(self, node, bfn):
     """
@@ -233,23 +218,62 @@ class BarModel(nx.MultiGraph):
         node        node to add to
         bfn         displacement as a function of time
     """
-    if 'force bc' in self.node[node] or 'displacement bc' in self.node[node]:
+    if 'force bc' in self.nodes[node] or 'displacement bc' in self.nodes[node]:
       warnings.warn("Overriding previous boundary condition")
-    if 'force bc' in self.node[node]:
-      del self.node[node]['force bc']
+    if 'force bc' in self.nodes[node]:
+      del self.nodes[node]['force bc']
 
-    self.node[node]['displacement bc'] = bfn
+    self.nodes[node]['displacement bc'] = bfn
 
   def validate(self):
     """
-      Iterate through the graph and make sure that everything is okay to
-      run.
+      Iterate through the graph, make sure that everything is okay to
+      run, and flatten it into the native solver
     """
-    for node in self.nodes():
-      if 'displacements' not in self.node[node]:
-        self.node[node]['displacements'] = np.array([0.0])
-      if 'forces' not in self.node[node]:
-        self.node[node]['forces'] = np.array([0.0])
+    self.node_list = list(self.nodes())
+    index = {n: i for i,n in enumerate(self.node_list)}
+    edges = list(self.edges(data = True))
+    for i,j,data in edges:
+      if not isinstance(data.get('object'), Bar):
+        raise ValueError("Edge (%s,%s) is not a Bar" % (str(i), str(j)))
+
+    self.bars = [data['object'] for i,j,data in edges]
+    self.areas = np.array([bar.A for bar in self.bars])
+    self.lengths = np.array([bar.l for bar in self.bars])
+    ends = [index[n] for i,j,data in edges for n in (i,j)]
+    fixed = ['displacement bc' in self.nodes[n] for n in self.node_list]
+
+    self.network = barnetwork.BarNetwork(len(self.node_list), ends,
+        [bar.mat for bar in self.bars], self.areas, self.lengths, fixed,
+        nthreads = self.nthreads)
+
+    d0 = np.zeros((len(self.node_list),))
+    f0 = np.zeros((len(self.node_list),))
+    for i,n in enumerate(self.node_list):
+      if 'displacements' in self.nodes[n]:
+        d0[i] = self.nodes[n]['displacements'][-1]
+      if 'forces' in self.nodes[n]:
+        f0[i] = self.nodes[n]['forces'][-1]
+
+    self.records = {
+        'displacements': StepRecord(d0),
+        'forces': StepRecord(f0),
+        'history': StepRecord(np.concatenate([bar.history[-1]
+          for bar in self.bars]) if self.bars else np.zeros((0,)))
+        }
+    for name in ('stress', 'strain', 'mstrain', 'estrain', 'tstrain',
+        'energy', 'dissipation', 'temperature'):
+      self.records[name] = StepRecord(np.array([getattr(bar, name)[-1]
+        for bar in self.bars]))
+
+    for i,n in enumerate(self.node_list):
+      self.nodes[n]['displacements'] = self.records['displacements'].values[:,i]
+      self.nodes[n]['forces'] = self.records['forces'].values[:,i]
+
+    offsets = self.network.offsets
+    for k, bar in enumerate(self.bars):
+      bar.attach(self.records, k, offsets[k], offsets[k+1])
+
     self.validated = True
 
   def gather_element(self, quantity):
@@ -259,12 +283,70 @@ class BarModel(nx.MultiGraph):
       Parameters:
         quantity        what to grab
     """
-    return np.array([getattr(e['object'], quantity) for i,j,e in 
+    return np.array([getattr(e['object'], quantity) for i,j,e in
       self.edges(data = True)])
 
+class StepRecord(object):
+  """
+    The values of a quantity at each step, kept in a block of memory
+    that doubles in size as needed
+  """
+  def __init__(self, first):
+    """
+      Parameters:
+        first       initial value
+    """
+    first = np.asarray(first, dtype = float)
+    self.data = np.empty((4,) + first.shape)
+    self.data[0] = first
+    self.n = 1
+
+  def append(self, value):
+    """
+      Add the value at the next step
+
+      Parameters:
+        value       new value
+    """
+    if self.n == self.data.shape[0]:
+      self.data = np.concatenate((self.data, np.empty_like(self.data)))
+    self.data[self.n] = value
+    self.n += 1
+
+  @property
+  def values(self):
+    """
+      View of the values at every step
+    """
+    return self.data[:self.n]
+
+  def __getitem__(self, i):
+    return self.values[i]
+
+  def __len__(self):
+    return self.n
+
+def bar_quantity(name, doc):
+  """
+    Property giving the value of a bar quantity at every step
+
+    Parameters:
+      name      name of the quantity
+      doc       docstring
+  """
+  def get(self):
+    if self.records is None:
+      return np.array([self.initial[name]])
+    return self.records[name].values[:,self.index]
+  return property(get, doc = doc)
+
 class Bar(object):
   """
     Object representing a single bar, including its history
+
+    Until the bar is part of a solved BarModel its history is just
+    the initial state.  After that the history is a view of the
+    model's records.
   """
   def __init__(self, mat, A, l, T = lambda t: 0.0):
     """
@@ -272,155 +354,57 @@ class Bar(object):
         mat     NEML small strain material model
         A       bar cross-sectional area
         l       bar length
-      
+
       Optional:
-        T       bar temperature as a function of time, defaults to 0 
+        T       bar temperature as a function of time, defaults to 0
     """
     self.mat = uniaxial.UniaxialModel(mat)
     self.A = A
     self.l = l
     self.T = T
-    
-    self.stress = np.zeros((1,))
-    self.strain = np.zeros((1,))
-    self.mstrain = np.zeros((1,))
-    self.estrain = np.zeros((1,))
-    self.tstrain = np.zeros((1,))
-    self.energy = np.zeros((1,))
-    self.dissipation = np.zeros((1,))
-    self.temperature = np.array([self.T(0)])
-    self.history = np.array([self.mat.init_store()])
-
-    self.stress_next = 0.0
-    self.strain_next = 0.0
-    self.mstrain_next = 0.0
-    self.estrain_next = 0.0
-    self.tstrain_next = 0.0
-    self.energy_next = 0.0
-    self.dissipation_next = 0.0
-    self.T_next = 0.0
-    self.history_next = np.empty(self.history[0].shape)
-
-  def update_force(self, d, t_np1, t_n):
-    """
-      Run a stress update, provide the force and the tangent
 
-      Parameters:
-        d       DELTA bar displacement
-        t_np1   next time step
-        t_n     last time step
-    """
-    self.T_next = self.T(t_np1)
-
-    a_np1 = self.mat.alpha(self.T_next)
-    a_n = self.mat.alpha(self.temperature[-1])
-    dT = self.T_next - self.temperature[-1]
-
-    self.tstrain_next = self.tstrain[-1] + dT * (a_np1 + a_n) / 2
-
-    self.strain_next = d / self.l
-    self.mstrain_next = self.strain_next - self.tstrain_next
-    
-    (self.stress_next, self.history_next, tangent, self.energy_next,
-        self.dissipation_next) = self.mat.update(
-            self.mstrain_next, self.mstrain[-1], 
-            self.T_next, self.temperature[-1],
-            t_np1, t_n,
-            self.stress[-1], self.history[-1],
-            self.energy[-1], self.dissipation[-1])
-
-    self.estrain_next = self.mat.elastic_strains(self.stress_next, self.T_next,
-        self.history_next)
-
-    return self.stress_next * self.A, tangent * self.A / self.l
-
-  def advance_step(self):
-    """
-      Actually append the speculative bar histories
-    """
-    self.stress = np.append(self.stress, self.stress_next)
-    self.strain = np.append(self.strain, self.strain_next)
-    self.mstrain = np.append(self.mstrain, self.mstrain_next)
-    self.estrain = np.append(self.estrain, self.estrain_next)
-    self.tstrain = np.append(self.tstrain, self.tstrain_next)
-    self.energy = np.append(self.energy, self.energy_next)
-    self.dissipation = np.append(self.dissipation, self.dissipation_next)
-    self.temperature = np.append(self.temperature, self.T_next)
-    self.history = np.vstack((self.history, self.history_next))
-   
-def newton(RJ, x0, verbose = False, rtol = 1.0e-6, atol = 1.0e-8, miter = 50,
-    linesearch = 'none', bt_tau = 0.5, bt_c = 1.0e-4, fail_iter = True):
-  """
-    Manually-code newton-raphson so that I can output convergence info, if
-    requested.
-
-    Parameters:
-      RJ        function return the residual + jacobian
-      x0        initial guess
-
-    Optional:
-      verbose   verbose output
-  """
-  R, J = RJ(x0)
-  nR = la.norm(R)
-  nR0 = nR
-  x = np.copy(x0)
-  
-  i = 0
-
-  if verbose:
-    print("Iter.\tnR\t\tnR/nR0\t\tcond\t\tlinesearch")
-    print("%i\t%e\t%e\t" % (i, nR, nR / nR0))
-
-  while (nR > rtol * nR0) and (nR > atol):
-    a = la.solve(J, R)
-
-    if linesearch == 'none':
-      f = 1.0
-    elif linesearch == 'backtracking':
-      f = backtrack(RJ, R, J, x, -a, tau = bt_tau, c = bt_c, verbose = verbose)
-    else:
-      raise ValueError("Unknown linesearch type.")
-    
-    x -= (a * f)
-    R, J = RJ(x)
-    nR = la.norm(R)
-    i += 1
-    if verbose:
-      print("%i\t%e\t%e\t%e\t%f" % (i, nR, nR / nR0,la.cond(J), f))
-    if i > miter:
-      if verbose:
-        print("")
-      if fail_iter:
-        raise MaximumIterations()
-      else:
-        break
-  
-  if verbose:
-    print("")
-
-  return x
-
-def backtrack(RJ, R0, J0, x, a, tau = 0.5, c = 1.0e-4, verbose = False):
-  """
-    Do a backtracking line search
-
-    Parameters:
-      RJ        residual/jacobian function
-      R0        value of R, to save a feval
-      J0        value of J, to save a feval
-      x         point to start from
-      a         direction
-
-    Optional:
-      tau       backtrack tau
-      c         backtrack c
-      verbose   verbose output
-  """
-  alpha = 1.0
-  cv = la.norm(RJ(x + alpha * a)[0])
-  while cv > la.norm(R0 + c * alpha * np.dot(J0, a)):
-    alpha *= tau
-    cv = la.norm(RJ(x + alpha * a)[0])
+    self.initial = {
+        'stress': 0.0,
+        'strain': 0.0,
+        'mstrain': 0.0,
+        'estrain': 0.0,
+        'tstrain': 0.0,
+        'energy': 0.0,
+        'dissipation': 0.0,
+        'temperature': self.T(0),
+        'history': self.mat.init_store()
+        }
+    self.records = None
+
+  def attach(self, records, index, start, end):
+    """
+      Take the history from the records of a BarModel
 
-  return alpha
+      Parameters:
+        records     model records
+        index       index of this bar
+        start       start of this bar's stored variables
+        end         end of this bar's stored variables
+    """
+    self.records = records
+    self.index = index
+    self.start = start
+    self.end = end
+
+  stress = bar_quantity('stress', "Stress at each step")
+  strain = bar_quantity('strain', "Total strain at each step")
+  mstrain = bar_quantity('mstrain', "Mechanical strain at each step")
+  estrain = bar_quantity('estrain', "Elastic strain at each step")
+  tstrain = bar_quantity('tstrain', "Thermal strain at each step")
+  energy = bar_quantity('energy', "Stored energy at each step")
+  dissipation = bar_quantity('dissipation', "Dissipation at each step")
+  temperature = bar_quantity('temperature', "Temperature at each step")
+
+  @property
+  def history(self):
+    """
+      Stored variables at each step
+    """
+    if self.records is None:
+      return np.array([self.initial['history']])
+    return self.records['history'].values[:,self.start:self.end]
@@ -1,13 +1,7 @@
 import numpy as np
-import numpy.linalg as la
-import scipy.linalg as sla
-import scipy.linalg.lapack as lapack
 from numpy.polynomial.legendre import leggauss as lgg
-import scipy.optimize as opt
 
-from neml import nemlmath, arbbar
-
-from functools import partial
+from neml import vessel
 
 def generate_thickness_gradient(ri, ro, T1, T2, Tdot_hot, hold, 
     Tdot_cold = None, hold_together = 0.0, delay = 0.0):
@@ -218,7 +212,7 @@ class VesselSectionProblem(object):
     model.
   """
   def __init__(self, rs, mats, ns, T, p, rtol = 1.0e-6, atol = 1.0e-8,
-      p_ext = lambda t: 0.0):
+      p_ext = lambda t: 0.0, nthreads = 1):
     """
       Parameters:
         rs      radii deliminating each region
@@ -228,9 +222,10 @@ class VesselSectionProblem(object):
         p       pressure, as a function of (t)
 
       Optional:
-        rtol    relative tolerance for N-R solve
-        atol    absolute tolerance for N-R solve
-        p_ext   external pressure, as a function of t
+        rtol      relative tolerance for N-R solve
+        atol      absolute tolerance for N-R solve
+        p_ext     external pressure, as a function of t
+        nthreads  threads for the material updates, 0 for all
     """
     # Check
     if len(rs) - 1 != len(mats):
@@ -247,6 +242,7 @@ class VesselSectionProblem(object):
 
     self.rtol = rtol
     self.atol = atol
+    self.nthreads = nthreads
 
     self.ts = np.diff(rs)
     self.t = np.sum(self.ts)
@@ -272,6 +268,20 @@ def rect(n):
 
   return pts, weights
 
+
+def split_store(store, offsets, n):
+  """
+    Split the stored variables of a native kernel into one
+    (n, nstore) view per element
+
+    Parameters:
+      store     flat stored variables
+      offsets   start of each element, plus the total length
+      n         number of points per element
+  """
+  return [store[a:b].reshape(n, (b-a) // n) for a,b in zip(offsets[:-1], 
+    offsets[1:])]
+
 class BreeProblem(VesselSectionProblem):
   """
     A Bree problem, referenced back to a vessel.
@@ -280,9 +290,13 @@ class BreeProblem(VesselSectionProblem):
     make the overall wall thickness = 1 spanning from
     r = [0,1] and directly apply the hoop stress as the 
     pressure.
+
+    Each integration point is a bar, with an area equal to its weight,
+    and the bars share the axial strain.  The steps are solved by the
+    native vessel.BreeSection.
   """
   def __init__(self, rs, mats, ns, T, p, rtol = 1.0e-6, atol = 1.0e-8,
-      itype = "gauss", p_ext = lambda t: 0.0):
+      itype = "gauss", p_ext = lambda t: 0.0, nthreads = 1):
     """
       Parameters:
         rs      radii deliminating each region
@@ -292,14 +306,14 @@ class BreeProblem(VesselSectionProblem):
         p       pressure, as a function of (t)
 
       Optional:
-        rtol    relative tolerance for N-R solve
-        atol    absolute tolerance for N-R solve
-        bias    bias the mesh towards the interfaces
-        itype   "rectangle" or "gauss", defaults to "gauss"
-        p_ext   external pressure as a function of t
+        rtol      relative tolerance for N-R solve
+        atol      absolute tolerance for N-R solve
+        itype     "rectangle" or "gauss", defaults to "gauss"
+        p_ext     external pressure as a function of t
+        nthreads  threads for the material updates, 0 for all
     """
     super(BreeProblem, self).__init__(rs, mats, ns, T, p,
-        rtol = rtol, atol = atol, p_ext = p_ext)
+        rtol = rtol, atol = atol, p_ext = p_ext, nthreads = nthreads)
     
     self.regions = np.diff(self.rs)
     self.dlength = [r for r,n in zip(self.regions, self.ns) for i in range(n)]
@@ -315,46 +329,46 @@ class BreeProblem(VesselSectionProblem):
         xi in ifn(n)[0]]
     self.weights = [wi * dl/2 for dl,n in zip(self.regions, self.ns) for 
         wi in ifn(n)[1]]
-    materials = [m for m,n in zip(self.mats, self.ns) for i in range(n)]
+    self.materials = [m for m,n in zip(self.mats, self.ns) for i in range(n)]
 
     self.npoints = len(self.ipoints)
     
     self.P = lambda t: (p(t) * self.r_inner - p_ext(t) * self.r_outer) / self.t
 
-    # Setup the n bar model
-    self.barmodel = arbbar.BarModel()
-    self.barmodel.add_node(1)
-    self.barmodel.add_node(2)
-
-    for ipt, wt, mat in zip(self.ipoints, self.weights, materials):
-      def tlocal(tt, x = ipt):
-        return self.T(x, tt)
-      self.barmodel.add_edge(1,2, object = arbbar.Bar(mat, wt, 1.0, 
-        T = tlocal))
-
-    self.barmodel.add_displacement_bc(1, lambda t: 0.0)
-    self.barmodel.add_force_bc(2, lambda t: self.P(t) * np.sum(self.weights))
+    self.kernel = vessel.BreeSection(self.materials, self.weights, 
+        nthreads = nthreads)
 
     # Setup fields
     self.axialstrain = [0.0]
     self.hoop = [self.P(0.0)]
     self.force = [0.0]
-    self.temperatures = [np.array([self.barmodel[1][2][i]['object'].temperature[-1]
-      for i in range(self.npoints)])]
-    self.stresses = [np.array([self.barmodel[1][2][i]['object'].stress[-1]
-      for i in range(self.npoints)])]
-    self.tstrains = [np.array([self.barmodel[1][2][i]['object'].tstrain[-1]
-      for i in range(self.npoints)])]
-    self.mstrains = [np.array([self.barmodel[1][2][i]['object'].mstrain[-1]
-      for i in range(self.npoints)])]
-    self.estrains = [np.array([self.barmodel[1][2][i]['object'].estrain[-1]
-      for i in range(self.npoints)])]
-    self.histories = [np.array([self.barmodel[1][2][i]['object'].history[-1]
-      for i in range(self.npoints)])]
+    self.temperatures = [np.array([self.T(x, 0.0) for x in self.ipoints])]
+    self.stresses = [np.zeros((self.npoints,))]
+    self.tstrains = [np.zeros((self.npoints,))]
+    self.mstrains = [np.zeros((self.npoints,))]
+    self.estrains = [np.zeros((self.npoints,))]
+    self.store = self.kernel.init_store()
+    self.histories = [self.split_histories(self.store)]
 
     self.energy = [0.0]
     self.work = [0.0]
 
+    self.bar_energy = np.zeros((self.npoints,))
+    self.bar_work = np.zeros((self.npoints,))
+
+  def split_histories(self, store):
+    """
+      The stored variables of each bar, as an array if all the bars
+      have the same number
+
+      Parameters:
+        store       flat stored variables of all the bars
+    """
+    h = split_store(store, self.kernel.offsets, 1)
+    if len(set(hi.shape[1] for hi in h)) == 1:
+      return store.reshape(self.npoints, -1)
+    return [hi[0] for hi in h]
+
   def step(self, t, rtol = 1.0e-6, atol = 1.0e-8, verbose = False,
       ndiv = 4, dfact = 2, extrapolate = False):
     """
@@ -366,7 +380,7 @@ class BreeProblem(VesselSectionProblem):
       Optional:
         rtol        solver relative tolerance
         atol        solver absolute tolerance
-        verbose     print a lot of stuff
+        verbose     print the substepping
         ndiv        maximum number of adaptive subdivisions
         dfact       subdivision factor
         extrapolate try to extrapolate displacements
@@ -375,35 +389,69 @@ class BreeProblem(VesselSectionProblem):
     if dt < 0.0:
       raise ValueError("Requesting negative time step!")
     
-    self.barmodel.solve(dt, ndiv = ndiv, dfact = dfact, 
-        verbose = verbose, extrapolate = extrapolate)
+    t_n = self.times[-1]
+    e_n = self.axialstrain[-1]
+    e_nm1 = self.axialstrain[-2] if len(self.axialstrain) > 1 else None
+    T_n = self.temperatures[-1]
+    state = (self.tstrains[-1], self.mstrains[-1], self.stresses[-1], 
+        self.store, self.bar_energy, self.bar_work)
+
+    step_total = dfact**ndiv
+    step_attempt = dfact**ndiv
+    step_curr = 0
+    dtried = 0
+    ef = 1.0
+
+    while step_curr < step_total:
+      t_np1 = t_n + dt * float(step_attempt) / step_total
+      T_np1 = np.array([self.T(x, t_np1) for x in self.ipoints])
+      if extrapolate and (e_nm1 is not None):
+        guess = e_n + ef * (e_n - e_nm1)
+      else:
+        guess = e_n
+      try:
+        res = self.kernel.step(t_np1, t_n, T_np1, T_n, 
+            self.P(t_np1) * np.sum(self.weights), guess, *state,
+            rtol = rtol, atol = atol)
+        step_curr += step_attempt
+      except RuntimeError as e:
+        dtried += 1
+        if verbose:
+          print("Substepping: %i" % dtried)
+        if dtried == ndiv:
+          raise e
+        step_attempt /= dfact
+        ef /= dfact
+        continue
+
+      e_nm1, e_n = e_n, res[0]
+      tstrain, mstrain, estrain, stress, store, u, w = res[1:]
+      state = (tstrain, mstrain, stress, store, u, w)
+      t_n = t_np1
+      T_n = T_np1
+      ef = 1.0
     
     self.times.append(t)
     self.pressures.append(self.p(t))
     self.external_pressures.append(self.p_ext(t))
     self.hoop.append(self.P(t))
-    self.force.append(self.barmodel.node[2]['forces'][-1])
-    self.axialstrain.append(self.barmodel.node[2]['displacements'][-1])
+    self.force.append(np.dot(self.weights, stress))
+    self.axialstrain.append(e_n)
     
-    self.temperatures.append(np.array([self.barmodel[1][2][i]['object'].temperature[-1]
-      for i in range(self.npoints)]))
-    self.stresses.append(np.array([self.barmodel[1][2][i]['object'].stress[-1]
-      for i in range(self.npoints)]))
-    self.tstrains.append(np.array([self.barmodel[1][2][i]['object'].tstrain[-1]
-      for i in range(self.npoints)]))
-    self.mstrains.append(np.array([self.barmodel[1][2][i]['object'].mstrain[-1]
-      for i in range(self.npoints)]))
-    self.estrains.append(np.array([self.barmodel[1][2][i]['object'].estrain[-1]
-      for i in range(self.npoints)]))
-    self.histories.append(np.array([self.barmodel[1][2][i]['object'].history[-1]
-      for i in range(self.npoints)]))
-
-    self.energy.append(0.0)
-    self.work.append(0.0)
-    for i,wt in enumerate(self.weights):
-      me = self.barmodel[1][2][i]['object']
-      self.energy[-1] += wt*me.energy[-1]*me.A*me.l
-      self.work[-1] += wt*me.dissipation[-1]*me.A*me.l
+    self.temperatures.append(T_n)
+    self.stresses.append(stress)
+    self.tstrains.append(tstrain)
+    self.mstrains.append(mstrain)
+    self.estrains.append(estrain)
+    self.store = store
+    self.histories.append(self.split_histories(store))
+
+    # Each bar has an area equal to its weight
+    self.bar_energy = u
+    self.bar_work = w
+    w2 = np.array(self.weights)**2.0
+    self.energy.append(np.dot(w2, u))
+    self.work.append(np.dot(w2, w))
     
 class AxisymmetricProblem(VesselSectionProblem):
   """
@@ -425,10 +473,14 @@ class AxisymmetricProblem(VesselSectionProblem):
     parallel cross sections from rotating, but allows some net axial strain.
 
     Using constrained = True gives traditional plane strain
+
+    The steps are solved by the native vessel.AxisymmetricSection, which
+    updates all the gauss points at once and solves the tridiagonal
+    system for the displacements.
   """
   def __init__(self, rs, mats, ns, T, p, rtol = 1.0e-6, atol = 1.0e-8,
       bias = False, factor = 2.0, ngpts = 1, constrained = False,
-      p_ext = lambda t: 0.0):
+      p_ext = lambda t: 0.0, nthreads = 1):
     """
       Parameters:
         rs      radii deliminating each region
@@ -445,10 +497,10 @@ class AxisymmetricProblem(VesselSectionProblem):
         ngpts       number of gauss points per element
         constrained constrain the cylinder against thermal expansion
         p_ext       external pressure, as a function of time
-        constrained fully constrain the cylinder against thermal expansion
+        nthreads    threads for the material updates, 0 for all
     """
     super(AxisymmetricProblem, self).__init__(rs, mats, ns, T, p,
-        rtol = rtol, atol = atol, p_ext = p_ext)
+        rtol = rtol, atol = atol, p_ext = p_ext, nthreads = nthreads)
 
     self.constrained = constrained
 
@@ -459,31 +511,42 @@ class AxisymmetricProblem(VesselSectionProblem):
 
     self.materials = [m for m,n in zip(self.mats, self.ns) for i in range(n)]
     
-    self.displacements = [[0.0 for i in range(self.nnodes)]]
-    self.axialstrain = [0.0]
-    
     self.ngpts = ngpts
     self.gpoints, self.gweights = lgg(ngpts)
 
+    self.kernel = vessel.AxisymmetricSection(self.mesh, self.materials,
+        self.gpoints, self.gweights, constrained = constrained,
+        nthreads = nthreads)
+
+    self.displacements = [np.zeros((self.nnodes,))]
+    self.axialstrain = [0.0]
+
     self.temperatures = [np.array([self.T(xi, 0) for xi in self.mesh])]
 
-    self.histories = [[np.array([m.init_store() for xi in self.gpoints])
-      for m in self.materials]]
-    self.stresses = [np.array([np.zeros((self.ngpts,6)) for n in self.ns for i in range(n)])]
-    self.strains = [np.array([np.zeros((self.ngpts,6)) for n in self.ns for i in range(n)])]
-    self.tstrains = [np.array([np.zeros((self.ngpts,6)) for n in self.ns for i in range(n)])]
-    self.mstrains = [np.array([np.zeros((self.ngpts,6)) for n in self.ns for i in range(n)])]
-    self.estrains = [np.array([np.zeros((self.ngpts,6)) for n in self.ns for i in range(n)])]
+    self.stores = [self.kernel.init_store()]
+    self.histories = [split_store(self.stores[0], self.kernel.offsets, 
+      self.ngpts)]
+    self.stresses = [np.zeros((self.nelem,self.ngpts,6))]
+    self.strains = [np.zeros((self.nelem,self.ngpts,6))]
+    self.tstrains = [np.zeros((self.nelem,self.ngpts,6))]
+    self.mstrains = [np.zeros((self.nelem,self.ngpts,6))]
+    self.estrains = [np.zeros((self.nelem,self.ngpts,6))]
 
     # Save a bit of time
     self.Nl = np.array([[(1-xi)/2, (1+xi)/2] for xi in self.gpoints])
-    self.ri = np.array([np.dot(self.Nl, self.mesh[e:e+2]) for e in range(self.nelem)])
+    self.ri = self.kernel.radii.reshape(self.nelem, self.ngpts)
     self.Bl = np.array([[-1.0/2, 1.0/2] for xi in self.gpoints])
 
+  # Everything recorded at each step
+  fields = ["times", "pressures", "external_pressures", "temperatures",
+      "strains", "tstrains", "mstrains", "estrains", "stresses", "histories",
+      "stores", "displacements", "axialstrain"]
+
   def take_step(self, t, rtol = 1.0e-6, atol = 1.0e-8, ilimit = 10,
       verbose = False, predict = 1.0):
     """
-      Actually take a time step, used to sort out adaptive integration
+      Actually take a time step from the last state, used to sort out
+      adaptive integration
       
       Parameters:
         t       next time
@@ -492,10 +555,12 @@ class AxisymmetricProblem(VesselSectionProblem):
         rtol    solver relative tolerance
         atol    solver absolute tolerance
         ilimit  solver iteration limit
-        verbose flag to print a lot of convergence info
+        verbose ignored, kept for compatibility
         predict factor for forward extrapolation for the initial guess:
                 1.0 = full extrapolation
                 0.0 = use previous step
+
+      Returns the values of each of the fields at time t
     """
     T = np.array([self.T(xi, t) for xi in self.mesh])
     p_left = self.p(t)
@@ -509,58 +574,14 @@ class AxisymmetricProblem(VesselSectionProblem):
       x0 = np.concatenate((self.displacements[-1] + (self.displacements[-1] - self.displacements[-2]) * predict,
         [self.axialstrain[-1] + (self.axialstrain[-1] - self.axialstrain[-2]) * predict]))
 
-    x = np.copy(x0)
-    if self.constrained:
-      x[-1] = 0.0
+    x, strains, tstrains, mstrains, estrains, stresses, store = self.kernel.step(
+        t, self.times[-1], T, self.temperatures[-1], p_left, p_right, x0,
+        self.tstrains[-1], self.mstrains[-1], self.stresses[-1], 
+        self.stores[-1], rtol = rtol, atol = atol, ilimit = ilimit)
+    histories = split_store(store, self.kernel.offsets, self.ngpts)
 
-    R, (J11_du,J11_d,J11_dl,J12,J21,J22), strains, tstrains, mstrains, estrains, stresses, histories = self.RJ(x, T, p_left,
-        p_right, t)
-
-    if self.constrained:
-      nR0 = la.norm(R[:-1])
-    else:
-      nR0 = la.norm(R)
-    nR = nR0
-
-    if verbose:
-      print("Iter.\tNorm res")
-      print("%i\t%e" % (0, nR0))
-    
-    i = 0
-    while (nR > atol) and (nR / nR0 > rtol) and (i < ilimit):
-      if self.constrained:
-        R1 = R[:-1]
-        x1 = tri_solve(J11_du, J11_d, J11_dl, R1)
-        x[:-1] -= x1
-
-      else:
-        R1 = R[:-1]
-        R2 = R[-1]
-        c = R1 - R2/J22 * J12
-        u = -J12 / J22
-        v = J21
-        x1 = cute_solve(J11_du, J11_d, J11_dl, u, v, c)
-        x2 = (R2 - np.dot(J21,x1)) / J22
-
-        x[:-1] -= x1
-        x[-1] -= x2
-
-      R, (J11_du,J11_d,J11_dl,J12,J21,J22), strains, tstrains, mstrains, estrains, stresses, histories = self.RJ(x, T, p_left,
-          p_right, t)
-
-      if self.constrained:
-        nR = la.norm(R[:-1])
-      else:
-        nR = la.norm(R)
-      i += 1
-
-      if verbose:
-        print("%i\t%e" % (i, nR))
-
-    if i == ilimit:
-      raise RuntimeError("Exceeded maximum allowed iterations!")
-    
-    return p_left, p_right, T, strains, tstrains, mstrains, estrains, stresses, histories, x[:-1], x[-1]
+    return (t, p_left, p_right, T, strains, tstrains, mstrains, estrains, 
+        stresses, histories, store, x[:-1], x[-1])
 
   def step(self, t, rtol = 1.0e-6, atol = 1.0e-8, verbose = False,
       div = 2, max_div = 4, predict = 1.0, ilimit = 10):
@@ -573,7 +594,7 @@ class AxisymmetricProblem(VesselSectionProblem):
       Optional:
         rtol    solver relative tolerance
         atol    solver absolute tolerance
-        verbose flag to print a lot of convergence info
+        verbose flag to print the substepping
         div     step division factor for adaptive stepping: 
                 new_time_step = old_time_step / div
         max_div maximum number of adaptive subdivisions
@@ -586,197 +607,30 @@ class AxisymmetricProblem(VesselSectionProblem):
     sstep = istep
     cstep = 0
     cdiv = 0
-    dt = t - self.times[-1]
+    t_n = self.times[-1]
+    dt = t - t_n
 
     ostep = len(self.times)
 
     while cstep != istep:
       cstep += sstep      
       try:
-        p_left, p_right, T, strains, tstrains, mstrains, estrains, stresses, histories, disp, axial = self.take_step(
-            self.times[-1] + dt * float(cstep)/istep, rtol = rtol, atol = atol,
-            verbose = verbose, predict = predict, ilimit = ilimit)
-        self.times.append(t)
-        self.pressures.append(p_left)
-        self.external_pressures.append(p_right)
-        self.temperatures.append(T)
-        self.strains.append(strains)
-        self.tstrains.append(tstrains)
-        self.mstrains.append(mstrains)
-        self.estrains.append(estrains)
-        self.stresses.append(stresses)
-        self.histories.append(histories)
-        self.displacements.append(disp)
-        self.axialstrain.append(axial)
+        values = self.take_step(t_n + dt * float(cstep)/istep, rtol = rtol,
+            atol = atol, verbose = verbose, predict = predict, ilimit = ilimit)
+        for f, v in zip(self.fields, values):
+          getattr(self, f).append(v)
       except RuntimeError as e:
         cstep -= sstep
         cdiv += 1
         if cdiv > max_div:
-          self.times = self.times[:ostep]
-          self.pressures = self.pressures[:ostep]
-          self.external_pressures = self.external_pressures[:ostep]
-          self.temperatures = self.temperatures[:ostep]
-          self.strains = self.strains[:ostep]
-          self.tstrains = self.tstrains[:ostep]
-          self.mstrains = self.mstrains[:ostep]
-          self.estrains = self.estrains[:ostep]
-          self.stresses = self.stresses[:ostep]
-          self.histories = self.histories[:ostep]
-          self.displacements = self.displacements[:ostep]
-          self.axialstrain = self.axialstrain[:ostep]
+          for f in self.fields:
+            setattr(self, f, getattr(self, f)[:ostep])
           raise e
         sstep /= div
         if verbose:
           print("Substepping: new step fraction %f" % (float(sstep) / istep))
 
-    self.times = self.times[:ostep] + [self.times[-1]]
-    self.pressures = self.pressures[:ostep] + [self.pressures[-1]]
-    self.external_pressures = self.external_pressures[:ostep] + [self.external_pressures[-1]]
-    self.temperatures = self.temperatures[:ostep] + [self.temperatures[-1]]
-    self.strains = self.strains[:ostep] + [self.strains[-1]]
-    self.tstrains = self.tstrains[:ostep] + [self.tstrains[-1]]
-    self.mstrains = self.mstrains[:ostep] + [self.mstrains[-1]]
-    self.estrains = self.estrains[:ostep] + [self.estrains[-1]]
-    self.stresses = self.stresses[:ostep] + [self.stresses[-1]]
-    self.histories = self.histories[:ostep] + [self.histories[-1]]
-    self.displacements = self.displacements[:ostep] + [self.displacements[-1]]
-    self.axialstrain = self.axialstrain[:ostep] + [self.axialstrain[-1]]
-
-
-  def strain(self, d, l, r, ez):
-    """
-      Compute the full strains
-
-      Parameters:
-        d   displacements
-        l   length
-        r   radius
-        ez  axial strain
-    """
-    strain = np.zeros((len(r),6))
-    strain[:,0] = np.dot(self.Bl, d) * 2.0 / l
-    strain[:,1] = np.dot(self.Nl, d) / r
-    strain[:,2] = ez 
-    return strain
-
-  def RJ(self, x, T, p_left, p_right, t):
-    """
-      Compute the residual, jacobian, and the rest of the updated quantities
-
-      Parameters:
-        x           iterate
-        T           nodal temperatures
-        Tn          previous temperatures
-        p_left      left pressure
-        t           time
-        p_right     right pressure
-        t           time 
-    """
-    d = x[:-1]
-    ez = x[-1]
-
-    Fext = np.zeros((self.nnodes+1,))
-    Fext[0] = p_left
-    Fext[-2] = -p_right
-    #Fext[-1] = (p_left *self.r_inner - p_right * self.r_outer) / (2*self.t)
-    # We should use the proper thick-walled vessel formula
-    Fext[-1] = (p_left * self.r_inner**2.0 / (self.r_outer**2.0 - self.r_inner**2.0) 
-        -p_right * self.r_outer**2.0 / (self.r_outer**2.0 - self.r_inner**2.0))
-    
-    strains = np.zeros((self.nelem, self.ngpts, 6))
-    tstrains = np.zeros((self.nelem, self.ngpts, 6))
-    mstrains = np.zeros((self.nelem, self.ngpts, 6))
-    estrains = np.zeros((self.nelem, self.ngpts, 6))
-    stresses = np.zeros((self.nelem, self.ngpts, 6))
-    histories = []
-
-    Fint = np.zeros((self.nnodes+1,))
-    A11_dl = np.zeros((self.nnodes-1,))
-    A11_d = np.zeros((self.nnodes,))
-    A11_du = np.zeros((self.nnodes-1,))
-    A12 = np.zeros((self.nnodes,))
-    A21 = np.zeros((self.nnodes,))
-    A22 = 0.0
-
-    for e, (mat, l, rs) in enumerate(zip(self.materials, self.ls, self.ri)):
-      de = d[e:e+2]
-      T_e = np.dot(self.Nl, T[e:e+2])
-      T_n = np.dot(self.Nl, self.temperatures[-1][e:e+2])
-      
-      therm_inc = np.array([mat.alpha(Ti)*(Ti-Tii)*np.array([1,1,1,0,0,0]) 
-        for Ti, Tii in zip(T_e, T_n)])
-
-      strain = self.strain(de, l, rs, ez)
-      tstrain = self.tstrains[-1][e] + therm_inc
-      mstrain = strain - tstrain
-      mstrain_n = self.mstrains[-1][e]
-      stress_n = self.stresses[-1][e]
-      hist_n = self.histories[-1][e]
-
-      stress = np.zeros((self.ngpts,6))
-      history = np.zeros((self.ngpts,len(hist_n[0])))
-      estrain = np.zeros((self.ngpts,6))
-
-      for i in range(self.ngpts):
-        si, hi, ti, ui, pi = mat.update_sd(mstrain[i], mstrain_n[i],
-            T_e[i], T_n[i], t, self.times[-1], stress_n[i], hist_n[i], 
-            0.0, 0.0)
-        stress[i] = si
-        history[i] = hi
-
-        estrain[i] = mat.elastic_strains(si, T_e[i], hi)
-        
-        wi = self.gweights[i]
-        #Actually add in our terms
-        Fint[e:e+2] += wi * (si[0] * self.Bl[i] * 2.0 / l + (si[1] - si[0]) * self.Nl[i] / rs[i]) * l / 2.0
-        Fint[-1] += wi * si[2] * l / 2.0 / self.t
-        
-        DE = np.array([self.Bl[i] * 2.0/l, self.Nl[i] / rs[i]])
-        
-        # Remember wi and the jacobian
-        J11 = np.dot(np.outer(2.0/l * self.Bl[i], ti[0,:2]) + np.outer(self.Nl[i] / rs[i], 
-            ti[1,:2] - ti[0,:2]), DE) * wi * l / 2.0 
-        J12 = (ti[0,2] * self.Bl[i] * 2.0 / l + (ti[1,2] - ti[0,2]) * self.Nl[i] / rs[i]) * wi * l / 2.0
-        J21 = (np.dot(ti[2,:2], DE) / self.t) * wi * l / 2.0 
-        J22 = (ti[2,2] / self.t) * wi * l / 2.0
-
-        A11_du[e] += J11[0,1]
-        A11_d[e] += J11[0,0]
-        A11_d[e+1] += J11[1,1]
-        A11_dl[e] += J11[1,0]
-        A12[e:e+2] += J12
-        A21[e:e+2] += J21
-        A22 += J22
-
-      strains[e] = strain
-      tstrains[e] = tstrain
-      mstrains[e] = mstrain
-      estrains[e] = estrain
-      stresses[e] = stress
-      histories.append(history)
-
-    return Fint - Fext, (A11_du,A11_d,A11_dl,A12,A21,A22), strains, tstrains, mstrains, estrains, stresses, histories
-
-def tri_solve(DU, D, DL, c):
-  """
-    Solve B x = c
-  """
-  DL, D, DU, DU2, IPIV = nemlmath.dgttrf(DL, D, DU)
-  x = nemlmath.dgttrs(DL,D,DU,DU2,IPIV,c)
-
-  return x
-
-def cute_solve(DU, D, DL, u, v, c):
-  """
-    Do a cute solve of:
-
-    (B + u v.T) x = c
-
-    with B tri-diagonal
-  """
-  DL, D, DU, DU2, IPIV = nemlmath.dgttrf(DL, D, DU)
-  
-  x = nemlmath.dgttrs(DL,D,DU,DU2,IPIV, c)
-  y = nemlmath.dgttrs(DL,D,DU,DU2,IPIV, u)
-  
-  return x - np.dot(v,x) / (1+np.dot(v,y)) * y
+    # Only keep the final substep
+    for f in self.fields:
+      v = getattr(self, f)
+      setattr(self, f, v[:ostep] + [v[-1]])
@@ -87,6 +87,43 @@ class Driver_sd(Driver):
     self.thermal_strain_int = [np.zeros((6,))]
     self.mechanical_strain_int = [np.zeros((6,))]
 
+    # Reused by every trial update and for the tangent of each step
+    self.trial = (np.zeros((6,)), np.zeros((self.model.nstore,)),
+        np.zeros((6,6)))
+
+    # The stress and history of each step are rows of blocks allocated
+    # for block_size steps at a time
+    self.block_size = 100
+    self.blocks = None
+    self.block_used = 0
+
+  def step_outputs(self):
+    """
+      Fresh stress and history arrays for the next step, taken from the
+      current block
+    """
+    if self.blocks is None or self.block_used == self.block_size:
+      self.blocks = (np.empty((self.block_size,6)), 
+          np.empty((self.block_size,self.model.nstore)))
+      self.block_used = 0
+    i = self.block_used
+    self.block_used += 1
+    return self.blocks[0][i], self.blocks[1][i]
+
+  def trial_update(self, e_np1, t_np1, T_np1):
+    """
+      Update from the last step to a trial mechanical strain, writing the
+      stress, history, and tangent into arrays overwritten by the next call
+
+      Parameters:
+        e_np1:       trial mechanical strain
+        t_np1:       next time
+        T_np1:       next temperature
+    """
+    return self.model.update_sd(e_np1, self.mechanical_strain_int[-1],
+        T_np1, self.T_int[-1], t_np1, self.t_int[-1], self.stress_int[-1],
+        self.stored_int[-1], self.u_int[-1], self.p_int[-1], self.trial)
+
   def solve_try(self, RJ, x0, extra = []):
     """
       Try several different nonlinear solvers in the hope that at least
@@ -177,16 +214,18 @@ class Driver_sd(Driver):
         T_np1:       next temperature
     """
     enext = self.update_thermal_strain(T_np1)
+    s_np1, h_np1 = self.step_outputs()
     s_np1, h_np1, A_np1, u_np1, p_np1 = self.model.update_sd(e_np1 - enext, 
         self.mechanical_strain_int[-1],
         T_np1, self.T_int[-1], t_np1, self.t_int[-1], self.stress_int[-1],
-        self.stored_int[-1], self.u_int[-1], self.p_int[-1])
+        self.stored_int[-1], self.u_int[-1], self.p_int[-1],
+        (s_np1, h_np1, self.trial[2]))
 
     self.strain_int.append(np.copy(e_np1))
     self.mechanical_strain_int.append(e_np1 - enext)
     self.thermal_strain_int.append(enext)
-    self.stress_int.append(np.copy(s_np1))
-    self.stored_int.append(np.copy(h_np1))
+    self.stress_int.append(s_np1)
+    self.stored_int.append(h_np1)
     self.T_int.append(T_np1)
     self.t_int.append(t_np1)
     self.u_int.append(u_np1)
@@ -203,12 +242,10 @@ class Driver_sd(Driver):
     """
     enext = self.update_thermal_strain(T_np1)
     def RJ(e):
-      s, h, A, u, p = self.model.update_sd(e - enext, self.mechanical_strain_int[-1],
-        T_np1, self.T_int[-1], t_np1, self.t_int[-1], 
-        self.stress_int[-1],
-        self.stored_int[-1], self.u_int[-1], self.p_int[-1])
+      s, h, A, u, p = self.trial_update(e - enext, t_np1, T_np1)
       R = s - s_np1
-      return R, A
+      # The line search keeps the jacobian across calls
+      return R, np.copy(A)
 
     if len(self.strain_int) > 1:
       inc = self.strain_int[-1] - self.strain_int[-2]
@@ -241,11 +278,8 @@ class Driver_sd(Driver):
     def RJ(x):
       a = x[0]
       e_inc = x[1:]
-      s, h, A, u, p = self.model.update_sd(self.strain_int[-1] + e_inc - enext,
-          self.mechanical_strain_int[-1],
-          T_np1, self.T_int[-1], t_np1, self.t_int[-1], self.stress_int[-1],
-          self.stored_int[-1],
-          self.u_int[-1], self.p_int[-1])
+      s, h, A, u, p = self.trial_update(self.strain_int[-1] + e_inc - enext,
+          t_np1, T_np1)
 
       R = np.zeros((7,))
       J = np.zeros((7,7))
@@ -334,10 +368,7 @@ class Driver_sd(Driver):
     enext = self.update_thermal_strain(T_np1)
     oset = sorted(list(set(range(6)) - set([i])))
     def RJ(e_np1):
-      s, h, A, u, p = self.model.update_sd(e_np1 - enext,
-          self.mechanical_strain_int[-1],
-          T_np1, self.T_int[-1], t_np1, self.t_int[-1], self.stress_int[-1],
-          self.stored_int[-1], self.u_int[-1], self.p_int[-1])
+      s, h, A, u, p = self.trial_update(e_np1 - enext, t_np1, T_np1)
 
       R = np.zeros((6,))
       R[0] = (e_np1[i] - self.strain_int[-1][i]
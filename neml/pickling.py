@@ -0,0 +1,18 @@
+# Every module registering classes, so objects come back as their own type
+from neml import (objects, interpolate, elasticity, surfaces, hardening,
+    ri_flow, visco_flow, general_flow, creep, models, damage, serialize)
+
+def restore(cls, image):
+  """
+    Recreate an object pickled by NEMLObject.__reduce__, checking it
+    comes back as the class it was pickled as
+
+    Parameters:
+      cls:       python class of the object when it was pickled
+      image:     the object as stored by serialize.dumps
+  """
+  obj = serialize.loads(image)
+  if not isinstance(obj, cls):
+    raise TypeError("Pickled %s restored as %s" % (cls.__name__,
+      type(obj).__name__))
+  return obj
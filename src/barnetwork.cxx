@@ -0,0 +1,226 @@
+#include "barnetwork.h"
+
+#include "nemlmath.h"
+#include "nemlerror.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace neml {
+
+namespace {
+
+// Bars per block in the threaded material updates
+const size_t BAR_GRAIN = 16;
+
+} // namespace
+
+BarNetwork::BarNetwork(
+    size_t nnodes, const std::vector<size_t> & ends,
+    const std::vector<std::shared_ptr<UniaxialModel>> & materials,
+    const std::vector<double> & areas,
+    const std::vector<double> & lengths,
+    const std::vector<bool> & fixed, unsigned nthreads) :
+      ends_(ends), materials_(materials), areas_(areas), lengths_(lengths),
+      fixed_(fixed), nthreads_(nthreads)
+{
+  size_t nb = materials_.size();
+  if ((ends_.size() != 2 * nb) || (areas_.size() != nb) ||
+      (lengths_.size() != nb)) {
+    throw std::invalid_argument(
+        "Each bar needs two end nodes, a material, an area, and a length");
+  }
+  if (fixed_.size() != nnodes) {
+    throw std::invalid_argument("Each node needs to be marked fixed or free");
+  }
+  for (auto n : ends_) {
+    if (n >= nnodes) throw std::invalid_argument("Bar end node out of range");
+  }
+  for (auto l : lengths_) {
+    if (l <= 0.0) throw std::invalid_argument("Bar lengths must be positive");
+  }
+
+  offsets_.push_back(0);
+  for (auto & m : materials_) {
+    offsets_.push_back(offsets_.back() + m->nstore());
+  }
+
+  // Node to bar incidence
+  node_ptr_.assign(nnodes + 1, 0);
+  for (auto n : ends_) node_ptr_[n+1]++;
+  for (size_t i = 0; i < nnodes; i++) node_ptr_[i+1] += node_ptr_[i];
+  node_ends_.resize(ends_.size());
+  std::vector<size_t> fill(node_ptr_.begin(), node_ptr_.end() - 1);
+  for (size_t k = 0; k < ends_.size(); k++) {
+    node_ends_[fill[ends_[k]]++] = k;
+  }
+
+  // Equation numbers for the free nodes
+  dof_.assign(nnodes, -1);
+  for (size_t i = 0; i < nnodes; i++) {
+    if (not fixed_[i]) {
+      dof_[i] = free_.size();
+      free_.push_back(i);
+    }
+  }
+
+  // Sparsity of the free block of the stiffness
+  std::vector<size_t> rows(1, 0), cols;
+  for (auto i : free_) {
+    cols.push_back(dof_[i]);
+    for (size_t k = node_ptr_[i]; k < node_ptr_[i+1]; k++) {
+      size_t b = node_ends_[k] / 2;
+      for (size_t e = 0; e < 2; e++) {
+        long j = dof_[ends_[2*b+e]];
+        if (j >= 0) cols.push_back(j);
+      }
+    }
+    std::sort(cols.begin() + rows.back(), cols.end());
+    cols.erase(std::unique(cols.begin() + rows.back(), cols.end()),
+               cols.end());
+    rows.push_back(cols.size());
+  }
+  solver_.reset(new SkylineSolver(nfree(), rows, cols));
+
+  // Where each bar adds into the stiffness: both diagonals and the
+  // coupling, or the storage size for nothing
+  size_t none = solver_->nstore();
+  positions_.assign(3 * nb, none);
+  for (size_t b = 0; b < nb; b++) {
+    long i = dof_[ends_[2*b]];
+    long j = dof_[ends_[2*b+1]];
+    if (i == j) continue;
+    if (i >= 0) positions_[3*b] = solver_->position(i, i);
+    if (j >= 0) positions_[3*b+1] = solver_->position(j, j);
+    if ((i >= 0) && (j >= 0)) positions_[3*b+2] = solver_->position(i, j);
+  }
+}
+
+int BarNetwork::init_store(double * const h) const
+{
+  for (size_t i = 0; i < nbars(); i++) {
+    int ier = materials_[i]->init_store(&h[offsets_[i]]);
+    if (ier != SUCCESS) return ier;
+  }
+  return SUCCESS;
+}
+
+int BarNetwork::step(
+    double t_np1, double t_n,
+    const double * const T_np1, const double * const T_n,
+    const double * const f_ext, double * const d,
+    const double * const tstrain_n, const double * const mstrain_n,
+    const double * const stress_n, const double * const h_n,
+    const double * const u_n, const double * const p_n,
+    double * const strain, double * const tstrain,
+    double * const mstrain, double * const estrain,
+    double * const stress, double * const h_np1,
+    double * const u_np1, double * const p_np1,
+    double * const f,
+    double rtol, double atol, int miter) const
+{
+  size_t nb = nbars();
+  std::vector<double> A(nb), R(nfree());
+  SkylineSolver solver(*solver_);
+
+  for (size_t i = 0; i < nb; i++) {
+    tstrain[i] = tstrain_n[i] +
+        materials_[i]->thermal_strain_increment(T_np1[i], T_n[i]);
+  }
+
+  int ier = update_bars_(d, t_np1, t_n, T_np1, T_n, tstrain, mstrain_n,
+                         stress_n, h_n, u_n, p_n, strain, mstrain, stress,
+                         h_np1, u_np1, p_np1, &A[0]);
+  if (ier != SUCCESS) return ier;
+  double nR = residual_(f_ext, stress, f, &R[0]);
+  double nR0 = nR;
+
+  int i = 0;
+  while ((nR > rtol * nR0) && (nR > atol)) {
+    jacobian_(&A[0], solver);
+    ier = solver.factor();
+    if (ier != SUCCESS) return ier;
+    solver.solve(&R[0]);
+    for (size_t k = 0; k < nfree(); k++) d[free_[k]] -= R[k];
+
+    ier = update_bars_(d, t_np1, t_n, T_np1, T_n, tstrain, mstrain_n,
+                       stress_n, h_n, u_n, p_n, strain, mstrain, stress,
+                       h_np1, u_np1, p_np1, &A[0]);
+    if (ier != SUCCESS) return ier;
+    nR = residual_(f_ext, stress, f, &R[0]);
+    i++;
+    if (i > miter) return MAX_ITERATIONS;
+  }
+
+  std::vector<int> ierb(nb, SUCCESS);
+  parallel_for(nb, nthreads_, [&](size_t k)
+  {
+    ierb[k] = materials_[k]->elastic_strains(stress[k], T_np1[k],
+                                             &h_np1[offsets_[k]], estrain[k]);
+  }, BAR_GRAIN);
+
+  return first_error(ierb);
+}
+
+int BarNetwork::update_bars_(
+    const double * const d, double t_np1, double t_n,
+    const double * const T_np1, const double * const T_n,
+    const double * const tstrain, const double * const mstrain_n,
+    const double * const stress_n, const double * const h_n,
+    const double * const u_n, const double * const p_n,
+    double * const strain, double * const mstrain,
+    double * const stress, double * const h_np1,
+    double * const u_np1, double * const p_np1,
+    double * const A) const
+{
+  std::vector<int> ier(nbars(), SUCCESS);
+  parallel_for(nbars(), nthreads_, [&](size_t b)
+  {
+    strain[b] = (d[ends_[2*b+1]] - d[ends_[2*b]]) / lengths_[b];
+    mstrain[b] = strain[b] - tstrain[b];
+    std::fill(&h_np1[offsets_[b]], &h_np1[offsets_[b+1]], 0.0);
+    ier[b] = materials_[b]->update(mstrain[b], mstrain_n[b], T_np1[b], T_n[b],
+                                   t_np1, t_n, stress[b], stress_n[b],
+                                   &h_np1[offsets_[b]], &h_n[offsets_[b]],
+                                   A[b], u_np1[b], u_n[b], p_np1[b], p_n[b]);
+  }, BAR_GRAIN);
+
+  return first_error(ier);
+}
+
+double BarNetwork::residual_(const double * const f_ext,
+                             const double * const stress, double * const f,
+                             double * const R) const
+{
+  // The bars pull on their first node and push on their second
+  for (size_t n = 0; n < nnodes(); n++) {
+    f[n] = 0.0;
+    for (size_t k = node_ptr_[n]; k < node_ptr_[n+1]; k++) {
+      size_t b = node_ends_[k] / 2;
+      double sign = (node_ends_[k] % 2 == 1) ? 1.0 : -1.0;
+      f[n] += sign * stress[b] * areas_[b];
+    }
+  }
+
+  for (size_t k = 0; k < nfree(); k++) {
+    R[k] = f[free_[k]] - f_ext[free_[k]];
+  }
+
+  return norm2_vec(R, nfree());
+}
+
+void BarNetwork::jacobian_(const double * const A,
+                           SkylineSolver & solver) const
+{
+  size_t none = solver.nstore();
+  solver.zero();
+  for (size_t b = 0; b < nbars(); b++) {
+    double k = A[b] * areas_[b] / lengths_[b];
+    if (positions_[3*b] != none) solver.add_at(positions_[3*b], k);
+    if (positions_[3*b+1] != none) solver.add_at(positions_[3*b+1], k);
+    if (positions_[3*b+2] != none) solver.add_at(positions_[3*b+2], -k);
+  }
+}
+
+} // namespace neml
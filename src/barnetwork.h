@@ -0,0 +1,100 @@
+#ifndef BARNETWORK_H
+#define BARNETWORK_H
+
+#include "models.h"
+#include "sparse.h"
+
+#include <memory>
+#include <vector>
+
+namespace neml {
+
+/// A network of uniaxial bars joined at rigid nodes, where the unknowns
+/// are the axial nodal displacements and the equations are nodal
+/// equilibrium
+//  The native engine behind neml.arbbar.BarModel.  The graph is flattened
+//  into a node to bar incidence in CSR form.  The bars are updated all at
+//  once, on up to nthreads threads, and the Newton iterations solve with
+//  the sparse SkylineSolver.  The object carries no state: each step
+//  takes the previous state of the bars and returns the next.
+class BarNetwork {
+ public:
+  /// Parameters are the number of nodes, the two end nodes of each bar,
+  /// one material, area, and length per bar, which nodes have imposed
+  /// displacements, and the number of threads (0 for all)
+  BarNetwork(size_t nnodes, const std::vector<size_t> & ends,
+             const std::vector<std::shared_ptr<UniaxialModel>> & materials,
+             const std::vector<double> & areas,
+             const std::vector<double> & lengths,
+             const std::vector<bool> & fixed, unsigned nthreads = 1);
+
+  /// Number of nodes
+  size_t nnodes() const {return fixed_.size();};
+  /// Number of bars
+  size_t nbars() const {return materials_.size();};
+  /// Number of nodes without imposed displacements
+  size_t nfree() const {return free_.size();};
+  /// Total length of the stored variables of all the bars
+  size_t nstore() const {return offsets_.back();};
+  /// Start of the stored variables of each bar, plus the total
+  const std::vector<size_t> & offsets() const {return offsets_;};
+  /// CSR row pointers of the node to bar incidence
+  const std::vector<size_t> & node_ptr() const {return node_ptr_;};
+  /// CSR entries of the node to bar incidence, as 2 * bar + end
+  const std::vector<size_t> & node_ends() const {return node_ends_;};
+
+  /// Initialize the stored variables of all the bars
+  int init_store(double * const h) const;
+
+  /// Update from the state at t_n to t_np1, given the bar temperatures
+  /// and the external nodal forces (only used at free nodes).  d holds the
+  /// imposed displacements and the guess for the others coming in and
+  /// all the displacements going out.  The bar arrays have one entry per
+  /// bar, except for the stored variables, and f returns the net bar
+  /// force on each node.
+  int step(double t_np1, double t_n,
+           const double * const T_np1, const double * const T_n,
+           const double * const f_ext, double * const d,
+           const double * const tstrain_n, const double * const mstrain_n,
+           const double * const stress_n, const double * const h_n,
+           const double * const u_n, const double * const p_n,
+           double * const strain, double * const tstrain,
+           double * const mstrain, double * const estrain,
+           double * const stress, double * const h_np1,
+           double * const u_np1, double * const p_np1,
+           double * const f,
+           double rtol = 1.0e-6, double atol = 1.0e-8,
+           int miter = 50) const;
+
+ private:
+  int update_bars_(const double * const d, double t_np1, double t_n,
+                   const double * const T_np1, const double * const T_n,
+                   const double * const tstrain, const double * const mstrain_n,
+                   const double * const stress_n, const double * const h_n,
+                   const double * const u_n, const double * const p_n,
+                   double * const strain, double * const mstrain,
+                   double * const stress, double * const h_np1,
+                   double * const u_np1, double * const p_np1,
+                   double * const A) const;
+  double residual_(const double * const f_ext, const double * const stress,
+                   double * const f, double * const R) const;
+  void jacobian_(const double * const A, SkylineSolver & solver) const;
+
+ private:
+  std::vector<size_t> ends_;
+  std::vector<std::shared_ptr<UniaxialModel>> materials_;
+  std::vector<double> areas_, lengths_;
+  std::vector<bool> fixed_;
+  unsigned nthreads_;
+
+  std::vector<size_t> offsets_;
+  std::vector<size_t> node_ptr_, node_ends_;
+  std::vector<size_t> free_;
+  std::vector<long> dof_;
+  std::unique_ptr<SkylineSolver> solver_;
+  std::vector<size_t> positions_;
+};
+
+} // namespace neml
+
+#endif // BARNETWORK_H
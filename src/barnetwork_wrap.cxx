@@ -0,0 +1,124 @@
+#include "pyhelp.h" // include first to avoid annoying redef warning
+
+#include "barnetwork.h"
+
+namespace py = pybind11;
+
+PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>)
+
+namespace neml {
+
+namespace {
+
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> InArray;
+
+} // namespace
+
+PYBIND11_MODULE(barnetwork, m) {
+  py::module::import("neml.objects");
+  py::module::import("neml.models");
+
+  m.doc() = "Native engine for the bar networks in neml.arbbar.";
+
+  py::class_<BarNetwork, std::shared_ptr<BarNetwork>>(m, "BarNetwork")
+      .def(py::init<size_t, const std::vector<size_t> &,
+           const std::vector<std::shared_ptr<UniaxialModel>> &,
+           const std::vector<double> &, const std::vector<double> &,
+           const std::vector<bool> &, unsigned>(), py::arg("nnodes"),
+           py::arg("ends"), py::arg("materials"), py::arg("areas"),
+           py::arg("lengths"), py::arg("fixed"), py::arg("nthreads") = 1)
+      .def_property_readonly("nnodes", &BarNetwork::nnodes,
+                             "Number of nodes.")
+      .def_property_readonly("nbars", &BarNetwork::nbars, "Number of bars.")
+      .def_property_readonly("nfree", &BarNetwork::nfree,
+                             "Number of nodes without imposed displacements.")
+      .def_property_readonly("nstore", &BarNetwork::nstore,
+                             "Length of all the stored variables.")
+      .def_property_readonly("offsets",
+           [](const BarNetwork & n) -> std::vector<size_t>
+           {
+            return n.offsets();
+           }, "Start of the stored variables of each bar.")
+      .def("init_store",
+           [](const BarNetwork & n) -> py::array_t<double>
+           {
+            auto h = alloc_vec<double>(n.nstore());
+            py_error(n.init_store(arr2ptr<double>(h)));
+            return h;
+           }, "Initial stored variables of all the bars.")
+      .def("step",
+           [](const BarNetwork & n, double t_np1, double t_n, InArray T_np1,
+              InArray T_n, InArray f_ext, InArray d0, InArray tstrain_n,
+              InArray mstrain_n, InArray stress_n, InArray h_n, InArray u_n,
+              InArray p_n, double rtol, double atol, int miter) -> py::tuple
+           {
+            size_t nb = n.nbars();
+            size_t nn = n.nnodes();
+            check_shape<double>(T_np1, {nb}, "T_np1");
+            check_shape<double>(T_n, {nb}, "T_n");
+            check_shape<double>(f_ext, {nn}, "f_ext");
+            check_shape<double>(d0, {nn}, "d0");
+            check_shape<double>(tstrain_n, {nb}, "tstrain_n");
+            check_shape<double>(mstrain_n, {nb}, "mstrain_n");
+            check_shape<double>(stress_n, {nb}, "stress_n");
+            check_shape<double>(h_n, {n.nstore()}, "h_n");
+            check_shape<double>(u_n, {nb}, "u_n");
+            check_shape<double>(p_n, {nb}, "p_n");
+
+            auto d = alloc_vec<double>(nn);
+            std::copy(d0.data(), d0.data() + nn, d.mutable_data());
+            auto strain = alloc_vec<double>(nb);
+            auto tstrain = alloc_vec<double>(nb);
+            auto mstrain = alloc_vec<double>(nb);
+            auto estrain = alloc_vec<double>(nb);
+            auto stress = alloc_vec<double>(nb);
+            auto h = alloc_vec<double>(n.nstore());
+            auto u = alloc_vec<double>(nb);
+            auto p = alloc_vec<double>(nb);
+            auto f = alloc_vec<double>(nn);
+
+            auto T_np1_ptr = T_np1.data();
+            auto T_n_ptr = T_n.data();
+            auto f_ext_ptr = f_ext.data();
+            auto d_ptr = d.mutable_data();
+            auto tstrain_n_ptr = tstrain_n.data();
+            auto mstrain_n_ptr = mstrain_n.data();
+            auto stress_n_ptr = stress_n.data();
+            auto h_n_ptr = h_n.data();
+            auto u_n_ptr = u_n.data();
+            auto p_n_ptr = p_n.data();
+            auto strain_ptr = strain.mutable_data();
+            auto tstrain_ptr = tstrain.mutable_data();
+            auto mstrain_ptr = mstrain.mutable_data();
+            auto estrain_ptr = estrain.mutable_data();
+            auto stress_ptr = stress.mutable_data();
+            auto h_ptr = h.mutable_data();
+            auto u_ptr = u.mutable_data();
+            auto p_ptr = p.mutable_data();
+            auto f_ptr = f.mutable_data();
+            int ier;
+            {
+              py::gil_scoped_release release;
+              ier = n.step(t_np1, t_n, T_np1_ptr, T_n_ptr, f_ext_ptr, d_ptr,
+                           tstrain_n_ptr, mstrain_n_ptr, stress_n_ptr, h_n_ptr,
+                           u_n_ptr, p_n_ptr, strain_ptr, tstrain_ptr,
+                           mstrain_ptr, estrain_ptr, stress_ptr, h_ptr, u_ptr,
+                           p_ptr, f_ptr, rtol, atol, miter);
+            }
+            py_error(ier);
+
+            return py::make_tuple(d, f, strain, tstrain, mstrain, estrain,
+                                  stress, h, u, p);
+           }, "Update to the next time, returning the nodal displacements "
+           "and forces and the strains, thermal strains, mechanical strains, "
+           "elastic strains, stresses, stored variables, energies, and "
+           "dissipations of the bars.",
+           py::arg("t_np1"), py::arg("t_n"), py::arg("T_np1"), py::arg("T_n"),
+           py::arg("f_ext"), py::arg("d0"), py::arg("tstrain_n"),
+           py::arg("mstrain_n"), py::arg("stress_n"), py::arg("h_n"),
+           py::arg("u_n"), py::arg("p_n"), py::arg("rtol") = 1.0e-6,
+           py::arg("atol") = 1.0e-8, py::arg("miter") = 50)
+      ;
+}
+
+} // namespace neml
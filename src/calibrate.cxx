@@ -0,0 +1,250 @@
+#include "calibrate.h"
+
+#include "nemlmath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <stdexcept>
+
+namespace neml {
+
+CalibrationObjective::CalibrationObjective(
+    std::shared_ptr<NEMLModel> model, const std::vector<std::string> & names,
+    unsigned nthreads, double penalty) :
+      names_(names), nthreads_(nthreads), penalty_(penalty), pool_(model),
+      offsets_({0}), cached_(false)
+{
+  if (not model) {
+    throw std::invalid_argument("Calibration needs a model");
+  }
+
+  TunableParameters tunable(model);
+  std::set<std::string> known(tunable.names().begin(),
+                              tunable.names().end());
+  std::set<std::string> seen;
+  for (auto & n : names_) {
+    if (not known.count(n)) {
+      throw std::invalid_argument("Unknown parameter " + n);
+    }
+    if (not seen.insert(n).second) {
+      throw std::invalid_argument("Parameter " + n + " appears twice");
+    }
+  }
+}
+
+void CalibrationObjective::add_dataset(const EnsembleCase & test,
+                                       const std::string & x,
+                                       const std::string & y,
+                                       const std::vector<double> & xdata,
+                                       const std::vector<double> & ydata,
+                                       double weight)
+{
+  if (not test.program) {
+    throw std::invalid_argument("Dataset without a loading program");
+  }
+  if (test.model) {
+    throw std::invalid_argument("Datasets are run on the objective's model");
+  }
+  if (ydata.empty()) {
+    throw std::invalid_argument("Dataset without any data");
+  }
+  if (not x.empty() && xdata.size() != ydata.size()) {
+    throw std::invalid_argument("Dataset has " + std::to_string(xdata.size())
+                                + " x values but "
+                                + std::to_string(ydata.size())
+                                + " y values");
+  }
+  if (weight < 0.0) {
+    throw std::invalid_argument("Dataset weights cannot be negative");
+  }
+
+  datasets_.push_back({test, x, y, x.empty() ? std::vector<double>() : xdata,
+                      ydata, weight});
+  offsets_.push_back(offsets_.back() + ydata.size());
+
+  cached_ = false;
+}
+
+void CalibrationObjective::residuals(const double * const p, double * const r)
+{
+  evaluate_(p, r);
+}
+
+double CalibrationObjective::objective(const double * const p)
+{
+  std::vector<double> r(nresiduals());
+  evaluate_(p, r.data());
+  double sum = 0.0;
+  for (auto ri : r) sum += ri * ri;
+  return sum;
+}
+
+void CalibrationObjective::jacobian(const double * const p, double * const J,
+                                    double rel_step)
+{
+  size_t np = nparams();
+  size_t nr = nresiduals();
+  size_t nd = ndatasets();
+
+  // The unchanged parameters only need running if they aren't cached
+  bool base = not (cached_ && std::equal(p, p + np, last_p_.begin()));
+  std::vector<std::vector<double>> ps;
+  if (base) ps.emplace_back(p, p + np);
+  std::vector<double> h(np);
+  for (size_t j = 0; j < np; j++) {
+    ps.emplace_back(p, p + np);
+    ps.back()[j] += rel_step * std::max(std::fabs(p[j]), 1.0);
+    h[j] = ps.back()[j] - p[j];
+  }
+
+  std::vector<EnsembleResult> results;
+  simulate_(ps, results);
+
+  std::vector<double> r0(nr), r(nr);
+  if (base) {
+    collect_(results, 0, r0.data(), true);
+    last_p_.assign(p, p + np);
+    last_r_ = r0;
+    cached_ = true;
+  }
+  else {
+    r0 = last_r_;
+  }
+
+  // Differencing against the penalty would give meaningless derivatives,
+  // so a dataset that fails at p or at the step has zero derivatives
+  size_t first = base ? nd : 0;
+  for (size_t j = 0; j < np; j++) {
+    collect_(results, first + j * nd, r.data(), false);
+    for (size_t i = 0; i < nd; i++) {
+      bool ok = (status_[i] == SUCCESS) &&
+          (results[first + j * nd + i].status == SUCCESS);
+      for (size_t k = offsets_[i]; k < offsets_[i+1]; k++) {
+        J[CINDEX(k,j,np)] = ok ? (r[k] - r0[k]) / h[j] : 0.0;
+      }
+    }
+  }
+}
+
+void CalibrationObjective::simulate_(
+    const std::vector<std::vector<double>> & ps,
+    std::vector<EnsembleResult> & results)
+{
+  std::vector<EnsembleCase> cases;
+  cases.reserve(ps.size() * datasets_.size());
+  for (auto & p : ps) {
+    for (auto & d : datasets_) {
+      cases.push_back(d.test);
+      for (size_t j = 0; j < names_.size(); j++) {
+        cases.back().parameters[names_[j]] = p[j];
+      }
+    }
+  }
+
+  results = run_ensemble(pool_, cases, nthreads_);
+
+  status_.resize(datasets_.size());
+  messages_.resize(datasets_.size());
+}
+
+void CalibrationObjective::collect_(std::vector<EnsembleResult> & results,
+                                    size_t first, double * const r,
+                                    bool record)
+{
+  for (size_t i = 0; i < ndatasets(); i++) {
+    EnsembleResult & res = results[first + i];
+    if (res.status == SUCCESS) {
+      res.status = compare_(datasets_[i], res.results, r + offsets_[i],
+                            res.message);
+    }
+    if (res.status != SUCCESS) {
+      std::fill(r + offsets_[i], r + offsets_[i+1],
+                std::sqrt(datasets_[i].weight) * penalty_);
+    }
+    if (record) {
+      status_[i] = res.status;
+      messages_[i] = res.message;
+    }
+  }
+}
+
+int CalibrationObjective::compare_(const Dataset & d,
+                                   const DriverResults & res,
+                                   double * const r,
+                                   std::string & message) const
+{
+  std::vector<double> y;
+  auto ya = res.arrays.find(d.y);
+  auto ys = res.scalars.find(d.y);
+  if (ya != res.arrays.end()) y = ya->second;
+  else if (ys != res.scalars.end()) y = {ys->second};
+  else {
+    message = "No result named " + d.y;
+    return UNKNOWN_ERROR;
+  }
+
+  double w = std::sqrt(d.weight);
+
+  if (d.x.empty()) {
+    if (y.size() != d.ydata.size()) {
+      message = "Expected " + std::to_string(d.ydata.size()) + " values of "
+          + d.y + ", got " + std::to_string(y.size());
+      return UNKNOWN_ERROR;
+    }
+    for (size_t k = 0; k < y.size(); k++) r[k] = w * (y[k] - d.ydata[k]);
+    return SUCCESS;
+  }
+
+  auto xa = res.arrays.find(d.x);
+  if (xa == res.arrays.end()) {
+    message = "No result named " + d.x;
+    return UNKNOWN_ERROR;
+  }
+  const std::vector<double> & x = xa->second;
+  if (x.size() != y.size() || x.empty()) {
+    message = "The results " + d.x + " and " + d.y
+        + " have different lengths";
+    return UNKNOWN_ERROR;
+  }
+  if (not std::is_sorted(x.begin(), x.end())) {
+    message = "The result " + d.x + " does not increase";
+    return UNKNOWN_ERROR;
+  }
+
+  for (size_t k = 0; k < d.xdata.size(); k++) {
+    double xk = d.xdata[k];
+    if (not ((xk >= x.front()) && (xk <= x.back()))) {
+      message = "The data go past the simulated range of " + d.x;
+      return UNKNOWN_ERROR;
+    }
+    size_t i = std::upper_bound(x.begin(), x.end(), xk) - x.begin();
+    i = std::max(std::min(i, x.size() - 1), (size_t) 1);
+    double yk;
+    if (x.size() == 1) yk = y[0];
+    else if (x[i] == x[i-1]) yk = y[i];
+    else yk = y[i-1] + (y[i] - y[i-1]) * (xk - x[i-1]) / (x[i] - x[i-1]);
+    r[k] = w * (yk - d.ydata[k]);
+  }
+
+  return SUCCESS;
+}
+
+void CalibrationObjective::evaluate_(const double * const p, double * const r)
+{
+  size_t np = nparams();
+  if (cached_ && std::equal(p, p + np, last_p_.begin())) {
+    std::copy(last_r_.begin(), last_r_.end(), r);
+    return;
+  }
+
+  std::vector<EnsembleResult> results;
+  simulate_({std::vector<double>(p, p + np)}, results);
+  collect_(results, 0, r, true);
+
+  last_p_.assign(p, p + np);
+  last_r_.assign(r, r + nresiduals());
+  cached_ = true;
+}
+
+} // namespace neml
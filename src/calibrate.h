@@ -0,0 +1,109 @@
+#ifndef CALIBRATE_H
+#define CALIBRATE_H
+
+#include "ensemble.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace neml {
+
+/// Weighted least squares objective for fitting some of the tunable
+/// parameters of a model (see tunable.h) to a set of tests
+//  Each dataset is a loading program and a measured response: the values
+//  ydata of the result y at the values xdata of the result x, for
+//  example the stress at a list of strains for a tensile test or the
+//  creep strain at a list of times for a creep test.  The simulated y is
+//  interpolated linearly in x, which must increase through the test.
+//  With no x the response is compared point by point and must have the
+//  same length as ydata, which also covers scalar results like the yield
+//  stress.
+//
+//  The residuals are sqrt(weight) * (simulated - measured).  Every
+//  evaluation runs all the simulations at once with run_ensemble, on
+//  copies of the model kept between evaluations and tuned in place.  A
+//  dataset whose simulation fails, or does not cover its xdata, gets the
+//  residuals sqrt(weight) * penalty.
+//
+//  The evaluations change the copies, so the object should only be used
+//  by one thread at a time.
+class CalibrationObjective {
+ public:
+  /// Parameters are the model, the names of the parameters to fit, the
+  /// number of threads (0 for all), and the residual for failed tests
+  CalibrationObjective(std::shared_ptr<NEMLModel> model,
+                       const std::vector<std::string> & names,
+                       unsigned nthreads = 0, double penalty = 1.0e6);
+
+  /// Add a dataset: the loading program, the names of the results to
+  /// compare (x may be empty), the measured data, and the weight.  Any
+  /// parameter changes in the test are kept, except for the parameters
+  /// being fit.
+  void add_dataset(const EnsembleCase & test, const std::string & x,
+                   const std::string & y, const std::vector<double> & xdata,
+                   const std::vector<double> & ydata, double weight = 1.0);
+
+  /// Names of the parameters to fit
+  const std::vector<std::string> & names() const {return names_;};
+  /// Number of parameters to fit
+  size_t nparams() const {return names_.size();};
+  /// Number of datasets
+  size_t ndatasets() const {return datasets_.size();};
+  /// Total number of residuals
+  size_t nresiduals() const {return offsets_.back();};
+  /// Start of the residuals of each dataset, plus the total
+  const std::vector<size_t> & offsets() const {return offsets_;};
+
+  /// Residuals with the parameters p
+  void residuals(const double * const p, double * const r);
+  /// Sum of the squares of the residuals
+  double objective(const double * const p);
+  /// Forward difference derivatives of the residuals with respect to the
+  /// parameters, with steps rel_step * max(|p|, 1), as a row major
+  /// nresiduals x nparams matrix.  All the simulations run at once.  The
+  /// derivatives of a dataset are zero wherever its simulation fails at p
+  /// or after the step.
+  void jacobian(const double * const p, double * const J,
+                double rel_step = 1.0e-6);
+
+  /// Status of each dataset in the last evaluation at p
+  const std::vector<int> & status() const {return status_;};
+  /// Why each dataset failed in the last evaluation at p
+  const std::vector<std::string> & messages() const {return messages_;};
+
+ private:
+  /// A loading program and the measured response
+  struct Dataset {
+    EnsembleCase test;
+    std::string x, y;
+    std::vector<double> xdata, ydata;
+    double weight;
+  };
+
+  void simulate_(const std::vector<std::vector<double>> & ps,
+                 std::vector<EnsembleResult> & results);
+  void collect_(std::vector<EnsembleResult> & results, size_t first,
+                double * const r, bool record);
+  int compare_(const Dataset & d, const DriverResults & res,
+               double * const r, std::string & message) const;
+  void evaluate_(const double * const p, double * const r);
+
+ private:
+  std::vector<std::string> names_;
+  unsigned nthreads_;
+  double penalty_;
+  TunedModelPool pool_;
+
+  std::vector<Dataset> datasets_;
+  std::vector<size_t> offsets_;
+
+  bool cached_;
+  std::vector<double> last_p_, last_r_;
+  std::vector<int> status_;
+  std::vector<std::string> messages_;
+};
+
+} // namespace neml
+
+#endif // CALIBRATE_H
@@ -0,0 +1,112 @@
+#include "pyhelp.h" // include first to avoid annoying redef warning
+
+#include "calibrate.h"
+
+namespace py = pybind11;
+
+PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>)
+
+namespace neml {
+
+namespace {
+
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> InArray;
+
+void check_parameters(const CalibrationObjective & o, const InArray & p)
+{
+  check_shape<double>(p, {o.nparams()}, "p");
+}
+
+} // namespace
+
+PYBIND11_MODULE(calibrate, m) {
+  py::module::import("neml.objects");
+  py::module::import("neml.models");
+  py::module::import("neml.ensemble");
+
+  m.doc() = "Objective functions for fitting models to test data.";
+
+  py::class_<CalibrationObjective, std::shared_ptr<CalibrationObjective>>(
+      m, "CalibrationObjective")
+      .def(py::init<std::shared_ptr<NEMLModel>,
+           const std::vector<std::string> &, unsigned, double>(),
+           py::arg("model"), py::arg("names"), py::arg("nthreads") = 0,
+           py::arg("penalty") = 1.0e6)
+      .def("add_dataset",
+           [](CalibrationObjective & o, const EnsembleCase & test,
+              py::object x, std::string y, py::object xdata,
+              std::vector<double> ydata, double weight)
+           {
+            std::vector<double> xd;
+            if (not xdata.is_none()) xd = xdata.cast<std::vector<double>>();
+            o.add_dataset(test, x.is_none() ? "" : x.cast<std::string>(), y,
+                          xd, ydata, weight);
+           }, "Add a test and the measured values of the result y at the "
+           "values xdata of the result x, or at every step if x is None.",
+           py::arg("test"), py::arg("x"), py::arg("y"), py::arg("xdata"),
+           py::arg("ydata"), py::arg("weight") = 1.0)
+      .def_property_readonly("names", &CalibrationObjective::names,
+                             "Names of the parameters to fit.")
+      .def_property_readonly("nparams", &CalibrationObjective::nparams,
+                             "Number of parameters to fit.")
+      .def_property_readonly("ndatasets", &CalibrationObjective::ndatasets,
+                             "Number of datasets.")
+      .def_property_readonly("nresiduals", &CalibrationObjective::nresiduals,
+                             "Total number of residuals.")
+      .def_property_readonly("offsets",
+           [](const CalibrationObjective & o) -> std::vector<size_t>
+           {
+            return o.offsets();
+           }, "Start of the residuals of each dataset.")
+      .def_property_readonly("status",
+           [](const CalibrationObjective & o) -> std::vector<int>
+           {
+            return o.status();
+           }, "Error code of each dataset in the last evaluation.")
+      .def_property_readonly("messages",
+           [](const CalibrationObjective & o) -> std::vector<std::string>
+           {
+            return o.messages();
+           }, "Why each dataset failed in the last evaluation.")
+      .def("residuals",
+           [](CalibrationObjective & o, InArray p) -> py::array_t<double>
+           {
+            check_parameters(o, p);
+            auto r = alloc_vec<double>(o.nresiduals());
+            auto p_ptr = p.data();
+            auto r_ptr = r.mutable_data();
+            {
+              py::gil_scoped_release release;
+              o.residuals(p_ptr, r_ptr);
+            }
+            return r;
+           }, "Weighted residuals for the parameters p.", py::arg("p"))
+      .def("jacobian",
+           [](CalibrationObjective & o, InArray p,
+              double rel_step) -> py::array_t<double>
+           {
+            check_parameters(o, p);
+            auto J = alloc_mat<double>(o.nresiduals(), o.nparams());
+            auto p_ptr = p.data();
+            auto J_ptr = J.mutable_data();
+            {
+              py::gil_scoped_release release;
+              o.jacobian(p_ptr, J_ptr, rel_step);
+            }
+            return J;
+           }, "Forward difference derivatives of the residuals with respect "
+           "to the parameters p.", py::arg("p"),
+           py::arg("rel_step") = 1.0e-6)
+      .def("__call__",
+           [](CalibrationObjective & o, InArray p) -> double
+           {
+            check_parameters(o, p);
+            auto p_ptr = p.data();
+            py::gil_scoped_release release;
+            return o.objective(p_ptr);
+           }, "Sum of the squares of the residuals for the parameters p.",
+           py::arg("p"))
+      ;
+}
+
+} // namespace neml
@@ -0,0 +1,980 @@
+#include "cdrivers.h"
+
+#include "nemlmath.h"
+#include "nemlerror.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace neml {
+
+namespace {
+
+// Cap on the backtracking line search, which would otherwise never stop
+// on a residual that can't be reduced
+const int MAX_BACKTRACK = 100;
+
+// Same as numpy.isclose with the default tolerances
+bool isclose(double a, double b)
+{
+  return std::fabs(a - b) <= 1.0e-8 + 1.0e-5 * std::fabs(b);
+}
+
+double dot6(const double * const a, const std::vector<double> & b)
+{
+  return dot_vec(a, &b[0], 6);
+}
+
+void check_direction(const std::vector<double> & d, const char * name)
+{
+  if (d.size() != 6) {
+    throw std::invalid_argument(std::string(name) +
+                                " should have 6 components");
+  }
+}
+
+// max and min as python computes them, so a nan only counts if it
+// is first in the range
+double py_max(const std::vector<double> & v, size_t start)
+{
+  double m = v[start];
+  for (size_t i = start + 1; i < v.size(); i++) if (v[i] > m) m = v[i];
+  return m;
+}
+
+double py_min(const std::vector<double> & v, size_t start)
+{
+  double m = v[start];
+  for (size_t i = start + 1; i < v.size(); i++) if (v[i] < m) m = v[i];
+  return m;
+}
+
+// The n points of numpy.linspace(start, stop, n)
+std::vector<double> linspace(double start, double stop, int n)
+{
+  std::vector<double> res(n);
+  double step = n > 1 ? (stop - start) / (n - 1) : 0.0;
+  for (int i = 0; i < n; i++) res[i] = start + i * step;
+  if (n > 1) res[n-1] = stop;
+  return res;
+}
+
+// The n points of numpy.logspace(0, log10(stop), n)
+std::vector<double> logspace(double stop, int n)
+{
+  std::vector<double> res = linspace(0.0, std::log10(stop), n);
+  for (auto & x : res) x = std::pow(10.0, x);
+  return res;
+}
+
+// Yield stress where the offset line crosses the piecewise linear stress
+// strain curve, infinite if it doesn't
+double offset_yield(const std::vector<double> & strain,
+                    const std::vector<double> & stress,
+                    double E, double offset)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+
+  std::vector<std::pair<double,double>> pts;
+  for (size_t i = 0; i < strain.size(); i++) {
+    pts.emplace_back(std::fabs(strain[i]), std::fabs(stress[i]));
+  }
+  std::stable_sort(pts.begin(), pts.end(),
+                   [](const std::pair<double,double> & a,
+                      const std::pair<double,double> & b)
+                   {return a.first < b.first;});
+
+  double hi = *std::max_element(strain.begin(), strain.end());
+  if (pts.front().first > 0.0 || hi > pts.back().first) return inf;
+
+  auto g = [&](size_t i) {return pts[i].second - E * (pts[i].first - offset);};
+  auto line = [&](double e) {return E * (e - offset);};
+
+  double gl = g(0);
+  if (gl == 0.0) return line(0.0);
+  for (size_t i = 0; i + 1 < pts.size() && pts[i].first < hi; i++) {
+    double xl = pts[i].first;
+    double xr = pts[i+1].first;
+    double gr = g(i+1);
+    if (xr > hi) {
+      gr = gl + (gr - gl) * (hi - xl) / (xr - xl);
+      xr = hi;
+    }
+    if (gr == 0.0) return line(xr);
+    if (gl * gr < 0.0) return line(xl + (xr - xl) * gl / (gl - gr));
+    gl = gr;
+  }
+
+  return inf;
+}
+
+std::vector<double> slice(const std::vector<double> & v, size_t start,
+                          size_t end)
+{
+  if (start >= end) return std::vector<double>();
+  return std::vector<double>(v.begin() + start, v.begin() + end);
+}
+
+} // namespace
+
+Driver_sd::Driver_sd(std::shared_ptr<NEMLModel> model, double T_init,
+                     bool no_thermal_strain, double rtol, double atol,
+                     int miter) :
+    model_(model), nts_(no_thermal_strain), rtol_(rtol), atol_(atol),
+    miter_(miter), h_(model->nstore()), h_trial_(model->nstore()),
+    T_(T_init), u_(0.0), p_(0.0), times_({0.0}), energies_({0.0}),
+    works_({0.0})
+{
+  std::fill(e_, e_+6, 0.0);
+  std::fill(e_prev_, e_prev_+6, 0.0);
+  std::fill(em_, em_+6, 0.0);
+  std::fill(eth_, eth_+6, 0.0);
+  std::fill(s_, s_+6, 0.0);
+  model_->init_store(&h_[0]);
+}
+
+void Driver_sd::set_history(const std::vector<double> & h)
+{
+  if (h.size() != h_.size()) {
+    throw std::invalid_argument("The history should have " +
+                                std::to_string(h_.size()) + " entries");
+  }
+  h_ = h;
+}
+
+int Driver_sd::strain_step(const double * const e_np1, double t_np1,
+                           double T_np1)
+{
+  double enext[6], e[6], em[6], s[6], A[36];
+  double u, p;
+  std::copy(e_np1, e_np1+6, e);
+  update_thermal_strain_(T_np1, enext);
+  for (int i = 0; i < 6; i++) em[i] = e[i] - enext[i];
+
+  std::fill(s, s+6, 0.0);
+  std::fill(A, A+36, 0.0);
+  std::vector<double> h(h_.size(), 0.0);
+  int ier = model_->update_sd(em, em_, T_np1, T_, t_np1, t(), s, s_,
+                              &h[0], &h_[0], A, u, u_, p, p_);
+  if (ier != SUCCESS) return ier;
+
+  std::copy(e_, e_+6, e_prev_);
+  std::copy(e, e+6, e_);
+  std::copy(em, em+6, em_);
+  std::copy(enext, enext+6, eth_);
+  std::copy(s, s+6, s_);
+  h_.swap(h);
+  T_ = T_np1;
+  u_ = u;
+  p_ = p;
+  times_.push_back(t_np1);
+  energies_.push_back(u);
+  works_.push_back(p);
+
+  return SUCCESS;
+}
+
+int Driver_sd::stress_step(const double * const s_np1, double t_np1,
+                           double T_np1)
+{
+  double st[6], enext[6];
+  std::copy(s_np1, s_np1+6, st);
+  update_thermal_strain_(T_np1, enext);
+
+  Residual RJ = [&](const double * const e, double * const R,
+                    double * const J) -> int
+  {
+    double em[6];
+    for (int i = 0; i < 6; i++) em[i] = e[i] - enext[i];
+    int ier = trial_(em, t_np1, T_np1, R, J);
+    for (int i = 0; i < 6; i++) R[i] -= st[i];
+    return ier;
+  };
+
+  std::vector<std::vector<double>> extra;
+  if (nstates() > 1) {
+    std::vector<double> g(6);
+    for (int i = 0; i < 6; i++) g[i] = 2.0 * e_[i] - e_prev_[i];
+    extra.push_back(g);
+  }
+
+  double e[6];
+  int ier = solve_(RJ, 6, e_, extra, e);
+  if (ier != SUCCESS) return ier;
+
+  return strain_step(e, t_np1, T_np1);
+}
+
+int Driver_sd::erate_step(const double * const sdir, double erate,
+                          double t_np1, double T_np1, double * const einc,
+                          double & ainc, const double * const einc_guess,
+                          const double * const ainc_guess)
+{
+  double d[6], enext[6];
+  std::copy(sdir, sdir+6, d);
+  normalize_vec(d, 6);
+  double dt = t_np1 - t();
+  update_thermal_strain_(T_np1, enext);
+
+  Residual RJ = [&](const double * const x, double * const R,
+                    double * const J) -> int
+  {
+    double em[6], s[6], A[36];
+    for (int i = 0; i < 6; i++) em[i] = e_[i] + x[i+1] - enext[i];
+    int ier = trial_(em, t_np1, T_np1, s, A);
+
+    std::fill(J, J+49, 0.0);
+    for (int i = 0; i < 6; i++) {
+      R[i] = s[i] - (d[i] * x[0] + s_[i]);
+      J[CINDEX(i,0,7)] = -d[i];
+      for (int j = 0; j < 6; j++) J[CINDEX(i,j+1,7)] = A[CINDEX(i,j,6)];
+      J[CINDEX(6,i+1,7)] = d[i] / dt;
+    }
+    R[6] = dot_vec(&x[1], d, 6) / dt - erate;
+
+    return ier;
+  };
+
+  double x0[7];
+  x0[0] = ainc_guess ? *ainc_guess : 1.0;
+  for (int i = 0; i < 6; i++) {
+    x0[i+1] = einc_guess ? einc_guess[i] : d[i] / 10000.0;
+  }
+
+  double x[7];
+  int ier = solve_(RJ, 7, x0, {}, x);
+  if (ier != SUCCESS) return ier;
+
+  double e_np1[6];
+  for (int i = 0; i < 6; i++) e_np1[i] = e_[i] + x[i+1];
+  ier = strain_step(e_np1, t_np1, T_np1);
+  if (ier != SUCCESS) return ier;
+
+  std::copy(x+1, x+7, einc);
+  ainc = x[0];
+
+  return SUCCESS;
+}
+
+int Driver_sd::erate_einc_step(const double * const sdir, double erate,
+                               double einc, double T_np1,
+                               double * const einc_out, double & ainc,
+                               const double * const einc_guess,
+                               const double * const ainc_guess)
+{
+  double dt = einc / erate;
+  return erate_step(sdir, erate, t() + dt, T_np1, einc_out, ainc,
+                    einc_guess, ainc_guess);
+}
+
+int Driver_sd::srate_sinc_step(const double * const sdir, double srate,
+                               double sinc, double T_np1)
+{
+  double s_np1[6], d[6];
+  std::copy(s_, s_+6, s_np1);
+  if (std::any_of(sdir, sdir+6, [](double x){return !isclose(x, 0.0);})) {
+    std::copy(sdir, sdir+6, d);
+    normalize_vec(d, 6);
+    for (int i = 0; i < 6; i++) s_np1[i] += d[i] * sinc;
+  }
+
+  double dt = 0.0;
+  if (!isclose(srate, 0.0)) {
+    double ds[6];
+    for (int i = 0; i < 6; i++) ds[i] = s_np1[i] - s_[i];
+    dt = std::fabs(dot_vec(ds, sdir, 6) / srate);
+  }
+
+  return stress_step(s_np1, t() + dt, T_np1);
+}
+
+int Driver_sd::strain_hold_step(int i, double t_np1, double T_np1, double q,
+                                double E)
+{
+  if (i < 0 || i > 5) {
+    throw std::invalid_argument("The held index should be between 0 and 5");
+  }
+  if (!isclose(q, 1.0) && isclose(E, -1.0)) {
+    throw std::invalid_argument("You must supply the Youngs modulus");
+  }
+
+  double enext[6];
+  update_thermal_strain_(T_np1, enext);
+  int oset[5];
+  for (int j = 0, k = 0; j < 6; j++) if (j != i) oset[k++] = j;
+
+  Residual RJ = [&](const double * const e, double * const R,
+                    double * const J) -> int
+  {
+    double em[6], s[6], A[36];
+    for (int j = 0; j < 6; j++) em[j] = e[j] - enext[j];
+    int ier = trial_(em, t_np1, T_np1, s, A);
+
+    R[0] = (e[i] - e_[i]) + (s[i] - s_[i]) / E * (q - 1.0);
+    for (int j = 0; j < 6; j++) {
+      J[CINDEX(0,j,6)] = A[CINDEX(i,j,6)] / E * (q - 1.0);
+    }
+    J[CINDEX(0,i,6)] += 1.0;
+    for (int k = 0; k < 5; k++) {
+      R[k+1] = s[oset[k]] - s_[oset[k]];
+      for (int j = 0; j < 6; j++) {
+        J[CINDEX((k+1),j,6)] = A[CINDEX(oset[k],j,6)];
+      }
+    }
+
+    return ier;
+  };
+
+  double e[6];
+  int ier = solve_(RJ, 6, e_, {}, e);
+  if (ier != SUCCESS) return ier;
+
+  return strain_step(e, t_np1, T_np1);
+}
+
+void Driver_sd::update_thermal_strain_(double T_np1,
+                                       double * const enext) const
+{
+  std::fill(enext, enext+6, 0.0);
+  if (nts_) return;
+
+  double dT = T_np1 - T_;
+  double a = dT * (model_->alpha(T_np1) + model_->alpha(T_)) / 2.0;
+  for (int i = 0; i < 6; i++) enext[i] = eth_[i];
+  for (int i = 0; i < 3; i++) enext[i] += a;
+}
+
+int Driver_sd::trial_(const double * const e_mech, double t_np1,
+                      double T_np1, double * const s, double * const A)
+{
+  double u, p;
+  std::fill(s, s+6, 0.0);
+  std::fill(A, A+36, 0.0);
+  std::fill(h_trial_.begin(), h_trial_.end(), 0.0);
+  return model_->update_sd(e_mech, em_, T_np1, T_, t_np1, t(), s, s_,
+                           &h_trial_[0], &h_[0], A, u, u_, p, p_);
+}
+
+int Driver_sd::solve_(Residual RJ, int n, const double * const x0,
+                      const std::vector<std::vector<double>> & extra,
+                      double * const x) const
+{
+  std::vector<const double *> guesses = {x0};
+  for (auto & g : extra) guesses.push_back(&g[0]);
+
+  for (auto g : guesses) {
+    for (bool linesearch : {false, true}) {
+      std::copy(g, g+n, x);
+      if (newton_(RJ, n, x, linesearch) == SUCCESS) return SUCCESS;
+    }
+  }
+
+  return MAX_ITERATIONS;
+}
+
+int Driver_sd::newton_(Residual RJ, int n, double * const x,
+                       bool linesearch) const
+{
+  std::vector<double> R(n), J(n*n), a(n), xt(n), Rt(n), Jt(n*n), Ja(n),
+      Rc(n);
+
+  int ier = RJ(x, &R[0], &J[0]);
+  if (ier != SUCCESS) return ier;
+  double nR = norm2_vec(&R[0], n);
+  double nR0 = nR;
+
+  int i = 0;
+  while ((nR > rtol_ * nR0) && (nR > atol_)) {
+    std::copy(R.begin(), R.end(), a.begin());
+    ier = solve_mat(&J[0], n, &a[0]);
+    if (ier != SUCCESS) return ier;
+
+    double f = 1.0;
+    if (linesearch) {
+      // Backtrack along -a until the residual drops enough
+      mat_vec(&J[0], n, &a[0], n, &Ja[0]);
+      for (int k = 0; ; k++) {
+        if (k > MAX_BACKTRACK) return MAX_ITERATIONS;
+        for (int j = 0; j < n; j++) xt[j] = x[j] - f * a[j];
+        ier = RJ(&xt[0], &Rt[0], &Jt[0]);
+        if (ier != SUCCESS) return ier;
+        for (int j = 0; j < n; j++) Rc[j] = R[j] - 1.0e-4 * f * Ja[j];
+        if (!(norm2_vec(&Rt[0], n) > norm2_vec(&Rc[0], n))) break;
+        f *= 0.5;
+      }
+    }
+
+    for (int j = 0; j < n; j++) x[j] -= a[j] * f;
+    ier = RJ(x, &R[0], &J[0]);
+    if (ier != SUCCESS) return ier;
+    nR = norm2_vec(&R[0], n);
+    i++;
+    if (i > miter_) return MAX_ITERATIONS;
+  }
+
+  return SUCCESS;
+}
+
+int uniaxial_test(std::shared_ptr<NEMLModel> model, double erate,
+                  DriverResults & res, double T, double emax, int nsteps,
+                  std::vector<double> sdir, double offset,
+                  std::vector<double> history, std::vector<double> tdir)
+{
+  check_direction(sdir, "sdir");
+  check_direction(tdir, "tdir");
+  if (nsteps < 1) throw std::invalid_argument("nsteps should be positive");
+
+  Driver_sd driver(model, T);
+  if (not history.empty()) driver.set_history(history);
+
+  double e_inc = emax / nsteps;
+  std::vector<double> strain, stress;
+  strain.reserve(nsteps + 1);
+  stress.reserve(nsteps + 1);
+  strain.push_back(0.0);
+  stress.push_back(0.0);
+
+  double einc[6], ainc, e1[6];
+  for (int i = 0; i < nsteps; i++) {
+    int ier;
+    if (i == 0) {
+      ier = driver.erate_einc_step(&sdir[0], erate, e_inc, T, einc, ainc);
+      std::copy(driver.strain(), driver.strain()+6, e1);
+    }
+    else {
+      ier = driver.erate_einc_step(&sdir[0], erate, e_inc, T, einc, ainc,
+                                   einc, &ainc);
+    }
+    if (ier != SUCCESS) return ier;
+    strain.push_back(dot6(driver.strain(), sdir));
+    stress.push_back(dot6(driver.stress(), sdir));
+  }
+
+  double E = std::fabs(stress[1]) / std::fabs(strain[1]);
+  res.scalars["youngs"] = E;
+  res.scalars["poissons"] = -dot6(e1, tdir) / dot6(e1, sdir);
+  res.scalars["yield"] = offset_yield(strain, stress, E, offset);
+
+  res.arrays["strain"] = std::move(strain);
+  res.arrays["stress"] = std::move(stress);
+  res.arrays["energy_density"] = driver.energies();
+  res.arrays["plastic_work"] = driver.works();
+
+  return SUCCESS;
+}
+
+int strain_cyclic(std::shared_ptr<NEMLModel> model, double emax, double R,
+                  double erate, int ncycles, DriverResults & res, double T,
+                  int nsteps, std::vector<double> sdir,
+                  std::vector<double> hold_time, int n_hold, bool check_dmg,
+                  double dtol)
+{
+  check_direction(sdir, "sdir");
+  if (hold_time.size() != 2) {
+    throw std::invalid_argument("hold_time should have 2 entries");
+  }
+
+  Driver_sd driver(model, T);
+  double emin = emax * R;
+  std::vector<double> msdir(6);
+  for (int i = 0; i < 6; i++) msdir[i] = -sdir[i];
+
+  size_t per_cycle = 2 * nsteps + (hold_time[0] > 0.0 ? n_hold : 0) +
+      (hold_time[1] > 0.0 ? n_hold : 0);
+  std::vector<double> strain, stress, time;
+  for (auto v : {&strain, &stress, &time}) {
+    v->reserve(1 + nsteps + ncycles * per_cycle);
+    v->push_back(0.0);
+  }
+  std::vector<int> cycles;
+  std::vector<double> smax, smin, smean, ecycle, pcycle;
+  for (auto v : {&smax, &smin, &smean, &ecycle, &pcycle}) v->reserve(ncycles);
+  cycles.reserve(ncycles);
+
+  auto damaged = [&]() {
+    return check_dmg && (not driver.history().empty()) &&
+        (driver.history()[0] > dtol);
+  };
+  auto record = [&]() {
+    strain.push_back(dot6(driver.strain(), sdir));
+    stress.push_back(dot6(driver.stress(), sdir));
+    time.push_back(driver.t());
+  };
+
+  double einc[6], ainc;
+  const double zero[6] = {0,0,0,0,0,0};
+  const double down = -1.0;
+
+  // Hold at the current strain
+  auto hold = [&](double ht) -> int {
+    if (not (ht > 0.0)) return SUCCESS;
+    double dt = ht / n_hold;
+    for (int i = 0; i < n_hold; i++) {
+      int ier = driver.erate_step(&sdir[0], 0.0, driver.t() + dt, T, einc,
+                                  ainc, zero, &down);
+      if (ier != SUCCESS) return ier;
+      if (damaged()) return DAMAGE_EXCEEDED;
+      record();
+    }
+    return SUCCESS;
+  };
+
+  // Load to the other peak, starting with the reversed last increment
+  auto ramp = [&](const std::vector<double> & d, double e_inc) -> int {
+    for (int i = 0; i < nsteps; i++) {
+      if (i == 0) {
+        double eg[6], ag = -ainc;
+        for (int j = 0; j < 6; j++) eg[j] = -einc[j];
+        int ier = driver.erate_einc_step(&d[0], erate, e_inc, T, einc, ainc,
+                                         eg, &ag);
+        if (ier != SUCCESS) return ier;
+      }
+      else {
+        int ier = driver.erate_einc_step(&d[0], erate, e_inc, T, einc, ainc,
+                                         einc, &ainc);
+        if (ier != SUCCESS) return ier;
+      }
+      if (damaged()) return DAMAGE_EXCEEDED;
+      record();
+    }
+    return SUCCESS;
+  };
+
+  // First half cycle
+  double e_inc = emax / nsteps;
+  for (int i = 0; i < nsteps; i++) {
+    int ier;
+    if (i == 0) {
+      ier = driver.erate_einc_step(&sdir[0], erate, e_inc, T, einc, ainc);
+    }
+    else {
+      ier = driver.erate_einc_step(&sdir[0], erate, e_inc, T, einc, ainc,
+                                   einc, &ainc);
+    }
+    if (ier != SUCCESS) return ier;
+    if (damaged()) return DAMAGE_EXCEEDED;
+    record();
+  }
+
+  for (int s = 0; s < ncycles; s++) {
+    if (hold(hold_time[0]) != SUCCESS) break;
+    size_t si = strain.size();
+    if (ramp(msdir, std::fabs(emin - emax) / nsteps) != SUCCESS) break;
+    if (hold(hold_time[1]) != SUCCESS) break;
+    if (ramp(sdir, std::fabs(emax - emin) / nsteps) != SUCCESS) break;
+
+    if (si >= stress.size()) break;
+    double mx = py_max(stress, si);
+    double mn = py_min(stress, si);
+    if (std::isnan(mx) || std::isnan(mn)) break;
+
+    cycles.push_back(s);
+    smax.push_back(mx);
+    smin.push_back(mn);
+    smean.push_back((mx + mn) / 2.0);
+    ecycle.push_back(driver.energies().back());
+    pcycle.push_back(driver.works().back());
+  }
+
+  res.arrays["strain"] = std::move(strain);
+  res.arrays["stress"] = std::move(stress);
+  res.int_arrays["cycles"] = std::move(cycles);
+  res.arrays["max"] = std::move(smax);
+  res.arrays["min"] = std::move(smin);
+  res.arrays["mean"] = std::move(smean);
+  res.arrays["energy_density"] = std::move(ecycle);
+  res.arrays["plastic_work"] = std::move(pcycle);
+  res.arrays["history"] = driver.history();
+  res.arrays["time"] = std::move(time);
+
+  return SUCCESS;
+}
+
+int stress_cyclic(std::shared_ptr<NEMLModel> model, double smax, double R,
+                  double srate, int ncycles, DriverResults & res, double T,
+                  int nsteps, std::vector<double> sdir,
+                  std::vector<double> hold_time, int n_hold, double etol)
+{
+  check_direction(sdir, "sdir");
+  if (hold_time.size() != 2) {
+    throw std::invalid_argument("hold_time should have 2 entries");
+  }
+
+  Driver_sd driver(model, T);
+  double smin = smax * R;
+
+  size_t per_cycle = 2 * nsteps + (hold_time[0] > 0.0 ? n_hold : 0) +
+      (hold_time[1] > 0.0 ? n_hold : 0);
+  std::vector<double> strain, stress;
+  for (auto v : {&strain, &stress}) {
+    v->reserve(1 + nsteps + ncycles * per_cycle);
+    v->push_back(0.0);
+  }
+  std::vector<int> cycles;
+  std::vector<double> emax, emin, emean, ecycle, pcycle;
+  for (auto v : {&emax, &emin, &emean, &ecycle, &pcycle}) v->reserve(ncycles);
+  cycles.reserve(ncycles);
+
+  auto record = [&]() {
+    strain.push_back(dot6(driver.strain(), sdir));
+    stress.push_back(dot6(driver.stress(), sdir));
+  };
+
+  // Record a step, unless it failed or the strain jumped more than etol
+  auto accept = [&](int ier) -> bool {
+    if (ier != SUCCESS) return false;
+    double de[6];
+    for (int i = 0; i < 6; i++) {
+      de[i] = driver.strain()[i] - driver.previous_strain()[i];
+    }
+    if (norm2_vec(de, 6) > etol) return false;
+    record();
+    return true;
+  };
+
+  auto hold = [&](double ht) -> bool {
+    if (not (ht > 0.0)) return true;
+    double dt = ht / n_hold;
+    for (int i = 0; i < n_hold; i++) {
+      if (not accept(driver.stress_step(driver.stress(), driver.t() + dt,
+                                        T))) return false;
+    }
+    return true;
+  };
+
+  auto ramp = [&](double s_inc) -> bool {
+    for (int i = 0; i < nsteps; i++) {
+      if (not accept(driver.srate_sinc_step(&sdir[0], srate, s_inc,
+                                            T))) return false;
+    }
+    return true;
+  };
+
+  // First half cycle
+  double s_inc = smax / nsteps;
+  for (int i = 0; i < nsteps; i++) {
+    int ier = driver.srate_sinc_step(&sdir[0], srate, s_inc, T);
+    if (ier != SUCCESS) return ier;
+    record();
+  }
+
+  for (int s = 0; s < ncycles; s++) {
+    size_t si = strain.size();
+    if (not hold(hold_time[0])) break;
+    if (not ramp((smin - smax) / nsteps)) break;
+    if (not hold(hold_time[1])) break;
+    if (not ramp((smax - smin) / nsteps)) break;
+    if (si >= strain.size()) break;
+
+    cycles.push_back(s);
+    emax.push_back(py_max(strain, si));
+    emin.push_back(py_min(strain, si));
+    emean.push_back((emax.back() + emin.back()) / 2.0);
+    ecycle.push_back(driver.energies().back());
+    pcycle.push_back(driver.works().back());
+  }
+
+  res.arrays["strain"] = std::move(strain);
+  res.arrays["stress"] = std::move(stress);
+  res.int_arrays["cycles"] = std::move(cycles);
+  res.arrays["max"] = std::move(emax);
+  res.arrays["min"] = std::move(emin);
+  res.arrays["mean"] = std::move(emean);
+  res.arrays["energy_density"] = std::move(ecycle);
+  res.arrays["plastic_work"] = std::move(pcycle);
+  res.arrays["time"] = driver.times();
+
+  return SUCCESS;
+}
+
+int stress_relaxation(std::shared_ptr<NEMLModel> model, double emax,
+                      double erate, double hold, DriverResults & res,
+                      double T, int nsteps, int nsteps_up, int index,
+                      double tc, bool logspace, double q)
+{
+  if (index < 0 || index > 5) {
+    throw std::invalid_argument("index should be between 0 and 5");
+  }
+
+  DriverResults elastic;
+  int ier = uniaxial_test(model, erate, elastic, T, 1.0e-4, 2);
+  if (ier != SUCCESS) return ier;
+  double E = elastic.scalars["youngs"];
+
+  Driver_sd driver(model, T);
+  std::vector<double> time, strain, stress;
+  for (auto v : {&time, &strain, &stress}) {
+    v->reserve(1 + nsteps_up + nsteps);
+    v->push_back(0.0);
+  }
+
+  std::vector<double> sdir(6, 0.0);
+  sdir[index] = tc;
+
+  auto record = [&]() {
+    time.push_back(driver.t());
+    strain.push_back(dot6(driver.strain(), sdir));
+    stress.push_back(dot6(driver.stress(), sdir));
+  };
+
+  // Ramp up
+  double e_inc = emax / nsteps_up;
+  double einc[6], ainc;
+  for (int i = 0; i < nsteps_up; i++) {
+    if (i == 0) {
+      ier = driver.erate_einc_step(&sdir[0], erate, e_inc, T, einc, ainc);
+    }
+    else {
+      ier = driver.erate_einc_step(&sdir[0], erate, e_inc, T, einc, ainc,
+                                   einc, &ainc);
+    }
+    if (ier != SUCCESS) return ier;
+    record();
+  }
+
+  size_t ri = strain.size();
+
+  // Hold
+  std::vector<double> dts;
+  if (logspace) {
+    std::vector<double> ts = neml::logspace(hold, nsteps + 1);
+    for (int i = 0; i < nsteps; i++) dts.push_back(ts[i+1] - ts[i]);
+  }
+  else {
+    dts.assign(nsteps, hold / nsteps);
+  }
+  for (auto dt : dts) {
+    ier = driver.strain_hold_step(index, driver.t() + dt, T, q, E);
+    if (ier != SUCCESS) return ier;
+    record();
+  }
+
+  size_t n = time.size();
+  std::vector<double> rrate, rtime;
+  for (size_t i = ri; i + 1 < n; i++) {
+    rrate.push_back(-(stress[i+1] - stress[i]) / (time[i+1] - time[i]));
+    rtime.push_back(time[i] - time[ri]);
+  }
+
+  res.arrays["rtime"] = std::move(rtime);
+  res.arrays["rrate"] = std::move(rrate);
+  res.arrays["rstress"] = slice(stress, ri, n - 1);
+  res.arrays["rstrain"] = slice(strain, ri, n - 1);
+  res.arrays["time"] = std::move(time);
+  res.arrays["strain"] = std::move(strain);
+  res.arrays["stress"] = std::move(stress);
+
+  return SUCCESS;
+}
+
+int creep(std::shared_ptr<NEMLModel> model, double smax, double srate,
+          double hold, DriverResults & res, double T, int nsteps,
+          int nsteps_up, std::vector<double> sdir, bool logspace,
+          std::vector<double> history, double elimit, bool check_dmg,
+          double dtol)
+{
+  check_direction(sdir, "sdir");
+
+  Driver_sd driver(model, T);
+  if (not history.empty()) driver.set_history(history);
+
+  std::vector<double> time, strain, stress;
+  for (auto v : {&time, &strain, &stress}) {
+    v->reserve(1 + nsteps_up + nsteps);
+    v->push_back(0.0);
+  }
+
+  // Ramp up
+  double sinc = smax / nsteps_up;
+  for (int i = 0; i < nsteps_up; i++) {
+    int ier = driver.srate_sinc_step(&sdir[0], srate, sinc, T);
+    if (ier != SUCCESS) return ier;
+    time.push_back(driver.t());
+    strain.push_back(dot6(driver.strain(), sdir));
+    stress.push_back(dot6(driver.stress(), sdir));
+  }
+
+  size_t ri = strain.size();
+  double t0 = time.back();
+  std::vector<double> ts = logspace ? neml::logspace(hold, nsteps) :
+      linspace(0.0, hold, nsteps);
+  for (auto & t : ts) t += t0;
+
+  // Hold until the end or the specimen fails
+  bool failed = false;
+  for (auto t : ts) {
+    if (driver.stress_step(driver.stress(), t, T) != SUCCESS) {
+      failed = true;
+      break;
+    }
+    const double * e = driver.strain();
+    if (std::any_of(e, e+6, [](double x) {return std::isnan(x);}) ||
+        std::any_of(e, e+6, [elimit](double x)
+                    {return std::fabs(x) > elimit;})) {
+      failed = true;
+      break;
+    }
+    double ed = dot6(e, sdir);
+    if (ed < strain.back()) {
+      failed = true;
+      break;
+    }
+    if (check_dmg && (not driver.history().empty()) &&
+        (driver.history()[0] > dtol)) {
+      failed = true;
+      break;
+    }
+
+    time.push_back(t);
+    strain.push_back(ed);
+    stress.push_back(dot6(driver.stress(), sdir));
+  }
+
+  size_t n = time.size();
+  std::vector<double> rrate, rtime, rstrain;
+  for (size_t i = ri; i + 1 < n; i++) {
+    rrate.push_back((strain[i+1] - strain[i]) / (time[i+1] - time[i]));
+    rtime.push_back(time[i] - time[ri]);
+    rstrain.push_back(strain[i] - strain[ri]);
+  }
+
+  res.arrays["rtime"] = std::move(rtime);
+  res.arrays["rrate"] = std::move(rrate);
+  res.arrays["rstrain"] = std::move(rstrain);
+  res.arrays["tstrain"] = slice(strain, ri, n - 1);
+  res.arrays["time"] = std::move(time);
+  res.arrays["strain"] = std::move(strain);
+  res.arrays["stress"] = std::move(stress);
+  res.flags["failed"] = failed;
+
+  return SUCCESS;
+}
+
+int thermomechanical_strain_raw(std::shared_ptr<NEMLModel> model,
+                                const std::vector<double> & time,
+                                const std::vector<double> & temperature,
+                                const std::vector<double> & strain,
+                                DriverResults & res, std::vector<double> sdir,
+                                int substep)
+{
+  check_direction(sdir, "sdir");
+  size_t n = time.size();
+  if (temperature.size() != n || strain.size() != n) {
+    throw std::invalid_argument(
+        "time, temperature, and strain should have the same length");
+  }
+  if (n < 2) throw std::invalid_argument("Need at least two points");
+
+  std::vector<double> stress(n, 0.0), mechstrain(n, 0.0);
+  Driver_sd driver(model, temperature[0]);
+
+  double einc[6], ainc;
+  size_t i;
+  for (i = 1; i < n; i++) {
+    bool quit = false;
+    for (int k = 0; k < substep; k++) {
+      double ei_np1 = (strain[i] - strain[i-1]) / substep * (k+1) + strain[i-1];
+      double ti_np1 = (time[i] - time[i-1]) / substep * (k+1) + time[i-1];
+      double Ti_np1 = (temperature[i] - temperature[i-1]) / substep * (k+1) +
+          temperature[i-1];
+      double ei_n = (strain[i] - strain[i-1]) / substep * k + strain[i-1];
+      double ti_n = (time[i] - time[i-1]) / substep * k + time[i-1];
+
+      double erate = (ei_np1 - ei_n) / (ti_np1 - ti_n);
+      int ier;
+      if (i == 1) {
+        ier = driver.erate_step(&sdir[0], erate, ti_np1, Ti_np1, einc, ainc);
+      }
+      else {
+        ier = driver.erate_step(&sdir[0], erate, ti_np1, Ti_np1, einc, ainc,
+                                einc, &ainc);
+      }
+      if (ier != SUCCESS) {
+        quit = true;
+        break;
+      }
+    }
+    if (quit) break;
+
+    stress[i] = dot6(driver.stress(), sdir);
+    mechstrain[i] = dot6(driver.thermal_strain(), sdir);
+  }
+
+  // The python version drops the last point, keep that
+  size_t end = std::min(i, n - 1);
+  res.arrays["time"] = slice(time, 0, end);
+  res.arrays["temperature"] = slice(temperature, 0, end);
+  res.arrays["strain"] = slice(strain, 0, end);
+  res.arrays["stress"] = slice(stress, 0, end);
+  res.arrays["mechanical strain"] = slice(mechstrain, 0, end);
+
+  return SUCCESS;
+}
+
+int rate_jump_test(std::shared_ptr<NEMLModel> model,
+                   const std::vector<double> & erates, DriverResults & res,
+                   double T, double e_per, int nsteps_per,
+                   std::vector<double> sdir, std::vector<double> history,
+                   std::vector<double> strains)
+{
+  check_direction(sdir, "sdir");
+
+  Driver_sd driver(model, T);
+  if (not history.empty()) driver.set_history(history);
+
+  std::vector<double> strain, stress;
+  for (auto v : {&strain, &stress}) {
+    v->reserve(1 + erates.size() * nsteps_per);
+    v->push_back(0.0);
+  }
+  auto record = [&]() {
+    strain.push_back(dot6(driver.strain(), sdir));
+    stress.push_back(dot6(driver.stress(), sdir));
+  };
+
+  double einc[6], ainc;
+  if (strains.empty()) {
+    double e_inc = e_per / nsteps_per;
+    for (auto erate : erates) {
+      for (int i = 0; i < nsteps_per; i++) {
+        int ier;
+        if (i == 0) {
+          ier = driver.erate_einc_step(&sdir[0], erate, e_inc, T, einc, ainc);
+        }
+        else {
+          ier = driver.erate_einc_step(&sdir[0], erate, e_inc, T, einc, ainc,
+                                       einc, &ainc);
+        }
+        if (ier != SUCCESS) return ier;
+        record();
+      }
+    }
+  }
+  else {
+    double last = 0.0;
+    for (size_t j = 0; j < std::min(strains.size(), erates.size()); j++) {
+      double inc = (strains[j] - last) / nsteps_per;
+      last = strains[j];
+      if (strain.back() < strains[j] && not (inc > 0.0)) {
+        throw std::invalid_argument("The jump strains should increase");
+      }
+      while (strain.back() < strains[j]) {
+        int ier = driver.erate_einc_step(&sdir[0], erates[j], inc, T, einc,
+                                         ainc);
+        if (ier != SUCCESS) return ier;
+        record();
+      }
+    }
+  }
+
+  res.arrays["strain"] = std::move(strain);
+  res.arrays["stress"] = std::move(stress);
+  res.arrays["energy_density"] = driver.energies();
+  res.arrays["plastic_work"] = driver.works();
+
+  return SUCCESS;
+}
+
+} // namespace neml
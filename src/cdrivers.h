@@ -0,0 +1,173 @@
+#ifndef CDRIVERS_H
+#define CDRIVERS_H
+
+#include "models.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace neml {
+
+/// Small strain driver taking a model through strain, stress, and mixed
+/// control steps, integrating the thermal strains as it goes
+//  The C++ version of neml.drivers.Driver_sd.  Only the current state is
+//  kept, along with the previous strain and the time, energy, and work
+//  of every step.  The mixed and stress controlled steps are solved with
+//  Newton's method, falling back to Newton's method with a backtracking
+//  line search.
+class Driver_sd {
+ public:
+  Driver_sd(std::shared_ptr<NEMLModel> model, double T_init = 0.0,
+            bool no_thermal_strain = false, double rtol = 1.0e-6,
+            double atol = 1.0e-10, int miter = 25);
+
+  /// Replace the initial history
+  void set_history(const std::vector<double> & h);
+
+  /// Total strain
+  const double * strain() const {return e_;};
+  /// Strain before the last step
+  const double * previous_strain() const {return e_prev_;};
+  /// Thermal strain
+  const double * thermal_strain() const {return eth_;};
+  /// Stress
+  const double * stress() const {return s_;};
+  /// History
+  const std::vector<double> & history() const {return h_;};
+  /// Temperature
+  double T() const {return T_;};
+  /// Time
+  double t() const {return times_.back();};
+  /// Number of states, including the initial one
+  size_t nstates() const {return times_.size();};
+  /// Time of each state
+  const std::vector<double> & times() const {return times_;};
+  /// Energy density of each state
+  const std::vector<double> & energies() const {return energies_;};
+  /// Plastic work of each state
+  const std::vector<double> & works() const {return works_;};
+
+  /// Take a strain controlled step
+  int strain_step(const double * const e_np1, double t_np1, double T_np1);
+  /// Take a stress controlled step
+  int stress_step(const double * const s_np1, double t_np1, double T_np1);
+  /// Load in the stress direction sdir at a strain rate erate, returning
+  /// the strain increment and stress increment magnitude, optionally
+  /// starting from guesses for both
+  int erate_step(const double * const sdir, double erate, double t_np1,
+                 double T_np1, double * const einc, double & ainc,
+                 const double * const einc_guess = nullptr,
+                 const double * const ainc_guess = nullptr);
+  /// erate_step with a strain increment in place of the time increment
+  int erate_einc_step(const double * const sdir, double erate, double einc,
+                      double T_np1, double * const einc_out, double & ainc,
+                      const double * const einc_guess = nullptr,
+                      const double * const ainc_guess = nullptr);
+  /// Stress controlled step with a stress increment in place of the time
+  /// increment
+  int srate_sinc_step(const double * const sdir, double srate, double sinc,
+                      double T_np1);
+  /// Hold the strain in index i while holding the other stresses, with
+  /// follow up factor q (which needs the Young's modulus E)
+  int strain_hold_step(int i, double t_np1, double T_np1, double q = 1.0,
+                       double E = -1.0);
+
+ private:
+  typedef std::function<int(const double * const, double * const,
+                            double * const)> Residual;
+
+  void update_thermal_strain_(double T_np1, double * const enext) const;
+  int trial_(const double * const e_mech, double t_np1, double T_np1,
+             double * const s, double * const A);
+  int solve_(Residual RJ, int n, const double * const x0,
+             const std::vector<std::vector<double>> & extra,
+             double * const x) const;
+  int newton_(Residual RJ, int n, double * const x, bool linesearch) const;
+
+ private:
+  std::shared_ptr<NEMLModel> model_;
+  bool nts_;
+  double rtol_, atol_;
+  int miter_;
+
+  double e_[6], e_prev_[6], em_[6], eth_[6], s_[6];
+  std::vector<double> h_, h_trial_;
+  double T_, u_, p_;
+  std::vector<double> times_, energies_, works_;
+};
+
+/// Results of one of the loading programs: arrays, integer arrays,
+/// scalars, and flags, by name
+struct DriverResults {
+  std::map<std::string, std::vector<double>> arrays;
+  std::map<std::string, std::vector<int>> int_arrays;
+  std::map<std::string, double> scalars;
+  std::map<std::string, bool> flags;
+};
+
+/// Uniaxial stress/strain curve
+int uniaxial_test(std::shared_ptr<NEMLModel> model, double erate,
+                  DriverResults & res, double T = 300.0, double emax = 0.05,
+                  int nsteps = 250,
+                  std::vector<double> sdir = {1,0,0,0,0,0},
+                  double offset = 0.2/100.0,
+                  std::vector<double> history = {},
+                  std::vector<double> tdir = {0,1,0,0,0,0});
+
+/// Strain controlled cyclic test, with optional holds at the peaks
+int strain_cyclic(std::shared_ptr<NEMLModel> model, double emax, double R,
+                  double erate, int ncycles, DriverResults & res,
+                  double T = 300.0, int nsteps = 50,
+                  std::vector<double> sdir = {1,0,0,0,0,0},
+                  std::vector<double> hold_time = {0,0}, int n_hold = 25,
+                  bool check_dmg = false, double dtol = 0.75);
+
+/// Stress controlled cyclic test, with optional holds at the peaks
+int stress_cyclic(std::shared_ptr<NEMLModel> model, double smax, double R,
+                  double srate, int ncycles, DriverResults & res,
+                  double T = 300.0, int nsteps = 50,
+                  std::vector<double> sdir = {1,0,0,0,0,0},
+                  std::vector<double> hold_time = {0,0}, int n_hold = 10,
+                  double etol = 0.1);
+
+/// Stress relaxation test
+int stress_relaxation(std::shared_ptr<NEMLModel> model, double emax,
+                      double erate, double hold, DriverResults & res,
+                      double T = 300.0, int nsteps = 250, int nsteps_up = 50,
+                      int index = 0, double tc = 1.0, bool logspace = false,
+                      double q = 1.0);
+
+/// Creep test
+int creep(std::shared_ptr<NEMLModel> model, double smax, double srate,
+          double hold, DriverResults & res, double T = 300.0,
+          int nsteps = 250, int nsteps_up = 150,
+          std::vector<double> sdir = {1,0,0,0,0,0}, bool logspace = false,
+          std::vector<double> history = {}, double elimit = 1.0,
+          bool check_dmg = false, double dtol = 0.75);
+
+/// Drive a model with the strain and temperature history from a
+/// thermomechanical test
+int thermomechanical_strain_raw(std::shared_ptr<NEMLModel> model,
+                                const std::vector<double> & time,
+                                const std::vector<double> & temperature,
+                                const std::vector<double> & strain,
+                                DriverResults & res,
+                                std::vector<double> sdir = {1,0,0,0,0,0},
+                                int substep = 1);
+
+/// Uniaxial strain rate jump test (jumps at strains, if given, otherwise
+/// every e_per)
+int rate_jump_test(std::shared_ptr<NEMLModel> model,
+                   const std::vector<double> & erates, DriverResults & res,
+                   double T = 300.0, double e_per = 0.01,
+                   int nsteps_per = 100,
+                   std::vector<double> sdir = {1,0,0,0,0,0},
+                   std::vector<double> history = {},
+                   std::vector<double> strains = {});
+
+} // namespace neml
+
+#endif // CDRIVERS_H
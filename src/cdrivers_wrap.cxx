@@ -0,0 +1,305 @@
+#include "pyhelp.h" // include first to avoid annoying redef warning
+
+#include "cdrivers.h"
+
+namespace py = pybind11;
+
+PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>)
+
+namespace neml {
+
+namespace {
+
+// Hand a vector over to numpy without copying it
+template<class T> py::array_t<T> to_array(std::vector<T> && v)
+{
+  if (v.empty()) return alloc_vec<T>(0);
+  auto store = new std::vector<T>(std::move(v));
+  py::capsule owner(store, [](void * p)
+                    {delete static_cast<std::vector<T>*>(p);});
+  return py::array_t<T>(store->size(), store->data(), owner);
+}
+
+py::dict to_dict(DriverResults && res)
+{
+  py::dict d;
+  for (auto & a : res.arrays) d[a.first.c_str()] = to_array(std::move(a.second));
+  for (auto & a : res.int_arrays) {
+    d[a.first.c_str()] = to_array(std::move(a.second));
+  }
+  for (auto & s : res.scalars) d[s.first.c_str()] = s.second;
+  for (auto & f : res.flags) d[f.first.c_str()] = f.second;
+  return d;
+}
+
+// None for nothing, otherwise a sequence of numbers
+std::vector<double> optional_vector(py::object v)
+{
+  if (v.is_none()) return std::vector<double>();
+  return v.cast<std::vector<double>>();
+}
+
+// The hold times at the two peaks: None or zero to not hold, a scalar to
+// hold the same time at both, or one time for each peak
+std::vector<double> hold_times(py::object hold_time)
+{
+  if (hold_time.is_none()) return {0.0, 0.0};
+  if (py::isinstance<py::float_>(hold_time) ||
+      py::isinstance<py::int_>(hold_time) ||
+      py::hasattr(hold_time, "__float__")) {
+    double h = hold_time.cast<double>();
+    return {h, h};
+  }
+  return hold_time.cast<std::vector<double>>();
+}
+
+// Run one of the loading programs without the GIL
+template<class F> py::dict run(F f)
+{
+  DriverResults res;
+  int ier;
+  {
+    py::gil_scoped_release release;
+    ier = f(res);
+  }
+  py_error(ier);
+  return to_dict(std::move(res));
+}
+
+} // namespace
+
+PYBIND11_MODULE(cdrivers, m) {
+  py::module::import("neml.objects");
+  py::module::import("neml.models");
+
+  m.doc() = "Native versions of the loading programs in neml.drivers.";
+
+  py::class_<Driver_sd, std::shared_ptr<Driver_sd>>(m, "Driver_sd")
+      .def(py::init<std::shared_ptr<NEMLModel>, double, bool, double, double,
+           int>(), py::arg("model"), py::arg("T_init") = 0.0,
+           py::arg("no_thermal_strain") = false, py::arg("rtol") = 1.0e-6,
+           py::arg("atol") = 1.0e-10, py::arg("miter") = 25)
+      .def_property_readonly("strain",
+           [](const Driver_sd & d) -> py::array_t<double>
+           {
+            return py::array_t<double>(6, d.strain());
+           }, "Current total strain.")
+      .def_property_readonly("thermal_strain",
+           [](const Driver_sd & d) -> py::array_t<double>
+           {
+            return py::array_t<double>(6, d.thermal_strain());
+           }, "Current thermal strain.")
+      .def_property_readonly("stress",
+           [](const Driver_sd & d) -> py::array_t<double>
+           {
+            return py::array_t<double>(6, d.stress());
+           }, "Current stress.")
+      .def_property_readonly("history",
+           [](const Driver_sd & d) -> py::array_t<double>
+           {
+            return py::array_t<double>(d.history().size(),
+                                       d.history().data());
+           }, "Current history.")
+      .def_property_readonly("T", &Driver_sd::T, "Current temperature.")
+      .def_property_readonly("t",
+           [](const Driver_sd & d) -> py::array_t<double>
+           {
+            return py::array_t<double>(d.times().size(), d.times().data());
+           }, "Time of each state.")
+      .def_property_readonly("u",
+           [](const Driver_sd & d) -> py::array_t<double>
+           {
+            return py::array_t<double>(d.energies().size(),
+                                       d.energies().data());
+           }, "Energy density of each state.")
+      .def_property_readonly("p",
+           [](const Driver_sd & d) -> py::array_t<double>
+           {
+            return py::array_t<double>(d.works().size(), d.works().data());
+           }, "Plastic work of each state.")
+      .def("strain_step",
+           [](Driver_sd & d, py::array_t<double, py::array::c_style> e_np1,
+              double t_np1, double T_np1)
+           {
+            check_shape<double>(e_np1, {6}, "e_np1");
+            py_error(d.strain_step(arr2ptr<double>(e_np1), t_np1, T_np1));
+           }, "Take a strain controlled step.")
+      .def("stress_step",
+           [](Driver_sd & d, py::array_t<double, py::array::c_style> s_np1,
+              double t_np1, double T_np1)
+           {
+            check_shape<double>(s_np1, {6}, "s_np1");
+            py_error(d.stress_step(arr2ptr<double>(s_np1), t_np1, T_np1));
+           }, "Take a stress controlled step.")
+      .def("erate_step",
+           [](Driver_sd & d, py::array_t<double, py::array::c_style> sdir,
+              double erate, double t_np1, double T_np1,
+              py::object einc_guess, py::object ainc_guess) -> py::tuple
+           {
+            check_shape<double>(sdir, {6}, "sdir");
+            std::vector<double> eg = optional_vector(einc_guess);
+            if (not eg.empty() && eg.size() != 6) {
+              throw std::invalid_argument(
+                  "einc_guess should have 6 components");
+            }
+            double ag = ainc_guess.is_none() ? 0.0 :
+                ainc_guess.cast<double>();
+            auto einc = alloc_vec<double>(6);
+            double ainc;
+            py_error(d.erate_step(arr2ptr<double>(sdir), erate, t_np1,
+                                  T_np1, arr2ptr<double>(einc), ainc,
+                                  eg.empty() ? nullptr : &eg[0],
+                                  ainc_guess.is_none() ? nullptr : &ag));
+            return py::make_tuple(einc, ainc);
+           }, "Load in a stress direction at a strain rate.",
+           py::arg("sdir"), py::arg("erate"), py::arg("t_np1"),
+           py::arg("T_np1"), py::arg("einc_guess") = py::none(),
+           py::arg("ainc_guess") = py::none())
+      .def("srate_sinc_step",
+           [](Driver_sd & d, py::array_t<double, py::array::c_style> sdir,
+              double srate, double sinc, double T_np1)
+           {
+            check_shape<double>(sdir, {6}, "sdir");
+            py_error(d.srate_sinc_step(arr2ptr<double>(sdir), srate, sinc,
+                                       T_np1));
+           }, "Stress controlled step by a stress increment.")
+      .def("strain_hold_step",
+           [](Driver_sd & d, int i, double t_np1, double T_np1, double q,
+              double E)
+           {
+            py_error(d.strain_hold_step(i, t_np1, T_np1, q, E));
+           }, "Hold the strain in one component and the other stresses.",
+           py::arg("i"), py::arg("t_np1"), py::arg("T_np1"),
+           py::arg("q") = 1.0, py::arg("E") = -1.0)
+      ;
+
+  m.def("uniaxial_test",
+        [](std::shared_ptr<NEMLModel> model, double erate, double T,
+           double emax, int nsteps, std::vector<double> sdir, bool verbose,
+           double offset, py::object history,
+           std::vector<double> tdir) -> py::dict
+        {
+          std::vector<double> h = optional_vector(history);
+          return run([&](DriverResults & res) {
+            return uniaxial_test(model, erate, res, T, emax, nsteps, sdir,
+                                 offset, h, tdir);
+          });
+        }, "Make a uniaxial stress/strain curve.",
+        py::arg("model"), py::arg("erate"), py::arg("T") = 300.0,
+        py::arg("emax") = 0.05, py::arg("nsteps") = 250,
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("verbose") = false, py::arg("offset") = 0.2/100.0,
+        py::arg("history") = py::none(),
+        py::arg("tdir") = std::vector<double>({0,1,0,0,0,0}));
+
+  m.def("strain_cyclic",
+        [](std::shared_ptr<NEMLModel> model, double emax, double R,
+           double erate, int ncycles, double T, int nsteps,
+           std::vector<double> sdir, py::object hold_time, int n_hold,
+           bool verbose, bool check_dmg, double dtol) -> py::dict
+        {
+          std::vector<double> ht = hold_times(hold_time);
+          return run([&](DriverResults & res) {
+            return strain_cyclic(model, emax, R, erate, ncycles, res, T,
+                                 nsteps, sdir, ht, n_hold, check_dmg, dtol);
+          });
+        }, "Strain controlled cyclic test.",
+        py::arg("model"), py::arg("emax"), py::arg("R"), py::arg("erate"),
+        py::arg("ncycles"), py::arg("T") = 300.0, py::arg("nsteps") = 50,
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("hold_time") = py::none(), py::arg("n_hold") = 25,
+        py::arg("verbose") = false, py::arg("check_dmg") = false,
+        py::arg("dtol") = 0.75);
+
+  m.def("stress_cyclic",
+        [](std::shared_ptr<NEMLModel> model, double smax, double R,
+           double srate, int ncycles, double T, int nsteps,
+           std::vector<double> sdir, py::object hold_time, int n_hold,
+           bool verbose, double etol) -> py::dict
+        {
+          std::vector<double> ht = hold_times(hold_time);
+          return run([&](DriverResults & res) {
+            return stress_cyclic(model, smax, R, srate, ncycles, res, T,
+                                 nsteps, sdir, ht, n_hold, etol);
+          });
+        }, "Stress controlled cyclic test.",
+        py::arg("model"), py::arg("smax"), py::arg("R"), py::arg("srate"),
+        py::arg("ncycles"), py::arg("T") = 300.0, py::arg("nsteps") = 50,
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("hold_time") = py::none(), py::arg("n_hold") = 10,
+        py::arg("verbose") = false, py::arg("etol") = 0.1);
+
+  m.def("stress_relaxation",
+        [](std::shared_ptr<NEMLModel> model, double emax, double erate,
+           double hold, double T, int nsteps, int nsteps_up, int index,
+           double tc, bool verbose, bool logspace, double q) -> py::dict
+        {
+          return run([&](DriverResults & res) {
+            return stress_relaxation(model, emax, erate, hold, res, T,
+                                     nsteps, nsteps_up, index, tc, logspace,
+                                     q);
+          });
+        }, "Simulate a stress relaxation test.",
+        py::arg("model"), py::arg("emax"), py::arg("erate"),
+        py::arg("hold"), py::arg("T") = 300.0, py::arg("nsteps") = 250,
+        py::arg("nsteps_up") = 50, py::arg("index") = 0,
+        py::arg("tc") = 1.0, py::arg("verbose") = false,
+        py::arg("logspace") = false, py::arg("q") = 1.0);
+
+  m.def("creep",
+        [](std::shared_ptr<NEMLModel> model, double smax, double srate,
+           double hold, double T, int nsteps, int nsteps_up,
+           std::vector<double> sdir, bool verbose, bool logspace,
+           py::object history, double elimit, bool check_dmg,
+           double dtol) -> py::dict
+        {
+          std::vector<double> h = optional_vector(history);
+          return run([&](DriverResults & res) {
+            return creep(model, smax, srate, hold, res, T, nsteps, nsteps_up,
+                         sdir, logspace, h, elimit, check_dmg, dtol);
+          });
+        }, "Simulate a creep test.",
+        py::arg("model"), py::arg("smax"), py::arg("srate"),
+        py::arg("hold"), py::arg("T") = 300.0, py::arg("nsteps") = 250,
+        py::arg("nsteps_up") = 150,
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("verbose") = false, py::arg("logspace") = false,
+        py::arg("history") = py::none(), py::arg("elimit") = 1.0,
+        py::arg("check_dmg") = false, py::arg("dtol") = 0.75);
+
+  m.def("thermomechanical_strain_raw",
+        [](std::shared_ptr<NEMLModel> model, std::vector<double> time,
+           std::vector<double> temperature, std::vector<double> strain,
+           std::vector<double> sdir, bool verbose, int substep) -> py::dict
+        {
+          return run([&](DriverResults & res) {
+            return thermomechanical_strain_raw(model, time, temperature,
+                                               strain, res, sdir, substep);
+          });
+        }, "Drive a model with the strain and temperature history of a "
+        "thermomechanical test.",
+        py::arg("model"), py::arg("time"), py::arg("temperature"),
+        py::arg("strain"),
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("verbose") = false, py::arg("substep") = 1);
+
+  m.def("rate_jump_test",
+        [](std::shared_ptr<NEMLModel> model, std::vector<double> erates,
+           double T, double e_per, int nsteps_per, std::vector<double> sdir,
+           bool verbose, py::object history, py::object strains) -> py::dict
+        {
+          std::vector<double> h = optional_vector(history);
+          std::vector<double> jumps = optional_vector(strains);
+          return run([&](DriverResults & res) {
+            return rate_jump_test(model, erates, res, T, e_per, nsteps_per,
+                                  sdir, h, jumps);
+          });
+        }, "Model a uniaxial strain rate jump test.",
+        py::arg("model"), py::arg("erates"), py::arg("T") = 300.0,
+        py::arg("e_per") = 0.01, py::arg("nsteps_per") = 100,
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("verbose") = false, py::arg("history") = py::none(),
+        py::arg("strains") = py::none());
+}
+
+} // namespace neml
@@ -0,0 +1,1840 @@
+#ifndef COMPOSE_H
+#define COMPOSE_H
+
+#include "objects.h"
+#include "models.h"
+#include "interpolate.h"
+#include "elasticity.h"
+#include "nemlerror.h"
+#include "mandel.h"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Compile time model composition.
+//
+// Host codes that know their material model at build time can write the
+// model as a template expression, for example
+//
+//    compose::Integrator<compose::TVP<compose::ChabocheFlow<
+//        compose::IsoKinJ2, compose::Chaboche<compose::Voce, 3>>>>
+//
+// and get a stress update with fixed array sizes and no virtual dispatch
+// or shared_ptr indirection inside the Newton iterations.
+//
+// Each component reads its parameters from the ParameterSet of the
+// matching runtime object (same names, same nested objects), so the same
+// XML or Python definitions drive both versions and they give the same
+// results.  Temperature dependent parameters (Interpolates) are evaluated
+// once per step into a plain Props struct.
+//
+// Component concepts (all methods are const and inline):
+//    isotropic hardening: q, dq_da
+//    yield surface: f and its first and second derivatives wrt s and q
+//    hardening: q, dq_da, h, h_time, h_temp and their derivatives
+//    viscoplastic flow: y, g, h (with time/temperature parts) and derivatives
+//    general flow rule: s, a and their derivatives, work_rate
+// mirroring the interfaces in hardening.h, surfaces.h, visco_flow.h,
+// and general_flow.h.
+
+namespace neml {
+
+namespace compose {
+
+/// Get the recorded ParameterSet for a nested object parameter and check
+/// that it has the type the template component expects
+inline ParameterSet nested_parameters(const std::shared_ptr<NEMLObject> & obj,
+                                      const std::string & type)
+{
+  if (obj == nullptr || obj->parameter_set() == nullptr) {
+    throw std::invalid_argument("Object of expected type " + type +
+                                " was not created through the Factory");
+  }
+  ParameterSet params = *obj->parameter_set();
+  if (params.type() != type) {
+    throw std::invalid_argument("Expected an object of type " + type +
+                                " but got " + params.type());
+  }
+  return params;
+}
+
+/// Nested object parameter by name
+inline ParameterSet nested_parameters(ParameterSet & params,
+                                      const std::string & name,
+                                      const std::string & type)
+{
+  return nested_parameters(
+      params.get_parameter<std::shared_ptr<NEMLObject>>(name), type);
+}
+
+/// Fixed length vector of Interpolates
+template <int N>
+std::array<std::shared_ptr<Interpolate>,N> interpolate_array(
+    ParameterSet & params, const std::string & name)
+{
+  auto vec = params.get_object_parameter_vector<Interpolate>(name);
+  if (vec.size() != N) {
+    throw std::invalid_argument("Parameter " + name + " has the wrong length");
+  }
+  std::array<std::shared_ptr<Interpolate>,N> res;
+  std::copy(vec.begin(), vec.end(), res.begin());
+  return res;
+}
+
+// Isotropic hardening
+
+/// Voce isotropic hardening, matches VoceIsotropicHardeningRule
+class Voce {
+ public:
+  static const int nhist = 1;
+  struct Props {
+    double s0, R, d;
+  };
+
+  static std::string type() {return "VoceIsotropicHardeningRule";};
+
+  explicit Voce(ParameterSet & params) :
+      s0_(params.get_object_parameter<Interpolate>("s0")),
+      R_(params.get_object_parameter<Interpolate>("R")),
+      d_(params.get_object_parameter<Interpolate>("d"))
+  {
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.s0 = s0_->value(T);
+    p.R = R_->value(T);
+    p.d = d_->value(T);
+    return p;
+  };
+
+  double q(const Props & p, double alpha) const
+  {
+    return -p.s0 - p.R * (1.0 - std::exp(-p.d * alpha));
+  };
+
+  double dq_da(const Props & p, double alpha) const
+  {
+    return -p.d * p.R * std::exp(-p.d * alpha);
+  };
+
+ private:
+  std::shared_ptr<Interpolate> s0_, R_, d_;
+};
+
+/// Linear isotropic hardening, matches LinearIsotropicHardeningRule
+class LinearIso {
+ public:
+  static const int nhist = 1;
+  struct Props {
+    double s0, K;
+  };
+
+  static std::string type() {return "LinearIsotropicHardeningRule";};
+
+  explicit LinearIso(ParameterSet & params) :
+      s0_(params.get_object_parameter<Interpolate>("s0")),
+      K_(params.get_object_parameter<Interpolate>("K"))
+  {
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.s0 = s0_->value(T);
+    p.K = K_->value(T);
+    return p;
+  };
+
+  double q(const Props & p, double alpha) const
+  {
+    return -p.s0 - p.K * alpha;
+  };
+
+  double dq_da(const Props & p, double alpha) const
+  {
+    return -p.K;
+  };
+
+ private:
+  std::shared_ptr<Interpolate> s0_, K_;
+};
+
+// Kinematic hardening
+
+/// Linear kinematic hardening, matches LinearKinematicHardeningRule
+class LinearKin {
+ public:
+  static const int nhist = 6;
+  struct Props {
+    double H;
+  };
+
+  static std::string type() {return "LinearKinematicHardeningRule";};
+
+  explicit LinearKin(ParameterSet & params) :
+      H_(params.get_object_parameter<Interpolate>("H"))
+  {
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.H = H_->value(T);
+    return p;
+  };
+
+  void q(const Props & p, const double * const alpha, double * const qv) const
+  {
+    for (int i=0; i<6; i++) qv[i] = -p.H * alpha[i];
+  };
+
+  /// Diagonal of dq_da
+  double dq_da(const Props & p) const
+  {
+    return -p.H;
+  };
+
+ private:
+  std::shared_ptr<Interpolate> H_;
+};
+
+// Associative hardening models
+
+/// Combined isotropic and kinematic hardening, matches CombinedHardeningRule
+template <class Iso, class Kin>
+class Combined {
+ public:
+  static const int nhist = Iso::nhist + Kin::nhist;
+  static const int nq = nhist;
+  struct Props {
+    typename Iso::Props iso;
+    typename Kin::Props kin;
+  };
+
+  static std::string type() {return "CombinedHardeningRule";};
+
+  explicit Combined(ParameterSet & params) :
+      iso_(init_<Iso>(params, "iso")),
+      kin_(init_<Kin>(params, "kin"))
+  {
+    static_assert(Iso::nhist == 1, "Isotropic hardening must have one variable");
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.iso = iso_.props(T);
+    p.kin = kin_.props(T);
+    return p;
+  };
+
+  void init_hist(double * const alpha) const
+  {
+    fixed::zero<nhist>(alpha);
+  };
+
+  void q(const Props & p, const double * const alpha, double * const qv) const
+  {
+    qv[0] = iso_.q(p.iso, alpha[0]);
+    kin_.q(p.kin, &alpha[1], &qv[1]);
+  };
+
+  /// nq x nhist
+  void dq_da(const Props & p, const double * const alpha,
+             double * const dq) const
+  {
+    fixed::zero<nq*nhist>(dq);
+    dq[0] = iso_.dq_da(p.iso, alpha[0]);
+    for (int i=1; i<nhist; i++) dq[i*nhist+i] = kin_.dq_da(p.kin);
+  };
+
+ private:
+  template <class C>
+  static C init_(ParameterSet & params, const std::string & name)
+  {
+    ParameterSet np = nested_parameters(params, name, C::type());
+    return C(np);
+  }
+
+ private:
+  Iso iso_;
+  Kin kin_;
+};
+
+// Gamma models for the Chaboche backstresses
+
+/// Constant gamma, matches ConstantGamma
+class ConstantGamma {
+ public:
+  struct Props {
+    double g;
+  };
+
+  static std::string type() {return "ConstantGamma";};
+
+  explicit ConstantGamma(ParameterSet & params) :
+      g_(params.get_object_parameter<Interpolate>("g"))
+  {
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.g = g_->value(T);
+    return p;
+  };
+
+  double gamma(const Props & p, double ep) const {return p.g;};
+  double dgamma(const Props & p, double ep) const {return 0.0;};
+
+ private:
+  std::shared_ptr<Interpolate> g_;
+};
+
+/// Saturating gamma, matches SatGamma
+class SatGamma {
+ public:
+  struct Props {
+    double gs, g0, beta;
+  };
+
+  static std::string type() {return "SatGamma";};
+
+  explicit SatGamma(ParameterSet & params) :
+      gs_(params.get_object_parameter<Interpolate>("gs")),
+      g0_(params.get_object_parameter<Interpolate>("g0")),
+      beta_(params.get_object_parameter<Interpolate>("beta"))
+  {
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.gs = gs_->value(T);
+    p.g0 = g0_->value(T);
+    p.beta = beta_->value(T);
+    return p;
+  };
+
+  double gamma(const Props & p, double ep) const
+  {
+    return p.gs + (p.g0 - p.gs) * std::exp(-p.beta * ep);
+  };
+
+  double dgamma(const Props & p, double ep) const
+  {
+    return p.beta * (p.gs - p.g0) * std::exp(-p.beta * ep);
+  };
+
+ private:
+  std::shared_ptr<Interpolate> gs_, g0_, beta_;
+};
+
+// Yield surfaces
+
+/// Combined isotropic/kinematic J2 surface, matches IsoKinJ2
+class IsoKinJ2 {
+ public:
+  static const int nq = 7;
+
+  static std::string type() {return "IsoKinJ2";};
+
+  explicit IsoKinJ2(ParameterSet & params)
+  {
+  };
+
+  double f(const double * const s, const double * const q) const
+  {
+    double n[6];
+    shifted_(s, q, n);
+    return fixed::norm2<6>(n) + std::sqrt(2.0/3.0) * q[0];
+  };
+
+  void df_ds(const double * const s, const double * const q,
+             double * const df) const
+  {
+    shifted_(s, q, df);
+    normalize_(df);
+  };
+
+  void df_dq(const double * const s, const double * const q,
+             double * const df) const
+  {
+    df[0] = std::sqrt(2.0/3.0);
+    df_ds(s, q, &df[1]);
+  };
+
+  /// 6 x 6
+  void df_dsds(const double * const s, const double * const q,
+               double * const ddf) const
+  {
+    proj_(s, q, true, ddf);
+  };
+
+  /// 6 x nq
+  void df_dsdq(const double * const s, const double * const q,
+               double * const ddf) const
+  {
+    double ss[36];
+    proj_(s, q, false, ss);
+    for (int i=0; i<6; i++) {
+      ddf[i*nq] = 0.0;
+      for (int j=0; j<6; j++) ddf[i*nq+j+1] = ss[i*6+j];
+    }
+  };
+
+  /// nq x 6
+  void df_dqds(const double * const s, const double * const q,
+               double * const ddf) const
+  {
+    double ss[36];
+    proj_(s, q, true, ss);
+    fixed::zero<6>(ddf);
+    fixed::copy<36>(ss, &ddf[6]);
+  };
+
+  /// nq x nq
+  void df_dqdq(const double * const s, const double * const q,
+               double * const ddf) const
+  {
+    double ss[36];
+    proj_(s, q, false, ss);
+    fixed::zero<nq*nq>(ddf);
+    for (int i=0; i<6; i++) {
+      for (int j=0; j<6; j++) ddf[(i+1)*nq+j+1] = ss[i*6+j];
+    }
+  };
+
+ private:
+  void shifted_(const double * const s, const double * const q,
+                double * const n) const
+  {
+    fixed::dev(s, n);
+    fixed::add<6>(n, &q[1], n);
+  };
+
+  void normalize_(double * const n) const
+  {
+    double nv = fixed::norm2<6>(n);
+    if (std::fabs(nv) < std::numeric_limits<double>::epsilon()) {
+      fixed::zero<6>(n);
+    }
+    else {
+      for (int i=0; i<6; i++) n[i] /= nv;
+    }
+  };
+
+  // (I - [dev] - n x n) / |n|, the dev part only on request
+  void proj_(const double * const s, const double * const q, bool dev,
+             double * const P) const
+  {
+    double n[6];
+    shifted_(s, q, n);
+    double nv = fixed::norm2<6>(n);
+    normalize_(n);
+    fixed::zero<36>(P);
+    if (nv > 0.0) {
+      for (int i=0; i<6; i++) P[i*6+i] += 1.0;
+      if (dev) {
+        for (int i=0; i<3; i++) {
+          for (int j=0; j<3; j++) P[i*6+j] -= 1.0 / 3.0;
+        }
+      }
+      fixed::outer_update<6,6>(-1.0, n, n, P);
+      for (int i=0; i<36; i++) P[i] /= nv;
+    }
+  };
+};
+
+// Hardening models (non-associative)
+
+/// Chaboche hardening with NB backstresses and no static recovery
+/// skipping, matches Chaboche
+template <class Iso, int NB, class Gamma = ConstantGamma>
+class Chaboche {
+ public:
+  static const int nhist = 1 + 6 * NB;
+  static const int nq = 7;
+  struct Props {
+    typename Iso::Props iso;
+    std::array<typename Gamma::Props,NB> gamma;
+    double c[NB], dc[NB], A[NB], a[NB];
+  };
+
+  static std::string type() {return "Chaboche";};
+
+  explicit Chaboche(ParameterSet & params) :
+      iso_(init_iso_(params)),
+      gammas_(init_gammas_(params)),
+      c_(interpolate_array<NB>(params, "C")),
+      A_(interpolate_array<NB>(params, "A")),
+      a_(interpolate_array<NB>(params, "a")),
+      noniso_(params.get_parameter<bool>("noniso"))
+  {
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.iso = iso_.props(T);
+    for (int i=0; i<NB; i++) {
+      p.gamma[i] = gammas_[i].props(T);
+      p.c[i] = c_[i]->value(T);
+      p.dc[i] = c_[i]->derivative(T);
+      p.A[i] = A_[i]->value(T);
+      p.a[i] = a_[i]->value(T);
+    }
+    return p;
+  };
+
+  void init_hist(double * const alpha) const
+  {
+    fixed::zero<nhist>(alpha);
+  };
+
+  void q(const Props & p, const double * const alpha, double * const qv) const
+  {
+    qv[0] = iso_.q(p.iso, alpha[0]);
+    backstress_(alpha, &qv[1]);
+  };
+
+  /// nq x nhist
+  void dq_da(const Props & p, const double * const alpha,
+             double * const dq) const
+  {
+    fixed::zero<nq*nhist>(dq);
+    dq[0] = iso_.dq_da(p.iso, alpha[0]);
+    for (int i=0; i<NB; i++) {
+      for (int j=0; j<6; j++) dq[(j+1)*nhist+1+i*6+j] = 1.0;
+    }
+  };
+
+  void h(const Props & p, const double * const s, const double * const alpha,
+         double * const hv) const
+  {
+    hv[0] = std::sqrt(2.0/3.0);
+    double n[6];
+    direction_(s, alpha, n);
+    for (int i=0; i<NB; i++) {
+      double g = gammas_[i].gamma(p.gamma[i], alpha[0]);
+      for (int j=0; j<6; j++) {
+        hv[1+i*6+j] = -2.0 / 3.0 * p.c[i] * n[j] - std::sqrt(2.0/3.0) * g *
+            alpha[1+i*6+j];
+      }
+    }
+  };
+
+  /// nhist x 6
+  void dh_ds(const Props & p, const double * const s,
+             const double * const alpha, double * const dhv) const
+  {
+    fixed::zero<nhist*6>(dhv);
+    double nn[36];
+    proj_(s, alpha, true, nn);
+    for (int i=0; i<NB; i++) {
+      for (int j=0; j<6; j++) {
+        for (int k=0; k<6; k++) {
+          dhv[(1+i*6+j)*6+k] = -2.0 / 3.0 * p.c[i] * nn[j*6+k];
+        }
+      }
+    }
+  };
+
+  /// nhist x nhist
+  void dh_da(const Props & p, const double * const s,
+             const double * const alpha, double * const dhv) const
+  {
+    fixed::zero<nhist*nhist>(dhv);
+    double ss[36];
+    proj_(s, alpha, false, ss);
+
+    for (int i=0; i<NB; i++) {
+      double g = gammas_[i].gamma(p.gamma[i], alpha[0]);
+      for (int j=0; j<6; j++) {
+        dhv[(1+i*6+j)*nhist+1+i*6+j] -= std::sqrt(2.0/3.0) * g;
+      }
+    }
+
+    for (int bi=0; bi<NB; bi++) {
+      for (int i=0; i<6; i++) {
+        for (int bj=0; bj<NB; bj++) {
+          for (int j=0; j<6; j++) {
+            dhv[(1+bi*6+i)*nhist+1+bj*6+j] -= 2.0 / 3.0 * p.c[bi] *
+                ss[i*6+j];
+          }
+        }
+      }
+    }
+
+    for (int i=0; i<NB; i++) {
+      double dg = gammas_[i].dgamma(p.gamma[i], alpha[0]);
+      for (int j=0; j<6; j++) {
+        dhv[(1+i*6+j)*nhist] = -std::sqrt(2.0/3.0) * dg * alpha[1+i*6+j];
+      }
+    }
+  };
+
+  void h_time(const Props & p, const double * const s,
+              const double * const alpha, double * const hv) const
+  {
+    fixed::zero<nhist>(hv);
+    for (int i=0; i<NB; i++) {
+      double nX = fixed::norm2<6>(&alpha[1+i*6]);
+      for (int j=0; j<6; j++) {
+        hv[1+i*6+j] = -p.A[i] * std::sqrt(3.0/2.0) *
+            std::pow(nX, p.a[i] - 1.0) * alpha[1+i*6+j];
+      }
+    }
+  };
+
+  void dh_ds_time(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    fixed::zero<nhist*6>(dhv);
+  };
+
+  void dh_da_time(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    fixed::zero<nhist*nhist>(dhv);
+    for (int i=0; i<NB; i++) {
+      double X[6];
+      fixed::copy<6>(&alpha[1+i*6], X);
+      double nX = fixed::norm2<6>(X);
+      if (std::fabs(nX) < std::numeric_limits<double>::epsilon()) {
+        fixed::zero<6>(X);
+      }
+      else {
+        for (int j=0; j<6; j++) X[j] /= nX;
+      }
+      double f = -p.A[i] * std::sqrt(3.0/2.0) * std::pow(nX, p.a[i]-1.0);
+      for (int j=0; j<6; j++) {
+        int ia = 1 + i*6 + j;
+        for (int k=0; k<6; k++) {
+          int ib = 1 + i*6 + k;
+          double d = (j == k) ? 1.0 : 0.0;
+          dhv[ia*nhist+ib] = f * (d + (p.a[i] - 1.0) * X[j] * X[k]);
+        }
+      }
+    }
+  };
+
+  void h_temp(const Props & p, const double * const s,
+              const double * const alpha, double * const hv) const
+  {
+    fixed::zero<nhist>(hv);
+    if (!noniso_) return;
+    for (int i=0; i<NB; i++) {
+      if (p.c[i] == 0.0) continue;
+      for (int j=0; j<6; j++) {
+        hv[1+i*6+j] = -std::sqrt(2.0/3.0) * p.dc[i] / p.c[i] *
+            alpha[1+i*6+j];
+      }
+    }
+  };
+
+  void dh_ds_temp(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    fixed::zero<nhist*6>(dhv);
+  };
+
+  void dh_da_temp(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    fixed::zero<nhist*nhist>(dhv);
+    if (!noniso_) return;
+    for (int i=0; i<NB; i++) {
+      if (p.c[i] == 0.0) continue;
+      for (int j=0; j<6; j++) {
+        int ci = 1 + i*6 + j;
+        dhv[ci*nhist+ci] = -std::sqrt(2.0/3.0) * p.dc[i] / p.c[i];
+      }
+    }
+  };
+
+ private:
+  static Iso init_iso_(ParameterSet & params)
+  {
+    ParameterSet ip = nested_parameters(params, "iso", Iso::type());
+    return Iso(ip);
+  };
+
+  static std::vector<Gamma> init_gammas_(ParameterSet & params)
+  {
+    auto objs = params.get_parameter<std::vector<std::shared_ptr<NEMLObject>>>(
+        "gmodels");
+    if (objs.size() != NB) {
+      throw std::invalid_argument("Parameter gmodels has the wrong length");
+    }
+    std::vector<Gamma> res;
+    for (auto & obj : objs) {
+      ParameterSet gp = nested_parameters(obj, Gamma::type());
+      res.push_back(Gamma(gp));
+    }
+    return res;
+  };
+
+  void backstress_(const double * const alpha, double * const X) const
+  {
+    fixed::zero<6>(X);
+    for (int i=0; i<NB; i++) {
+      fixed::add<6>(X, &alpha[1+i*6], X);
+    }
+  };
+
+  void direction_(const double * const s, const double * const alpha,
+                  double * const n) const
+  {
+    double X[6];
+    backstress_(alpha, X);
+    fixed::dev(s, n);
+    fixed::add<6>(n, X, n);
+    double nv = fixed::norm2<6>(n);
+    if (std::fabs(nv) < std::numeric_limits<double>::epsilon()) {
+      fixed::zero<6>(n);
+    }
+    else {
+      for (int i=0; i<6; i++) n[i] /= nv;
+    }
+  };
+
+  void proj_(const double * const s, const double * const alpha, bool dev,
+             double * const P) const
+  {
+    double X[6], n[6];
+    backstress_(alpha, X);
+    fixed::dev(s, n);
+    fixed::add<6>(n, X, n);
+    double nv = fixed::norm2<6>(n);
+    direction_(s, alpha, n);
+    fixed::zero<36>(P);
+    for (int i=0; i<6; i++) P[i*6+i] += 1.0;
+    if (dev) {
+      for (int i=0; i<3; i++) {
+        for (int j=0; j<3; j++) P[i*6+j] -= 1.0 / 3.0;
+      }
+    }
+    fixed::outer_update<6,6>(-1.0, n, n, P);
+    for (int i=0; i<36; i++) P[i] /= nv;
+  };
+
+ private:
+  Iso iso_;
+  std::vector<Gamma> gammas_;
+  std::array<std::shared_ptr<Interpolate>,NB> c_, A_, a_;
+  bool noniso_;
+};
+
+// Perzyna rate functions
+
+/// Power law rate function, matches GPowerLaw
+class GPowerLaw {
+ public:
+  struct Props {
+    double n, eta;
+  };
+
+  static std::string type() {return "GPowerLaw";};
+
+  explicit GPowerLaw(ParameterSet & params) :
+      n_(params.get_object_parameter<Interpolate>("n")),
+      eta_(params.get_object_parameter<Interpolate>("eta"))
+  {
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.n = n_->value(T);
+    p.eta = eta_->value(T);
+    return p;
+  };
+
+  double g(const Props & p, double f) const
+  {
+    return std::pow(f / p.eta, p.n);
+  };
+
+  double dg(const Props & p, double f) const
+  {
+    return p.n * std::pow(f / p.eta, p.n - 1.0) / p.eta;
+  };
+
+ private:
+  std::shared_ptr<Interpolate> n_, eta_;
+};
+
+// Fluidity models
+
+/// Constant fluidity, matches ConstantFluidity
+class ConstantFluidity {
+ public:
+  struct Props {
+    double eta;
+  };
+
+  static std::string type() {return "ConstantFluidity";};
+
+  explicit ConstantFluidity(ParameterSet & params) :
+      eta_(params.get_object_parameter<Interpolate>("eta"))
+  {
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.eta = eta_->value(T);
+    return p;
+  };
+
+  double eta(const Props & p, double a) const {return p.eta;};
+  double deta(const Props & p, double a) const {return 0.0;};
+
+ private:
+  std::shared_ptr<Interpolate> eta_;
+};
+
+/// Saturating fluidity, matches SaturatingFluidity
+class SaturatingFluidity {
+ public:
+  struct Props {
+    double K0, A, b;
+  };
+
+  static std::string type() {return "SaturatingFluidity";};
+
+  explicit SaturatingFluidity(ParameterSet & params) :
+      K0_(params.get_object_parameter<Interpolate>("K0")),
+      A_(params.get_object_parameter<Interpolate>("A")),
+      b_(params.get_object_parameter<Interpolate>("b"))
+  {
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.K0 = K0_->value(T);
+    p.A = A_->value(T);
+    p.b = b_->value(T);
+    return p;
+  };
+
+  double eta(const Props & p, double a) const
+  {
+    return p.K0 + p.A * (1.0 - std::exp(-p.b * a));
+  };
+
+  double deta(const Props & p, double a) const
+  {
+    return p.A * p.b * std::exp(-p.b * a);
+  };
+
+ private:
+  std::shared_ptr<Interpolate> K0_, A_, b_;
+};
+
+// Viscoplastic flow rules
+
+/// Chaboche viscoplastic flow, matches ChabocheFlowRule
+template <class Surface, class Hardening, class Fluidity = ConstantFluidity>
+class ChabocheFlow {
+ public:
+  static const int nhist = Hardening::nhist;
+  static const int nq = Hardening::nq;
+  struct Props {
+    typename Hardening::Props hard;
+    typename Fluidity::Props fluid;
+    double n;
+  };
+
+  static std::string type() {return "ChabocheFlowRule";};
+
+  explicit ChabocheFlow(ParameterSet & params) :
+      surface_(init_<Surface>(params, "surface")),
+      hardening_(init_<Hardening>(params, "hardening")),
+      fluidity_(init_<Fluidity>(params, "fluidity")),
+      n_(params.get_object_parameter<Interpolate>("n"))
+  {
+    static_assert(Surface::nq == Hardening::nq,
+                  "Surface and hardening are not compatible");
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.hard = hardening_.props(T);
+    p.fluid = fluidity_.props(T);
+    p.n = n_->value(T);
+    return p;
+  };
+
+  void init_hist(double * const h) const
+  {
+    hardening_.init_hist(h);
+  };
+
+  double y(const Props & p, const double * const s,
+           const double * const alpha) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    double fv = surface_.f(s, q);
+    if (fv > 0.0) {
+      double eta = std::sqrt(2.0/3.0) * fluidity_.eta(p.fluid, alpha[0]);
+      return std::sqrt(3.0/2.0) * std::pow(fv/eta, p.n);
+    }
+    return 0.0;
+  };
+
+  void dy_ds(const Props & p, const double * const s,
+             const double * const alpha, double * const dyv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    double fv = surface_.f(s, q);
+    fixed::zero<6>(dyv);
+    if (fv > 0.0) {
+      surface_.df_ds(s, q, dyv);
+      double eta = std::sqrt(2.0/3.0) * fluidity_.eta(p.fluid, alpha[0]);
+      double mv = std::sqrt(3.0/2.0) * std::pow(fv/eta, p.n - 1.0) * p.n / eta;
+      for (int i=0; i<6; i++) dyv[i] *= mv;
+    }
+  };
+
+  void dy_da(const Props & p, const double * const s,
+             const double * const alpha, double * const dyv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    double fv = surface_.f(s, q);
+    fixed::zero<nhist>(dyv);
+    if (fv > 0.0) {
+      double jac[nq*nhist];
+      hardening_.dq_da(p.hard, alpha, jac);
+      double dq[nq];
+      surface_.df_dq(s, q, dq);
+      fixed::mat_vec_trans<nq,nhist>(jac, dq, dyv);
+
+      double eta = std::sqrt(2.0/3.0) * fluidity_.eta(p.fluid, alpha[0]);
+      double mv = std::sqrt(3.0/2.0) * std::pow(fv/eta, p.n - 1.0) * p.n / eta;
+      for (int i=0; i<nhist; i++) dyv[i] *= mv;
+
+      double mv2 = -std::sqrt(3.0/2.0) * fv * std::pow(fv/eta, p.n - 1.0) *
+          p.n / (eta * eta);
+      double deta = std::sqrt(2.0/3.0) * fluidity_.deta(p.fluid, alpha[0]);
+      dyv[0] += deta * mv2;
+    }
+  };
+
+  void g(const Props & p, const double * const s, const double * const alpha,
+         double * const gv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    surface_.df_ds(s, q, gv);
+  };
+
+  void dg_ds(const Props & p, const double * const s,
+             const double * const alpha, double * const dgv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    surface_.df_dsds(s, q, dgv);
+  };
+
+  void dg_da(const Props & p, const double * const s,
+             const double * const alpha, double * const dgv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    double jac[nq*nhist];
+    hardening_.dq_da(p.hard, alpha, jac);
+    double dd[6*nq];
+    surface_.df_dsdq(s, q, dd);
+    fixed::mat_mat<6,nhist,nq>(dd, jac, dgv);
+  };
+
+  void g_time(const Props & p, const double * const s,
+              const double * const alpha, double * const gv) const
+  {
+    fixed::zero<6>(gv);
+  };
+
+  void dg_ds_time(const Props & p, const double * const s,
+                  const double * const alpha, double * const dgv) const
+  {
+    fixed::zero<36>(dgv);
+  };
+
+  void dg_da_time(const Props & p, const double * const s,
+                  const double * const alpha, double * const dgv) const
+  {
+    fixed::zero<6*nhist>(dgv);
+  };
+
+  void g_temp(const Props & p, const double * const s,
+              const double * const alpha, double * const gv) const
+  {
+    fixed::zero<6>(gv);
+  };
+
+  void dg_ds_temp(const Props & p, const double * const s,
+                  const double * const alpha, double * const dgv) const
+  {
+    fixed::zero<36>(dgv);
+  };
+
+  void dg_da_temp(const Props & p, const double * const s,
+                  const double * const alpha, double * const dgv) const
+  {
+    fixed::zero<6*nhist>(dgv);
+  };
+
+  void h(const Props & p, const double * const s, const double * const alpha,
+         double * const hv) const
+  {
+    hardening_.h(p.hard, s, alpha, hv);
+  };
+
+  void dh_ds(const Props & p, const double * const s,
+             const double * const alpha, double * const dhv) const
+  {
+    hardening_.dh_ds(p.hard, s, alpha, dhv);
+  };
+
+  void dh_da(const Props & p, const double * const s,
+             const double * const alpha, double * const dhv) const
+  {
+    hardening_.dh_da(p.hard, s, alpha, dhv);
+  };
+
+  void h_time(const Props & p, const double * const s,
+              const double * const alpha, double * const hv) const
+  {
+    hardening_.h_time(p.hard, s, alpha, hv);
+  };
+
+  void dh_ds_time(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    hardening_.dh_ds_time(p.hard, s, alpha, dhv);
+  };
+
+  void dh_da_time(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    hardening_.dh_da_time(p.hard, s, alpha, dhv);
+  };
+
+  void h_temp(const Props & p, const double * const s,
+              const double * const alpha, double * const hv) const
+  {
+    hardening_.h_temp(p.hard, s, alpha, hv);
+  };
+
+  void dh_ds_temp(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    hardening_.dh_ds_temp(p.hard, s, alpha, dhv);
+  };
+
+  void dh_da_temp(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    hardening_.dh_da_temp(p.hard, s, alpha, dhv);
+  };
+
+ private:
+  template <class C>
+  static C init_(ParameterSet & params, const std::string & name)
+  {
+    ParameterSet np = nested_parameters(params, name, C::type());
+    return C(np);
+  }
+
+ private:
+  Surface surface_;
+  Hardening hardening_;
+  Fluidity fluidity_;
+  std::shared_ptr<Interpolate> n_;
+};
+
+/// Perzyna associative viscoplastic flow, matches PerzynaFlowRule
+template <class Surface, class Hardening, class G = GPowerLaw>
+class PerzynaFlow {
+ public:
+  static const int nhist = Hardening::nhist;
+  static const int nq = Hardening::nq;
+  struct Props {
+    typename Hardening::Props hard;
+    typename G::Props g;
+  };
+
+  static std::string type() {return "PerzynaFlowRule";};
+
+  explicit PerzynaFlow(ParameterSet & params) :
+      surface_(init_<Surface>(params, "surface")),
+      hardening_(init_<Hardening>(params, "hardening")),
+      g_(init_<G>(params, "g"))
+  {
+    static_assert((Surface::nq == Hardening::nq) && (nq == nhist),
+                  "Surface and hardening are not compatible");
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.hard = hardening_.props(T);
+    p.g = g_.props(T);
+    return p;
+  };
+
+  void init_hist(double * const h) const
+  {
+    hardening_.init_hist(h);
+  };
+
+  double y(const Props & p, const double * const s,
+           const double * const alpha) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    double fv = surface_.f(s, q);
+    if (fv > 0.0) return g_.g(p.g, std::fabs(fv));
+    return 0.0;
+  };
+
+  void dy_ds(const Props & p, const double * const s,
+             const double * const alpha, double * const dyv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    double fv = surface_.f(s, q);
+    fixed::zero<6>(dyv);
+    if (fv > 0.0) {
+      double dgv = g_.dg(p.g, std::fabs(fv));
+      surface_.df_ds(s, q, dyv);
+      for (int i=0; i<6; i++) dyv[i] *= dgv;
+    }
+  };
+
+  void dy_da(const Props & p, const double * const s,
+             const double * const alpha, double * const dyv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    double fv = surface_.f(s, q);
+    fixed::zero<nhist>(dyv);
+    if (fv > 0.0) {
+      double dgv = g_.dg(p.g, std::fabs(fv));
+      double jac[nq*nhist];
+      hardening_.dq_da(p.hard, alpha, jac);
+      double rd[nq];
+      surface_.df_dq(s, q, rd);
+      fixed::mat_vec_trans<nq,nhist>(jac, rd, dyv);
+      for (int i=0; i<nhist; i++) dyv[i] *= dgv;
+    }
+  };
+
+  void g(const Props & p, const double * const s, const double * const alpha,
+         double * const gv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    surface_.df_ds(s, q, gv);
+  };
+
+  void dg_ds(const Props & p, const double * const s,
+             const double * const alpha, double * const dgv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    surface_.df_dsds(s, q, dgv);
+  };
+
+  void dg_da(const Props & p, const double * const s,
+             const double * const alpha, double * const dgv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    double jac[nq*nhist];
+    hardening_.dq_da(p.hard, alpha, jac);
+    double dd[6*nq];
+    surface_.df_dsdq(s, q, dd);
+    fixed::mat_mat<6,nhist,nq>(dd, jac, dgv);
+  };
+
+  void g_time(const Props & p, const double * const s,
+              const double * const alpha, double * const gv) const
+  {
+    fixed::zero<6>(gv);
+  };
+
+  void dg_ds_time(const Props & p, const double * const s,
+                  const double * const alpha, double * const dgv) const
+  {
+    fixed::zero<36>(dgv);
+  };
+
+  void dg_da_time(const Props & p, const double * const s,
+                  const double * const alpha, double * const dgv) const
+  {
+    fixed::zero<6*nhist>(dgv);
+  };
+
+  void g_temp(const Props & p, const double * const s,
+              const double * const alpha, double * const gv) const
+  {
+    fixed::zero<6>(gv);
+  };
+
+  void dg_ds_temp(const Props & p, const double * const s,
+                  const double * const alpha, double * const dgv) const
+  {
+    fixed::zero<36>(dgv);
+  };
+
+  void dg_da_temp(const Props & p, const double * const s,
+                  const double * const alpha, double * const dgv) const
+  {
+    fixed::zero<6*nhist>(dgv);
+  };
+
+  void h(const Props & p, const double * const s, const double * const alpha,
+         double * const hv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    surface_.df_dq(s, q, hv);
+  };
+
+  void dh_ds(const Props & p, const double * const s,
+             const double * const alpha, double * const dhv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    surface_.df_dqds(s, q, dhv);
+  };
+
+  void dh_da(const Props & p, const double * const s,
+             const double * const alpha, double * const dhv) const
+  {
+    double q[nq];
+    hardening_.q(p.hard, alpha, q);
+    double jac[nq*nhist];
+    hardening_.dq_da(p.hard, alpha, jac);
+    double dd[nq*nq];
+    surface_.df_dqdq(s, q, dd);
+    fixed::mat_mat<nhist,nhist,nq>(dd, jac, dhv);
+  };
+
+  void h_time(const Props & p, const double * const s,
+              const double * const alpha, double * const hv) const
+  {
+    fixed::zero<nhist>(hv);
+  };
+
+  void dh_ds_time(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    fixed::zero<nhist*6>(dhv);
+  };
+
+  void dh_da_time(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    fixed::zero<nhist*nhist>(dhv);
+  };
+
+  void h_temp(const Props & p, const double * const s,
+              const double * const alpha, double * const hv) const
+  {
+    fixed::zero<nhist>(hv);
+  };
+
+  void dh_ds_temp(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    fixed::zero<nhist*6>(dhv);
+  };
+
+  void dh_da_temp(const Props & p, const double * const s,
+                  const double * const alpha, double * const dhv) const
+  {
+    fixed::zero<nhist*nhist>(dhv);
+  };
+
+ private:
+  template <class C>
+  static C init_(ParameterSet & params, const std::string & name)
+  {
+    ParameterSet np = nested_parameters(params, name, C::type());
+    return C(np);
+  }
+
+ private:
+  Surface surface_;
+  Hardening hardening_;
+  G g_;
+};
+
+// General flow rules
+
+/// Thermo-viscoplastic flow rule with isotropic elasticity,
+/// matches TVPFlowRule
+template <class Flow>
+class TVP {
+ public:
+  static const int nhist = Flow::nhist;
+  struct Props {
+    typename Flow::Props flow;
+    double K3, G2;
+  };
+
+  static std::string type() {return "TVPFlowRule";};
+
+  explicit TVP(ParameterSet & params) :
+      elastic_(init_elastic_(params)),
+      flow_(init_flow_(params))
+  {
+  };
+
+  Props props(double T) const
+  {
+    Props p;
+    p.flow = flow_.props(T);
+    p.K3 = 3.0 * elastic_->K(T);
+    p.G2 = 2.0 * elastic_->G(T);
+    return p;
+  };
+
+  void init_hist(double * const h) const
+  {
+    flow_.init_hist(h);
+  };
+
+  void s(const Props & p, const double * const s, const double * const alpha,
+         const double * const edot, double Tdot, double * const sdot) const
+  {
+    double erate[6];
+    fixed::copy<6>(edot, erate);
+    double temp[6];
+    flow_.g(p.flow, s, alpha, temp);
+    double yv = flow_.y(p.flow, s, alpha);
+    for (int i=0; i<6; i++) erate[i] -= yv * temp[i];
+    flow_.g_temp(p.flow, s, alpha, temp);
+    for (int i=0; i<6; i++) erate[i] -= Tdot * temp[i];
+    flow_.g_time(p.flow, s, alpha, temp);
+    for (int i=0; i<6; i++) erate[i] -= temp[i];
+    C_<1>(p, erate, sdot);
+  };
+
+  void ds_ds(const Props & p, const double * const s,
+             const double * const alpha, const double * const edot,
+             double Tdot, double * const d_sdot) const
+  {
+    double yv = flow_.y(p.flow, s, alpha);
+    double work[36];
+    flow_.dg_ds(p.flow, s, alpha, work);
+    for (int i=0; i<36; i++) work[i] *= -yv;
+    double t1[6], t2[6];
+    flow_.g(p.flow, s, alpha, t1);
+    flow_.dy_ds(p.flow, s, alpha, t2);
+    fixed::outer_update<6,6>(-1.0, t1, t2, work);
+    double t3[36];
+    flow_.dg_ds_temp(p.flow, s, alpha, t3);
+    for (int i=0; i<36; i++) work[i] -= t3[i] * Tdot;
+    flow_.dg_ds_time(p.flow, s, alpha, t3);
+    for (int i=0; i<36; i++) work[i] -= t3[i];
+    C_<6>(p, work, d_sdot);
+  };
+
+  void ds_da(const Props & p, const double * const s,
+             const double * const alpha, const double * const edot,
+             double Tdot, double * const d_sdot) const
+  {
+    double yv = flow_.y(p.flow, s, alpha);
+    double work[6*nhist];
+    flow_.dg_da(p.flow, s, alpha, work);
+    for (int i=0; i<6*nhist; i++) work[i] *= -yv;
+    double t1[6], t2[nhist];
+    flow_.g(p.flow, s, alpha, t1);
+    flow_.dy_da(p.flow, s, alpha, t2);
+    fixed::outer_update<6,nhist>(-1.0, t1, t2, work);
+    double t3[6*nhist];
+    flow_.dg_da_temp(p.flow, s, alpha, t3);
+    for (int i=0; i<6*nhist; i++) work[i] -= t3[i] * Tdot;
+    flow_.dg_da_time(p.flow, s, alpha, t3);
+    for (int i=0; i<6*nhist; i++) work[i] -= t3[i];
+    C_<nhist>(p, work, d_sdot);
+  };
+
+  void ds_de(const Props & p, const double * const s,
+             const double * const alpha, const double * const edot,
+             double Tdot, double * const d_sdot) const
+  {
+    fixed::zero<36>(d_sdot);
+    for (int i=0; i<6; i++) d_sdot[i*6+i] = 1.0;
+    C_<6>(p, d_sdot, d_sdot);
+  };
+
+  void a(const Props & p, const double * const s, const double * const alpha,
+         const double * const edot, double Tdot, double * const adot) const
+  {
+    double dg = flow_.y(p.flow, s, alpha);
+    flow_.h(p.flow, s, alpha, adot);
+    for (int i=0; i<nhist; i++) adot[i] *= dg;
+    double temp[nhist];
+    flow_.h_temp(p.flow, s, alpha, temp);
+    for (int i=0; i<nhist; i++) adot[i] += temp[i] * Tdot;
+    flow_.h_time(p.flow, s, alpha, temp);
+    for (int i=0; i<nhist; i++) adot[i] += temp[i];
+  };
+
+  void da_ds(const Props & p, const double * const s,
+             const double * const alpha, const double * const edot,
+             double Tdot, double * const d_adot) const
+  {
+    double dg = flow_.y(p.flow, s, alpha);
+    flow_.dh_ds(p.flow, s, alpha, d_adot);
+    for (int i=0; i<nhist*6; i++) d_adot[i] *= dg;
+    double t1[nhist], t2[6];
+    flow_.h(p.flow, s, alpha, t1);
+    flow_.dy_ds(p.flow, s, alpha, t2);
+    fixed::outer_update<nhist,6>(1.0, t1, t2, d_adot);
+    double t3[nhist*6];
+    flow_.dh_ds_temp(p.flow, s, alpha, t3);
+    for (int i=0; i<nhist*6; i++) d_adot[i] += t3[i] * Tdot;
+    flow_.dh_ds_time(p.flow, s, alpha, t3);
+    for (int i=0; i<nhist*6; i++) d_adot[i] += t3[i];
+  };
+
+  void da_da(const Props & p, const double * const s,
+             const double * const alpha, const double * const edot,
+             double Tdot, double * const d_adot) const
+  {
+    double dg = flow_.y(p.flow, s, alpha);
+    flow_.dh_da(p.flow, s, alpha, d_adot);
+    for (int i=0; i<nhist*nhist; i++) d_adot[i] *= dg;
+    double t1[nhist], t2[nhist];
+    flow_.h(p.flow, s, alpha, t1);
+    flow_.dy_da(p.flow, s, alpha, t2);
+    fixed::outer_update<nhist,nhist>(1.0, t1, t2, d_adot);
+    double t3[nhist*nhist];
+    flow_.dh_da_temp(p.flow, s, alpha, t3);
+    for (int i=0; i<nhist*nhist; i++) d_adot[i] += t3[i] * Tdot;
+    flow_.dh_da_time(p.flow, s, alpha, t3);
+    for (int i=0; i<nhist*nhist; i++) d_adot[i] += t3[i];
+  };
+
+  void da_de(const Props & p, const double * const s,
+             const double * const alpha, const double * const edot,
+             double Tdot, double * const d_adot) const
+  {
+    fixed::zero<nhist*6>(d_adot);
+  };
+
+  double work_rate(const Props & p, const double * const s,
+                   const double * const alpha, const double * const edot,
+                   double Tdot) const
+  {
+    double erate[6];
+    fixed::zero<6>(erate);
+    double temp[6];
+    flow_.g(p.flow, s, alpha, temp);
+    double yv = flow_.y(p.flow, s, alpha);
+    for (int i=0; i<6; i++) erate[i] += yv * temp[i];
+    flow_.g_temp(p.flow, s, alpha, temp);
+    for (int i=0; i<6; i++) erate[i] += Tdot * temp[i];
+    flow_.g_time(p.flow, s, alpha, temp);
+    for (int i=0; i<6; i++) erate[i] += temp[i];
+    return fixed::dot<6>(s, erate);
+  };
+
+ private:
+  static std::shared_ptr<LinearElasticModel> init_elastic_(
+      ParameterSet & params)
+  {
+    auto elastic = params.get_object_parameter<LinearElasticModel>("elastic");
+    if (std::dynamic_pointer_cast<IsotropicLinearElasticModel>(elastic)
+        == nullptr) {
+      throw std::invalid_argument(
+          "Composed models require isotropic elasticity");
+    }
+    return elastic;
+  };
+
+  static Flow init_flow_(ParameterSet & params)
+  {
+    ParameterSet fp = nested_parameters(params, "flow", Flow::type());
+    return Flow(fp);
+  };
+
+  // Apply 3K P_vol + 2G P_dev to each column of a 6 x N matrix
+  template <int N>
+  void C_(const Props & p, const double * const A, double * const B) const
+  {
+    for (int j=0; j<N; j++) {
+      double vol = (p.K3 - p.G2) * (A[0*N+j] + A[1*N+j] + A[2*N+j]) / 3.0;
+      for (int i=0; i<3; i++) B[i*N+j] = p.G2 * A[i*N+j] + vol;
+      for (int i=3; i<6; i++) B[i*N+j] = p.G2 * A[i*N+j];
+    }
+  }
+
+ private:
+  std::shared_ptr<LinearElasticModel> elastic_;
+  Flow flow_;
+};
+
+// Integrators
+
+/// Small strain integrator for a general flow rule, matches the
+/// GeneralIntegrator update_sd
+template <class Rule>
+class Integrator {
+ public:
+  static const int nhist = Rule::nhist;
+  static const int nparams = 6 + nhist;
+
+  static std::string type() {return "GeneralIntegrator";};
+
+  explicit Integrator(ParameterSet & params) :
+      rule_(init_rule_(params)),
+      tol_(params.get_parameter<double>("tol")),
+      miter_(params.get_parameter<int>("miter")),
+      max_divide_(params.get_parameter<int>("max_divide"))
+  {
+  };
+
+  /// Setup from a runtime object created through the Factory
+  explicit Integrator(const NEMLObject & model) :
+      Integrator(model_parameters_(model))
+  {
+  };
+
+  explicit Integrator(ParameterSet && params) :
+      Integrator(params)
+  {
+  };
+
+  /// Initialize the history
+  void init_hist(double * const h) const
+  {
+    rule_.init_hist(h);
+  };
+
+  /// The small strain stress update, same interface as NEMLModel_sd
+  int update_sd(
+      const double * const e_np1, const double * const e_n,
+      double T_np1, double T_n,
+      double t_np1, double t_n,
+      double * const s_np1, const double * const s_n,
+      double * const h_np1, const double * const h_n,
+      double * const A_np1,
+      double & u_np1, double u_n,
+      double & p_np1, double p_n) const
+  {
+    int nd = 0;
+    int tf = 1 << max_divide_;
+    int cm = tf;
+    int cs = 0;
+
+    double e_diff[6];
+    for (int i=0; i<6; i++) e_diff[i] = e_np1[i] - e_n[i];
+    double T_diff = T_np1 - T_n;
+    double t_diff = t_np1 - t_n;
+
+    double e_past[6];
+    fixed::copy<6>(e_n, e_past);
+    double h_past[nhist];
+    fixed::copy<nhist>(h_n, h_past);
+    double s_past[6];
+    fixed::copy<6>(s_n, s_past);
+    double T_past = T_n;
+    double t_past = t_n;
+
+    double e_next[6];
+    double x[nparams];
+    double T_next, t_next;
+
+    while (cs < tf) {
+      double sm = (double) (cs + cm) / (double) tf;
+      for (int i=0; i<6; i++) e_next[i] = e_n[i] + sm * e_diff[i];
+      T_next = T_n + sm * T_diff;
+      t_next = t_n + sm * t_diff;
+
+      State ts;
+      make_state_(e_next, e_past, T_next, T_past, t_next, t_past, s_past,
+                  h_past, ts);
+
+      int ier = newton_(x, ts);
+      if (ier != SUCCESS) {
+        nd += 1;
+        cm /= 2;
+        if (nd == max_divide_) return ier;
+        continue;
+      }
+
+      cs += cm;
+      fixed::copy<6>(e_next, e_past);
+      fixed::copy<nhist>(&x[6], h_past);
+      fixed::copy<6>(x, s_past);
+      T_past = T_next;
+      t_past = t_next;
+    }
+
+    fixed::copy<6>(x, s_np1);
+    fixed::copy<nhist>(&x[6], h_np1);
+
+    // Tangent over the full step
+    State ts;
+    make_state_(e_np1, e_n, T_np1, T_n, t_np1, t_n, s_n, h_n, ts);
+    int ier = tangent_(x, ts, A_np1);
+    if (ier != SUCCESS) return ier;
+
+    // Energy (trapezoid rule)
+    double u = 0.0;
+    for (int i=0; i<6; i++) {
+      u += (s_np1[i] + s_n[i]) / 2.0 * (e_np1[i] - e_n[i]);
+    }
+    u_np1 = u_n + u;
+
+    double p_dot_np1 = rule_.work_rate(ts.props, s_np1, h_np1, ts.e_dot,
+                                       ts.Tdot);
+    double p_dot_n = rule_.work_rate(ts.props, s_n, h_n, ts.e_dot, ts.Tdot);
+    p_np1 = p_n + (p_dot_np1 + p_dot_n) / 2.0 * ts.dt;
+
+    return 0;
+  };
+
+ private:
+  struct State {
+    double dt, T, Tdot;
+    double e_dot[6];
+    double s_n[6];
+    double h_n[nhist];
+    typename Rule::Props props;
+  };
+
+  static ParameterSet model_parameters_(const NEMLObject & model)
+  {
+    if (model.parameter_set() == nullptr) {
+      throw std::invalid_argument("Model was not created through the Factory");
+    }
+    return *model.parameter_set();
+  };
+
+  static Rule init_rule_(ParameterSet & params)
+  {
+    if (params.type() != type()) {
+      throw std::invalid_argument("Expected an object of type " + type() +
+                                  " but got " + params.type());
+    }
+    ParameterSet rp = nested_parameters(params, "rule", Rule::type());
+    return Rule(rp);
+  };
+
+  void make_state_(const double * const e_np1, const double * const e_n,
+                   double T_np1, double T_n, double t_np1, double t_n,
+                   const double * const s_n, const double * const h_n,
+                   State & ts) const
+  {
+    ts.dt = t_np1 - t_n;
+    ts.T = T_np1;
+    if (ts.dt > 0.0) {
+      ts.Tdot = (T_np1 - T_n) / ts.dt;
+      for (int i=0; i<6; i++) ts.e_dot[i] = (e_np1[i] - e_n[i]) / ts.dt;
+    }
+    else {
+      ts.Tdot = 0.0;
+      fixed::zero<6>(ts.e_dot);
+    }
+    fixed::copy<6>(s_n, ts.s_n);
+    fixed::copy<nhist>(h_n, ts.h_n);
+    ts.props = rule_.props(ts.T);
+  };
+
+  void RJ_(const double * const x, const State & ts, double * const R,
+           double * const J) const
+  {
+    double s_mod[6];
+    fixed::copy<6>(x, s_mod);
+    if (fixed::norm2<6>(x) < std::numeric_limits<double>::epsilon()) {
+      s_mod[0] = 2.0 * std::numeric_limits<double>::epsilon();
+    }
+    const double * const h_np1 = &x[6];
+    const typename Rule::Props & p = ts.props;
+
+    rule_.s(p, s_mod, h_np1, ts.e_dot, ts.Tdot, R);
+    for (int i=0; i<6; i++) R[i] = -s_mod[i] + ts.s_n[i] + R[i] * ts.dt;
+    rule_.a(p, s_mod, h_np1, ts.e_dot, ts.Tdot, &R[6]);
+    for (int i=0; i<nhist; i++) {
+      R[i+6] = -h_np1[i] + ts.h_n[i] + R[i+6] * ts.dt;
+    }
+
+    double J11[36];
+    rule_.ds_ds(p, s_mod, h_np1, ts.e_dot, ts.Tdot, J11);
+    double J12[6*nhist];
+    rule_.ds_da(p, s_mod, h_np1, ts.e_dot, ts.Tdot, J12);
+    for (int i=0; i<6; i++) {
+      for (int j=0; j<6; j++) {
+        J[i*nparams+j] = J11[i*6+j] * ts.dt - ((i == j) ? 1.0 : 0.0);
+      }
+      for (int j=0; j<nhist; j++) {
+        J[i*nparams+j+6] = J12[i*nhist+j] * ts.dt;
+      }
+    }
+
+    double J21[nhist*6];
+    rule_.da_ds(p, s_mod, h_np1, ts.e_dot, ts.Tdot, J21);
+    double J22[nhist*nhist];
+    rule_.da_da(p, s_mod, h_np1, ts.e_dot, ts.Tdot, J22);
+    for (int i=0; i<nhist; i++) {
+      for (int j=0; j<6; j++) {
+        J[(i+6)*nparams+j] = J21[i*6+j] * ts.dt;
+      }
+      for (int j=0; j<nhist; j++) {
+        J[(i+6)*nparams+j+6] = J22[i*nhist+j] * ts.dt -
+            ((i == j) ? 1.0 : 0.0);
+      }
+    }
+  };
+
+  int newton_(double * const x, const State & ts) const
+  {
+    fixed::copy<6>(ts.s_n, x);
+    fixed::copy<nhist>(ts.h_n, &x[6]);
+
+    double R[nparams];
+    double J[nparams*nparams];
+    RJ_(x, ts, R, J);
+    double nR = fixed::norm2<nparams>(R);
+    int i = 0;
+    while ((nR > tol_) && (i < miter_)) {
+      if (!fixed::solve<nparams,1>(J, R)) return LINALG_FAILURE;
+      for (int j=0; j<nparams; j++) x[j] -= R[j];
+      RJ_(x, ts, R, J);
+      nR = fixed::norm2<nparams>(R);
+      i++;
+    }
+    if (i == miter_) return MAX_ITERATIONS;
+    return SUCCESS;
+  };
+
+  int tangent_(const double * const x, const State & ts,
+               double * const A_np1) const
+  {
+    double s_mod[6];
+    fixed::copy<6>(x, s_mod);
+    if (fixed::norm2<6>(x) < std::numeric_limits<double>::epsilon()) {
+      s_mod[0] = 2.0 * std::numeric_limits<double>::epsilon();
+    }
+    const double * const h_np1 = &x[6];
+
+    double A[36];
+    rule_.ds_de(ts.props, s_mod, h_np1, ts.e_dot, ts.Tdot, A);
+    double B[nhist*6];
+    rule_.da_de(ts.props, s_mod, h_np1, ts.e_dot, ts.Tdot, B);
+
+    double R[nparams];
+    double J[nparams*nparams];
+    RJ_(x, ts, R, J);
+
+    // Schur complement on the history block:
+    //  A_np1 = (J11 - J12 J22^-1 J21)^-1 (J12 J22^-1 B - A)
+    double J22[nhist*nhist];
+    double X[nhist*12];
+    for (int i=0; i<nhist; i++) {
+      for (int j=0; j<nhist; j++) J22[i*nhist+j] = J[(i+6)*nparams+j+6];
+      for (int j=0; j<6; j++) {
+        X[i*12+j] = J[(i+6)*nparams+j];
+        X[i*12+j+6] = B[i*6+j];
+      }
+    }
+    if (!fixed::solve<nhist,12>(J22, X)) return LINALG_FAILURE;
+
+    double T2[36];
+    double T4[36];
+    for (int i=0; i<6; i++) {
+      for (int j=0; j<6; j++) {
+        double s2 = 0.0;
+        double s4 = 0.0;
+        for (int k=0; k<nhist; k++) {
+          s2 += J[i*nparams+k+6] * X[k*12+j];
+          s4 += J[i*nparams+k+6] * X[k*12+j+6];
+        }
+        T2[i*6+j] = J[i*nparams+j] - s2;
+        T4[i*6+j] = s4 - A[i*6+j];
+      }
+    }
+    if (!fixed::solve<6,6>(T2, T4)) return LINALG_FAILURE;
+    fixed::copy<36>(T4, A_np1);
+
+    return SUCCESS;
+  };
+
+ private:
+  Rule rule_;
+  double tol_;
+  int miter_, max_divide_;
+};
+
+/// A composed integrator behind the usual NEMLModel_sd interface, so it
+/// can be registered with the Factory and used anywhere a runtime model is
+template <class Composed>
+class Model : public NEMLModel_sd {
+ public:
+  explicit Model(ParameterSet & params) :
+      NEMLModel_sd(params.get_object_parameter<LinearElasticModel>("elastic"),
+                   params.get_object_parameter<Interpolate>("alpha"),
+                   params.get_parameter<bool>("truesdell"),
+                   params.get_parameter<bool>("tangent_outer")),
+      composed_(params)
+  {
+  };
+
+  /// Small strain stress update
+  virtual int update_sd(
+      const double * const e_np1, const double * const e_n,
+      double T_np1, double T_n,
+      double t_np1, double t_n,
+      double * const s_np1, const double * const s_n,
+      double * const h_np1, const double * const h_n,
+      double * const A_np1,
+      double & u_np1, double u_n,
+      double & p_np1, double p_n)
+  {
+    return composed_.update_sd(e_np1, e_n, T_np1, T_n, t_np1, t_n, s_np1,
+                               s_n, h_np1, h_n, A_np1, u_np1, u_n, p_np1,
+                               p_n);
+  };
+
+  /// Number of history variables
+  virtual size_t nhist() const
+  {
+    return Composed::nhist;
+  };
+
+  /// Initialize the history
+  virtual int init_hist(double * const hist) const
+  {
+    composed_.init_hist(hist);
+    return 0;
+  };
+
+ private:
+  Composed composed_;
+};
+
+} // namespace compose
+
+} // namespace neml
+
+#endif // COMPOSE_H
@@ -26,6 +26,17 @@ int ScalarCreepRule::dg_dT(double seq, double eeq, double t, double T,
   return 0;
 }
 
+int ScalarCreepRule::g_vec(size_t n, const double * const seq,
+                           const double * const eeq, const double * const t,
+                           const double * const T, double * const g) const
+{
+  for (size_t i = 0; i < n; i++) {
+    int ier = this->g(seq[i], eeq[i], t[i], T[i], g[i]);
+    if (ier != 0) return ier;
+  }
+  return 0;
+}
+
 // Implementation of power law creep
 PowerLawCreep::PowerLawCreep(std::shared_ptr<Interpolate> A,
                              std::shared_ptr<Interpolate> n) :
@@ -64,6 +75,17 @@ int PowerLawCreep::g(double seq, double eeq, double t, double T, double & g) con
   return 0;
 }
 
+int PowerLawCreep::g_vec(size_t n, const double * const seq,
+                         const double * const eeq, const double * const t,
+                         const double * const T, double * const g) const
+{
+  std::vector<double> nv(n);
+  A_->value_vec(n, T, g);
+  n_->value_vec(n, T, nv.data());
+  for (size_t i = 0; i < n; i++) g[i] *= pow(seq[i], nv[i]);
+  return 0;
+}
+
 int PowerLawCreep::dg_ds(double seq, double eeq, double t, double T, double & dg) const
 {
   double nv = n_->value(T);
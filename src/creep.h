@@ -27,6 +27,10 @@ class ScalarCreepRule: public NEMLObject {
    /// Derivative of scalar creep rate wrt temperature, defaults to zero
    virtual int dg_dT(double seq, double eeq, double t, double T, double & dg) 
        const;
+   /// Creep rate at each of n points, defaults to calling g for each
+   virtual int g_vec(size_t n, const double * const seq, 
+                     const double * const eeq, const double * const t, 
+                     const double * const T, double * const g) const;
 };
 
 /// Simple power law creep
@@ -50,6 +54,10 @@ class PowerLawCreep: public ScalarCreepRule {
   /// Derivative of rate wrt effective strain = 0
   virtual int dg_de(double seq, double eeq, double t, double T, double & dg)
       const;
+  /// Rate at each of n points
+  virtual int g_vec(size_t n, const double * const seq, 
+                    const double * const eeq, const double * const t, 
+                    const double * const T, double * const g) const;
   
   /// Getter for the prefactor
   double A(double T) const;
@@ -60,8 +68,6 @@ class PowerLawCreep: public ScalarCreepRule {
   const std::shared_ptr<const Interpolate> A_, n_;
 };
 
-static Register<PowerLawCreep> regPowerLawCreep;
-
 /// A power law type model that uses KM concepts to switch between mechanisms
 class RegionKMCreep: public ScalarCreepRule {
  public:
@@ -97,8 +103,6 @@ class RegionKMCreep: public ScalarCreepRule {
   const std::shared_ptr<LinearElasticModel> emodel_;
 };
 
-static Register<RegionKMCreep> regRegionKMCreep;
-
 /// Classical Norton-Bailey creep
 class NortonBaileyCreep: public ScalarCreepRule {
  public:
@@ -132,8 +136,6 @@ class NortonBaileyCreep: public ScalarCreepRule {
   const std::shared_ptr<const Interpolate> A_, m_, n_;
 };
 
-static Register<NortonBaileyCreep> regNortonBaileyCreep;
-
 /// Classical Mukherjee creep
 class MukherjeeCreep: public ScalarCreepRule {
  public:
@@ -178,8 +180,6 @@ class MukherjeeCreep: public ScalarCreepRule {
   const double A_, n_, D0_, Q_, b_, k_, R_;
 };
 
-static Register<MukherjeeCreep> regMukherjeeCreep;
-
 /// A generic creep rate model where log(creep_rate) = Interpolate(log(stress))
 class GenericCreep: public ScalarCreepRule {
  public:
@@ -204,8 +204,6 @@ class GenericCreep: public ScalarCreepRule {
   const std::shared_ptr<Interpolate> cfn_;
 };
 
-static Register<GenericCreep> regGenericCreep;
-
 /// Sinh type model used in the Blackburn models for creep in 316 and 304 SS
 class BlackburnSinhCreep: public ScalarCreepRule {
  public:
@@ -234,8 +232,6 @@ class BlackburnSinhCreep: public ScalarCreepRule {
   const double Q_, R_;
 };
 
-static Register<BlackburnSinhCreep> regBlackburnSinhCreep;
-
 /// Creep trial state
 class CreepModelTrialState : public TrialState {
  public:
@@ -342,8 +338,6 @@ class J2CreepModel: public CreepModel {
   std::shared_ptr<ScalarCreepRule> rule_;
 };
 
-static Register<J2CreepModel> regJ2CreepModel;
-
 } // namespace neml
 
 #endif // CREEP_H
@@ -26,7 +26,15 @@ PYBIND11_MODULE(creep, m) {
             auto e_np1 = alloc_vec<double>(6);
             auto A_np1 = alloc_mat<double>(6,6);
 
-            int ier = m.update(arr2ptr<double>(s_np1), arr2ptr<double>(e_np1), arr2ptr<double>(e_n), T_np1, T_n, t_np1, t_n, arr2ptr<double>(A_np1));
+            auto s_np1_ptr = s_np1.data();
+            auto e_np1_ptr = e_np1.mutable_data();
+            auto e_n_ptr = e_n.data();
+            auto A_np1_ptr = A_np1.mutable_data();
+            int ier;
+            {
+              py::gil_scoped_release release;
+              ier = m.update(s_np1_ptr, e_np1_ptr, e_n_ptr, T_np1, T_n, t_np1, t_n, A_np1_ptr);
+            }
             py_error(ier);
 
             return std::make_tuple(e_np1, A_np1);
@@ -110,6 +118,28 @@ PYBIND11_MODULE(creep, m) {
             return gv;
            }, "Evaluate creep rate.")
 
+      .def("g_vec",
+           [](const ScalarCreepRule & m, py::object seq, py::object eeq, py::object t, py::object T) -> py::array_t<double>
+           {
+            std::vector<size_t> shape;
+            auto args = broadcast_arrays({seq, eeq, t, T}, {{}, {}, {}, {}},
+                                         {"seq", "eeq", "t", "T"}, shape);
+            auto gv = alloc_array<double>(shape);
+            auto args0_ptr = args[0].data();
+            auto args1_ptr = args[1].data();
+            auto args2_ptr = args[2].data();
+            auto args3_ptr = args[3].data();
+            auto gv_ptr = gv.mutable_data();
+            int ier;
+            {
+              py::gil_scoped_release release;
+              ier = m.g_vec(gv.size(), args0_ptr, args1_ptr, args2_ptr, args3_ptr, gv_ptr);
+            }
+            py_error(ier);
+            return gv;
+           }, "Evaluate creep rate for arrays of inputs, broadcast against each other.",
+           py::arg("seq"), py::arg("eeq"), py::arg("t"), py::arg("T"))
+
       .def("dg_ds",
            [](const ScalarCreepRule & m, double seq, double eeq, double t, double T) -> double
            {
@@ -8,8 +8,8 @@ namespace neml {
 NEMLDamagedModel_sd::NEMLDamagedModel_sd(std::shared_ptr<LinearElasticModel> elastic,
                                          std::shared_ptr<NEMLModel_sd> base, 
                                          std::shared_ptr<Interpolate> alpha,
-                                         bool truesdell) :
-    NEMLModel_sd(elastic, alpha, truesdell), base_(base)
+                                         bool truesdell, bool tangent_outer) :
+    NEMLModel_sd(elastic, alpha, truesdell, tangent_outer), base_(base)
 {
 
 }
@@ -38,9 +38,9 @@ NEMLScalarDamagedModel_sd::NEMLScalarDamagedModel_sd(
     std::shared_ptr<NEMLModel_sd> base, 
     std::shared_ptr<Interpolate> alpha,
     double tol, int miter, bool verbose,
-    bool truesdell, bool ekill, double dkill,
+    bool truesdell, bool tangent_outer, bool ekill, double dkill,
     double sfact) :
-      NEMLDamagedModel_sd(elastic, base, alpha, truesdell), tol_(tol), miter_(miter),
+      NEMLDamagedModel_sd(elastic, base, alpha, truesdell, tangent_outer), tol_(tol), miter_(miter),
       verbose_(verbose), ekill_(ekill), dkill_(dkill), sfact_(sfact)
 {
 
@@ -264,8 +264,8 @@ CombinedDamageModel_sd::CombinedDamageModel_sd(
     std::vector<std::shared_ptr<NEMLScalarDamagedModel_sd>> models,
     std::shared_ptr<NEMLModel_sd> base,
     std::shared_ptr<Interpolate> alpha,
-    double tol, int miter, bool verbose, bool truesdell) :
-      NEMLScalarDamagedModel_sd(elastic, base, alpha, tol, miter, verbose, truesdell, false, 0, 1),
+    double tol, int miter, bool verbose, bool truesdell, bool tangent_outer) :
+      NEMLScalarDamagedModel_sd(elastic, base, alpha, tol, miter, verbose, truesdell, tangent_outer, false, 0, 1),
       models_(models)
 {
 
@@ -291,6 +291,7 @@ ParameterSet CombinedDamageModel_sd::parameters()
   pset.add_optional_parameter<int>("miter", 50);
   pset.add_optional_parameter<bool>("verbose", false);
   pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
 
   return pset;
 }
@@ -305,7 +306,8 @@ std::unique_ptr<NEMLObject> CombinedDamageModel_sd::initialize(ParameterSet & pa
       params.get_parameter<double>("tol"),
       params.get_parameter<int>("miter"),
       params.get_parameter<bool>("verbose"),
-      params.get_parameter<bool>("truesdell")
+      params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer")
       ); 
 }
 
@@ -408,8 +410,8 @@ ClassicalCreepDamageModel_sd::ClassicalCreepDamageModel_sd(
     std::shared_ptr<NEMLModel_sd> base,
     std::shared_ptr<Interpolate> alpha,
     double tol, int miter,
-    bool verbose, bool truesdell) :
-      NEMLScalarDamagedModel_sd(elastic, base, alpha, tol, miter, verbose, truesdell, false, 0, 1),
+    bool verbose, bool truesdell, bool tangent_outer) :
+      NEMLScalarDamagedModel_sd(elastic, base, alpha, tol, miter, verbose, truesdell, tangent_outer, false, 0, 1),
       A_(A), xi_(xi), phi_(phi)
 {
 
@@ -437,6 +439,7 @@ ParameterSet ClassicalCreepDamageModel_sd::parameters()
   pset.add_optional_parameter<int>("miter", 50);
   pset.add_optional_parameter<bool>("verbose", false);
   pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
 
   return pset;
 }
@@ -453,7 +456,8 @@ std::unique_ptr<NEMLObject> ClassicalCreepDamageModel_sd::initialize(ParameterSe
       params.get_parameter<double>("tol"),
       params.get_parameter<int>("miter"),
       params.get_parameter<bool>("verbose"),
-      params.get_parameter<bool>("truesdell")
+      params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer")
       ); 
 }
 
@@ -722,36 +726,22 @@ int MaxPrincipalEffectiveStress::effective(const double * const s, double & eff)
 
 int MaxPrincipalEffectiveStress::deffective(const double * const s, double * const deff) const
 {
-  double vectors[9];
   double values[3];
-  int ier = eigenvalues_sym(s, values);
+  double vectors[9];
+  int ier = eigen_sym(s, values, vectors);
+  if (ier != SUCCESS) return ier;
 
   if (values[2] < 0.0) {
     std::fill(deff, deff+6, 0.0);
-    return 0.0;
+    return 0;
   }
 
-  ier = eigenvectors_sym(s, vectors);
-  double * v = &(vectors[6]);
-
+  // d(max eigenvalue)/ds = v x v
   double full[9];
-  double nf = 0.0;
-  for (int i=0; i<3; i++) {
-    nf += v[i] * v[i];
-    for (int j=0; j<3; j++) {
-      full[CINDEX(i,j,3)] = v[i]*v[j];
-    }
-  }
-
-  if (nf != 0) {
-    for (int i=0; i<9; i++) {
-      full[i] /= nf;
-    }
-  }
-
+  outer_vec(&vectors[6], 3, &vectors[6], 3, full);
   sym(full, deff);
 
-  return ier;
+  return 0;
 }
 
 
@@ -824,9 +814,9 @@ ModularCreepDamageModel_sd::ModularCreepDamageModel_sd(
     std::shared_ptr<NEMLModel_sd> base,
     std::shared_ptr<Interpolate> alpha,
     double tol, int miter,
-    bool verbose, bool truesdell,
+    bool verbose, bool truesdell, bool tangent_outer,
     bool ekill, double dkill, double sfact) :
-      NEMLScalarDamagedModel_sd(elastic, base, alpha, tol, miter, verbose, truesdell, ekill, dkill, sfact),
+      NEMLScalarDamagedModel_sd(elastic, base, alpha, tol, miter, verbose, truesdell, tangent_outer, ekill, dkill, sfact),
       A_(A), xi_(xi), phi_(phi), estress_(estress)
 {
 
@@ -855,6 +845,7 @@ ParameterSet ModularCreepDamageModel_sd::parameters()
   pset.add_optional_parameter<int>("miter", 50);
   pset.add_optional_parameter<bool>("verbose", false);
   pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
   pset.add_optional_parameter<bool>("ekill", false);
   pset.add_optional_parameter<double>("dkill", 0.5);
   pset.add_optional_parameter<double>("sfact", 100000.0);
@@ -876,6 +867,7 @@ std::unique_ptr<NEMLObject> ModularCreepDamageModel_sd::initialize(ParameterSet
       params.get_parameter<int>("miter"),
       params.get_parameter<bool>("verbose"),
       params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer"),
       params.get_parameter<bool>("ekill"),
       params.get_parameter<double>("dkill"),
       params.get_parameter<double>("sfact")
@@ -970,8 +962,8 @@ NEMLStandardScalarDamagedModel_sd::NEMLStandardScalarDamagedModel_sd(
     std::shared_ptr<LinearElasticModel> elastic,
     std::shared_ptr<NEMLModel_sd> base,
     std::shared_ptr<Interpolate> alpha,
-    double tol, int miter, bool verbose, bool truesdell) :
-      NEMLScalarDamagedModel_sd(elastic, base, alpha, tol, miter, verbose, truesdell, false, 0, 1) 
+    double tol, int miter, bool verbose, bool truesdell, bool tangent_outer) :
+      NEMLScalarDamagedModel_sd(elastic, base, alpha, tol, miter, verbose, truesdell, tangent_outer, false, 0, 1) 
 {
 
 }
@@ -1034,12 +1026,8 @@ int NEMLStandardScalarDamagedModel_sd::ddamage_de(
     de[i] = e_np1[i] - e_n[i];
   }
 
-  double S[36];
-  ier = elastic_->S(T_np1, S);
-  if (ier != SUCCESS) return ier;
-
-  double dee[36];
-  ier = mat_vec(S, 6, ds, 6, dee);
+  double dee[6];
+  ier = elastic_->apply_S(T_np1, ds, dee);
   if (ier != SUCCESS) return ier;
 
   for (int i=0; i<6; i++) {
@@ -1074,12 +1062,8 @@ int NEMLStandardScalarDamagedModel_sd::ddamage_ds(
     de[i] = e_np1[i] - e_n[i];
   }
 
-  double S[36];
-  ier = elastic_->S(T_np1, S);
-  if (ier != SUCCESS) return ier;
-
-  double dee[36];
-  ier = mat_vec(S, 6, ds, 6, dee);
+  double dee[6];
+  ier = elastic_->apply_S(T_np1, ds, dee);
   if (ier != SUCCESS) return ier;
 
   double v1[6];
@@ -1087,7 +1071,7 @@ int NEMLStandardScalarDamagedModel_sd::ddamage_ds(
     v1[i] = (2.0 * fval) / (3.0 * deps) * (dee[i] - de[i]); 
   }
 
-  ier = mat_vec(S, 6, v1, 6, dd);
+  ier = elastic_->apply_S(T_np1, v1, dd);
   if (ier != SUCCESS) return ier;
 
   double dds[6];
@@ -1106,9 +1090,6 @@ double NEMLStandardScalarDamagedModel_sd::dep(
     const double * const e_np1, const double * const e_n,
     double T_np1) const
 {
-  double S[36];
-  elastic_->S(T_np1, S);
-  
   double ds[6];
   double de[6];
   for (int i=0; i<6; i++) {
@@ -1116,8 +1097,8 @@ double NEMLStandardScalarDamagedModel_sd::dep(
     de[i] = e_np1[i] - e_n[i];
   }
 
-  double dee[36];
-  mat_vec(S, 6, ds, 6, dee);
+  double dee[6];
+  elastic_->apply_S(T_np1, ds, dee);
 
   double val_sq =  2.0/3.0 * (dot_vec(de, de, 6) + dot_vec(dee, dee, 6) -
                          2.0 * dot_vec(de, dee, 6));
@@ -1136,9 +1117,9 @@ NEMLPowerLawDamagedModel_sd::NEMLPowerLawDamagedModel_sd(
     std::shared_ptr<NEMLModel_sd> base,
     std::shared_ptr<Interpolate> alpha,
     double tol, int miter,
-    bool verbose, bool truesdell) :
+    bool verbose, bool truesdell, bool tangent_outer) :
       NEMLStandardScalarDamagedModel_sd(elastic, base, alpha, tol, miter, 
-                                        verbose, truesdell), 
+                                        verbose, truesdell, tangent_outer), 
       A_(A), a_(a)
 {
 
@@ -1165,6 +1146,7 @@ ParameterSet NEMLPowerLawDamagedModel_sd::parameters()
   pset.add_optional_parameter<bool>("verbose", false);
 
   pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
 
   return pset;
 }
@@ -1180,7 +1162,8 @@ std::unique_ptr<NEMLObject> NEMLPowerLawDamagedModel_sd::initialize(ParameterSet
       params.get_parameter<double>("tol"),
       params.get_parameter<int>("miter"),
       params.get_parameter<bool>("verbose"),
-      params.get_parameter<bool>("truesdell")
+      params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer")
       ); 
 }
 
@@ -1238,9 +1221,9 @@ NEMLExponentialWorkDamagedModel_sd::NEMLExponentialWorkDamagedModel_sd(
     std::shared_ptr<NEMLModel_sd> base,
     std::shared_ptr<Interpolate> alpha,
     double tol, int miter,
-    bool verbose, bool truesdell) :
+    bool verbose, bool truesdell, bool tangent_outer) :
       NEMLStandardScalarDamagedModel_sd(elastic, base, alpha, tol, miter, 
-                                        verbose, truesdell), 
+                                        verbose, truesdell, tangent_outer), 
       W0_(W0), k0_(k0), af_(af)
 {
 
@@ -1268,6 +1251,7 @@ ParameterSet NEMLExponentialWorkDamagedModel_sd::parameters()
   pset.add_optional_parameter<bool>("verbose", false);
 
   pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
 
   return pset;
 }
@@ -1284,7 +1268,8 @@ std::unique_ptr<NEMLObject> NEMLExponentialWorkDamagedModel_sd::initialize(Param
       params.get_parameter<double>("tol"),
       params.get_parameter<int>("miter"),
       params.get_parameter<bool>("verbose"),
-      params.get_parameter<bool>("truesdell")
+      params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer")
       ); 
 }
 
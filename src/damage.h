@@ -16,7 +16,7 @@ class NEMLDamagedModel_sd: public NEMLModel_sd {
                       std::shared_ptr<LinearElasticModel> elastic,
                       std::shared_ptr<NEMLModel_sd> base,
                       std::shared_ptr<Interpolate> alpha,
-                      bool truesdell);
+                      bool truesdell, bool tangent_outer);
   
   /// How many history variables?  Equal to base_history + ndamage
   virtual size_t nhist() const;
@@ -69,7 +69,7 @@ class NEMLScalarDamagedModel_sd: public NEMLDamagedModel_sd, public Solvable {
                             std::shared_ptr<NEMLModel_sd> base,
                             std::shared_ptr<Interpolate> alpha,
                             double tol, int miter,
-                            bool verbose, bool truesdell,
+                            bool verbose, bool truesdell, bool tangent_outer,
                             bool ekill, double dkill, double sfact);
   
   /// Stress update using the scalar damage model
@@ -158,7 +158,7 @@ class CombinedDamageModel_sd: public NEMLScalarDamagedModel_sd {
       std::shared_ptr<NEMLModel_sd> base,
       std::shared_ptr<Interpolate> alpha,
       double tol, int miter,
-      bool verbose, bool truesdell);
+      bool verbose, bool truesdell, bool tangent_outer);
   
   /// String type for the object system
   static std::string type();
@@ -203,8 +203,6 @@ class CombinedDamageModel_sd: public NEMLScalarDamagedModel_sd {
   const std::vector<std::shared_ptr<NEMLScalarDamagedModel_sd>> models_;
 };
 
-static Register<CombinedDamageModel_sd> regCombinedDamageModel_sd;
-
 /// Classical Hayhurst-Leckie-Rabotnov-Kachanov damage
 class ClassicalCreepDamageModel_sd: public NEMLScalarDamagedModel_sd {
  public:
@@ -219,7 +217,7 @@ class ClassicalCreepDamageModel_sd: public NEMLScalarDamagedModel_sd {
                             std::shared_ptr<NEMLModel_sd> base,
                             std::shared_ptr<Interpolate> alpha,
                             double tol, int miter,
-                            bool verbose, bool truesdell);
+                            bool verbose, bool truesdell, bool tangent_outer);
   
   /// String type for the object system
   static std::string type();
@@ -266,8 +264,6 @@ class ClassicalCreepDamageModel_sd: public NEMLScalarDamagedModel_sd {
   std::shared_ptr<Interpolate> phi_;
 };
 
-static Register<ClassicalCreepDamageModel_sd> regClassicalCreepDamageModel_sd;
-
 /// Base class of modular effective stresses used by ModularCreepDamageModel_sd
 class EffectiveStress: public NEMLObject {
  public:
@@ -292,8 +288,6 @@ class VonMisesEffectiveStress: public EffectiveStress
   virtual int deffective(const double * const s, double * const deff) const;
 };
 
-static Register<VonMisesEffectiveStress> regVonMisesEffectiveStress;
-
 /// Huddleston stress
 class HuddlestonEffectiveStress: public EffectiveStress
 {
@@ -314,8 +308,6 @@ class HuddlestonEffectiveStress: public EffectiveStress
   double b_;
 };
 
-static Register<HuddlestonEffectiveStress> regHuddlestonEffectiveStress;
-
 /// Maximum principal stress
 class MaxPrincipalEffectiveStress: public EffectiveStress
 {
@@ -333,8 +325,6 @@ class MaxPrincipalEffectiveStress: public EffectiveStress
   virtual int deffective(const double * const s, double * const deff) const;
 };
 
-static Register<MaxPrincipalEffectiveStress> regMaxPrincipalEffectiveStress;
-
 /// Maximum of several effective stress measures
 class MaxSeveralEffectiveStress: public EffectiveStress
 {
@@ -358,8 +348,6 @@ class MaxSeveralEffectiveStress: public EffectiveStress
   std::vector<std::shared_ptr<EffectiveStress>> measures_;
 };
 
-static Register<MaxSeveralEffectiveStress> regMaxSeveralEffectiveStress;
-
 /// Modular version of Hayhurst-Leckie-Rabotnov-Kachanov damage
 //    This model differs from the above in two ways
 //      1) You can change the effective stress measure
@@ -376,7 +364,7 @@ class ModularCreepDamageModel_sd: public NEMLScalarDamagedModel_sd {
                             std::shared_ptr<NEMLModel_sd> base,
                             std::shared_ptr<Interpolate> alpha,
                             double tol, int miter,
-                            bool verbose, bool truesdell, 
+                            bool verbose, bool truesdell, bool tangent_outer, 
                             bool ekill, double dkill,
                             double sfact);
   
@@ -423,8 +411,6 @@ class ModularCreepDamageModel_sd: public NEMLScalarDamagedModel_sd {
   std::shared_ptr<EffectiveStress> estress_;
 };
 
-static Register<ModularCreepDamageModel_sd> regModularCreepDamageModel_sd;
-
 /// A standard damage model where the damage rate goes as the plastic strain
 class NEMLStandardScalarDamagedModel_sd: public NEMLScalarDamagedModel_sd {
  public:
@@ -435,7 +421,7 @@ class NEMLStandardScalarDamagedModel_sd: public NEMLScalarDamagedModel_sd {
       std::shared_ptr<NEMLModel_sd> base,
       std::shared_ptr<Interpolate> alpha,
       double tol, int miter,
-      bool verbose, bool truesdell);
+      bool verbose, bool truesdell, bool tangent_outer);
   
   /// Damage, now only proportional to the inelastic effective strain
   virtual int damage(double d_np1, double d_n, 
@@ -495,7 +481,7 @@ class NEMLPowerLawDamagedModel_sd: public NEMLStandardScalarDamagedModel_sd {
       std::shared_ptr<NEMLModel_sd> base,
       std::shared_ptr<Interpolate> alpha,
       double tol, int miter,
-      bool verbose, bool truesdell);
+      bool verbose, bool truesdell, bool tangent_outer);
 
   /// String type for the object system
   static std::string type();
@@ -522,8 +508,6 @@ class NEMLPowerLawDamagedModel_sd: public NEMLStandardScalarDamagedModel_sd {
   std::shared_ptr<Interpolate> a_;
 };
 
-static Register<NEMLPowerLawDamagedModel_sd> regNEMLPowerLawDamagedModel_sd;
-
 /// Simple exponential damage model
 class NEMLExponentialWorkDamagedModel_sd: public NEMLStandardScalarDamagedModel_sd {
  public:
@@ -537,7 +521,7 @@ class NEMLExponentialWorkDamagedModel_sd: public NEMLStandardScalarDamagedModel_
       std::shared_ptr<NEMLModel_sd> base,
       std::shared_ptr<Interpolate> alpha,
       double tol, int miter,
-      bool verbose, bool truesdell);
+      bool verbose, bool truesdell, bool tangent_outer);
 
   /// String type for the object system
   static std::string type();
@@ -565,8 +549,6 @@ class NEMLExponentialWorkDamagedModel_sd: public NEMLStandardScalarDamagedModel_
   std::shared_ptr<Interpolate> af_;
 };
 
-static Register<NEMLExponentialWorkDamagedModel_sd> regNEMLExponentialWorkDamagedModel_sd;
-
 } //namespace neml
 
 #endif // DAMAGE_H
@@ -8,6 +8,42 @@
 
 namespace neml {
 
+int LinearElasticModel::apply_C(double T, const double * const e,
+                                double * const s) const
+{
+  double Cv[36];
+  int ier = C(T, Cv);
+  if (ier != SUCCESS) return ier;
+  return mat_vec(Cv, 6, e, 6, s);
+}
+
+int LinearElasticModel::apply_S(double T, const double * const s,
+                                double * const e) const
+{
+  double Sv[36];
+  int ier = S(T, Sv);
+  if (ier != SUCCESS) return ier;
+  return mat_vec(Sv, 6, s, 6, e);
+}
+
+int LinearElasticModel::apply_C_mat(double T, const double * const A, int n,
+                                    double * const B) const
+{
+  double Cv[36];
+  int ier = C(T, Cv);
+  if (ier != SUCCESS) return ier;
+  return mat_mat(6, n, 6, Cv, A, B);
+}
+
+int LinearElasticModel::apply_S_mat(double T, const double * const A, int n,
+                                    double * const B) const
+{
+  double Sv[36];
+  int ier = S(T, Sv);
+  if (ier != SUCCESS) return ier;
+  return mat_mat(6, n, 6, Sv, A, B);
+}
+
 bool LinearElasticModel::valid() const
 {
   return false;
@@ -18,17 +54,15 @@ IsotropicLinearElasticModel::IsotropicLinearElasticModel(
       std::string m1_type,
       std::shared_ptr<Interpolate> m2,
       std::string m2_type) :
-    m1_(m1), m2_(m2), m1_type_(m1_type), m2_type_(m2_type)
+    m1_(m1), m2_(m2), m1_type_(m1_type), m2_type_(m2_type),
+    m1_const_(constant_type_(m1_type)), m2_const_(constant_type_(m2_type)),
+    constant_(false), G_(0.0), K_(0.0)
 {
   if (m1_type_ == m2_type) {
     throw std::invalid_argument("Two distinct elastic constants are required!");
   }
-  if (valid_types_.find(m1_type) == valid_types_.end()) {
-    throw std::invalid_argument("Unknown elastic constant " + m1_type);
-  }
-  if (valid_types_.find(m2_type) == valid_types_.end()) {
-    throw std::invalid_argument("Unknown elastic constant " + m2_type);
-  }
+
+  setup_();
 }
 
 std::string IsotropicLinearElasticModel::type()
@@ -74,6 +108,42 @@ int IsotropicLinearElasticModel::S(double T, double * const Sv) const
   return S_calc_(G, K, Sv);
 }
 
+int IsotropicLinearElasticModel::apply_C(double T, const double * const e,
+                                         double * const s) const
+{
+  double G, K;
+  get_GK_(T, G, K);
+
+  return iso_proj_vec(3.0 * K, 2.0 * G, e, s);
+}
+
+int IsotropicLinearElasticModel::apply_S(double T, const double * const s,
+                                         double * const e) const
+{
+  double G, K;
+  get_GK_(T, G, K);
+
+  return iso_proj_vec(1.0 / (3.0 * K), 1.0 / (2.0 * G), s, e);
+}
+
+int IsotropicLinearElasticModel::apply_C_mat(double T, const double * const A,
+                                             int n, double * const B) const
+{
+  double G, K;
+  get_GK_(T, G, K);
+
+  return iso_proj_mat(3.0 * K, 2.0 * G, A, n, B);
+}
+
+int IsotropicLinearElasticModel::apply_S_mat(double T, const double * const A,
+                                             int n, double * const B) const
+{
+  double G, K;
+  get_GK_(T, G, K);
+
+  return iso_proj_mat(1.0 / (3.0 * K), 1.0 / (2.0 * G), A, n, B);
+}
+
 double IsotropicLinearElasticModel::E(double T) const
 {
   double G, K;
@@ -165,64 +235,83 @@ bool IsotropicLinearElasticModel::valid() const
   return true;
 }
 
-void IsotropicLinearElasticModel::get_GK_(double T, double & G, double & K) const
+void IsotropicLinearElasticModel::parameters_changed()
 {
-  double m1 = m1_->value(T);
-  double m2 = m2_->value(T);
+  setup_();
+}
 
-  if (m1_type_ == "shear" and m2_type_ == "bulk") {
-    G = m1;
-    K = m2;
-  }
-  else if (m1_type_ == "bulk" and m2_type_ == "shear") {
-    G = m2;
-    K = m1;
+void IsotropicLinearElasticModel::setup_()
+{
+  // Temperature independent moduli only need to be converted once
+  constant_ = false;
+  if (std::dynamic_pointer_cast<ConstantInterpolate>(m1_) and
+      std::dynamic_pointer_cast<ConstantInterpolate>(m2_)) {
+    convert_GK_(m1_->value(0.0), m2_->value(0.0), G_, K_);
+    constant_ = true;
   }
-  else if (m1_type_ == "youngs" and m2_type_ == "poissons") {
-    G = m1 / (2.0 * (1.0 + m2));
-    K = m1 / (3.0 * (1.0 - 2.0 * m2));
+}
+
+void IsotropicLinearElasticModel::get_GK_(double T, double & G, double & K) const
+{
+  if (constant_) {
+    G = G_;
+    K = K_;
   }
-  else if (m1_type_ == "poissons" and m2_type_ == "youngs") {
-    G = m2 / (2.0 * (1.0 + m1));
-    K = m2 / (3.0 * (1.0 - 2.0 * m1));
+  else {
+    convert_GK_(m1_->value(T), m2_->value(T), G, K);
   }
-  else if (m1_type_ == "youngs" and m2_type_ == "shear") {
-    G = m2;
-    K = m1 * m2 / (3.0 * (3.0 * m2 - m1));
+}
+
+void IsotropicLinearElasticModel::convert_GK_(double m1, double m2, 
+                                              double & G, double & K) const
+{
+  // Put the pair in enum order so each combination appears once
+  ElasticConstant c1 = m1_const_;
+  ElasticConstant c2 = m2_const_;
+  if (c1 > c2) {
+    std::swap(c1, c2);
+    std::swap(m1, m2);
   }
-  else if (m1_type_ == "shear" and m2_type_ == "youngs") {
+
+  if (c1 == SHEAR and c2 == BULK) {
     G = m1;
-    K = m2 * m1 / (3.0 * (3.0 * m1 - m2));
-  }
-  else if (m1_type_ == "youngs" and m2_type_ == "bulk") {
-    G = 3.0 * m2 * m1 / (9.0 * m2 - m1);
     K = m2;
   }
-  else if (m1_type_ == "bulk" and m2_type_ == "youngs") {
-    G = 3.0 * m1 * m2 / (9.0 * m1 - m2);
-    K = m1;
-  }
-  else if (m1_type_ == "poissons" and m2_type_ == "shear") {
-    G = m2;
-    K = 2.0 * m2 * (1.0 + m1) / (3.0 * (1.0 - 2.0 * m1));
+  else if (c1 == SHEAR and c2 == YOUNGS) {
+    G = m1;
+    K = m2 * m1 / (3.0 * (3.0 * m1 - m2));
   }
-  else if (m1_type_ == "shear" and m2_type_ == "poissons") {
+  else if (c1 == SHEAR and c2 == POISSONS) {
     G = m1;
     K = 2.0 * m1 * (1.0 + m2) / (3.0 * (1.0 - 2.0 * m2));
   }
-  else if (m1_type_ == "poissons" and m2_type_ == "bulk") {
-    G = 3.0 * m2 * (1.0 - 2.0 * m1) / (2.0 * (1.0 + m1));
-    K = m2;
+  else if (c1 == BULK and c2 == YOUNGS) {
+    G = 3.0 * m1 * m2 / (9.0 * m1 - m2);
+    K = m1;
   }
-  else if (m1_type_ == "bulk" and m2_type_ == "poissons") {
+  else if (c1 == BULK and c2 == POISSONS) {
     G = 3.0 * m1 * (1.0 - 2.0 * m2) / (2.0 * (1.0 + m2));
     K = m1;
   }
+  else if (c1 == YOUNGS and c2 == POISSONS) {
+    G = m1 / (2.0 * (1.0 + m2));
+    K = m1 / (3.0 * (1.0 - 2.0 * m2));
+  }
   else {
     throw std::invalid_argument("Unknown combination of elastic properties");
   }
 }
 
+IsotropicLinearElasticModel::ElasticConstant 
+  IsotropicLinearElasticModel::constant_type_(std::string name) const
+{
+  if (name == "shear") return SHEAR;
+  else if (name == "bulk") return BULK;
+  else if (name == "youngs") return YOUNGS;
+  else if (name == "poissons") return POISSONS;
+  else throw std::invalid_argument("Unknown elastic constant " + name);
+}
+
 BlankElasticModel::BlankElasticModel()
 {
 
@@ -19,6 +19,17 @@ class LinearElasticModel: public NEMLObject {
   virtual int C(double T, double * const Cv) const = 0;
   /// The compliance tensor, in Mandel notation
   virtual int S(double T, double * const Sv) const = 0;
+
+  /// Apply the stiffness tensor to a Mandel vector, s = C : e
+  virtual int apply_C(double T, const double * const e, double * const s) const;
+  /// Apply the compliance tensor to a Mandel vector, e = S : s
+  virtual int apply_S(double T, const double * const s, double * const e) const;
+  /// Left multiply a 6 x n Mandel matrix by the stiffness, B = C . A
+  virtual int apply_C_mat(double T, const double * const A, int n,
+                          double * const B) const;
+  /// Left multiply a 6 x n Mandel matrix by the compliance, B = S . A
+  virtual int apply_S_mat(double T, const double * const A, int n,
+                          double * const B) const;
   
   /// The Young's modulus
   virtual double E(double T) const = 0;
@@ -54,6 +65,17 @@ class IsotropicLinearElasticModel: public LinearElasticModel {
   virtual int C(double T, double * const Cv) const;
   /// Implement the compliance tensor
   virtual int S(double T, double * const Sv) const;
+
+  /// s = (3K P_vol + 2G P_dev) : e, without forming the stiffness
+  virtual int apply_C(double T, const double * const e, double * const s) const;
+  /// e = (1/(3K) P_vol + 1/(2G) P_dev) : s, without forming the compliance
+  virtual int apply_S(double T, const double * const s, double * const e) const;
+  /// Projector form of B = C . A
+  virtual int apply_C_mat(double T, const double * const A, int n,
+                          double * const B) const;
+  /// Projector form of B = S . A
+  virtual int apply_S_mat(double T, const double * const A, int n,
+                          double * const B) const;
   
   /// The Young's modulus
   virtual double E(double T) const;
@@ -67,20 +89,35 @@ class IsotropicLinearElasticModel: public LinearElasticModel {
   /// This is a valid model
   virtual bool valid() const;
 
+  /// Convert the moduli again if they changed in place
+  virtual void parameters_changed();
+
  private:
+  /// Internal enum for the elastic constant types, in a fixed order
+  enum ElasticConstant {
+    SHEAR     = 0,
+    BULK      = 1,
+    YOUNGS    = 2,
+    POISSONS  = 3
+  };
+
   int C_calc_(double G, double K, double * const Cv) const;
   int S_calc_(double G, double K, double * const Sv) const;
 
   void get_GK_(double T, double & G, double & K) const;
+  void convert_GK_(double m1, double m2, double & G, double & K) const;
+  ElasticConstant constant_type_(std::string name) const;
+  void setup_();
   
  private:
   std::shared_ptr<Interpolate> m1_, m2_;
   std::string m1_type_, m2_type_;
-  const std::set<std::string> valid_types_ = {"bulk", "shear", 
-    "youngs", "poissons"};
-};
+  ElasticConstant m1_const_, m2_const_;
 
-static Register<IsotropicLinearElasticModel> regIsotropicLinearElasticModel;
+  // Moduli are fixed at construction if neither constant depends on T
+  bool constant_;
+  double G_, K_;
+};
 
 /// Dummy model  used to signal "take elastic properties from another object"
 class BlankElasticModel: public LinearElasticModel {
@@ -109,8 +146,6 @@ class BlankElasticModel: public LinearElasticModel {
   virtual double K(double T) const;
 };
 
-static Register<BlankElasticModel> regBlankElasticModel;
-
 } // namespace neml
 
 
@@ -33,6 +33,24 @@ PYBIND11_MODULE(elasticity, m) {
             py_error(ier);
             return S;
            }, "Return compliance elasticity matrix.")
+
+      .def("apply_C",
+           [](const LinearElasticModel & m, double T, py::array_t<double, py::array::c_style> e) -> py::array_t<double>
+           {
+            auto s = alloc_vec<double>(6);
+            int ier = m.apply_C(T, arr2ptr<double>(e), arr2ptr<double>(s));
+            py_error(ier);
+            return s;
+           }, "Apply the stiffness to a strain vector.")
+
+      .def("apply_S",
+           [](const LinearElasticModel & m, double T, py::array_t<double, py::array::c_style> s) -> py::array_t<double>
+           {
+            auto e = alloc_vec<double>(6);
+            int ier = m.apply_S(T, arr2ptr<double>(s), arr2ptr<double>(e));
+            py_error(ier);
+            return e;
+           }, "Apply the compliance to a stress vector.")
       .def("E", &LinearElasticModel::E, "Young's modulus as a function of temperature.")
       .def("nu", &LinearElasticModel::nu, "Poisson's ratio as a function of temperature.")
       .def("G", &LinearElasticModel::G, "Shear modulus as a function of temperature.")
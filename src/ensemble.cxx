@@ -0,0 +1,143 @@
+#include "ensemble.h"
+
+#include "parallel.h"
+
+#include <exception>
+#include <stdexcept>
+
+namespace neml {
+
+TunedModel::TunedModel(const NEMLModel & source)
+{
+  model_ = std::dynamic_pointer_cast<NEMLModel>(source.clone());
+  if (not model_) {
+    throw std::runtime_error("Cloning the model did not give a NEMLModel");
+  }
+  tunable_.reset(new TunableParameters(model_));
+  base_ = tunable_->values();
+  current_ = base_;
+  const std::vector<std::string> & names = tunable_->names();
+  for (size_t i = 0; i < names.size(); i++) index_[names[i]] = i;
+}
+
+void TunedModel::tune(const std::map<std::string, double> & changes)
+{
+  std::vector<double> values = base_;
+  for (auto & c : changes) {
+    auto it = index_.find(c.first);
+    if (it == index_.end()) {
+      throw std::invalid_argument("Unknown parameter " + c.first);
+    }
+    values[it->second] = c.second;
+  }
+  if (values != current_) {
+    tunable_->set_values(values);
+    current_ = values;
+  }
+}
+
+TunedModelPool::TunedModelPool(std::shared_ptr<NEMLModel> model) :
+    model_(model)
+{
+
+}
+
+std::unique_ptr<TunedModel> TunedModelPool::acquire()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (not free_.empty()) {
+      std::unique_ptr<TunedModel> copy = std::move(free_.back());
+      free_.pop_back();
+      return copy;
+    }
+  }
+  if (not model_) {
+    throw std::invalid_argument("No model to copy");
+  }
+  return std::unique_ptr<TunedModel>(new TunedModel(*model_));
+}
+
+void TunedModelPool::release(std::unique_ptr<TunedModel> copy)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_.push_back(std::move(copy));
+}
+
+namespace {
+
+int run_case(const EnsembleCase & c, TunedModelPool & pool,
+             EnsembleResult & res)
+{
+  if (c.model) {
+    if (c.parameters.empty()) return c.program(c.model, res.results);
+    TunedModel copy(*c.model);
+    copy.tune(c.parameters);
+    return c.program(copy.model(), res.results);
+  }
+
+  if (c.parameters.empty()) return c.program(pool.model(), res.results);
+
+  std::unique_ptr<TunedModel> copy = pool.acquire();
+  int ier;
+  try {
+    copy->tune(c.parameters);
+    ier = c.program(copy->model(), res.results);
+  }
+  catch (...) {
+    pool.release(std::move(copy));
+    throw;
+  }
+  pool.release(std::move(copy));
+  return ier;
+}
+
+} // namespace
+
+std::vector<EnsembleResult> run_ensemble(
+    std::shared_ptr<NEMLModel> model,
+    const std::vector<EnsembleCase> & cases, unsigned nthreads)
+{
+  TunedModelPool pool(model);
+  return run_ensemble(pool, cases, nthreads);
+}
+
+std::vector<EnsembleResult> run_ensemble(
+    TunedModelPool & pool, const std::vector<EnsembleCase> & cases,
+    unsigned nthreads)
+{
+  for (auto & c : cases) {
+    if (not c.program) {
+      throw std::invalid_argument("Ensemble case without a loading program");
+    }
+    if (not (pool.model() or c.model)) {
+      throw std::invalid_argument("Ensemble case without a model");
+    }
+  }
+
+  std::vector<EnsembleResult> results(cases.size());
+
+  parallel_for(cases.size(), nthreads, [&](size_t i)
+               {
+                EnsembleResult & res = results[i];
+                try {
+                  res.status = run_case(cases[i], pool, res);
+                  if (res.status != SUCCESS) {
+                    res.message = string_error(res.status);
+                  }
+                }
+                catch (std::exception & e) {
+                  res.status = UNKNOWN_ERROR;
+                  res.message = e.what();
+                }
+                catch (...) {
+                  res.status = UNKNOWN_ERROR;
+                  res.message = string_error(UNKNOWN_ERROR);
+                }
+                if (res.status != SUCCESS) res.results = DriverResults();
+               });
+
+  return results;
+}
+
+} // namespace neml
@@ -0,0 +1,99 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include "cdrivers.h"
+#include "tunable.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace neml {
+
+/// One of the loading programs in cdrivers.h, with everything but the model
+/// filled in
+typedef std::function<int(std::shared_ptr<NEMLModel>, DriverResults &)>
+    LoadingProgram;
+
+/// A case in an ensemble: a loading program, optionally run on a different
+/// model or with some of the model's tunable parameters (see tunable.h)
+/// changed
+struct EnsembleCase {
+  LoadingProgram program;
+  /// Changes to the tunable parameters, by name
+  std::map<std::string, double> parameters;
+  /// Model to use in place of the ensemble's model, if not null
+  std::shared_ptr<NEMLModel> model;
+};
+
+/// The outcome of one case: the error code (SUCCESS or an Error, with
+/// UNKNOWN_ERROR for exceptions), a description of any failure, and the
+/// results of the loading program
+struct EnsembleResult {
+  int status;
+  std::string message;
+  DriverResults results;
+};
+
+/// A copy of a model that can be tuned in place
+class TunedModel {
+ public:
+  TunedModel(const NEMLModel & source);
+
+  /// Set the parameters to those of the source, with the given changes
+  void tune(const std::map<std::string, double> & changes);
+  /// The copy
+  std::shared_ptr<NEMLModel> model() const {return model_;};
+
+ private:
+  std::shared_ptr<NEMLModel> model_;
+  std::unique_ptr<TunableParameters> tunable_;
+  std::vector<double> base_, current_;
+  std::unordered_map<std::string, size_t> index_;
+};
+
+/// Copies of a model to tune in place, each used by one thread at a time
+//  Copies are made as threads ask for them and kept when handed back, so
+//  later runs reuse them.  Changes are relative to the parameters the
+//  model had when the pool was made.
+class TunedModelPool {
+ public:
+  TunedModelPool(std::shared_ptr<NEMLModel> model);
+
+  /// The model the copies are made from
+  std::shared_ptr<NEMLModel> model() const {return model_;};
+  /// Take a copy out of the pool
+  std::unique_ptr<TunedModel> acquire();
+  /// Hand a copy back
+  void release(std::unique_ptr<TunedModel> copy);
+
+ private:
+  std::shared_ptr<NEMLModel> model_;
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<TunedModel>> free_;
+};
+
+/// Run all the cases on up to nthreads threads (0 for all)
+//  Idle threads take the next case not yet started, so long and short
+//  cases balance out.  A failed case only sets its own status: the other
+//  cases still run.  Cases without parameter changes all share the model,
+//  which is only read.  Cases that change the base model's parameters use
+//  one clone of it per thread, tuned in place for each case.  Cases with
+//  their own model and parameter changes clone that model.
+std::vector<EnsembleResult> run_ensemble(
+    std::shared_ptr<NEMLModel> model,
+    const std::vector<EnsembleCase> & cases, unsigned nthreads = 0);
+
+/// run_ensemble with the copies of the model kept in a pool, to reuse
+/// over several runs
+std::vector<EnsembleResult> run_ensemble(
+    TunedModelPool & pool, const std::vector<EnsembleCase> & cases,
+    unsigned nthreads = 0);
+
+} // namespace neml
+
+#endif // ENSEMBLE_H
@@ -0,0 +1,321 @@
+#include "pyhelp.h" // include first to avoid annoying redef warning
+
+#include "ensemble.h"
+
+#include <limits>
+
+namespace py = pybind11;
+
+PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>)
+
+namespace neml {
+
+namespace {
+
+// None for nothing, otherwise a sequence of numbers
+std::vector<double> optional_vector(py::object v)
+{
+  if (v.is_none()) return std::vector<double>();
+  return v.cast<std::vector<double>>();
+}
+
+// The hold times at the two peaks, as for the cdrivers cyclic tests
+std::vector<double> hold_times(py::object hold_time)
+{
+  if (hold_time.is_none()) return {0.0, 0.0};
+  if (py::isinstance<py::float_>(hold_time) ||
+      py::isinstance<py::int_>(hold_time) ||
+      py::hasattr(hold_time, "__float__")) {
+    double h = hold_time.cast<double>();
+    return {h, h};
+  }
+  return hold_time.cast<std::vector<double>>();
+}
+
+EnsembleCase make_case(LoadingProgram program, py::object parameters,
+                       py::object model)
+{
+  EnsembleCase c;
+  c.program = program;
+  if (not parameters.is_none()) {
+    c.parameters = parameters.cast<std::map<std::string, double>>();
+  }
+  if (not model.is_none()) {
+    c.model = model.cast<std::shared_ptr<NEMLModel>>();
+  }
+  return c;
+}
+
+// The widest entry under each name in the maps of the cases
+template<class T> std::map<std::string, size_t> widths(
+    const std::vector<EnsembleResult> & results,
+    std::map<std::string, std::vector<T>> DriverResults::*member)
+{
+  std::map<std::string, size_t> w;
+  for (auto & r : results) {
+    for (auto & a : r.results.*member) {
+      w[a.first] = std::max(w[a.first], a.second.size());
+    }
+  }
+  return w;
+}
+
+// Stack the arrays of the cases row by row, padding with fill
+template<class T> void stack_arrays(
+    const std::vector<EnsembleResult> & results,
+    std::map<std::string, std::vector<T>> DriverResults::*member, T fill,
+    py::dict & d)
+{
+  for (auto & w : widths(results, member)) {
+    auto arr = alloc_mat<T>(results.size(), w.second);
+    T * data = arr.mutable_data();
+    std::fill(data, data + results.size() * w.second, fill);
+    for (size_t i = 0; i < results.size(); i++) {
+      auto it = (results[i].results.*member).find(w.first);
+      if (it == (results[i].results.*member).end()) continue;
+      std::copy(it->second.begin(), it->second.end(), data + i * w.second);
+    }
+    d[w.first.c_str()] = arr;
+  }
+}
+
+// The results of all the cases, stacked
+py::dict stack(const std::vector<EnsembleResult> & results)
+{
+  size_t n = results.size();
+  py::dict d;
+
+  stack_arrays(results, &DriverResults::arrays,
+               std::numeric_limits<double>::quiet_NaN(), d);
+  stack_arrays(results, &DriverResults::int_arrays, -1, d);
+
+  std::map<std::string, py::array_t<double>> scalars;
+  std::map<std::string, py::array_t<bool>> flags;
+  for (size_t i = 0; i < n; i++) {
+    for (auto & s : results[i].results.scalars) {
+      if (not scalars.count(s.first)) {
+        scalars[s.first] = alloc_vec<double>(n);
+        std::fill(scalars[s.first].mutable_data(),
+                  scalars[s.first].mutable_data() + n,
+                  std::numeric_limits<double>::quiet_NaN());
+      }
+      scalars[s.first].mutable_data()[i] = s.second;
+    }
+    for (auto & f : results[i].results.flags) {
+      if (not flags.count(f.first)) {
+        flags[f.first] = alloc_vec<bool>(n);
+        std::fill(flags[f.first].mutable_data(),
+                  flags[f.first].mutable_data() + n, false);
+      }
+      flags[f.first].mutable_data()[i] = f.second;
+    }
+  }
+  for (auto & s : scalars) d[s.first.c_str()] = s.second;
+  for (auto & f : flags) d[f.first.c_str()] = f.second;
+
+  auto status = alloc_vec<int>(n);
+  py::list messages;
+  for (size_t i = 0; i < n; i++) {
+    status.mutable_data()[i] = results[i].status;
+    messages.append(results[i].message);
+  }
+  d["status"] = status;
+  d["message"] = messages;
+
+  return d;
+}
+
+} // namespace
+
+PYBIND11_MODULE(ensemble, m) {
+  py::module::import("neml.objects");
+  py::module::import("neml.models");
+
+  m.doc() = "Run the native loading programs over many cases at once.";
+
+  py::class_<EnsembleCase>(m, "Case")
+      .def_readwrite("parameters", &EnsembleCase::parameters,
+                     "Changes to the tunable parameters of the model.")
+      .def_property("model",
+           [](const EnsembleCase & c) -> py::object
+           {
+            if (not c.model) return py::none();
+            return py::cast(c.model);
+           },
+           [](EnsembleCase & c, py::object model)
+           {
+            c.model = model.is_none() ? nullptr :
+                model.cast<std::shared_ptr<NEMLModel>>();
+           }, "Model to use in place of the ensemble's model, or None.")
+      ;
+
+  m.def("run",
+        [](py::object model, std::vector<EnsembleCase> cases,
+           unsigned nthreads) -> py::dict
+        {
+          std::shared_ptr<NEMLModel> base;
+          if (not model.is_none()) {
+            base = model.cast<std::shared_ptr<NEMLModel>>();
+          }
+          std::vector<EnsembleResult> results;
+          {
+            py::gil_scoped_release release;
+            results = run_ensemble(base, cases, nthreads);
+          }
+          return stack(results);
+        }, "Run a list of cases, returning the results stacked with one "
+        "row per case.  Shorter arrays and failed cases are padded with "
+        "nan (-1 for integer arrays, False for flags).  status gives the "
+        "error code of each case, 0 for success, and message describes "
+        "any failure.",
+        py::arg("model"), py::arg("cases"), py::arg("nthreads") = 0);
+
+  m.def("uniaxial_test",
+        [](double erate, double T, double emax, int nsteps,
+           std::vector<double> sdir, bool verbose, double offset,
+           py::object history, std::vector<double> tdir,
+           py::object parameters, py::object model) -> EnsembleCase
+        {
+          std::vector<double> h = optional_vector(history);
+          return make_case(
+              [=](std::shared_ptr<NEMLModel> mod, DriverResults & res) {
+                return uniaxial_test(mod, erate, res, T, emax, nsteps, sdir,
+                                     offset, h, tdir);
+              }, parameters, model);
+        }, "Case for a uniaxial stress/strain curve.",
+        py::arg("erate"), py::arg("T") = 300.0,
+        py::arg("emax") = 0.05, py::arg("nsteps") = 250,
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("verbose") = false, py::arg("offset") = 0.2/100.0,
+        py::arg("history") = py::none(),
+        py::arg("tdir") = std::vector<double>({0,1,0,0,0,0}),
+        py::arg("parameters") = py::none(), py::arg("model") = py::none());
+
+  m.def("strain_cyclic",
+        [](double emax, double R, double erate, int ncycles, double T,
+           int nsteps, std::vector<double> sdir, py::object hold_time,
+           int n_hold, bool verbose, bool check_dmg, double dtol,
+           py::object parameters, py::object model) -> EnsembleCase
+        {
+          std::vector<double> ht = hold_times(hold_time);
+          return make_case(
+              [=](std::shared_ptr<NEMLModel> mod, DriverResults & res) {
+                return strain_cyclic(mod, emax, R, erate, ncycles, res, T,
+                                     nsteps, sdir, ht, n_hold, check_dmg,
+                                     dtol);
+              }, parameters, model);
+        }, "Case for a strain controlled cyclic test.",
+        py::arg("emax"), py::arg("R"), py::arg("erate"),
+        py::arg("ncycles"), py::arg("T") = 300.0, py::arg("nsteps") = 50,
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("hold_time") = py::none(), py::arg("n_hold") = 25,
+        py::arg("verbose") = false, py::arg("check_dmg") = false,
+        py::arg("dtol") = 0.75,
+        py::arg("parameters") = py::none(), py::arg("model") = py::none());
+
+  m.def("stress_cyclic",
+        [](double smax, double R, double srate, int ncycles, double T,
+           int nsteps, std::vector<double> sdir, py::object hold_time,
+           int n_hold, bool verbose, double etol,
+           py::object parameters, py::object model) -> EnsembleCase
+        {
+          std::vector<double> ht = hold_times(hold_time);
+          return make_case(
+              [=](std::shared_ptr<NEMLModel> mod, DriverResults & res) {
+                return stress_cyclic(mod, smax, R, srate, ncycles, res, T,
+                                     nsteps, sdir, ht, n_hold, etol);
+              }, parameters, model);
+        }, "Case for a stress controlled cyclic test.",
+        py::arg("smax"), py::arg("R"), py::arg("srate"),
+        py::arg("ncycles"), py::arg("T") = 300.0, py::arg("nsteps") = 50,
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("hold_time") = py::none(), py::arg("n_hold") = 10,
+        py::arg("verbose") = false, py::arg("etol") = 0.1,
+        py::arg("parameters") = py::none(), py::arg("model") = py::none());
+
+  m.def("stress_relaxation",
+        [](double emax, double erate, double hold, double T, int nsteps,
+           int nsteps_up, int index, double tc, bool verbose, bool logspace,
+           double q, py::object parameters,
+           py::object model) -> EnsembleCase
+        {
+          return make_case(
+              [=](std::shared_ptr<NEMLModel> mod, DriverResults & res) {
+                return stress_relaxation(mod, emax, erate, hold, res, T,
+                                         nsteps, nsteps_up, index, tc,
+                                         logspace, q);
+              }, parameters, model);
+        }, "Case for a stress relaxation test.",
+        py::arg("emax"), py::arg("erate"), py::arg("hold"),
+        py::arg("T") = 300.0, py::arg("nsteps") = 250,
+        py::arg("nsteps_up") = 50, py::arg("index") = 0,
+        py::arg("tc") = 1.0, py::arg("verbose") = false,
+        py::arg("logspace") = false, py::arg("q") = 1.0,
+        py::arg("parameters") = py::none(), py::arg("model") = py::none());
+
+  m.def("creep",
+        [](double smax, double srate, double hold, double T, int nsteps,
+           int nsteps_up, std::vector<double> sdir, bool verbose,
+           bool logspace, py::object history, double elimit,
+           bool check_dmg, double dtol, py::object parameters,
+           py::object model) -> EnsembleCase
+        {
+          std::vector<double> h = optional_vector(history);
+          return make_case(
+              [=](std::shared_ptr<NEMLModel> mod, DriverResults & res) {
+                return creep(mod, smax, srate, hold, res, T, nsteps,
+                             nsteps_up, sdir, logspace, h, elimit,
+                             check_dmg, dtol);
+              }, parameters, model);
+        }, "Case for a creep test.",
+        py::arg("smax"), py::arg("srate"), py::arg("hold"),
+        py::arg("T") = 300.0, py::arg("nsteps") = 250,
+        py::arg("nsteps_up") = 150,
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("verbose") = false, py::arg("logspace") = false,
+        py::arg("history") = py::none(), py::arg("elimit") = 1.0,
+        py::arg("check_dmg") = false, py::arg("dtol") = 0.75,
+        py::arg("parameters") = py::none(), py::arg("model") = py::none());
+
+  m.def("thermomechanical_strain_raw",
+        [](std::vector<double> time, std::vector<double> temperature,
+           std::vector<double> strain, std::vector<double> sdir,
+           bool verbose, int substep, py::object parameters,
+           py::object model) -> EnsembleCase
+        {
+          return make_case(
+              [=](std::shared_ptr<NEMLModel> mod, DriverResults & res) {
+                return thermomechanical_strain_raw(mod, time, temperature,
+                                                   strain, res, sdir,
+                                                   substep);
+              }, parameters, model);
+        }, "Case driving a model with the strain and temperature history of "
+        "a thermomechanical test.",
+        py::arg("time"), py::arg("temperature"), py::arg("strain"),
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("verbose") = false, py::arg("substep") = 1,
+        py::arg("parameters") = py::none(), py::arg("model") = py::none());
+
+  m.def("rate_jump_test",
+        [](std::vector<double> erates, double T, double e_per,
+           int nsteps_per, std::vector<double> sdir, bool verbose,
+           py::object history, py::object strains, py::object parameters,
+           py::object model) -> EnsembleCase
+        {
+          std::vector<double> h = optional_vector(history);
+          std::vector<double> jumps = optional_vector(strains);
+          return make_case(
+              [=](std::shared_ptr<NEMLModel> mod, DriverResults & res) {
+                return rate_jump_test(mod, erates, res, T, e_per, nsteps_per,
+                                      sdir, h, jumps);
+              }, parameters, model);
+        }, "Case for a uniaxial strain rate jump test.",
+        py::arg("erates"), py::arg("T") = 300.0,
+        py::arg("e_per") = 0.01, py::arg("nsteps_per") = 100,
+        py::arg("sdir") = std::vector<double>({1,0,0,0,0,0}),
+        py::arg("verbose") = false, py::arg("history") = py::none(),
+        py::arg("strains") = py::none(),
+        py::arg("parameters") = py::none(), py::arg("model") = py::none());
+}
+
+} // namespace neml
@@ -97,12 +97,7 @@ int TVPFlowRule::s(const double * const s, const double * const alpha,
     erate[i] -= temp[i];
   }
   
-  double C[36];
-  elastic_->C(T, C);
-
-  mat_vec(C, 6, erate, 6, sdot);
-
-  return 0;
+  return elastic_->apply_C(T, erate, sdot);
 
 }
 
@@ -143,11 +138,7 @@ int TVPFlowRule::ds_ds(const double * const s, const double * const alpha,
     work[i] -= t3[i];
   }
 
-  elastic_->C(T, t3);
-
-  mat_mat(6,6,6, t3, work, d_sdot);
-
-  return 0;
+  return elastic_->apply_C_mat(T, work, 6, d_sdot);
 
 }
 
@@ -193,12 +184,7 @@ int TVPFlowRule::ds_da(const double * const s, const double * const alpha,
     work[i] -= t3[i];
   }
 
-  double C[36];
-  elastic_->C(T, C);
-
-  mat_mat(6, nhist(), 6, C, work, d_sdot);
-
-  return 0;
+  return elastic_->apply_C_mat(T, work, nhist(), d_sdot);
 
 }
 
@@ -366,11 +352,7 @@ int TVPFlowRule::work_rate(const double * const s,
 int TVPFlowRule::elastic_strains(const double * const s_np1, double T_np1,
                                  double * const e_np1) const
 {
-  double S[36];
-  elastic_->S(T_np1, S);
-  mat_vec(S, 6, s_np1, 6, e_np1);
-
-  return 0;
+  return elastic_->apply_S(T_np1, s_np1, e_np1);
 }
 
 int TVPFlowRule::set_elastic_model(std::shared_ptr<LinearElasticModel> emodel)
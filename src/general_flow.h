@@ -153,8 +153,6 @@ class TVPFlowRule : public GeneralFlowRule {
   std::shared_ptr<ViscoPlasticFlowRule> flow_;
 };
 
-static Register<TVPFlowRule> regTVPFlowRule;
-
 } // namespace neml
 
 #endif
@@ -66,8 +66,6 @@ class LinearIsotropicHardeningRule: public IsotropicHardeningRule {
   const std::shared_ptr<const Interpolate> s0_, K_;
 };
 
-static Register<LinearIsotropicHardeningRule> regLinearIsotropicHardeningRule;
-
 /// Isotropic hardening with flow stress from some interpolation function
 //    The convention will be to provide a flow curve as
 //    (plastic strain, flow stress) tuples, with the value of the curve at
@@ -93,9 +91,6 @@ class InterpolatedIsotropicHardeningRule: public IsotropicHardeningRule {
   const std::shared_ptr<const Interpolate> flow_;
 };
 
-static Register<InterpolatedIsotropicHardeningRule>
-  regInterpolatedIsotropicHardeningRule;
-
 /// Voce isotropic hardening
 class VoceIsotropicHardeningRule: public IsotropicHardeningRule {
  public:
@@ -128,8 +123,6 @@ class VoceIsotropicHardeningRule: public IsotropicHardeningRule {
   const std::shared_ptr<const Interpolate> s0_, R_, d_;
 };
 
-static Register<VoceIsotropicHardeningRule> regVoceIsotropicHardeningRule;
-
 /// Combined hardening rule superimposing a bunch of separate ones
 class CombinedIsotropicHardeningRule: public IsotropicHardeningRule {
  public:
@@ -157,8 +150,6 @@ class CombinedIsotropicHardeningRule: public IsotropicHardeningRule {
 
 };
 
-static Register<CombinedIsotropicHardeningRule> regCombinedIsotropicHardeningRule;
-
 /// Base class for pure kinematic hardening
 class KinematicHardeningRule: public HardeningRule {
  public:
@@ -198,8 +189,6 @@ class LinearKinematicHardeningRule: public KinematicHardeningRule {
   const std::shared_ptr<const Interpolate> H_;
 };
 
-static Register<LinearKinematicHardeningRule> regLinearKinematicHardeningRule;
-
 /// Class to combine isotropic and kinematic hardening rules
 class CombinedHardeningRule: public HardeningRule {
  public:
@@ -228,8 +217,6 @@ class CombinedHardeningRule: public HardeningRule {
   std::shared_ptr<KinematicHardeningRule> kin_;
 };
 
-static Register<CombinedHardeningRule> regCombinedHardeningRule;
-
 /// ABC of a non-associative hardening rule
 class NonAssociativeHardening: public NEMLObject {
  public:
@@ -312,8 +299,6 @@ class ConstantGamma: public GammaModel {
   const std::shared_ptr<const Interpolate> g_;
 };
 
-static Register<ConstantGamma> regConstantGamma;
-
 /// Gamma evolves with a saturating Voce form
 class SatGamma: public GammaModel {
  public:
@@ -344,8 +329,6 @@ class SatGamma: public GammaModel {
   const std::shared_ptr<const Interpolate> gs_, g0_, beta_;
 };
 
-static Register<SatGamma> regSatGamma;
-
 /// Chaboche model: generalized Frederick-Armstrong
 //    This model degenerates to Frederick-Armstrong for n = 1 and
 //    A = 0, a = 1
@@ -440,8 +423,6 @@ class Chaboche: public NonAssociativeHardening {
   const bool noniso_;
 };
 
-static Register<Chaboche> regChaboche;
-
 } // namespace neml
 
 #endif // HARDENING_H
@@ -5,15 +5,50 @@
 #include <math.h>
 #include <algorithm>
 #include <limits>
+#include <stdexcept>
 
 namespace neml {
 
+namespace {
+
+/// Names for the entries of a vector constant
+std::vector<std::string> indexed(const std::string & name, size_t n)
+{
+  std::vector<std::string> names;
+  for (size_t i = 0; i < n; i++) {
+    names.push_back(name + "[" + std::to_string(i) + "]");
+  }
+  return names;
+}
+
+/// Keep the parameters recorded by the Factory up to date
+void record(const NEMLObject & obj, const std::string & name, param_type value)
+{
+  if (obj.parameter_set() != nullptr) {
+    obj.parameter_set()->assign_parameter(name, value);
+  }
+}
+
+} // namespace
+
 Interpolate::Interpolate() :
     valid_(true)
 {
 
 }
 
+void Interpolate::value_vec(size_t n, const double * const x,
+                            double * const y) const
+{
+  for (size_t i = 0; i < n; i++) y[i] = value(x[i]);
+}
+
+void Interpolate::derivative_vec(size_t n, const double * const x,
+                                 double * const y) const
+{
+  for (size_t i = 0; i < n; i++) y[i] = derivative(x[i]);
+}
+
 double Interpolate::operator()(double x) const
 {
   return value(x);
@@ -24,14 +59,38 @@ bool Interpolate::valid() const
   return valid_;
 }
 
+std::vector<std::string> Interpolate::constant_names() const
+{
+  return {};
+}
+
+std::vector<double> Interpolate::constants() const
+{
+  return {};
+}
+
+void Interpolate::set_constants(const std::vector<double> & values)
+{
+  if (values.size() != constant_names().size()) {
+    throw std::invalid_argument("Wrong number of constants for the interpolate");
+  }
+  set_constants_(values);
+}
+
+void Interpolate::set_constants_(const std::vector<double> & values)
+{
+
+}
+
+bool Interpolate::constant_data() const
+{
+  return true;
+}
+
 PolynomialInterpolate::PolynomialInterpolate(const std::vector<double> coefs) :
     Interpolate(), coefs_(coefs)
 {
-  int n = coefs_.size();
-  deriv_.resize(n - 1);
-  for (int i = 0; i < n - 1; i++) {
-    deriv_[i] = coefs_[i] * ((double) (n - 1 - i));
-  }
+  setup_();
 }
 
 std::string PolynomialInterpolate::type()
@@ -65,20 +124,62 @@ double PolynomialInterpolate::derivative(double x) const
   return polyval(&deriv_[0], deriv_.size(), x);
 }
 
+void PolynomialInterpolate::value_vec(size_t n, const double * const x,
+                                      double * const y) const
+{
+  horner_vec_(coefs_, n, x, y);
+}
+
+void PolynomialInterpolate::derivative_vec(size_t n, const double * const x,
+                                           double * const y) const
+{
+  horner_vec_(deriv_, n, x, y);
+}
+
+void PolynomialInterpolate::horner_vec_(const std::vector<double> & c,
+                                        size_t n, const double * const x,
+                                        double * const y) const
+{
+  // Coefficient by coefficient so the inner loop is over the points
+  std::fill(y, y + n, 0.0);
+  for (double ci : c) {
+    for (size_t i = 0; i < n; i++) y[i] = y[i] * x[i] + ci;
+  }
+}
+
+std::vector<std::string> PolynomialInterpolate::constant_names() const
+{
+  return indexed("coefs", coefs_.size());
+}
+
+std::vector<double> PolynomialInterpolate::constants() const
+{
+  return coefs_;
+}
+
+void PolynomialInterpolate::set_constants_(const std::vector<double> & values)
+{
+  coefs_ = values;
+  setup_();
+  record(*this, "coefs", coefs_);
+}
+
+void PolynomialInterpolate::setup_()
+{
+  int n = coefs_.size();
+  deriv_.resize(n - 1);
+  for (int i = 0; i < n - 1; i++) {
+    deriv_[i] = coefs_[i] * ((double) (n - 1 - i));
+  }
+}
+
 
 PiecewiseLinearInterpolate::PiecewiseLinearInterpolate(
     const std::vector<double> points,
     const std::vector<double> values) :
       Interpolate(), points_(points), values_(values)
 {
-  // Check if sorted
-  if (not std::is_sorted(points.begin(), points.end())) {
-    valid_ = false; 
-  }
-
-  if (points.size() != values.size()) {
-    valid_ = false;
-  }
+  setup_();
 }
 
 std::string PiecewiseLinearInterpolate::type()
@@ -150,21 +251,54 @@ double PiecewiseLinearInterpolate::derivative(double x) const
   }
 }
 
-GenericPiecewiseInterpolate::GenericPiecewiseInterpolate(
-    std::vector<double> points,
-    std::vector<std::shared_ptr<Interpolate>> functions) :
-      Interpolate(), points_(points), functions_(functions)
+std::vector<std::string> PiecewiseLinearInterpolate::constant_names() const
+{
+  std::vector<std::string> names = indexed("points", points_.size());
+  std::vector<std::string> vnames = indexed("values", values_.size());
+  names.insert(names.end(), vnames.begin(), vnames.end());
+  return names;
+}
+
+std::vector<double> PiecewiseLinearInterpolate::constants() const
+{
+  std::vector<double> values = points_;
+  values.insert(values.end(), values_.begin(), values_.end());
+  return values;
+}
+
+void PiecewiseLinearInterpolate::set_constants_(
+    const std::vector<double> & values)
 {
+  size_t n = points_.size();
+  std::copy(values.begin(), values.begin() + n, points_.begin());
+  std::copy(values.begin() + n, values.end(), values_.begin());
+  setup_();
+  record(*this, "points", points_);
+  record(*this, "values", values_);
+}
+
+void PiecewiseLinearInterpolate::setup_()
+{
+  valid_ = true;
+
   // Check if sorted
-  if (not std::is_sorted(points.begin(), points.end())) {
+  if (not std::is_sorted(points_.begin(), points_.end())) {
     valid_ = false; 
   }
 
-  if (points.size() != (functions.size()+1)) {
+  if (points_.size() != values_.size()) {
     valid_ = false;
   }
 }
 
+GenericPiecewiseInterpolate::GenericPiecewiseInterpolate(
+    std::vector<double> points,
+    std::vector<std::shared_ptr<Interpolate>> functions) :
+      Interpolate(), points_(points), functions_(functions)
+{
+  setup_();
+}
+
 std::string GenericPiecewiseInterpolate::type()
 {
   return "GenericPiecewiseInterpolate";
@@ -226,24 +360,44 @@ double GenericPiecewiseInterpolate::derivative(double x) const
   }
 }
 
-PiecewiseLogLinearInterpolate::PiecewiseLogLinearInterpolate(
-    const std::vector<double> points,
-    const std::vector<double> values) :
-      Interpolate(), points_(points), values_(values)
+std::vector<std::string> GenericPiecewiseInterpolate::constant_names() const
+{
+  return indexed("points", points_.size());
+}
+
+std::vector<double> GenericPiecewiseInterpolate::constants() const
 {
+  return points_;
+}
+
+void GenericPiecewiseInterpolate::set_constants_(
+    const std::vector<double> & values)
+{
+  points_ = values;
+  setup_();
+  record(*this, "points", points_);
+}
+
+void GenericPiecewiseInterpolate::setup_()
+{
+  valid_ = true;
+
   // Check if sorted
-  if (not std::is_sorted(points.begin(), points.end())) {
+  if (not std::is_sorted(points_.begin(), points_.end())) {
     valid_ = false; 
   }
 
-  if (points.size() != values.size()) {
+  if (points_.size() != (functions_.size()+1)) {
     valid_ = false;
   }
+}
 
-  for (auto it = values_.begin(); it != values_.end(); ++it) {
-    if (*it < 0.0) valid_ = false;
-    *it = log(*it);
-  }
+PiecewiseLogLinearInterpolate::PiecewiseLogLinearInterpolate(
+    const std::vector<double> points,
+    const std::vector<double> values) :
+      Interpolate(), points_(points), input_values_(values)
+{
+  setup_();
 }
 
 std::string PiecewiseLogLinearInterpolate::type()
@@ -315,6 +469,52 @@ double PiecewiseLogLinearInterpolate::derivative(double x) const
   }
 }
 
+std::vector<std::string> PiecewiseLogLinearInterpolate::constant_names() const
+{
+  std::vector<std::string> names = indexed("points", points_.size());
+  std::vector<std::string> vnames = indexed("values", input_values_.size());
+  names.insert(names.end(), vnames.begin(), vnames.end());
+  return names;
+}
+
+std::vector<double> PiecewiseLogLinearInterpolate::constants() const
+{
+  std::vector<double> values = points_;
+  values.insert(values.end(), input_values_.begin(), input_values_.end());
+  return values;
+}
+
+void PiecewiseLogLinearInterpolate::set_constants_(
+    const std::vector<double> & values)
+{
+  size_t n = points_.size();
+  std::copy(values.begin(), values.begin() + n, points_.begin());
+  std::copy(values.begin() + n, values.end(), input_values_.begin());
+  setup_();
+  record(*this, "points", points_);
+  record(*this, "values", input_values_);
+}
+
+void PiecewiseLogLinearInterpolate::setup_()
+{
+  valid_ = true;
+
+  // Check if sorted
+  if (not std::is_sorted(points_.begin(), points_.end())) {
+    valid_ = false; 
+  }
+
+  if (points_.size() != input_values_.size()) {
+    valid_ = false;
+  }
+
+  values_ = input_values_;
+  for (auto it = values_.begin(); it != values_.end(); ++it) {
+    if (*it < 0.0) valid_ = false;
+    *it = log(*it);
+  }
+}
+
 ConstantInterpolate::ConstantInterpolate(double v) :
     Interpolate(), v_(v)
 {
@@ -352,6 +552,39 @@ double ConstantInterpolate::derivative(double x) const
   return 0.0;
 }
 
+void ConstantInterpolate::value_vec(size_t n, const double * const x,
+                                    double * const y) const
+{
+  std::fill(y, y + n, v_);
+}
+
+void ConstantInterpolate::derivative_vec(size_t n, const double * const x,
+                                         double * const y) const
+{
+  std::fill(y, y + n, 0.0);
+}
+
+std::vector<std::string> ConstantInterpolate::constant_names() const
+{
+  return {"v"};
+}
+
+std::vector<double> ConstantInterpolate::constants() const
+{
+  return {v_};
+}
+
+void ConstantInterpolate::set_constants_(const std::vector<double> & values)
+{
+  v_ = values[0];
+  record(*this, "v", v_);
+}
+
+std::shared_ptr<NEMLObject> ConstantInterpolate::copy_direct() const
+{
+  return std::make_shared<ConstantInterpolate>(v_);
+}
+
 ExpInterpolate::ExpInterpolate(double A, double B) :
     Interpolate(), A_(A), B_(B)
 {
@@ -391,6 +624,24 @@ double ExpInterpolate::derivative(double x) const
   return -A_ * B_ * exp(B_ / x) / (x*x);
 }
 
+std::vector<std::string> ExpInterpolate::constant_names() const
+{
+  return {"A", "B"};
+}
+
+std::vector<double> ExpInterpolate::constants() const
+{
+  return {A_, B_};
+}
+
+void ExpInterpolate::set_constants_(const std::vector<double> & values)
+{
+  A_ = values[0];
+  B_ = values[1];
+  record(*this, "A", A_);
+  record(*this, "B", B_);
+}
+
 MTSShearInterpolate::MTSShearInterpolate(double V0, double D, double T0) :
     Interpolate(), V0_(V0), D_(D), T0_(T0)
 {
@@ -432,6 +683,26 @@ double MTSShearInterpolate::derivative(double x) const
   return -D_ * T0_ / (4.0 * pow(x * sinh(T0_ / (2 * x)),2));
 }
 
+std::vector<std::string> MTSShearInterpolate::constant_names() const
+{
+  return {"V0", "D", "T0"};
+}
+
+std::vector<double> MTSShearInterpolate::constants() const
+{
+  return {V0_, D_, T0_};
+}
+
+void MTSShearInterpolate::set_constants_(const std::vector<double> & values)
+{
+  V0_ = values[0];
+  D_ = values[1];
+  T0_ = values[2];
+  record(*this, "V0", V0_);
+  record(*this, "D", D_);
+  record(*this, "T0", T0_);
+}
+
 std::vector<std::shared_ptr<Interpolate>> 
     make_vector(const std::vector<double> & iv)
 {
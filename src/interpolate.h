@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 namespace neml {
 
@@ -18,12 +19,32 @@ class Interpolate: public NEMLObject {
   virtual double value(double x) const = 0;
   /// Returns the derivative of the function
   virtual double derivative(double x) const = 0;
+  /// Values of the function at each of n points
+  virtual void value_vec(size_t n, const double * const x, 
+                         double * const y) const;
+  /// Derivatives of the function at each of n points
+  virtual void derivative_vec(size_t n, const double * const x,
+                              double * const y) const;
   /// Nice wrapper for function call syntax
   double operator()(double x) const;
   /// Is the interpolate valid?
   bool valid() const;
 
+  /// Names of the constants defining the function, empty if they can't
+  /// be changed in place
+  virtual std::vector<std::string> constant_names() const;
+  /// Current values of the constants, in the order of constant_names
+  virtual std::vector<double> constants() const;
+  /// Change the constants in place
+  void set_constants(const std::vector<double> & values);
+
+  /// Interpolates only hold parameter data
+  virtual bool constant_data() const;
+
  protected:
+  /// Store new constants and update anything derived from them
+  virtual void set_constants_(const std::vector<double> & values);
+
   bool valid_;
 };
 
@@ -42,14 +63,27 @@ class PolynomialInterpolate : public Interpolate {
   
   virtual double value(double x) const;
   virtual double derivative(double x) const;
+  virtual void value_vec(size_t n, const double * const x,
+                         double * const y) const;
+  virtual void derivative_vec(size_t n, const double * const x,
+                              double * const y) const;
+
+  virtual std::vector<std::string> constant_names() const;
+  virtual std::vector<double> constants() const;
+
+ protected:
+  virtual void set_constants_(const std::vector<double> & values);
+
+ private:
+  void setup_();
+  void horner_vec_(const std::vector<double> & c, size_t n,
+                   const double * const x, double * const y) const;
 
  private:
-  const std::vector<double> coefs_;
+  std::vector<double> coefs_;
   std::vector<double> deriv_;
 };
 
-static Register<PolynomialInterpolate> regPolynomialInterpolate;
-
 /// Generic piecewise interpolation
 class GenericPiecewiseInterpolate: public Interpolate {
  public:
@@ -66,13 +100,20 @@ class GenericPiecewiseInterpolate: public Interpolate {
   virtual double value(double x) const;
   virtual double derivative(double x) const;
 
+  virtual std::vector<std::string> constant_names() const;
+  virtual std::vector<double> constants() const;
+
+ protected:
+  virtual void set_constants_(const std::vector<double> & values);
+
  private:
-  const std::vector<double> points_;
+  void setup_();
+
+ private:
+  std::vector<double> points_;
   const std::vector<std::shared_ptr<Interpolate>> functions_;
 };
 
-static Register<GenericPiecewiseInterpolate> regGenericPiecewiseInterpolate;
-
 /// Piecewise linear interpolation
 class PiecewiseLinearInterpolate: public Interpolate {
  public:
@@ -91,11 +132,18 @@ class PiecewiseLinearInterpolate: public Interpolate {
   virtual double value(double x) const;
   virtual double derivative(double x) const;
 
+  virtual std::vector<std::string> constant_names() const;
+  virtual std::vector<double> constants() const;
+
+ protected:
+  virtual void set_constants_(const std::vector<double> & values);
+
  private:
-  const std::vector<double> points_, values_;
-};
+  void setup_();
 
-static Register<PiecewiseLinearInterpolate> regPiecewiseLinearInterpolate;
+ private:
+  std::vector<double> points_, values_;
+};
 
 /// Piecewise loglinear interpolation
 class PiecewiseLogLinearInterpolate: public Interpolate {
@@ -115,12 +163,20 @@ class PiecewiseLogLinearInterpolate: public Interpolate {
   virtual double value(double x) const;
   virtual double derivative(double x) const;
 
+  virtual std::vector<std::string> constant_names() const;
+  virtual std::vector<double> constants() const;
+
+ protected:
+  virtual void set_constants_(const std::vector<double> & values);
+
  private:
-  const std::vector<double> points_;
-  std::vector<double> values_;
-};
+  void setup_();
 
-static Register<PiecewiseLogLinearInterpolate> regPiecewiseLogLinearInterpolate;
+ private:
+  std::vector<double> points_;
+  // The values as given and their logs
+  std::vector<double> input_values_, values_;
+};
 
 /// A constant value
 class ConstantInterpolate : public Interpolate {
@@ -137,13 +193,24 @@ class ConstantInterpolate : public Interpolate {
 
   virtual double value(double x) const;
   virtual double derivative(double x) const;
+  virtual void value_vec(size_t n, const double * const x,
+                         double * const y) const;
+  virtual void derivative_vec(size_t n, const double * const x,
+                              double * const y) const;
+
+  virtual std::vector<std::string> constant_names() const;
+  virtual std::vector<double> constants() const;
+
+  /// The parsers make these directly from plain numbers
+  virtual std::shared_ptr<NEMLObject> copy_direct() const;
+
+ protected:
+  virtual void set_constants_(const std::vector<double> & values);
 
  private:
-  const double v_;
+  double v_;
 };
 
-static Register<ConstantInterpolate> regConstantInterpolate;
-
 /// A*exp(B/x)
 class ExpInterpolate : public Interpolate {
  public:
@@ -160,12 +227,16 @@ class ExpInterpolate : public Interpolate {
   virtual double value(double x) const;
   virtual double derivative(double x) const;
 
+  virtual std::vector<std::string> constant_names() const;
+  virtual std::vector<double> constants() const;
+
+ protected:
+  virtual void set_constants_(const std::vector<double> & values);
+
  private:
-  const double A_, B_;
+  double A_, B_;
 };
 
-static Register<ExpInterpolate> regExpInterpolate;
-
 /// The MTS shear modulus function proposed in the original paper
 class MTSShearInterpolate : public Interpolate {
  public:
@@ -182,12 +253,16 @@ class MTSShearInterpolate : public Interpolate {
   virtual double value(double x) const;
   virtual double derivative(double x) const;
 
+  virtual std::vector<std::string> constant_names() const;
+  virtual std::vector<double> constants() const;
+
+ protected:
+  virtual void set_constants_(const std::vector<double> & values);
+
  private:
-  const double V0_, D_, T0_;
+  double V0_, D_, T0_;
 };
 
-static Register<MTSShearInterpolate> regMTSShearInterpolate;
-
 /// A helper to make a vector of constant interpolates from a vector
 std::vector<std::shared_ptr<Interpolate>> 
   make_vector(const std::vector<double> & iv);
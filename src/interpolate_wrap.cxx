@@ -18,12 +18,46 @@ PYBIND11_MODULE(interpolate, m) {
   py::class_<Interpolate, NEMLObject, std::shared_ptr<Interpolate>>(m, "Interpolate")
       .def("value", &Interpolate::value, "Interpolate to x")
       .def("derivative", &Interpolate::derivative, "Derivative at x")
+      .def("value_vec",
+           [](const Interpolate & m, py::object x) -> py::array_t<double>
+           {
+            std::vector<size_t> shape;
+            auto xa = broadcast_arrays({x}, {{}}, {"x"}, shape)[0];
+            auto y = alloc_array<double>(shape);
+            auto xa_ptr = xa.data();
+            auto y_ptr = y.mutable_data();
+            {
+              py::gil_scoped_release release;
+              m.value_vec(y.size(), xa_ptr, y_ptr);
+            }
+            return y;
+           }, "Interpolate to each entry of an array of x", py::arg("x"))
+      .def("derivative_vec",
+           [](const Interpolate & m, py::object x) -> py::array_t<double>
+           {
+            std::vector<size_t> shape;
+            auto xa = broadcast_arrays({x}, {{}}, {"x"}, shape)[0];
+            auto y = alloc_array<double>(shape);
+            auto xa_ptr = xa.data();
+            auto y_ptr = y.mutable_data();
+            {
+              py::gil_scoped_release release;
+              m.derivative_vec(y.size(), xa_ptr, y_ptr);
+            }
+            return y;
+           }, "Derivative at each entry of an array of x", py::arg("x"))
       .def("__call__", 
            [](Interpolate & m, double x) -> double
            {
             return m(x);
            }, "Operator overload ()")
       .def_property_readonly("valid", &Interpolate::valid)
+      .def_property_readonly("constant_names", &Interpolate::constant_names,
+                             "Names of the constants defining the function.")
+      .def("constants", &Interpolate::constants, 
+           "Current values of the constants.")
+      .def("set_constants", &Interpolate::set_constants,
+           "Change the constants in place.")
       ;
 
   py::class_<PolynomialInterpolate, Interpolate, std::shared_ptr<PolynomialInterpolate>>(m, "PolynomialInterpolate")
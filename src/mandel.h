@@ -0,0 +1,404 @@
+#ifndef MANDEL_H
+#define MANDEL_H
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+// Fixed size Mandel tensor types and inline kernels.
+//
+// The sizes are compile time constants so the compiler can unroll and
+// vectorize the loops, which is much faster than calling BLAS for the
+// 6 and 9 dimensional operations used throughout the models.
+//
+// Conventions match nemlmath.h:
+// symmetric: [E(0,0), E(1,1), E(2,2), sqrt(2) E(1,2), sqrt(2) E(0,2), sqrt(2) E(0,1)]
+// skew: [-W(1,2), W(0,2), -W(0,1)]
+// matrices are row major
+
+namespace neml {
+
+/// Fixed size vector
+template <int N>
+struct FixedVector {
+  static const int size = N;
+
+  double & operator[](int i) { return v[i]; };
+  const double & operator[](int i) const { return v[i]; };
+
+  double * data() { return v; };
+  const double * data() const { return v; };
+
+  double v[N];
+};
+
+/// Fixed size, row major matrix
+template <int M, int N>
+struct FixedMatrix {
+  static const int rows = M;
+  static const int cols = N;
+
+  double & operator()(int i, int j) { return v[i*N+j]; };
+  const double & operator()(int i, int j) const { return v[i*N+j]; };
+
+  double * data() { return v; };
+  const double * data() const { return v; };
+
+  double v[M*N];
+};
+
+/// Symmetric rank 2 tensor in Mandel notation
+typedef FixedVector<6> Sym6;
+/// Skew rank 2 tensor
+typedef FixedVector<3> Skew3;
+/// Symmetric rank 4 tensor in Mandel notation
+typedef FixedMatrix<6,6> Mat66;
+/// Full rank 4 tensor
+typedef FixedMatrix<9,9> Mat99;
+
+namespace fixed {
+
+// Pointer level kernels, these are what the value types and the
+// nemlmath.h adapters use.  Outputs may alias inputs.
+
+/// Zero a vector
+template <int N>
+inline void zero(double * const a)
+{
+  for (int i=0; i<N; i++) a[i] = 0.0;
+}
+
+/// Copy a vector
+template <int N>
+inline void copy(const double * const a, double * const b)
+{
+  for (int i=0; i<N; i++) b[i] = a[i];
+}
+
+/// c = a + b
+template <int N>
+inline void add(const double * const a, const double * const b,
+                double * const c)
+{
+  for (int i=0; i<N; i++) c[i] = a[i] + b[i];
+}
+
+/// c = a - b
+template <int N>
+inline void sub(const double * const a, const double * const b,
+                double * const c)
+{
+  for (int i=0; i<N; i++) c[i] = a[i] - b[i];
+}
+
+/// b = s * a
+template <int N>
+inline void scale(double s, const double * const a, double * const b)
+{
+  for (int i=0; i<N; i++) b[i] = s * a[i];
+}
+
+/// a . b
+template <int N>
+inline double dot(const double * const a, const double * const b)
+{
+  double sum = 0.0;
+  for (int i=0; i<N; i++) sum += a[i] * b[i];
+  return sum;
+}
+
+/// Two norm
+template <int N>
+inline double norm2(const double * const a)
+{
+  return std::sqrt(dot<N>(a, a));
+}
+
+/// Deviatoric part of a Mandel vector
+inline void dev(const double * const a, double * const b)
+{
+  double tr = (a[0] + a[1] + a[2]) / 3.0;
+  for (int i=0; i<3; i++) b[i] = a[i] - tr;
+  for (int i=3; i<6; i++) b[i] = a[i];
+}
+
+/// C = a outer b
+template <int M, int N>
+inline void outer(const double * const a, const double * const b,
+                  double * const C)
+{
+  for (int i=0; i<M; i++) {
+    for (int j=0; j<N; j++) {
+      C[i*N+j] = a[i] * b[j];
+    }
+  }
+}
+
+/// C += s * (a outer b)
+template <int M, int N>
+inline void outer_update(double s, const double * const a,
+                         const double * const b, double * const C)
+{
+  for (int i=0; i<M; i++) {
+    double sa = s * a[i];
+    for (int j=0; j<N; j++) {
+      C[i*N+j] += sa * b[j];
+    }
+  }
+}
+
+/// c = A . b
+template <int M, int N>
+inline void mat_vec(const double * const A, const double * const b,
+                    double * const c)
+{
+  double r[M];
+  for (int i=0; i<M; i++) {
+    double sum = 0.0;
+    for (int j=0; j<N; j++) {
+      sum += A[i*N+j] * b[j];
+    }
+    r[i] = sum;
+  }
+  copy<M>(r, c);
+}
+
+/// c = A.T . b
+template <int M, int N>
+inline void mat_vec_trans(const double * const A, const double * const b,
+                          double * const c)
+{
+  double r[N];
+  zero<N>(r);
+  for (int i=0; i<M; i++) {
+    for (int j=0; j<N; j++) {
+      r[j] += A[i*N+j] * b[i];
+    }
+  }
+  copy<N>(r, c);
+}
+
+/// C = A . B with A (M x K) and B (K x N)
+template <int M, int N, int K>
+inline void mat_mat(const double * const A, const double * const B,
+                    double * const C)
+{
+  double R[M*N];
+  zero<M*N>(R);
+  for (int i=0; i<M; i++) {
+    for (int k=0; k<K; k++) {
+      double a = A[i*K+k];
+      for (int j=0; j<N; j++) {
+        R[i*N+j] += a * B[k*N+j];
+      }
+    }
+  }
+  copy<M*N>(R, C);
+}
+
+/// Solve A X = B in place for N x N A and N x R B (row major), using
+/// Gaussian elimination with partial pivoting.  A is destroyed and B is
+/// overwritten with X.  Returns false if A is singular.
+template <int N, int R>
+inline bool solve(double * const A, double * const B)
+{
+  for (int k=0; k<N; k++) {
+    int p = k;
+    double big = std::fabs(A[k*N+k]);
+    for (int i=k+1; i<N; i++) {
+      if (std::fabs(A[i*N+k]) > big) {
+        big = std::fabs(A[i*N+k]);
+        p = i;
+      }
+    }
+    if (big == 0.0) return false;
+    if (p != k) {
+      for (int j=0; j<N; j++) std::swap(A[k*N+j], A[p*N+j]);
+      for (int j=0; j<R; j++) std::swap(B[k*R+j], B[p*R+j]);
+    }
+    for (int i=k+1; i<N; i++) {
+      double f = A[i*N+k] / A[k*N+k];
+      for (int j=k+1; j<N; j++) A[i*N+j] -= f * A[k*N+j];
+      for (int j=0; j<R; j++) B[i*R+j] -= f * B[k*R+j];
+    }
+  }
+  for (int k=N-1; k>=0; k--) {
+    for (int j=0; j<R; j++) {
+      double sum = B[k*R+j];
+      for (int i=k+1; i<N; i++) sum -= A[k*N+i] * B[i*R+j];
+      B[k*R+j] = sum / A[k*N+k];
+    }
+  }
+  return true;
+}
+
+/// Convert a mandel matrix to a full 9x9
+inline void mandel2full(const double * const M, double * const A)
+{
+  const double s2 = std::sqrt(2.0) / 2.0;
+  // Mandel index of each (i,j) pair of a full 3x3 index
+  const int mi[9] = {0, 5, 4, 5, 1, 3, 4, 3, 2};
+  for (int a=0; a<9; a++) {
+    double fa = (mi[a] < 3) ? 1.0 : s2;
+    for (int b=0; b<9; b++) {
+      double fb = (mi[b] < 3) ? 1.0 : s2;
+      A[a*9+b] = fa * fb * M[mi[a]*6+mi[b]];
+    }
+  }
+}
+
+/// Form the 9x9 matrix used in the Truesdell update
+inline void truesdell_mat(const double * const D, const double * const W,
+                          double * const M)
+{
+  // Full (row major) forms of D and W
+  const double s2 = std::sqrt(2.0) / 2.0;
+  double d[9] = {D[0], s2*D[5], s2*D[4],
+                 s2*D[5], D[1], s2*D[3],
+                 s2*D[4], s2*D[3], D[2]};
+  double w[9] = {0.0, -W[2], W[1],
+                 W[2], 0.0, -W[0],
+                 -W[1], W[0], 0.0};
+  double tr = D[0] + D[1] + D[2];
+
+  // M_ijkl = (1 + tr(D)) d_ik d_jl - L_ik d_jl - d_ik L_jl with L = D + W
+  zero<81>(M);
+  for (int i=0; i<3; i++) {
+    for (int j=0; j<3; j++) {
+      int r = i*3+j;
+      M[r*9+r] += 1.0 + tr;
+      for (int k=0; k<3; k++) {
+        M[r*9+k*3+j] -= d[i*3+k] + w[i*3+k];
+        M[r*9+i*3+k] -= d[j*3+k] + w[j*3+k];
+      }
+    }
+  }
+}
+
+}
+
+// Value type operations
+
+template <int N>
+inline FixedVector<N> operator+(const FixedVector<N> & a,
+                                const FixedVector<N> & b)
+{
+  FixedVector<N> c;
+  fixed::add<N>(a.v, b.v, c.v);
+  return c;
+}
+
+template <int N>
+inline FixedVector<N> operator-(const FixedVector<N> & a,
+                                const FixedVector<N> & b)
+{
+  FixedVector<N> c;
+  fixed::sub<N>(a.v, b.v, c.v);
+  return c;
+}
+
+template <int N>
+inline FixedVector<N> operator*(double s, const FixedVector<N> & a)
+{
+  FixedVector<N> b;
+  fixed::scale<N>(s, a.v, b.v);
+  return b;
+}
+
+template <int M, int N>
+inline FixedMatrix<M,N> operator+(const FixedMatrix<M,N> & A,
+                                  const FixedMatrix<M,N> & B)
+{
+  FixedMatrix<M,N> C;
+  fixed::add<M*N>(A.v, B.v, C.v);
+  return C;
+}
+
+template <int M, int N>
+inline FixedMatrix<M,N> operator-(const FixedMatrix<M,N> & A,
+                                  const FixedMatrix<M,N> & B)
+{
+  FixedMatrix<M,N> C;
+  fixed::sub<M*N>(A.v, B.v, C.v);
+  return C;
+}
+
+template <int M, int N>
+inline FixedMatrix<M,N> operator*(double s, const FixedMatrix<M,N> & A)
+{
+  FixedMatrix<M,N> B;
+  fixed::scale<M*N>(s, A.v, B.v);
+  return B;
+}
+
+/// Matrix-vector product
+template <int M, int N>
+inline FixedVector<M> operator*(const FixedMatrix<M,N> & A,
+                                const FixedVector<N> & b)
+{
+  FixedVector<M> c;
+  fixed::mat_vec<M,N>(A.v, b.v, c.v);
+  return c;
+}
+
+/// Matrix-matrix product
+template <int M, int N, int K>
+inline FixedMatrix<M,N> operator*(const FixedMatrix<M,K> & A,
+                                  const FixedMatrix<K,N> & B)
+{
+  FixedMatrix<M,N> C;
+  fixed::mat_mat<M,N,K>(A.v, B.v, C.v);
+  return C;
+}
+
+/// Contraction a : b
+template <int N>
+inline double dot(const FixedVector<N> & a, const FixedVector<N> & b)
+{
+  return fixed::dot<N>(a.v, b.v);
+}
+
+/// Two norm
+template <int N>
+inline double norm(const FixedVector<N> & a)
+{
+  return fixed::norm2<N>(a.v);
+}
+
+/// Outer product
+template <int M, int N>
+inline FixedMatrix<M,N> outer(const FixedVector<M> & a,
+                              const FixedVector<N> & b)
+{
+  FixedMatrix<M,N> C;
+  fixed::outer<M,N>(a.v, b.v, C.v);
+  return C;
+}
+
+/// Deviatoric part
+inline Sym6 dev(const Sym6 & a)
+{
+  Sym6 b;
+  fixed::dev(a.v, b.v);
+  return b;
+}
+
+/// Convert a Mandel matrix to a full 9x9
+inline Mat99 mandel2full(const Mat66 & M)
+{
+  Mat99 A;
+  fixed::mandel2full(M.v, A.v);
+  return A;
+}
+
+/// The 9x9 matrix used in the Truesdell update
+inline Mat99 truesdell_mat(const Sym6 & D, const Skew3 & W)
+{
+  Mat99 M;
+  fixed::truesdell_mat(D.v, W.v, M.v);
+  return M;
+}
+
+}
+
+#endif // MANDEL_H
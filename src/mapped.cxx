@@ -0,0 +1,53 @@
+#include "mapped.h"
+
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace neml {
+
+MappedFile::MappedFile(std::string fname) :
+    data_(nullptr), size_(0), mapped_(false)
+{
+#ifndef _WIN32
+  int fd = open(fname.c_str(), O_RDONLY);
+  if (fd < 0) throw FileMapError(fname, "cannot open file");
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    throw FileMapError(fname, "cannot stat file");
+  }
+  size_ = st.st_size;
+  if (size_ > 0) {
+    void * map = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+      data_ = static_cast<const char*>(map);
+      mapped_ = true;
+    }
+  }
+  close(fd);
+  if (mapped_ || size_ == 0) return;
+#endif
+  // Fall back to reading the whole file
+  std::ifstream is(fname, std::ios::binary);
+  if (not is.good()) throw FileMapError(fname, "cannot open file");
+  buffer_.assign(std::istreambuf_iterator<char>(is),
+                 std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+  if (mapped_) munmap(const_cast<char*>(data_), size_);
+#endif
+}
+
+} // namespace neml
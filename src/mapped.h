@@ -0,0 +1,54 @@
+#ifndef MAPPED_H
+#define MAPPED_H
+
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace neml {
+
+/// Read only view of a whole file, memory mapped where the platform
+/// supports it (otherwise read into a buffer)
+class MappedFile {
+ public:
+  /// Map the file, throws FileMapError if it cannot be opened
+  MappedFile(std::string fname);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile & operator=(const MappedFile &) = delete;
+
+  /// Start of the file contents
+  const char * data() const {return data_;};
+  /// Size of the file in bytes
+  size_t size() const {return size_;};
+
+ private:
+  const char * data_;
+  size_t size_;
+  bool mapped_;
+  std::vector<char> buffer_;
+};
+
+/// Error opening or mapping a file
+class FileMapError: public std::exception {
+ public:
+  FileMapError(std::string fname, std::string problem) :
+      msg_(fname + ": " + problem)
+  {
+
+  };
+
+  const char * what() const throw ()
+  {
+    return msg_.c_str();
+  };
+
+ private:
+  std::string msg_;
+};
+
+} // namespace neml
+
+#endif // MAPPED_H
@@ -2,19 +2,80 @@
 
 #include "nemlmath.h"
 #include "nemlerror.h"
+#include "parallel.h"
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 
 namespace neml {
 
+namespace {
+
+// Points per block in the batch updates, enough to amortize the
+// scheduling
+const size_t BATCH_GRAIN = 16;
+
+} // namespace
+
+// NEMLModel implementation
+int NEMLModel::update_sd_vec(
+    size_t n,
+    const double * const e_np1, const double * const e_n,
+    const double * const T_np1, const double * const T_n,
+    const double * const t_np1, const double * const t_n,
+    double * const s_np1, const double * const s_n,
+    double * const h_np1, const double * const h_n,
+    double * const A_np1,
+    double * const u_np1, const double * const u_n,
+    double * const p_np1, const double * const p_n,
+    unsigned nthreads)
+{
+  size_t nh = nstore();
+  std::vector<int> ier(n, SUCCESS);
+  parallel_for(n, nthreads, [&](size_t i)
+  {
+    ier[i] = update_sd(&e_np1[6*i], &e_n[6*i], T_np1[i], T_n[i],
+                       t_np1[i], t_n[i], &s_np1[6*i], &s_n[6*i],
+                       &h_np1[nh*i], &h_n[nh*i], &A_np1[36*i],
+                       u_np1[i], u_n[i], p_np1[i], p_n[i]);
+  }, BATCH_GRAIN);
+  return first_error(ier);
+}
+
+int NEMLModel::update_ld_inc_vec(
+    size_t n,
+    const double * const d_np1, const double * const d_n,
+    const double * const w_np1, const double * const w_n,
+    const double * const T_np1, const double * const T_n,
+    const double * const t_np1, const double * const t_n,
+    double * const s_np1, const double * const s_n,
+    double * const h_np1, const double * const h_n,
+    double * const A_np1, double * const B_np1,
+    double * const u_np1, const double * const u_n,
+    double * const p_np1, const double * const p_n,
+    unsigned nthreads)
+{
+  size_t nh = nstore();
+  std::vector<int> ier(n, SUCCESS);
+  parallel_for(n, nthreads, [&](size_t i)
+  {
+    ier[i] = update_ld_inc(&d_np1[6*i], &d_n[6*i], &w_np1[3*i], &w_n[3*i],
+                           T_np1[i], T_n[i], t_np1[i], t_n[i],
+                           &s_np1[6*i], &s_n[6*i], &h_np1[nh*i], &h_n[nh*i],
+                           &A_np1[36*i], &B_np1[18*i],
+                           u_np1[i], u_n[i], p_np1[i], p_n[i]);
+  }, BATCH_GRAIN);
+  return first_error(ier);
+}
+
 // NEMLModel_sd implementation
 NEMLModel_sd::NEMLModel_sd(
     std::shared_ptr<LinearElasticModel> emodel,
     std::shared_ptr<Interpolate> alpha, 
-    bool truesdell) :
+    bool truesdell, bool tangent_outer) :
       NEMLModel(), elastic_(emodel), alpha_(alpha),
-      truesdell_(truesdell)
+      truesdell_(truesdell), tangent_outer_(tangent_outer)
 {
 
 }
@@ -91,12 +152,7 @@ int NEMLModel_sd::elastic_strains(const double * const s_np1,
                                            const double * const h_np1,
                                            double * const e_np1) const
 {
-  double S[36];
-  int ier = elastic_->S(T_np1, S);
-  if (ier != SUCCESS) {
-    return ier;
-  }
-  return mat_vec(S, 6, s_np1, 6, e_np1);
+  return elastic_->apply_S(T_np1, s_np1, e_np1);
 }
 
 double NEMLModel_sd::bulk(double T) const
@@ -117,40 +173,94 @@ int NEMLModel_sd::set_elastic_model(std::shared_ptr<LinearElasticModel> emodel)
 
 int NEMLModel_sd::calc_tangent_(const double * const D, const double * const W,
                                 const double * const C, const double * const S,
-                                double * const A, double * const B)
-{
-  int ier;
-  double J[81];
-  double O[81];
-
-  truesdell_mat(D, W, J);
-  ier = invert_mat(J, 9);
-  if (ier != 0) return ier;
-
-  truesdell_tangent_outer(S, O);
-
-  double F[81];
-  mandel2full(C, F);
-  double dL[81];
-  mat_mat(9,9,9, F, idsym, dL);
-
-  double T1[81];
-  for (int i=0; i<81; i++) T1[i] = dL[i] + O[i];
-
-  double L[81];
-  mat_mat(9,9,9, J, T1, L);
-
-  double Dpart[81];
-  double Wpart[81];
+                                double * const A, double * const B) const
+{
+  // The update operator X -> (1 + tr(D)) X - L X - X L^T maps symmetric
+  // tensors onto symmetric tensors and the right hand sides are all
+  // symmetric, so only the 6x6 Mandel block of the 9x9 system is needed.
+  // Columns are formed by applying the operators to the Mandel and skew
+  // basis tensors.
+  double L[9];
+  usym(D, L);
+  L[1] -= W[2];
+  L[2] += W[1];
+  L[3] += W[2];
+  L[5] -= W[0];
+  L[6] -= W[1];
+  L[7] += W[0];
+  double LT[9];
+  for (int i=0; i<3; i++) {
+    for (int j=0; j<3; j++) {
+      LT[CINDEX(i,j,3)] = L[CINDEX(j,i,3)];
+    }
+  }
+  double trD = D[0] + D[1] + D[2];
+
+  double Sf[9];
+  usym(S, Sf);
+
+  // RHS, [A | B] as one 6x9 row major block
+  double RHS[54];
+  std::fill(RHS, RHS+54, 0.0);
+
+  double J[36];
+  double e[6];
+  double X[9];
+  double Y[9];
+  double T[9];
+  double c[6];
+  for (int k=0; k<6; k++) {
+    std::fill(e, e+6, 0.0);
+    e[k] = 1.0;
+    usym(e, X);
+
+    // (1 + tr(D)) X - L X - X L^T
+    fixed::mat_mat<3,3,3>(L, X, Y);
+    fixed::mat_mat<3,3,3>(X, LT, T);
+    for (int i=0; i<9; i++) Y[i] = (1.0 + trD) * X[i] - Y[i] - T[i];
+    sym(Y, c);
+    for (int i=0; i<6; i++) J[CINDEX(i,k,6)] = c[i];
+
+    for (int i=0; i<6; i++) RHS[CINDEX(i,k,9)] = C[CINDEX(i,k,6)];
+
+    // Truesdell outer terms: X S + S X - tr(X) S
+    if (tangent_outer_) {
+      fixed::mat_mat<3,3,3>(X, Sf, Y);
+      fixed::mat_mat<3,3,3>(Sf, X, T);
+      double trX = X[0] + X[4] + X[8];
+      for (int i=0; i<9; i++) Y[i] += T[i] - trX * Sf[i];
+      sym(Y, c);
+      for (int i=0; i<6; i++) RHS[CINDEX(i,k,9)] += c[i];
+    }
+  }
 
-  mat_mat(9,9,9, L, idsym, Dpart);
-  mat_mat(9,9,9, L, idskew, Wpart);
+  // Spin terms: X S - S X
+  if (tangent_outer_) {
+    double w[3];
+    for (int k=0; k<3; k++) {
+      std::fill(w, w+3, 0.0);
+      w[k] = 1.0;
+      std::fill(X, X+9, 0.0);
+      X[1] = -w[2];
+      X[2] = w[1];
+      X[3] = w[2];
+      X[5] = -w[0];
+      X[6] = -w[1];
+      X[7] = w[0];
+      fixed::mat_mat<3,3,3>(X, Sf, Y);
+      fixed::mat_mat<3,3,3>(Sf, X, T);
+      for (int i=0; i<9; i++) Y[i] -= T[i];
+      sym(Y, c);
+      for (int i=0; i<6; i++) RHS[CINDEX(i,6+k,9)] = c[i];
+    }
+  }
 
-  full2mandel(Dpart, A);
-  full2skew(Wpart, B);
+  if (!fixed::solve<6,9>(J, RHS)) return LINALG_FAILURE;
 
-  // IMPORTANT TODO: go back and find where you dropped the factor of 2...
-  for (int i=0; i<18; i++) B[i] *= 2.0;
+  for (int i=0; i<6; i++) {
+    std::copy(&RHS[CINDEX(i,0,9)], &RHS[CINDEX(i,6,9)], &A[CINDEX(i,0,6)]);
+    std::copy(&RHS[CINDEX(i,6,9)], &RHS[CINDEX(i,9,9)], &B[CINDEX(i,0,3)]);
+  }
 
   return 0;
 }
@@ -159,8 +269,8 @@ int NEMLModel_sd::calc_tangent_(const double * const D, const double * const W,
 SmallStrainElasticity::SmallStrainElasticity(
     std::shared_ptr<LinearElasticModel> elastic,
     std::shared_ptr<Interpolate> alpha,
-    bool truesdell) :
-    NEMLModel_sd(elastic, alpha, truesdell)
+    bool truesdell, bool tangent_outer) :
+    NEMLModel_sd(elastic, alpha, truesdell, tangent_outer)
 {
 
 }
@@ -179,6 +289,7 @@ ParameterSet SmallStrainElasticity::parameters()
   pset.add_optional_parameter<NEMLObject>("alpha",
                                           std::make_shared<ConstantInterpolate>(0.0));
   pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
 
   return pset;
 }
@@ -188,7 +299,8 @@ std::unique_ptr<NEMLObject> SmallStrainElasticity::initialize(ParameterSet & par
   return neml::make_unique<SmallStrainElasticity>(
       params.get_object_parameter<LinearElasticModel>("elastic"),
       params.get_object_parameter<Interpolate>("alpha"),
-      params.get_parameter<bool>("truesdell")
+      params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer")
       ); 
 }
 
@@ -235,8 +347,8 @@ SmallStrainPerfectPlasticity::SmallStrainPerfectPlasticity(
     std::shared_ptr<Interpolate> ys,
     std::shared_ptr<Interpolate> alpha,
     double tol, int miter,
-    bool verbose, int max_divide, bool truesdell) :
-      NEMLModel_sd(elastic, alpha, truesdell),
+    bool verbose, int max_divide, bool truesdell, bool tangent_outer) :
+      NEMLModel_sd(elastic, alpha, truesdell, tangent_outer),
       surface_(surface), ys_(ys),
       tol_(tol), miter_(miter), verbose_(verbose), max_divide_(max_divide)
 {
@@ -264,6 +376,7 @@ ParameterSet SmallStrainPerfectPlasticity::parameters()
   pset.add_optional_parameter<int>("max_divide", 8);
 
   pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
 
   return pset;
 }
@@ -279,7 +392,8 @@ std::unique_ptr<NEMLObject> SmallStrainPerfectPlasticity::initialize(ParameterSe
       params.get_parameter<int>("miter"),
       params.get_parameter<bool>("verbose"),
       params.get_parameter<int>("max_divide"),
-      params.get_parameter<bool>("truesdell")
+      params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer")
       ); 
 }
 
@@ -516,10 +630,8 @@ int SmallStrainPerfectPlasticity::make_trial_state(
 
   std::copy(s_n, s_n+6, ts.s_n);
 
-  double S_n[36];
-  ier = elastic_->S(T_n, S_n);
+  ier = elastic_->apply_S(T_n, s_n, ts.ee_n);
   if (ier != SUCCESS) return ier;
-  mat_vec(S_n, 6, s_n, 6, ts.ee_n);
 
   double temp[6];
   ier = elastic_->C(T_np1, ts.C);
@@ -577,8 +689,8 @@ SmallStrainRateIndependentPlasticity::SmallStrainRateIndependentPlasticity(
     std::shared_ptr<RateIndependentFlowRule> flow, 
     std::shared_ptr<Interpolate> alpha, double tol,
     int miter, bool verbose, double kttol, bool check_kt,
-    bool truesdell) :
-      NEMLModel_sd(elastic, alpha, truesdell),
+    bool truesdell, bool tangent_outer) :
+      NEMLModel_sd(elastic, alpha, truesdell, tangent_outer),
       flow_(flow), tol_(tol), kttol_(kttol), miter_(miter),
       verbose_(verbose), check_kt_(check_kt)
 {
@@ -606,6 +718,7 @@ ParameterSet SmallStrainRateIndependentPlasticity::parameters()
   pset.add_optional_parameter<bool>("check_kt", false);
 
   pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
 
   return pset;
 }
@@ -621,7 +734,8 @@ std::unique_ptr<NEMLObject> SmallStrainRateIndependentPlasticity::initialize(Par
       params.get_parameter<bool>("verbose"),
       params.get_parameter<double>("kttol"),
       params.get_parameter<bool>("check_kt"),
-      params.get_parameter<bool>("truesdell")
+      params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer")
       ); 
 }
 
@@ -860,12 +974,10 @@ int SmallStrainRateIndependentPlasticity::make_trial_state(
   // Save e_np1
   std::copy(e_np1, e_np1+6, ts.e_np1);
   // ep_tr = ep_n
-  double S_n[36];
   double ee_n[6];
-  int ier = elastic_->S(T_n, S_n);
+  int ier = elastic_->apply_S(T_n, s_n, ee_n);
   if (ier != SUCCESS) return ier;
 
-  mat_vec(S_n, 6, s_n, 6, ee_n);
   sub_vec(e_n, ee_n, 6, ts.ep_tr);
 
   ts.h_tr.resize(flow_->nhist());
@@ -1023,8 +1135,8 @@ SmallStrainCreepPlasticity::SmallStrainCreepPlasticity(
     std::shared_ptr<NEMLModel_sd> plastic,
     std::shared_ptr<CreepModel> creep,
     std::shared_ptr<Interpolate> alpha, double tol,
-    int miter, bool verbose, double sf, bool truesdell) :
-      NEMLModel_sd(elastic, alpha, truesdell),
+    int miter, bool verbose, double sf, bool truesdell, bool tangent_outer) :
+      NEMLModel_sd(elastic, alpha, truesdell, tangent_outer),
       plastic_(plastic), creep_(creep), tol_(tol), sf_(sf),
       miter_(miter), verbose_(verbose)
 {
@@ -1052,6 +1164,7 @@ ParameterSet SmallStrainCreepPlasticity::parameters()
   pset.add_optional_parameter<double>("sf", 1.0e6);
 
   pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
 
   return pset;
 }
@@ -1067,7 +1180,8 @@ std::unique_ptr<NEMLObject> SmallStrainCreepPlasticity::initialize(ParameterSet
       params.get_parameter<int>("miter"),
       params.get_parameter<bool>("verbose"),
       params.get_parameter<double>("sf"),
-      params.get_parameter<bool>("truesdell")
+      params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer")
       ); 
 }
 
@@ -1283,8 +1397,8 @@ GeneralIntegrator::GeneralIntegrator(std::shared_ptr<LinearElasticModel> elastic
                                      std::shared_ptr<Interpolate> alpha,
                                      double tol, int miter,
                                      bool verbose, int max_divide, 
-                                     bool truesdell) :
-    NEMLModel_sd(elastic, alpha, truesdell),
+                                     bool truesdell, bool tangent_outer) :
+    NEMLModel_sd(elastic, alpha, truesdell, tangent_outer),
     rule_(rule), tol_(tol), miter_(miter), max_divide_(max_divide),
     verbose_(verbose) 
 {
@@ -1311,6 +1425,7 @@ ParameterSet GeneralIntegrator::parameters()
   pset.add_optional_parameter<int>("max_divide", 8);
 
   pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
 
   return pset;
 }
@@ -1325,7 +1440,8 @@ std::unique_ptr<NEMLObject> GeneralIntegrator::initialize(ParameterSet & params)
       params.get_parameter<int>("miter"),
       params.get_parameter<bool>("verbose"),
       params.get_parameter<int>("max_divide"),
-      params.get_parameter<bool>("truesdell")
+      params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer")
       ); 
 }
 
@@ -1709,8 +1825,8 @@ KMRegimeModel::KMRegimeModel(std::shared_ptr<LinearElasticModel> emodel,
                              std::vector<double> gs,
                              double kboltz, double b, double eps0,
                              std::shared_ptr<Interpolate> alpha, 
-                             bool truesdell) :
-    NEMLModel_sd(emodel, alpha, truesdell), models_(models), gs_(gs),
+                             bool truesdell, bool tangent_outer) :
+    NEMLModel_sd(emodel, alpha, truesdell, tangent_outer), models_(models), gs_(gs),
     kboltz_(kboltz), b_(b), eps0_(eps0)
 {
 
@@ -1736,6 +1852,7 @@ ParameterSet KMRegimeModel::parameters()
                                           std::make_shared<ConstantInterpolate>(0.0));
 
   pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
 
   return pset;
 }
@@ -1750,7 +1867,8 @@ std::unique_ptr<NEMLObject> KMRegimeModel::initialize(ParameterSet & params)
       params.get_parameter<double>("b"),
       params.get_parameter<double>("eps0"),
       params.get_object_parameter<Interpolate>("alpha"),
-      params.get_parameter<bool>("truesdell")
+      params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer")
       ); 
 }
 
@@ -1818,4 +1936,321 @@ int KMRegimeModel::set_elastic_model(std::shared_ptr<LinearElasticModel> emodel)
   return 0;
 }
 
+// Start MixedControlModel
+MixedControlModel::MixedControlModel(std::shared_ptr<NEMLModel_sd> model,
+                                     std::vector<double> control,
+                                     double rtol, double atol, int miter,
+                                     bool truesdell, bool tangent_outer) :
+    NEMLModel_sd(std::const_pointer_cast<LinearElasticModel>(model->elastic()),
+                 nullptr, truesdell, tangent_outer),
+    model_(model), rtol_(rtol), atol_(atol), miter_(miter)
+{
+  bool held[6] = {false, false, false, false, false, false};
+  for (auto c : control) {
+    int i = (int) c;
+    if (i != c || i < 0 || i > 5 || held[i]) {
+      throw std::invalid_argument(
+          "The controlled components should be distinct indices from 0 to 5");
+    }
+    held[i] = true;
+    control_.push_back(i);
+  }
+  for (int i = 0; i < 6; i++) if (not held[i]) free_.push_back(i);
+}
+
+std::string MixedControlModel::type()
+{
+  return "MixedControlModel";
+}
+
+ParameterSet MixedControlModel::parameters()
+{
+  ParameterSet pset(MixedControlModel::type());
+
+  pset.add_parameter<NEMLObject>("model");
+
+  pset.add_optional_parameter<std::vector<double>>("control",
+                                                   std::vector<double>({2,3,4}));
+  pset.add_optional_parameter<double>("rtol", 1.0e-6);
+  pset.add_optional_parameter<double>("atol", 1.0e-10);
+  pset.add_optional_parameter<int>("miter", 20);
+  pset.add_optional_parameter<bool>("truesdell", true);
+  pset.add_optional_parameter<bool>("tangent_outer", true);
+
+  return pset;
+}
+
+std::unique_ptr<NEMLObject> MixedControlModel::initialize(ParameterSet & params)
+{
+  return neml::make_unique<MixedControlModel>(
+      params.get_object_parameter<NEMLModel_sd>("model"),
+      params.get_parameter<std::vector<double>>("control"),
+      params.get_parameter<double>("rtol"),
+      params.get_parameter<double>("atol"),
+      params.get_parameter<int>("miter"),
+      params.get_parameter<bool>("truesdell"),
+      params.get_parameter<bool>("tangent_outer")
+      );
+}
+
+int MixedControlModel::update_sd(
+    const double * const e_np1, const double * const e_n,
+    double T_np1, double T_n,
+    double t_np1, double t_n,
+    double * const s_np1, const double * const s_n,
+    double * const h_np1, const double * const h_n,
+    double * const A_np1,
+    double & u_np1, double u_n,
+    double & p_np1, double p_n)
+{
+  int nc = control_.size();
+  size_t nh = model_->nhist();
+
+  // The controlled strains at step n are the stored ones
+  double e[6], en[6], A[36];
+  std::copy(e_np1, e_np1+6, e);
+  std::copy(e_n, e_n+6, en);
+  for (int k = 0; k < nc; k++) {
+    e[control_[k]] = h_n[k];
+    en[control_[k]] = h_n[k];
+  }
+
+  // Update with the current controlled strains, leaving the wrapped
+  // model's history in h_np1
+  std::vector<double> R(nc), J(nc*nc);
+  auto RJ = [&]() -> int
+  {
+    std::fill(s_np1, s_np1+6, 0.0);
+    std::fill(A, A+36, 0.0);
+    std::fill(&h_np1[nc], &h_np1[nc] + nh, 0.0);
+    int ier = model_->update_sd(e, en, T_np1, T_n, t_np1, t_n, s_np1, s_n,
+                                &h_np1[nc], &h_n[nc], A, u_np1, u_n,
+                                p_np1, p_n);
+    for (int i = 0; i < nc; i++) {
+      R[i] = s_np1[control_[i]];
+      for (int j = 0; j < nc; j++) {
+        J[CINDEX(i,j,nc)] = A[CINDEX(control_[i],control_[j],6)];
+      }
+    }
+    return ier;
+  };
+
+  int ier = RJ();
+  if (ier != SUCCESS) return ier;
+  double nR = norm2_vec(&R[0], nc);
+  double nR0 = nR;
+  int i = 0;
+  while ((nR > rtol_ * nR0) && (nR > atol_)) {
+    ier = solve_mat(&J[0], nc, &R[0]);
+    if (ier != SUCCESS) return ier;
+    for (int k = 0; k < nc; k++) e[control_[k]] -= R[k];
+    ier = RJ();
+    if (ier != SUCCESS) return ier;
+    nR = norm2_vec(&R[0], nc);
+    i++;
+    if (i > miter_) return MAX_ITERATIONS;
+  }
+
+  for (int k = 0; k < nc; k++) h_np1[k] = e[control_[k]];
+
+  // Condensed tangent Aff - Afc Acc^-1 Acf, with Acc from the last update
+  std::fill(A_np1, A_np1+36, 0.0);
+  if (nc > 0) {
+    ier = invert_mat(&J[0], nc);
+    if (ier != SUCCESS) return ier;
+  }
+  for (auto a : free_) {
+    for (auto b : free_) {
+      double v = A[CINDEX(a,b,6)];
+      for (int k = 0; k < nc; k++) {
+        for (int l = 0; l < nc; l++) {
+          v -= A[CINDEX(a,control_[k],6)] * J[CINDEX(k,l,nc)] *
+              A[CINDEX(control_[l],b,6)];
+        }
+      }
+      A_np1[CINDEX(a,b,6)] = v;
+    }
+  }
+
+  return SUCCESS;
+}
+
+size_t MixedControlModel::nhist() const
+{
+  return control_.size() + model_->nhist();
+}
+
+int MixedControlModel::init_hist(double * const hist) const
+{
+  std::fill(hist, hist + control_.size(), 0.0);
+  return model_->init_hist(&hist[control_.size()]);
+}
+
+double MixedControlModel::alpha(double T) const
+{
+  return model_->alpha(T);
+}
+
+int MixedControlModel::elastic_strains(const double * const s_np1,
+                                       double T_np1,
+                                       const double * const h_np1,
+                                       double * const e_np1) const
+{
+  return model_->elastic_strains(s_np1, T_np1, &h_np1[control_.size()],
+                                 e_np1);
+}
+
+int MixedControlModel::set_elastic_model(
+    std::shared_ptr<LinearElasticModel> emodel)
+{
+  elastic_ = emodel;
+  return model_->set_elastic_model(emodel);
+}
+
+// Start UniaxialModel
+UniaxialModel::UniaxialModel(std::shared_ptr<NEMLModel> model, double rtol,
+                             double atol, int miter) :
+    model_(model), rtol_(rtol), atol_(atol), miter_(miter)
+{
+
+}
+
+std::string UniaxialModel::type()
+{
+  return "UniaxialModel";
+}
+
+ParameterSet UniaxialModel::parameters()
+{
+  ParameterSet pset(UniaxialModel::type());
+
+  pset.add_parameter<NEMLObject>("model");
+
+  pset.add_optional_parameter<double>("rtol", 1.0e-6);
+  pset.add_optional_parameter<double>("atol", 1.0e-10);
+  pset.add_optional_parameter<int>("miter", 20);
+
+  return pset;
+}
+
+std::unique_ptr<NEMLObject> UniaxialModel::initialize(ParameterSet & params)
+{
+  return neml::make_unique<UniaxialModel>(
+      params.get_object_parameter<NEMLModel>("model"),
+      params.get_parameter<double>("rtol"),
+      params.get_parameter<double>("atol"),
+      params.get_parameter<int>("miter")
+      );
+}
+
+size_t UniaxialModel::nstore() const
+{
+  return model_->nstore() + 5;
+}
+
+int UniaxialModel::init_store(double * const store) const
+{
+  std::fill(store, store+5, 0.0);
+  return model_->init_store(&store[5]);
+}
+
+size_t UniaxialModel::nhist() const
+{
+  return model_->nhist();
+}
+
+int UniaxialModel::init_hist(double * const hist) const
+{
+  return model_->init_hist(hist);
+}
+
+int UniaxialModel::update(double e_np1, double e_n,
+                          double T_np1, double T_n,
+                          double t_np1, double t_n,
+                          double & s_np1, double s_n,
+                          double * const h_np1, const double * const h_n,
+                          double & A_np1,
+                          double & u_np1, double u_n,
+                          double & p_np1, double p_n) const
+{
+  size_t nh = model_->nstore();
+  double e_n_vec[6], s_n_vec[6], e_vec[6], s_vec[6], A[36];
+  e_n_vec[0] = e_n;
+  std::copy(h_n, h_n+5, &e_n_vec[1]);
+  std::fill(s_n_vec, s_n_vec+6, 0.0);
+  s_n_vec[0] = s_n;
+
+  // Update at the current lateral strains, leaving the model's variables
+  // in h_np1
+  auto RJ = [&](const double * const x, double * const R,
+                double * const J) -> int
+  {
+    e_vec[0] = e_np1;
+    std::copy(x, x+5, &e_vec[1]);
+    std::fill(s_vec, s_vec+6, 0.0);
+    std::fill(A, A+36, 0.0);
+    std::fill(&h_np1[5], &h_np1[5] + nh, 0.0);
+    int ier = model_->update_sd(e_vec, e_n_vec, T_np1, T_n, t_np1, t_n,
+                                s_vec, s_n_vec, &h_np1[5], &h_n[5], A,
+                                u_np1, u_n, p_np1, p_n);
+    for (int i = 0; i < 5; i++) {
+      R[i] = s_vec[i+1];
+      for (int j = 0; j < 5; j++) J[CINDEX(i,j,5)] = A[CINDEX((i+1),(j+1),6)];
+    }
+    return ier;
+  };
+
+  double x[5], R[5], J[25];
+  std::copy(h_n, h_n+5, x);
+  int ier = RJ(x, R, J);
+  if (ier != SUCCESS) return ier;
+  double nR = norm2_vec(R, 5);
+  double nR0 = nR;
+  int i = 0;
+  while ((nR > rtol_ * nR0) && (nR > atol_)) {
+    ier = solve_mat(J, 5, R);
+    if (ier != SUCCESS) return ier;
+    for (int j = 0; j < 5; j++) x[j] -= R[j];
+    ier = RJ(x, R, J);
+    if (ier != SUCCESS) return ier;
+    nR = norm2_vec(R, 5);
+    i++;
+    if (i > miter_) return MAX_ITERATIONS;
+  }
+
+  std::copy(x, x+5, h_np1);
+  s_np1 = s_vec[0];
+
+  // Condensed tangent A00 - A0l All^-1 Al0, with Jacobian from the last
+  // update
+  double v[5];
+  for (int j = 0; j < 5; j++) v[j] = A[CINDEX((j+1),0,6)];
+  ier = solve_mat(J, 5, v);
+  if (ier != SUCCESS) return ier;
+  A_np1 = A[0] - dot_vec(&A[1], v, 5);
+
+  return SUCCESS;
+}
+
+double UniaxialModel::alpha(double T) const
+{
+  return model_->alpha(T);
+}
+
+double UniaxialModel::thermal_strain_increment(double T_np1, double T_n) const
+{
+  return (T_np1 - T_n) * (alpha(T_np1) + alpha(T_n)) / 2.0;
+}
+
+int UniaxialModel::elastic_strains(double s_np1, double T_np1,
+                                   const double * const h_np1,
+                                   double & e_np1) const
+{
+  double s[6] = {s_np1, 0, 0, 0, 0, 0};
+  double e[6];
+  int ier = model_->elastic_strains(s, T_np1, &h_np1[5], e);
+  e_np1 = e[0];
+  return ier;
+}
+
 } // namespace neml
@@ -51,6 +51,39 @@ class NEMLModel: public NEMLObject {
        double & u_np1, double u_n,
        double & p_np1, double p_n) = 0;
 
+   // The batch updates run n independent points, with the arrays for
+   // each point stored one after the other, on up to nthreads threads.
+   // The default is a single thread, so hosts calling from their own
+   // threads don't oversubscribe; 0 uses all the hardware threads.  They
+   // return the error code of the first point that failed.
+
+   /// Small strain update of a batch of points
+   int update_sd_vec(
+       size_t n,
+       const double * const e_np1, const double * const e_n,
+       const double * const T_np1, const double * const T_n,
+       const double * const t_np1, const double * const t_n,
+       double * const s_np1, const double * const s_n,
+       double * const h_np1, const double * const h_n,
+       double * const A_np1,
+       double * const u_np1, const double * const u_n,
+       double * const p_np1, const double * const p_n,
+       unsigned nthreads = 1);
+
+   /// Large strain incremental update of a batch of points
+   int update_ld_inc_vec(
+       size_t n,
+       const double * const d_np1, const double * const d_n,
+       const double * const w_np1, const double * const w_n,
+       const double * const T_np1, const double * const T_n,
+       const double * const t_np1, const double * const t_n,
+       double * const s_np1, const double * const s_n,
+       double * const h_np1, const double * const h_n,
+       double * const A_np1, double * const B_np1,
+       double * const u_np1, const double * const u_n,
+       double * const p_np1, const double * const p_n,
+       unsigned nthreads = 1);
+
    /// Number of internal variables that are true material history
    virtual size_t nhist() const = 0;
    /// Initialize the history variables
@@ -74,7 +107,7 @@ class NEMLModel_sd: public NEMLModel {
     /// All small strain models use small strain elasticity and CTE
     NEMLModel_sd(std::shared_ptr<LinearElasticModel> emodel,
                  std::shared_ptr<Interpolate> alpha,
-                 bool truesdell);
+                 bool truesdell, bool tangent_outer);
     virtual ~NEMLModel_sd();
 
    /// The small strain stress update interface
@@ -130,7 +163,7 @@ class NEMLModel_sd: public NEMLModel {
   private:
    int calc_tangent_(const double * const D, const double * const W, 
                      const double * const C, const double * const S, 
-                     double * const A, double * const B);
+                     double * const A, double * const B) const;
 
   protected:
    std::shared_ptr<LinearElasticModel> elastic_;
@@ -138,6 +171,7 @@ class NEMLModel_sd: public NEMLModel {
   private:
    std::shared_ptr<Interpolate> alpha_;
    bool truesdell_;
+   bool tangent_outer_;
 
 };
 
@@ -148,7 +182,7 @@ class SmallStrainElasticity: public NEMLModel_sd {
   /// Parameters are the minimum: an elastic model and a thermal expansion 
   SmallStrainElasticity(std::shared_ptr<LinearElasticModel> elastic,
                         std::shared_ptr<Interpolate> alpha,
-                        bool truesdell);
+                        bool truesdell, bool tangent_outer);
   
   /// Type for the object system
   static std::string type();
@@ -173,8 +207,6 @@ class SmallStrainElasticity: public NEMLModel_sd {
   virtual int init_hist(double * const hist) const;
 };
 
-static Register<SmallStrainElasticity> regSmallStrainElasticity;
-
 /// Small strain perfect plasticity trial state
 //  Store data the solver needs and can be passed into solution interface
 class SSPPTrialState : public TrialState {
@@ -237,7 +269,7 @@ class SmallStrainPerfectPlasticity: public NEMLModel_sd, public Solvable {
                                double tol, int miter,
                                bool verbose,
                                int max_divide,
-                               bool truesdell);
+                               bool truesdell, bool tangent_outer);
   
   /// Type for the object system
   static std::string type();
@@ -299,8 +331,6 @@ class SmallStrainPerfectPlasticity: public NEMLModel_sd, public Solvable {
   const int max_divide_;
 };
 
-static Register<SmallStrainPerfectPlasticity> regSmallStrainPerfectPlasticity;
-
 /// Small strain, rate-independent plasticity
 //    The algorithm used here is generalized closest point projection
 //    for associative flow models.  For non-associative models the algorithm
@@ -318,7 +348,7 @@ class SmallStrainRateIndependentPlasticity: public NEMLModel_sd, public Solvable
                                        std::shared_ptr<RateIndependentFlowRule> flow,
                                        std::shared_ptr<Interpolate> alpha,
                                        double tol, int miter, bool verbose,double kttol,
-                                       bool check_kt, bool truesdell);
+                                       bool check_kt, bool truesdell, bool tangent_outer);
 
   /// Type for the object system
   static std::string type();
@@ -373,8 +403,6 @@ class SmallStrainRateIndependentPlasticity: public NEMLModel_sd, public Solvable
   bool verbose_, check_kt_;
 };
 
-static Register<SmallStrainRateIndependentPlasticity> regSmallStrainRateIndependentPlasticity;
-
 /// Small strain, rate-independent plasticity + creep
 //  Uses a combined iteration of a rate independent plastic + creep model
 //  to solver overall update
@@ -391,7 +419,7 @@ class SmallStrainCreepPlasticity: public NEMLModel_sd, public Solvable {
                              std::shared_ptr<Interpolate> alpha,
                              double tol, int miter,
                              bool verbose, double sf,
-                             bool truesdell);
+                             bool truesdell, bool tangent_outer);
 
   /// Type for the object system
   static std::string type();
@@ -446,8 +474,6 @@ class SmallStrainCreepPlasticity: public NEMLModel_sd, public Solvable {
   bool verbose_;
 };
 
-static Register<SmallStrainCreepPlasticity> regSmallStrainCreepPlasticity;
-
 /// Small strain general integrator
 //    General NR one some stress rate + history evolution rate
 //
@@ -462,7 +488,7 @@ class GeneralIntegrator: public NEMLModel_sd, public Solvable {
                     std::shared_ptr<Interpolate> alpha,
                     double tol, int miter,
                     bool verbose, int max_divide,
-                    bool truesdell);
+                    bool truesdell, bool tangent_outer);
 
   /// Type for the object system
   static std::string type();
@@ -514,8 +540,6 @@ class GeneralIntegrator: public NEMLModel_sd, public Solvable {
   bool verbose_;
 };
 
-static Register<GeneralIntegrator> regGeneralIntegrator;
-
 /// Combines multiple small strain integrators based on regimes of
 /// rate-dependent behavior.
 //
@@ -542,7 +566,7 @@ class KMRegimeModel: public NEMLModel_sd {
                 std::vector<double> gs, 
                 double kboltz, double b, double eps0,
                 std::shared_ptr<Interpolate> alpha,
-                bool truesdell);
+                bool truesdell, bool tangent_outer);
 
   /// Type for the object system
   static std::string type();
@@ -582,7 +606,119 @@ class KMRegimeModel: public NEMLModel_sd {
   double kboltz_, b_, eps0_;
 };
 
-static Register<KMRegimeModel> regKMRegimeModel;
+/// Holds a set of stress components at zero around another small strain
+/// model, for example plane stress
+//
+//  Each update solves for the strains in the controlled components that
+//  make those stresses vanish with a local Newton iteration, using the
+//  wrapped model's tangent.  The solved strains are stored ahead of the
+//  wrapped model's history and start the next solve.  The tangent is the
+//  statically condensed tangent, with zero rows and columns for the
+//  controlled components.
+//
+class MixedControlModel: public NEMLModel_sd {
+ public:
+  /// Parameters are the wrapped model, the Mandel indices of the zero
+  /// stress components, the Newton tolerances and iteration limit, and the
+  /// large deformation stress rate
+  MixedControlModel(std::shared_ptr<NEMLModel_sd> model,
+                    std::vector<double> control,
+                    double rtol, double atol, int miter,
+                    bool truesdell, bool tangent_outer);
+
+  /// Type for the object system
+  static std::string type();
+  /// Parameters for the object system
+  static ParameterSet parameters();
+  /// Setup from a ParameterSet
+  static std::unique_ptr<NEMLObject> initialize(ParameterSet & params);
+
+  /// The small strain stress update
+  virtual int update_sd(
+      const double * const e_np1, const double * const e_n,
+      double T_np1, double T_n,
+      double t_np1, double t_n,
+      double * const s_np1, const double * const s_n,
+      double * const h_np1, const double * const h_n,
+      double * const A_np1,
+      double & u_np1, double u_n,
+      double & p_np1, double p_n);
+
+  /// The controlled strains plus the wrapped model's history
+  virtual size_t nhist() const;
+  /// Initialize history at time zero
+  virtual int init_hist(double * const hist) const;
+
+  /// The wrapped model's CTE
+  virtual double alpha(double T) const;
+  /// The wrapped model's elastic strains
+  virtual int elastic_strains(const double * const s_np1,
+                              double T_np1, const double * const h_np1,
+                              double * const e_np1) const;
+  /// Set a new elastic model, here and in the wrapped model
+  virtual int set_elastic_model(std::shared_ptr<LinearElasticModel> emodel);
+
+ private:
+  std::shared_ptr<NEMLModel_sd> model_;
+  std::vector<int> control_, free_;
+  double rtol_, atol_;
+  int miter_;
+};
+
+/// Condenses a small strain model to uniaxial stress
+//
+//  Each update solves for the five lateral strains that make the other
+//  stress components vanish with a local Newton iteration.  The lateral
+//  strains are stored ahead of the wrapped model's variables and start the
+//  next solve.  The tangent is the condensed, consistent uniaxial tangent.
+//
+class UniaxialModel: public NEMLObject {
+ public:
+  /// Parameters are the 3D model and the Newton tolerances and iteration
+  /// limit
+  UniaxialModel(std::shared_ptr<NEMLModel> model, double rtol, double atol,
+                int miter);
+
+  /// Type for the object system
+  static std::string type();
+  /// Parameters for the object system
+  static ParameterSet parameters();
+  /// Setup from a ParameterSet
+  static std::unique_ptr<NEMLObject> initialize(ParameterSet & params);
+
+  /// Number of stored variables, the model's plus the lateral strains
+  size_t nstore() const;
+  /// Initialize the stored variables
+  int init_store(double * const store) const;
+  /// Number of model history variables
+  size_t nhist() const;
+  /// Initialize the model history
+  int init_hist(double * const hist) const;
+
+  /// Uniaxial stress update
+  int update(double e_np1, double e_n,
+             double T_np1, double T_n,
+             double t_np1, double t_n,
+             double & s_np1, double s_n,
+             double * const h_np1, const double * const h_n,
+             double & A_np1,
+             double & u_np1, double u_n,
+             double & p_np1, double p_n) const;
+
+  /// Instantaneous thermal expansion coefficient
+  double alpha(double T) const;
+  /// Increment in the thermal strain over a step, using the average
+  /// expansion coefficient
+  double thermal_strain_increment(double T_np1, double T_n) const;
+  /// Axial elastic strain for a stress, temperature, and stored variables
+  int elastic_strains(double s_np1, double T_np1, const double * const h_np1,
+                      double & e_np1) const;
+
+ private:
+  std::shared_ptr<NEMLModel> model_;
+  double rtol_, atol_;
+  int miter_;
+};
 
 } // namespace neml
 #endif // MODELS_H
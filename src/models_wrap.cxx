@@ -37,34 +37,179 @@ PYBIND11_MODULE(models, m) {
             return h;
            }, "Initialize history variables.")
       .def("update_sd",
-           [](NEMLModel & m, py::array_t<double, py::array::c_style> e_np1, py::array_t<double, py::array::c_style> e_n, double T_np1, double T_n, double t_np1, double t_n, py::array_t<double, py::array::c_style> s_n, py::array_t<double, py::array::c_style> h_n, double u_n, double p_n) -> std::tuple<py::array_t<double>, py::array_t<double>, py::array_t<double>, double, double>
+           [](NEMLModel & m, py::array_t<double, py::array::c_style> e_np1, py::array_t<double, py::array::c_style> e_n, double T_np1, double T_n, double t_np1, double t_n, py::array_t<double, py::array::c_style> s_n, py::array_t<double, py::array::c_style> h_n, double u_n, double p_n, py::object out) -> py::tuple
            {
-            auto s_np1 = alloc_vec<double>(6);
-            auto h_np1 = alloc_vec<double>(m.nstore());
-            auto A_np1 = alloc_mat<double>(6,6);
+            auto res = output_arrays<double>(out, {{6}, {m.nstore()}, {6,6}},
+                                             {"s_np1", "h_np1", "A_np1"},
+                                             {e_np1, e_n, s_n, h_n});
+            auto & s_np1 = res[0];
+            auto & h_np1 = res[1];
+            auto & A_np1 = res[2];
             double u_np1, p_np1;
 
-            int ier = m.update_sd(arr2ptr<double>(e_np1), arr2ptr<double>(e_n), T_np1, T_n, t_np1, t_n, arr2ptr<double>(s_np1), arr2ptr<double>(s_n), arr2ptr<double>(h_np1), arr2ptr<double>(h_n), arr2ptr<double>(A_np1), u_np1, u_n, p_np1, p_n);
+            auto e_np1_ptr = e_np1.data();
+            auto e_n_ptr = e_n.data();
+            auto s_np1_ptr = s_np1.mutable_data();
+            auto s_n_ptr = s_n.data();
+            auto h_np1_ptr = h_np1.mutable_data();
+            auto h_n_ptr = h_n.data();
+            auto A_np1_ptr = A_np1.mutable_data();
+            int ier;
+            {
+              py::gil_scoped_release release;
+              ier = m.update_sd(e_np1_ptr, e_n_ptr, T_np1, T_n, t_np1, t_n, s_np1_ptr, s_n_ptr, h_np1_ptr, h_n_ptr, A_np1_ptr, u_np1, u_n, p_np1, p_n);
+            }
             py_error(ier);
 
-            return std::make_tuple(s_np1, h_np1, A_np1, u_np1, p_np1);
+            return py::make_tuple(s_np1, h_np1, A_np1, u_np1, p_np1);
 
-           }, "Small deformation update.")
+           }, "Small deformation update, optionally writing the stress, history, and tangent into the arrays in out.",
+           py::arg("e_np1"), py::arg("e_n"), py::arg("T_np1"), py::arg("T_n"), py::arg("t_np1"), py::arg("t_n"), py::arg("s_n"), py::arg("h_n"), py::arg("u_n"), py::arg("p_n"), py::arg("out") = py::none())
       .def("update_ld_inc",
-           [](NEMLModel & m, py::array_t<double, py::array::c_style> d_np1, py::array_t<double, py::array::c_style> d_n, py::array_t<double, py::array::c_style> w_np1, py::array_t<double, py::array::c_style> w_n, double T_np1, double T_n, double t_np1, double t_n, py::array_t<double, py::array::c_style> s_n, py::array_t<double, py::array::c_style> h_n, double u_n, double p_n) -> std::tuple<py::array_t<double>, py::array_t<double>, py::array_t<double>, py::array_t<double>, double, double>
+           [](NEMLModel & m, py::array_t<double, py::array::c_style> d_np1, py::array_t<double, py::array::c_style> d_n, py::array_t<double, py::array::c_style> w_np1, py::array_t<double, py::array::c_style> w_n, double T_np1, double T_n, double t_np1, double t_n, py::array_t<double, py::array::c_style> s_n, py::array_t<double, py::array::c_style> h_n, double u_n, double p_n, py::object out) -> py::tuple
            {
-            auto s_np1 = alloc_vec<double>(6);
-            auto h_np1 = alloc_vec<double>(m.nstore());
-            auto A_np1 = alloc_mat<double>(6,6);
-            auto B_np1 = alloc_mat<double>(6,3);
+            auto res = output_arrays<double>(out, 
+                {{6}, {m.nstore()}, {6,6}, {6,3}},
+                {"s_np1", "h_np1", "A_np1", "B_np1"},
+                {d_np1, d_n, w_np1, w_n, s_n, h_n});
+            auto & s_np1 = res[0];
+            auto & h_np1 = res[1];
+            auto & A_np1 = res[2];
+            auto & B_np1 = res[3];
             double u_np1, p_np1;
 
-            int ier = m.update_ld_inc(arr2ptr<double>(d_np1), arr2ptr<double>(d_n), arr2ptr<double>(w_np1), arr2ptr<double>(w_n), T_np1, T_n, t_np1, t_n, arr2ptr<double>(s_np1), arr2ptr<double>(s_n), arr2ptr<double>(h_np1), arr2ptr<double>(h_n), arr2ptr<double>(A_np1), arr2ptr<double>(B_np1), u_np1, u_n, p_np1, p_n);
+            auto d_np1_ptr = d_np1.data();
+            auto d_n_ptr = d_n.data();
+            auto w_np1_ptr = w_np1.data();
+            auto w_n_ptr = w_n.data();
+            auto s_np1_ptr = s_np1.mutable_data();
+            auto s_n_ptr = s_n.data();
+            auto h_np1_ptr = h_np1.mutable_data();
+            auto h_n_ptr = h_n.data();
+            auto A_np1_ptr = A_np1.mutable_data();
+            auto B_np1_ptr = B_np1.mutable_data();
+            int ier;
+            {
+              py::gil_scoped_release release;
+              ier = m.update_ld_inc(d_np1_ptr, d_n_ptr, w_np1_ptr, w_n_ptr, T_np1, T_n, t_np1, t_n, s_np1_ptr, s_n_ptr, h_np1_ptr, h_n_ptr, A_np1_ptr, B_np1_ptr, u_np1, u_n, p_np1, p_n);
+            }
             py_error(ier);
 
-            return std::make_tuple(s_np1, h_np1, A_np1, B_np1, u_np1, p_np1);
+            return py::make_tuple(s_np1, h_np1, A_np1, B_np1, u_np1, p_np1);
+
+           }, "Large deformation incremental update, optionally writing the stress, history, and tangents into the arrays in out.",
+           py::arg("d_np1"), py::arg("d_n"), py::arg("w_np1"), py::arg("w_n"), py::arg("T_np1"), py::arg("T_n"), py::arg("t_np1"), py::arg("t_n"), py::arg("s_n"), py::arg("h_n"), py::arg("u_n"), py::arg("p_n"), py::arg("out") = py::none())
+      .def("update_sd_vec",
+           [](NEMLModel & m, py::array_t<double, py::array::c_style> e_np1, py::array_t<double, py::array::c_style> e_n, py::array_t<double, py::array::c_style> T_np1, py::array_t<double, py::array::c_style> T_n, py::array_t<double, py::array::c_style> t_np1, py::array_t<double, py::array::c_style> t_n, py::array_t<double, py::array::c_style> s_n, py::array_t<double, py::array::c_style> h_n, py::array_t<double, py::array::c_style> u_n, py::array_t<double, py::array::c_style> p_n, unsigned nthreads, py::object out) -> py::tuple
+           {
+            size_t n = e_np1.ndim() > 0 ? e_np1.shape(0) : 0;
+            size_t nh = m.nstore();
+            check_shape<double>(e_np1, {n, 6}, "e_np1");
+            check_shape<double>(e_n, {n, 6}, "e_n");
+            check_shape<double>(T_np1, {n}, "T_np1");
+            check_shape<double>(T_n, {n}, "T_n");
+            check_shape<double>(t_np1, {n}, "t_np1");
+            check_shape<double>(t_n, {n}, "t_n");
+            check_shape<double>(s_n, {n, 6}, "s_n");
+            check_shape<double>(h_n, {n, nh}, "h_n");
+            check_shape<double>(u_n, {n}, "u_n");
+            check_shape<double>(p_n, {n}, "p_n");
+
+            auto res = output_arrays<double>(out,
+                {{n, 6}, {n, nh}, {n, 6, 6}, {n}, {n}},
+                {"s_np1", "h_np1", "A_np1", "u_np1", "p_np1"},
+                {e_np1, e_n, T_np1, T_n, t_np1, t_n, s_n, h_n, u_n, p_n});
+            auto & s_np1 = res[0];
+            auto & h_np1 = res[1];
+            auto & A_np1 = res[2];
+            auto & u_np1 = res[3];
+            auto & p_np1 = res[4];
+
+            auto e_np1_ptr = e_np1.data();
+            auto e_n_ptr = e_n.data();
+            auto T_np1_ptr = T_np1.data();
+            auto T_n_ptr = T_n.data();
+            auto t_np1_ptr = t_np1.data();
+            auto t_n_ptr = t_n.data();
+            auto s_np1_ptr = s_np1.mutable_data();
+            auto s_n_ptr = s_n.data();
+            auto h_np1_ptr = h_np1.mutable_data();
+            auto h_n_ptr = h_n.data();
+            auto A_np1_ptr = A_np1.mutable_data();
+            auto u_np1_ptr = u_np1.mutable_data();
+            auto u_n_ptr = u_n.data();
+            auto p_np1_ptr = p_np1.mutable_data();
+            auto p_n_ptr = p_n.data();
+            int ier;
+            {
+              py::gil_scoped_release release;
+              ier = m.update_sd_vec(n, e_np1_ptr, e_n_ptr, T_np1_ptr, T_n_ptr, t_np1_ptr, t_n_ptr, s_np1_ptr, s_n_ptr, h_np1_ptr, h_n_ptr, A_np1_ptr, u_np1_ptr, u_n_ptr, p_np1_ptr, p_n_ptr, nthreads);
+            }
+            py_error(ier);
 
-           }, "Large deformation incremental update.")
+            return py::make_tuple(s_np1, h_np1, A_np1, u_np1, p_np1);
+
+           }, "Small deformation update of a batch of points, each row of the arrays being one point, on nthreads threads (default 1, 0 for all the hardware threads).",
+           py::arg("e_np1"), py::arg("e_n"), py::arg("T_np1"), py::arg("T_n"), py::arg("t_np1"), py::arg("t_n"), py::arg("s_n"), py::arg("h_n"), py::arg("u_n"), py::arg("p_n"), py::arg("nthreads") = 1, py::arg("out") = py::none())
+      .def("update_ld_inc_vec",
+           [](NEMLModel & m, py::array_t<double, py::array::c_style> d_np1, py::array_t<double, py::array::c_style> d_n, py::array_t<double, py::array::c_style> w_np1, py::array_t<double, py::array::c_style> w_n, py::array_t<double, py::array::c_style> T_np1, py::array_t<double, py::array::c_style> T_n, py::array_t<double, py::array::c_style> t_np1, py::array_t<double, py::array::c_style> t_n, py::array_t<double, py::array::c_style> s_n, py::array_t<double, py::array::c_style> h_n, py::array_t<double, py::array::c_style> u_n, py::array_t<double, py::array::c_style> p_n, unsigned nthreads, py::object out) -> py::tuple
+           {
+            size_t n = d_np1.ndim() > 0 ? d_np1.shape(0) : 0;
+            size_t nh = m.nstore();
+            check_shape<double>(d_np1, {n, 6}, "d_np1");
+            check_shape<double>(d_n, {n, 6}, "d_n");
+            check_shape<double>(w_np1, {n, 3}, "w_np1");
+            check_shape<double>(w_n, {n, 3}, "w_n");
+            check_shape<double>(T_np1, {n}, "T_np1");
+            check_shape<double>(T_n, {n}, "T_n");
+            check_shape<double>(t_np1, {n}, "t_np1");
+            check_shape<double>(t_n, {n}, "t_n");
+            check_shape<double>(s_n, {n, 6}, "s_n");
+            check_shape<double>(h_n, {n, nh}, "h_n");
+            check_shape<double>(u_n, {n}, "u_n");
+            check_shape<double>(p_n, {n}, "p_n");
+
+            auto res = output_arrays<double>(out,
+                {{n, 6}, {n, nh}, {n, 6, 6}, {n, 6, 3}, {n}, {n}},
+                {"s_np1", "h_np1", "A_np1", "B_np1", "u_np1", "p_np1"},
+                {d_np1, d_n, w_np1, w_n, T_np1, T_n, t_np1, t_n, s_n, h_n, u_n,
+                 p_n});
+            auto & s_np1 = res[0];
+            auto & h_np1 = res[1];
+            auto & A_np1 = res[2];
+            auto & B_np1 = res[3];
+            auto & u_np1 = res[4];
+            auto & p_np1 = res[5];
+
+            auto d_np1_ptr = d_np1.data();
+            auto d_n_ptr = d_n.data();
+            auto w_np1_ptr = w_np1.data();
+            auto w_n_ptr = w_n.data();
+            auto T_np1_ptr = T_np1.data();
+            auto T_n_ptr = T_n.data();
+            auto t_np1_ptr = t_np1.data();
+            auto t_n_ptr = t_n.data();
+            auto s_np1_ptr = s_np1.mutable_data();
+            auto s_n_ptr = s_n.data();
+            auto h_np1_ptr = h_np1.mutable_data();
+            auto h_n_ptr = h_n.data();
+            auto A_np1_ptr = A_np1.mutable_data();
+            auto B_np1_ptr = B_np1.mutable_data();
+            auto u_np1_ptr = u_np1.mutable_data();
+            auto u_n_ptr = u_n.data();
+            auto p_np1_ptr = p_np1.mutable_data();
+            auto p_n_ptr = p_n.data();
+            int ier;
+            {
+              py::gil_scoped_release release;
+              ier = m.update_ld_inc_vec(n, d_np1_ptr, d_n_ptr, w_np1_ptr, w_n_ptr, T_np1_ptr, T_n_ptr, t_np1_ptr, t_n_ptr, s_np1_ptr, s_n_ptr, h_np1_ptr, h_n_ptr, A_np1_ptr, B_np1_ptr, u_np1_ptr, u_n_ptr, p_np1_ptr, p_n_ptr, nthreads);
+            }
+            py_error(ier);
+
+            return py::make_tuple(s_np1, h_np1, A_np1, B_np1, u_np1, p_np1);
+
+           }, "Large deformation incremental update of a batch of points, each row of the arrays being one point, on nthreads threads (default 1, 0 for all the hardware threads).",
+           py::arg("d_np1"), py::arg("d_n"), py::arg("w_np1"), py::arg("w_n"), py::arg("T_np1"), py::arg("T_n"), py::arg("t_np1"), py::arg("t_n"), py::arg("s_n"), py::arg("h_n"), py::arg("u_n"), py::arg("p_n"), py::arg("nthreads") = 1, py::arg("out") = py::none())
 
       .def("alpha", &NEMLModel::alpha)
       .def("elastic_strains",
@@ -219,6 +364,69 @@ PYBIND11_MODULE(models, m) {
                                                      "b", "eps0"});
         }))
       ;
+
+  py::class_<MixedControlModel, NEMLModel_sd, std::shared_ptr<MixedControlModel>>(m, "MixedControlModel")
+      .def(py::init([](py::args args, py::kwargs kwargs)
+        {
+          return create_object_python<MixedControlModel>(args, kwargs,
+                                                         {"model"});
+        }))
+      ;
+
+  py::class_<UniaxialModel, NEMLObject, std::shared_ptr<UniaxialModel>>(m, "UniaxialModel")
+      .def(py::init([](py::args args, py::kwargs kwargs)
+        {
+          return create_object_python<UniaxialModel>(args, kwargs, {"model"});
+        }))
+      .def_property_readonly("nstore", &UniaxialModel::nstore, "Number of variables the program needs to store.")
+      .def("init_store",
+           [](UniaxialModel & m) -> py::array_t<double>
+           {
+            auto h = alloc_vec<double>(m.nstore());
+            int ier = m.init_store(arr2ptr<double>(h));
+            py_error(ier);
+            return h;
+           }, "Initialize stored variables.")
+      .def_property_readonly("nhist", &UniaxialModel::nhist, "Number of actual history variables.")
+      .def("init_hist",
+           [](UniaxialModel & m) -> py::array_t<double>
+           {
+            auto h = alloc_vec<double>(m.nhist());
+            int ier = m.init_hist(arr2ptr<double>(h));
+            py_error(ier);
+            return h;
+           }, "Initialize history variables.")
+      .def("update",
+           [](UniaxialModel & m, double e_np1, double e_n, double T_np1, double T_n, double t_np1, double t_n, double s_n, py::array_t<double, py::array::c_style> h_n, double u_n, double p_n) -> py::tuple
+           {
+            check_shape<double>(h_n, {m.nstore()}, "h_n");
+            auto h_np1 = alloc_vec<double>(m.nstore());
+            double s_np1, A_np1, u_np1, p_np1;
+
+            auto h_np1_ptr = h_np1.mutable_data();
+            auto h_n_ptr = h_n.data();
+            int ier;
+            {
+              py::gil_scoped_release release;
+              ier = m.update(e_np1, e_n, T_np1, T_n, t_np1, t_n, s_np1, s_n, h_np1_ptr, h_n_ptr, A_np1, u_np1, u_n, p_np1, p_n);
+            }
+            py_error(ier);
+
+            return py::make_tuple(s_np1, h_np1, A_np1, u_np1, p_np1);
+           }, "Uniaxial stress update.")
+      .def("alpha", &UniaxialModel::alpha, "Instantaneous thermal expansion coefficient.")
+      .def("thermal_strain_increment", &UniaxialModel::thermal_strain_increment, "Increment in the thermal strain over a step, using the average expansion coefficient.",
+           py::arg("T_np1"), py::arg("T_n"))
+      .def("elastic_strains",
+           [](UniaxialModel & m, double s_np1, double T_np1, py::array_t<double, py::array::c_style> h_np1) -> double
+           {
+            check_shape<double>(h_np1, {m.nstore()}, "h_np1");
+            double e_np1;
+            int ier = m.elastic_strains(s_np1, T_np1, h_np1.data(), e_np1);
+            py_error(ier);
+            return e_np1;
+           }, "Axial elastic strain.")
+      ;
 }
 
 } // namespace neml
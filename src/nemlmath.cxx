@@ -2,9 +2,11 @@
 
 #include "nemlerror.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <vector>
 
 namespace neml {
 
@@ -337,88 +339,8 @@ int full2mandel(const double * const A, double * const M)
 
 int mandel2full(const double * const M, double * const A)
 {
-	A[0] = M[0];
-	A[1] = sqrt(2)*M[5]/2;
-	A[2] = sqrt(2)*M[4]/2;
-	A[3] = sqrt(2)*M[5]/2;
-	A[4] = M[1];
-	A[5] = sqrt(2)*M[3]/2;
-	A[6] = sqrt(2)*M[4]/2;
-	A[7] = sqrt(2)*M[3]/2;
-	A[8] = M[2];
-	A[9] = sqrt(2)*M[30]/2;
-	A[10] = M[35]/2;
-	A[11] = M[34]/2;
-	A[12] = M[35]/2;
-	A[13] = sqrt(2)*M[31]/2;
-	A[14] = M[33]/2;
-	A[15] = M[34]/2;
-	A[16] = M[33]/2;
-	A[17] = sqrt(2)*M[32]/2;
-	A[18] = sqrt(2)*M[24]/2;
-	A[19] = M[29]/2;
-	A[20] = M[28]/2;
-	A[21] = M[29]/2;
-	A[22] = sqrt(2)*M[25]/2;
-	A[23] = M[27]/2;
-	A[24] = M[28]/2;
-	A[25] = M[27]/2;
-	A[26] = sqrt(2)*M[26]/2;
-	A[27] = sqrt(2)*M[30]/2;
-	A[28] = M[35]/2;
-	A[29] = M[34]/2;
-	A[30] = M[35]/2;
-	A[31] = sqrt(2)*M[31]/2;
-	A[32] = M[33]/2;
-	A[33] = M[34]/2;
-	A[34] = M[33]/2;
-	A[35] = sqrt(2)*M[32]/2;
-	A[36] = M[6];
-	A[37] = sqrt(2)*M[11]/2;
-	A[38] = sqrt(2)*M[10]/2;
-	A[39] = sqrt(2)*M[11]/2;
-	A[40] = M[7];
-	A[41] = sqrt(2)*M[9]/2;
-	A[42] = sqrt(2)*M[10]/2;
-	A[43] = sqrt(2)*M[9]/2;
-	A[44] = M[8];
-	A[45] = sqrt(2)*M[18]/2;
-	A[46] = M[23]/2;
-	A[47] = M[22]/2;
-	A[48] = M[23]/2;
-	A[49] = sqrt(2)*M[19]/2;
-	A[50] = M[21]/2;
-	A[51] = M[22]/2;
-	A[52] = M[21]/2;
-	A[53] = sqrt(2)*M[20]/2;
-	A[54] = sqrt(2)*M[24]/2;
-	A[55] = M[29]/2;
-	A[56] = M[28]/2;
-	A[57] = M[29]/2;
-	A[58] = sqrt(2)*M[25]/2;
-	A[59] = M[27]/2;
-	A[60] = M[28]/2;
-	A[61] = M[27]/2;
-	A[62] = sqrt(2)*M[26]/2;
-	A[63] = sqrt(2)*M[18]/2;
-	A[64] = M[23]/2;
-	A[65] = M[22]/2;
-	A[66] = M[23]/2;
-	A[67] = sqrt(2)*M[19]/2;
-	A[68] = M[21]/2;
-	A[69] = M[22]/2;
-	A[70] = M[21]/2;
-	A[71] = sqrt(2)*M[20]/2;
-	A[72] = M[12];
-	A[73] = sqrt(2)*M[17]/2;
-	A[74] = sqrt(2)*M[16]/2;
-	A[75] = sqrt(2)*M[17]/2;
-	A[76] = M[13];
-	A[77] = sqrt(2)*M[15]/2;
-	A[78] = sqrt(2)*M[16]/2;
-	A[79] = sqrt(2)*M[15]/2;
-	A[80] = M[14];
-  
+  fixed::mandel2full(M, A);
+
   return 0;
 }
 
@@ -446,87 +368,7 @@ int truesdell_update_sym(const double * const D, const double * const W,
 int truesdell_mat(const double * const D, const double * const W,
                   double * const M)
 {
-	M[0] = -D[0] + D[1] + D[2] + 1;
-	M[1] = -sqrt(2)*D[5]/2 + W[2];
-	M[2] = -sqrt(2)*D[4]/2 - W[1];
-	M[3] = -sqrt(2)*D[5]/2 + W[2];
-	M[4] = 0;
-	M[5] = 0;
-	M[6] = -sqrt(2)*D[4]/2 - W[1];
-	M[7] = 0;
-	M[8] = 0;
-	M[9] = -sqrt(2)*D[5]/2 - W[2];
-	M[10] = D[2] + 1;
-	M[11] = -sqrt(2)*D[3]/2 + W[0];
-	M[12] = 0;
-	M[13] = -sqrt(2)*D[5]/2 + W[2];
-	M[14] = 0;
-	M[15] = 0;
-	M[16] = -sqrt(2)*D[4]/2 - W[1];
-	M[17] = 0;
-	M[18] = -sqrt(2)*D[4]/2 + W[1];
-	M[19] = -sqrt(2)*D[3]/2 - W[0];
-	M[20] = D[1] + 1;
-	M[21] = 0;
-	M[22] = 0;
-	M[23] = -sqrt(2)*D[5]/2 + W[2];
-	M[24] = 0;
-	M[25] = 0;
-	M[26] = -sqrt(2)*D[4]/2 - W[1];
-	M[27] = -sqrt(2)*D[5]/2 - W[2];
-	M[28] = 0;
-	M[29] = 0;
-	M[30] = D[2] + 1;
-	M[31] = -sqrt(2)*D[5]/2 + W[2];
-	M[32] = -sqrt(2)*D[4]/2 - W[1];
-	M[33] = -sqrt(2)*D[3]/2 + W[0];
-	M[34] = 0;
-	M[35] = 0;
-	M[36] = 0;
-	M[37] = -sqrt(2)*D[5]/2 - W[2];
-	M[38] = 0;
-	M[39] = -sqrt(2)*D[5]/2 - W[2];
-	M[40] = D[0] - D[1] + D[2] + 1;
-	M[41] = -sqrt(2)*D[3]/2 + W[0];
-	M[42] = 0;
-	M[43] = -sqrt(2)*D[3]/2 + W[0];
-	M[44] = 0;
-	M[45] = 0;
-	M[46] = 0;
-	M[47] = -sqrt(2)*D[5]/2 - W[2];
-	M[48] = -sqrt(2)*D[4]/2 + W[1];
-	M[49] = -sqrt(2)*D[3]/2 - W[0];
-	M[50] = D[0] + 1;
-	M[51] = 0;
-	M[52] = 0;
-	M[53] = -sqrt(2)*D[3]/2 + W[0];
-	M[54] = -sqrt(2)*D[4]/2 + W[1];
-	M[55] = 0;
-	M[56] = 0;
-	M[57] = -sqrt(2)*D[3]/2 - W[0];
-	M[58] = 0;
-	M[59] = 0;
-	M[60] = D[1] + 1;
-	M[61] = -sqrt(2)*D[5]/2 + W[2];
-	M[62] = -sqrt(2)*D[4]/2 - W[1];
-	M[63] = 0;
-	M[64] = -sqrt(2)*D[4]/2 + W[1];
-	M[65] = 0;
-	M[66] = 0;
-	M[67] = -sqrt(2)*D[3]/2 - W[0];
-	M[68] = 0;
-	M[69] = -sqrt(2)*D[5]/2 - W[2];
-	M[70] = D[0] + 1;
-	M[71] = -sqrt(2)*D[3]/2 + W[0];
-	M[72] = 0;
-	M[73] = 0;
-	M[74] = -sqrt(2)*D[4]/2 + W[1];
-	M[75] = 0;
-	M[76] = 0;
-	M[77] = -sqrt(2)*D[3]/2 - W[0];
-	M[78] = -sqrt(2)*D[4]/2 + W[1];
-	M[79] = -sqrt(2)*D[3]/2 - W[0];
-	M[80] = D[0] + D[1] - D[2] + 1;
+  fixed::truesdell_mat(D, W, M);
 
   return 0;
 }
@@ -583,6 +425,10 @@ int minus_vec(double * const a, int n)
 
 int add_vec(const double * const a, const double * const b, int n, double * const c)
 {
+  if (n == 6) {
+    fixed::add<6>(a, b, c);
+    return 0;
+  }
   for (int i=0; i<n; i++) {
     c[i] = a[i] + b[i];
   }
@@ -592,6 +438,10 @@ int add_vec(const double * const a, const double * const b, int n, double * cons
 
 int sub_vec(const double * const a, const double * const b, int n, double * const c)
 {
+  if (n == 6) {
+    fixed::sub<6>(a, b, c);
+    return 0;
+  }
   for (int i=0; i<n; i++) {
     c[i] = a[i] - b[i];
   }
@@ -601,6 +451,7 @@ int sub_vec(const double * const a, const double * const b, int n, double * cons
 
 double dot_vec(const double * const a, const double * const b, int n)
 {
+  if (n == 6) return fixed::dot<6>(a, b);
   double sum = 0.0;
   for (int i=0; i<n; i++) {
     sum += a[i] * b[i];
@@ -628,9 +479,36 @@ int normalize_vec(double * const a, int n)
 
 int dev_vec(double * const a)
 {
-  double tr = (a[0] + a[1] + a[2]) / 3.0;
+  fixed::dev(a, a);
+
+  return 0;
+}
+
+int iso_proj_vec(double a, double b, const double * const v, double * const r)
+{
+  double vol = (a - b) * (v[0] + v[1] + v[2]) / 3.0;
   for (int i=0; i<3; i++) {
-    a[i] -= tr;
+    r[i] = b * v[i] + vol;
+  }
+  for (int i=3; i<6; i++) {
+    r[i] = b * v[i];
+  }
+
+  return 0;
+}
+
+int iso_proj_mat(double a, double b, const double * const A, int n, 
+                 double * const B)
+{
+  for (int j=0; j<n; j++) {
+    double vol = (a - b) * (A[CINDEX(0,j,n)] + A[CINDEX(1,j,n)] + 
+                            A[CINDEX(2,j,n)]) / 3.0;
+    for (int i=0; i<3; i++) {
+      B[CINDEX(i,j,n)] = b * A[CINDEX(i,j,n)] + vol;
+    }
+    for (int i=3; i<6; i++) {
+      B[CINDEX(i,j,n)] = b * A[CINDEX(i,j,n)];
+    }
   }
 
   return 0;
@@ -638,6 +516,10 @@ int dev_vec(double * const a)
 
 int outer_vec(const double * const a, int na, const double * const b, int nb, double * const C)
 {
+  if ((na == 6) && (nb == 6)) {
+    fixed::outer<6,6>(a, b, C);
+    return 0;
+  }
   for (int i=0; i < na; i++) {
     for (int j=0; j < nb; j++) {
       C[CINDEX(i,j,nb)] = a[i] * b[j];
@@ -651,6 +533,10 @@ int outer_vec(const double * const a, int na, const double * const b, int nb, do
 int outer_update(const double * const a, int na, const double * const b, 
                  int nb, double * const C)
 {
+  if ((na == 6) && (nb == 6)) {
+    fixed::outer_update<6,6>(1.0, a, b, C);
+    return 0;
+  }
   dger_(nb, na, 1.0, b, 1, a, 1, C, nb);
 
   return 0;
@@ -659,6 +545,10 @@ int outer_update(const double * const a, int na, const double * const b,
 int outer_update_minus(const double * const a, int na, const double * const b, 
                        int nb, double * const C)
 {
+  if ((na == 6) && (nb == 6)) {
+    fixed::outer_update<6,6>(-1.0, a, b, C);
+    return 0;
+  }
   dger_(nb, na, -1.0, b, 1, a, 1, C, nb);
 
   return 0;
@@ -667,6 +557,10 @@ int outer_update_minus(const double * const a, int na, const double * const b,
 int mat_vec(const double * const A, int m, const double * const b, int n, 
             double * const c)
 {
+  if ((m == 6) && (n == 6)) {
+    fixed::mat_vec<6,6>(A, b, c);
+    return 0;
+  }
   dgemv_("T", n, m, 1.0, A, n, b, 1, 0.0, c, 1);
 
   return 0;
@@ -675,6 +569,10 @@ int mat_vec(const double * const A, int m, const double * const b, int n,
 int mat_vec_trans(const double * const A, int m, const double * const b, int n, 
             double * const c)
 {
+  if ((m == 6) && (n == 6)) {
+    fixed::mat_vec_trans<6,6>(A, b, c);
+    return 0;
+  }
   dgemv_("N", m, n, 1.0, A, m, b, 1, 0.0, c, 1);
 
   return 0;
@@ -707,6 +605,10 @@ int invert_mat(double * const A, int n)
 int mat_mat(int m, int n, int k, const double * const A,
             const double * const B, double * const C)
 {
+  if ((m == 6) && (n == 6) && (k == 6)) {
+    fixed::mat_mat<6,6,6>(A, B, C);
+    return 0;
+  }
   dgemm_("N", "N", n, m, k, 1.0, B, n, A, k, 0.0, C, n);
 
   return 0;
@@ -733,6 +635,22 @@ int solve_mat(const double * const A, int n, double * const x)
   return 0;
 }
 
+int solve_tridiagonal(double * const dl, double * const d, double * const du,
+                      int n, double * const x, int nrhs)
+{
+  int info;
+  std::vector<double> du2(std::max(n-2, 1));
+  std::vector<int> ipiv(n);
+
+  dgttrf_(n, dl, d, du, &du2[0], &ipiv[0], info);
+  if (info != 0) return LINALG_FAILURE;
+
+  dgttrs_("N", n, nrhs, dl, d, du, &du2[0], &ipiv[0], x, n, info);
+  if (info != 0) return LINALG_FAILURE;
+
+  return 0;
+}
+
 /*
  *  No error checking in this function, as it is assumed to be non-critical
  */
@@ -786,32 +704,111 @@ double polyval(const double * const poly, const int n, double x)
   return res;
 }
 
-int eigenvalues_sym(const double * const s, double * values)
-{
-  double F[9];
-  usym(s, F);
-  
-  int swork = 15;
-  double work[15];
-  int info;
+int eigen_sym(const double * const s, double * const values,
+              double * const vectors)
+{
+  // Cyclic Jacobi on the full matrix: robust for repeated roots and
+  // accurate to roughly machine precision for 3x3
+  double A[9];
+  usym(s, A);
+  double V[9] = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+
+  double scale = 0.0;
+  for (int i=0; i<9; i++) scale += A[i] * A[i];
+  double tol = std::numeric_limits<double>::epsilon();
+  tol = tol * tol * scale;
+
+  const int ps[3] = {0, 0, 1};
+  const int qs[3] = {1, 2, 2};
+  bool converged = false;
+  for (int sweep = 0; sweep < 50; sweep++) {
+    double off = A[1] * A[1] + A[2] * A[2] + A[5] * A[5];
+    if (off <= tol) {
+      converged = true;
+      break;
+    }
+    for (int r=0; r<3; r++) {
+      int p = ps[r];
+      int q = qs[r];
+      double apq = A[CINDEX(p,q,3)];
+      if (apq == 0.0) continue;
+
+      double theta = (A[CINDEX(q,q,3)] - A[CINDEX(p,p,3)]) / (2.0 * apq);
+      double t = 1.0 / (fabs(theta) + std::hypot(theta, 1.0));
+      if (theta < 0.0) t = -t;
+      double c = 1.0 / std::sqrt(t * t + 1.0);
+      double sn = t * c;
+      double tau = sn / (1.0 + c);
+
+      A[CINDEX(p,p,3)] -= t * apq;
+      A[CINDEX(q,q,3)] += t * apq;
+      A[CINDEX(p,q,3)] = 0.0;
+      A[CINDEX(q,p,3)] = 0.0;
+      for (int k=0; k<3; k++) {
+        if ((k != p) && (k != q)) {
+          double g = A[CINDEX(k,p,3)];
+          double h = A[CINDEX(k,q,3)];
+          A[CINDEX(k,p,3)] = g - sn * (h + g * tau);
+          A[CINDEX(p,k,3)] = A[CINDEX(k,p,3)];
+          A[CINDEX(k,q,3)] = h + sn * (g - h * tau);
+          A[CINDEX(q,k,3)] = A[CINDEX(k,q,3)];
+        }
+        double g = V[CINDEX(k,p,3)];
+        double h = V[CINDEX(k,q,3)];
+        V[CINDEX(k,p,3)] = g - sn * (h + g * tau);
+        V[CINDEX(k,q,3)] = h + sn * (g - h * tau);
+      }
+    }
+  }
+
+  if (!converged) return LINALG_FAILURE;
+
+  // Sort ascending
+  int order[3] = {0, 1, 2};
+  for (int i=1; i<3; i++) {
+    for (int j=i; j>0; j--) {
+      if (A[CINDEX(order[j],order[j],3)] < 
+          A[CINDEX(order[j-1],order[j-1],3)]) {
+        std::swap(order[j], order[j-1]);
+      }
+    }
+  }
 
-  dsyev_("N", "U", 3, F, 3, values, work, swork, info);
+  for (int i=0; i<3; i++) {
+    if (values != nullptr) values[i] = A[CINDEX(order[i],order[i],3)];
+    if (vectors != nullptr) {
+      for (int j=0; j<3; j++) {
+        vectors[CINDEX(i,j,3)] = V[CINDEX(j,order[i],3)];
+      }
+    }
+  }
 
-  return info;
+  return 0;
+}
+
+int eigenvalues_sym(const double * const s, double * values)
+{
+  return eigen_sym(s, values, nullptr);
 }
 
 int eigenvectors_sym(const double * const s, double * vectors)
 {
-  usym(s, vectors);
+  return eigen_sym(s, nullptr, vectors);
+}
 
-  int swork = 15;
-  double work[15];
-  int info;
-  double values[3];
+int eigenvalue_derivs_sym(const double * const s, double * const dvals)
+{
+  double vectors[9];
+  int ier = eigen_sym(s, nullptr, vectors);
+  if (ier != SUCCESS) return ier;
 
-  dsyev_("V", "U", 3, vectors, 3, values, work, swork, info);
+  double full[9];
+  for (int k=0; k<3; k++) {
+    outer_vec(&vectors[k*3], 3, &vectors[k*3], 3, full);
+    sym(full, &dvals[k*6]);
+  }
 
-  return info;
+  return 0;
 }
 
 double I1(const double * const s)
@@ -1,6 +1,8 @@
 #ifndef NEMLMATH_H
 #define NEMLMATH_H
 
+#include "mandel.h"
+
 #include <cstddef>
 
 #define CINDEX(i,j,n) (j + i * n)
@@ -87,6 +89,13 @@ int normalize_vec(double * const a, int n);
 /// Return the deviatoric vector
 int dev_vec(double * const a);
 
+/// Apply the isotropic tensor a P_vol + b P_dev to a Mandel vector
+int iso_proj_vec(double a, double b, const double * const v, double * const r);
+
+/// Apply a P_vol + b P_dev to each column of a 6 x n Mandel matrix
+int iso_proj_mat(double a, double b, const double * const A, int n, 
+                 double * const B);
+
 /// Outer product of two vectors
 int outer_vec(const double * const a, int na, const double * const b, int nb, double * const C);
 
@@ -111,18 +120,32 @@ int invert_mat(double* const A, int n);
 /// Solve unsymmetric system
 int solve_mat(const double * const A, int n, double * const x);
 
+/// Solve a tridiagonal system for nrhs right hand sides stored one after
+/// the other in x, the diagonals are overwritten with the factorization
+int solve_tridiagonal(double * const dl, double * const d, double * const du,
+                      int n, double * const x, int nrhs = 1);
+
 /// Get the condition number of a matrix
 double condition(const double * const A, int n);
 
 /// Evaluate a polynomial with Horner's method, highest order term first
 double polyval(const double * const poly, const int n, double x);
 
+/// Eigenvalues (ascending) and eigenvectors (as rows) of a symmetric 3x3 
+/// matrix in Mandel notation, either output may be nullptr
+int eigen_sym(const double * const s, double * const values,
+              double * const vectors);
+
 /// Get the eigenvalues of a symmetric 3x3 matrix in Mandel notation
 int eigenvalues_sym(const double * const s, double * values);
 
 /// Get the eigenvectors of a symmetric 3x3 matrix (row major)
 int eigenvectors_sym(const double * const s, double * vectors);
 
+/// Derivatives of the (ascending) eigenvalues of a symmetric 3x3 matrix
+/// with respect to the Mandel vector, as 3 rows of 6
+int eigenvalue_derivs_sym(const double * const s, double * const dvals);
+
 /// First principal invariant
 double I1(const double * const s);
 
@@ -521,6 +521,17 @@ PYBIND11_MODULE(nemlmath, m) {
            return V;
          }, "Eigenvectors of a symmetric matrix.");
 
+   m.def("eigenvalue_derivs_sym",
+         [](py::array_t<double, py::array::c_style> s) -> py::array_t<double>
+         {
+           auto D = alloc_mat<double>(3,6);
+           
+           int ier = eigenvalue_derivs_sym(arr2ptr<double>(s), arr2ptr<double>(D));
+           py_error(ier);
+
+           return D;
+         }, "Derivatives of the eigenvalues of a symmetric matrix.");
+
    m.def("I1",
          [](py::array_t<double, py::array::c_style> s) -> double
          {
@@ -2,16 +2,96 @@
 
 namespace neml {
 
+namespace {
+
+/// Copies an object graph, each object only once
+class Cloner {
+ public:
+  Cloner(bool share_constants) : share_(share_constants) {};
+
+  std::shared_ptr<NEMLObject> copy(const std::shared_ptr<NEMLObject> & obj)
+  {
+    if (obj == nullptr) return obj;
+
+    auto found = done_.find(obj.get());
+    if (found != done_.end()) return found->second;
+
+    std::shared_ptr<NEMLObject> res;
+    if (share_ && obj->constant_data()) {
+      res = obj;
+      shared_.push_back(obj.get());
+    }
+    else {
+      res = rebuild(*obj);
+    }
+    done_[obj.get()] = res;
+    return res;
+  }
+
+  /// The objects the copy shares with the original
+  const std::vector<const NEMLObject*> & shared() const {return shared_;};
+
+  std::shared_ptr<NEMLObject> rebuild(const NEMLObject & obj)
+  {
+    if (obj.parameter_set() == nullptr) {
+      std::shared_ptr<NEMLObject> res = obj.copy_direct();
+      if (res == nullptr) {
+        throw std::runtime_error(
+            "Cannot clone an object not created by the Factory");
+      }
+      return res;
+    }
+
+    // Same parameters, but with copies of the nested objects
+    ParameterSet params = *obj.parameter_set();
+    for (auto & name : params.param_names()) {
+      switch (params.get_object_type(name)) {
+        case TYPE_NEML_OBJECT:
+          params.assign_parameter(name, copy(
+                  params.get_parameter<std::shared_ptr<NEMLObject>>(name)));
+          break;
+        case TYPE_VEC_NEML_OBJECT:
+          {
+            auto v = params.get_parameter<
+                std::vector<std::shared_ptr<NEMLObject>>>(name);
+            for (auto & o : v) o = copy(o);
+            params.assign_parameter(name, v);
+          }
+          break;
+        default:
+          break;
+      }
+    }
+
+    return Factory::Creator()->create(params);
+  }
+
+ private:
+  bool share_;
+  std::unordered_map<const NEMLObject*, std::shared_ptr<NEMLObject>> done_;
+  std::vector<const NEMLObject*> shared_;
+};
+
+} // namespace
+
+std::shared_ptr<NEMLObject> NEMLObject::clone(bool share_constants) const
+{
+  Cloner cloner(share_constants);
+  std::shared_ptr<NEMLObject> res = cloner.rebuild(*this);
+  for (auto obj : cloner.shared()) obj->set_shared_between_models();
+  return res;
+}
+
 ParameterSet::ParameterSet() :
-    type_("invalid")
+    ParameterSet("invalid")
 {
 
 }
 
 ParameterSet::ParameterSet(std::string type) :
-    type_(type)
+    layout_(std::make_shared<Layout>())
 {
-
+  layout_->type = type;
 }
 
 ParameterSet::~ParameterSet()
@@ -21,7 +101,7 @@ ParameterSet::~ParameterSet()
 
 const std::string & ParameterSet::type() const
 {
-  return type_;
+  return layout_->type;
 }
 
 void ParameterSet::assign_defered_parameter(std::string name, ParameterSet value)
@@ -31,13 +111,18 @@ void ParameterSet::assign_defered_parameter(std::string name, ParameterSet value
 
 ParamType ParameterSet::get_object_type(std::string name)
 {
-  return param_types_[name];
+  return layout_->types[index_(name)];
+}
+
+const std::vector<std::string> & ParameterSet::param_names() const
+{
+  return layout_->names;
 }
 
 bool ParameterSet::is_parameter(std::string name) const
 {
-  return std::find(param_names_.begin(), param_names_.end(), name) != 
-      param_names_.end();
+  return std::find(layout_->names.begin(), layout_->names.end(), name) != 
+      layout_->names.end();
 }
 
 std::vector<std::string> ParameterSet::unassigned_parameters()
@@ -46,9 +131,9 @@ std::vector<std::string> ParameterSet::unassigned_parameters()
 
   std::vector<std::string> uparams;
 
-  for (auto it = param_names_.begin(); it != param_names_.end(); ++it) {
-    if (params_.find(*it) == params_.end()) {
-      uparams.push_back(*it);
+  for (size_t i = 0; i < assigned_.size(); i++) {
+    if (not assigned_[i]) {
+      uparams.push_back(layout_->names[i]);
     }
   }
 
@@ -59,43 +144,51 @@ bool ParameterSet::fully_assigned()
 {
   resolve_objects_();
   
-  for (auto it = param_names_.begin(); it != param_names_.end(); ++it) {
-    if (params_.find(*it) == params_.end()) return false;
-  }
-
-  return true;
+  return std::find(assigned_.begin(), assigned_.end(), false) == 
+      assigned_.end();
 }
 
 void ParameterSet::resolve_objects_()
 {
+  // Sets that were already resolved, like the ones objects record, are
+  // only read and so can be shared between threads
+  if (defered_params_.empty()) return;
+
   for (auto it = defered_params_.begin(); it != defered_params_.end(); ++it) {
-    params_[it->first] = Factory::Creator()->create(it->second);
+    assign_parameter(it->first, Factory::Creator()->create(it->second));
   }
   defered_params_.clear();
 }
 
-ParameterSet Factory::provide_parameters(std::string type)
+void ParameterSet::add_parameter_(const std::string & name, ParamType type)
 {
-  try {
-    return setups_[type]();
+  if (layout_.use_count() > 1) {
+    layout_ = std::make_shared<Layout>(*layout_);
   }
-  catch (std::exception & e) {
-    throw UnregisteredError(type);
+  layout_->names.push_back(name);
+  layout_->types.push_back(type);
+  values_.emplace_back();
+  assigned_.push_back(false);
+}
+
+size_t ParameterSet::index_(const std::string & name) const
+{
+  // Objects have a handful of parameters, so a scan beats a tree
+  const std::vector<std::string> & names = layout_->names;
+  for (size_t i = 0; i < names.size(); i++) {
+    if (names[i] == name) return i;
   }
+  throw UnknownParameter(type(), name);
+}
+
+ParameterSet Factory::provide_parameters(std::string type)
+{
+  return entry_(type)->setup();
 }
 
 std::shared_ptr<NEMLObject> Factory::create(ParameterSet & params)
 {
-  if (not params.fully_assigned()) {
-    throw UndefinedParameters(params.type(), params.unassigned_parameters());
-  }
-  
-  try {
-    return creators_[params.type()](params);
-  }
-  catch (std::exception & e) {
-    throw UnregisteredError(params.type());
-  }
+  return create_unique(params);
 }
 
 std::unique_ptr<NEMLObject> Factory::create_unique(ParameterSet & params)
@@ -104,25 +197,41 @@ std::unique_ptr<NEMLObject> Factory::create_unique(ParameterSet & params)
     throw UndefinedParameters(params.type(), params.unassigned_parameters());
   }
 
-  try {
-    return creators_[params.type()](params);
-  }
-  catch (std::exception & e) {
-      throw UnregisteredError(params.type());
-  }
+  std::unique_ptr<NEMLObject> obj = entry_(params.type())->creator(params);
+  
+  // Remember where the object came from
+  obj->params_ = std::make_shared<ParameterSet>(params);
+
+  return obj;
 }
 
 void Factory::register_type(std::string type,
                             std::function<std::unique_ptr<NEMLObject>(ParameterSet &)> creator,
                             std::function<ParameterSet()> setup)
 {
-  creators_[type] = creator;
-  setups_[type] = setup;
+  auto entry = std::make_shared<const Entry>(Entry{creator, setup});
+  std::lock_guard<std::mutex> lock(mutex_);
+  types_[type] = entry;
+}
+
+std::shared_ptr<const Factory::Entry> Factory::entry_(
+    const std::string & type) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = types_.find(type);
+  if (found == types_.end()) {
+    throw UnregisteredError(type);
+  }
+  return found->second;
 }
 
 Factory * Factory::Creator()
 {
   static Factory creator;
+  // Function local statics are initialized once, even with threads, so
+  // this registers the NEML objects exactly once on first use
+  static bool registered = (register_neml_objects(creator), true);
+  (void) registered;
   return &creator;
 }
 
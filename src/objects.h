@@ -5,7 +5,10 @@
 #include <sstream>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <atomic>
 #include <functional>
 #include <stdexcept>
 #include <algorithm>
@@ -20,11 +23,45 @@ std::unique_ptr<T> make_unique(Args&&... args) {
     return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
 }
 
+class ParameterSet;
+
 /// NEMLObjects are current pretty useless.  However, they are a hook
 /// for future work on serialization.
 class NEMLObject {
  public:
   virtual ~NEMLObject() {};
+
+  /// The parameters the Factory used to create this object (nullptr if
+  /// the object was constructed directly)
+  std::shared_ptr<ParameterSet> parameter_set() const {return params_;};
+
+  /// Recompute anything derived from the parameters after some were
+  /// changed in place (see tunable.h), called on children first
+  virtual void parameters_changed() {};
+
+  /// Deep copy of the object and everything it uses, rebuilt through the
+  /// Factory.  Objects shared within the graph stay shared in the copy.
+  /// With share_constants the objects that only hold parameter data
+  /// (the interpolates) are shared with the original instead of copied,
+  /// and are marked as shared_between_models.
+  std::shared_ptr<NEMLObject> clone(bool share_constants = false) const;
+
+  /// True if the object is used by several separate models (see clone
+  /// and XMLLibrary), which means it must not be changed in place
+  bool shared_between_models() const {return shared_;};
+  /// Mark the object as used by several separate models
+  void set_shared_between_models() const {shared_ = true;};
+
+  /// Copy of an object the Factory did not create, nullptr if the class
+  /// does not know how
+  virtual std::shared_ptr<NEMLObject> copy_direct() const {return nullptr;};
+  /// True if the object only holds parameter data, which clone can share
+  virtual bool constant_data() const {return false;};
+
+ private:
+  friend class Factory;
+  std::shared_ptr<ParameterSet> params_;
+  mutable std::atomic<bool> shared_ {false};
 };
 
 // This version supports the following types of objects as parameters:
@@ -126,17 +163,15 @@ class ParameterSet {
   template<typename T>
   void add_parameter(std::string name)
   {
-    param_names_.push_back(name);
-    param_types_[name] = GetParamType<T>();
+    add_parameter_(name, GetParamType<T>());
   }
   
   /// Immediately assign an input of the right type to a parameter
   void assign_parameter(std::string name, param_type value)
   {
-    if (std::find(param_names_.begin(), param_names_.end(), name) == param_names_.end()) {
-      throw UnknownParameter(type(), name);
-    }
-    params_[name] = value;
+    size_t i = index_(name);
+    values_[i] = value;
+    assigned_[i] = true;
   }
   
   /// Add a generic parameter with a default
@@ -152,7 +187,7 @@ class ParameterSet {
   T get_parameter(std::string name)
   {
     resolve_objects_();
-    return boost::get<T>(params_[name]);
+    return boost::get<T>(values_[index_(name)]);
   }
   
   /// Assign a parameter set to be used to create an object later
@@ -196,6 +231,9 @@ class ParameterSet {
   /// Get the type of parameter
   ParamType get_object_type(std::string name);
 
+  /// The names of all the parameters, in the order they were added
+  const std::vector<std::string> & param_names() const;
+
   /// Check if this is an actual parameter
   bool is_parameter(std::string name) const;
 
@@ -208,16 +246,31 @@ class ParameterSet {
  private:
   /// Run down the chain of deferred objects and actually construct them
   void resolve_objects_();
-  
-  std::string type_;
-  
-  std::vector<std::string> param_names_;
-  std::map<std::string, ParamType> param_types_;
-  std::map<std::string, param_type> params_;
+
+  /// Add a parameter to the layout
+  void add_parameter_(const std::string & name, ParamType type);
+
+  /// Position of a parameter in the flat arrays
+  size_t index_(const std::string & name) const;
+
+  /// Type, names, and types of the parameters.  Copies of a set share
+  /// this and only copy it if a parameter is added.
+  struct Layout {
+    std::string type;
+    std::vector<std::string> names;
+    std::vector<ParamType> types;
+  };
+  std::shared_ptr<Layout> layout_;
+
+  std::vector<param_type> values_;
+  std::vector<bool> assigned_;
   std::map<std::string, ParameterSet> defered_params_;
 };
 
 /// Factory that produces NEMLObjects from ParameterSets
+//  Creating objects is safe from any number of threads at once, as is
+//  registering new types while others create objects.  Each thread must
+//  use its own ParameterSets.
 class Factory {
  public:
   /// Provide a valid parameter set for the object type
@@ -260,21 +313,41 @@ class Factory {
                      std::function<std::unique_ptr<NEMLObject>(ParameterSet &)> creator,
                      std::function<ParameterSet()> setup);
 
-  /// Static factor instance
+  /// Register a class providing type(), initialize(), and parameters()
+  template<typename T>
+  void register_type()
+  {
+    register_type(T::type(), &T::initialize, &T::parameters);
+  }
+
+  /// Static factory instance, with all the NEML objects registered the
+  /// first time it is used
   static Factory * Creator();
 
  private:
-  std::map<std::string, std::function<std::unique_ptr<NEMLObject>(ParameterSet &)>> creators_;
-  std::map<std::string, std::function<ParameterSet()>> setups_;
+  struct Entry {
+    std::function<std::unique_ptr<NEMLObject>(ParameterSet &)> creator;
+    std::function<ParameterSet()> setup;
+  };
+  std::shared_ptr<const Entry> entry_(const std::string & type) const;
+
+  // Entries are never changed once registered, only replaced, so they
+  // can be used outside the lock
+  std::unordered_map<std::string, std::shared_ptr<const Entry>> types_;
+  mutable std::mutex mutex_;
 };
 
-/// Little object used for auto registration
+/// Register all the objects in NEML (in registry.cxx)
+void register_neml_objects(Factory & factory);
+
+/// Little object used for auto registration of objects defined outside
+/// of NEML.  Declare one in a source file, not a header.
 template<typename T>
 class Register {
  public:
   Register()
   {
-    Factory::Creator()->register_type(T::type(), &T::initialize, &T::parameters);
+    Factory::Creator()->register_type<T>();
   }
 };
 
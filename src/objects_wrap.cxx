@@ -12,6 +12,20 @@ PYBIND11_MODULE(objects, m) {
   m.doc() = "Factory system for creating objects.";
 
   py::class_<NEMLObject, std::shared_ptr<NEMLObject>>(m, "NEMLObject")
+      .def("clone", &NEMLObject::clone, 
+           "Deep copy of the object, optionally sharing the interpolates.",
+           py::arg("share_constants") = false)
+      .def_property_readonly("shared_between_models",
+           &NEMLObject::shared_between_models,
+           "True if the object is shared by several separate models.")
+      .def("__reduce__",
+           [](py::object self) -> py::tuple
+           {
+            auto restore = py::module::import("neml.pickling").attr("restore");
+            auto image = py::module::import("neml.serialize").attr("dumps")(self);
+            return py::make_tuple(restore, 
+                                  py::make_tuple(self.attr("__class__"), image));
+           }, "Pickle through the binary model image.")
       ;
 }
 
@@ -0,0 +1,87 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "nemlerror.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Minimal thread pool helpers for running independent tasks
+
+namespace neml {
+
+/// The number of threads to use for n tasks: nthreads, or all the
+/// hardware threads if nthreads is 0, but never more than the tasks
+inline unsigned thread_count(unsigned nthreads, size_t n)
+{
+  if (nthreads == 0) {
+    nthreads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  return (unsigned) std::max(std::min((size_t) nthreads, n), (size_t) 1);
+}
+
+/// The first error code in the codes from a set of tasks, or SUCCESS
+inline int first_error(const std::vector<int> & ier)
+{
+  for (auto i : ier) {
+    if (i != SUCCESS) return i;
+  }
+  return SUCCESS;
+}
+
+/// Call f(i) for each i in [0, n) using up to nthreads threads (0 for all
+/// the hardware threads)
+//  The threads take blocks of grain indices at a time.  The calling
+//  thread does its share of the work.  If any call throws no new blocks
+//  are started and, once all the threads finish, the exception from the
+//  lowest index is rethrown.
+template <class F>
+void parallel_for(size_t n, unsigned nthreads, F f, size_t grain = 1)
+{
+  grain = std::max(grain, (size_t) 1);
+  std::atomic<size_t> next(0);
+  std::atomic<bool> failed(false);
+  std::mutex mutex;
+  std::exception_ptr error;
+  size_t error_index = std::numeric_limits<size_t>::max();
+
+  auto work = [&]()
+  {
+    while (not failed) {
+      size_t start = next.fetch_add(grain);
+      if (start >= n) break;
+      size_t end = std::min(start + grain, n);
+      for (size_t i = start; i < end; i++) {
+        try {
+          f(i);
+        }
+        catch (...) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (i < error_index) {
+            error_index = i;
+            error = std::current_exception();
+          }
+          failed = true;
+          break;
+        }
+      }
+    }
+  };
+
+  unsigned nt = thread_count(nthreads, (n + grain - 1) / grain);
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < nt; i++) threads.emplace_back(work);
+  work();
+  for (auto & t : threads) t.join();
+
+  if (error) std::rethrow_exception(error);
+}
+
+} // namespace neml
+
+#endif // PARALLEL_H
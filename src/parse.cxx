@@ -1,5 +1,14 @@
 #include "parse.h"
 
+#include "parallel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+#include <sys/stat.h>
+
 namespace neml {
 
 std::shared_ptr<NEMLModel> parse_xml(std::string fname, std::string mname)
@@ -16,7 +25,8 @@ std::shared_ptr<NEMLModel> parse_xml(std::string fname, std::string mname)
   const rapidxml::xml_node<> * found = root->first_node(mname.c_str());
 
   // Get the NEMLObject
-  std::shared_ptr<NEMLObject> obj = get_object(found);
+  XMLDefinitions defs(root->first_node(XML_DEFINES.c_str()));
+  std::shared_ptr<NEMLObject> obj = get_object(found, &defs);
 
   // Do a dangerous cast
   auto res = std::dynamic_pointer_cast<NEMLModel>(obj);
@@ -42,7 +52,8 @@ std::unique_ptr<NEMLModel> parse_xml_unique(std::string fname, std::string mname
   const rapidxml::xml_node<> * found = root->first_node(mname.c_str());
 
   // Get the NEMLObject
-  std::unique_ptr<NEMLObject> obj = get_object_unique(found);
+  XMLDefinitions defs(root->first_node(XML_DEFINES.c_str()));
+  std::unique_ptr<NEMLObject> obj = get_object_unique(found, &defs);
 
   // Do a dangerous cast
   auto res = std::unique_ptr<NEMLModel>(dynamic_cast<NEMLModel*>(obj.release()));
@@ -54,14 +65,104 @@ std::unique_ptr<NEMLModel> parse_xml_unique(std::string fname, std::string mname
   }
 }
 
-std::unique_ptr<NEMLObject> get_object_unique(const rapidxml::xml_node<> * node) {
+std::vector<std::shared_ptr<NEMLModel>> parse_xml_parallel(
+    std::string fname, std::vector<std::string> mnames, unsigned nthreads)
+{
+  rapidxml::file <> xmlFile(fname.c_str());
+  rapidxml::xml_document<> doc;
+  doc.parse<0>(xmlFile.data());
+  const rapidxml::xml_node<> * root = doc.first_node("materials");
+  if (root == nullptr) throw NodeNotFound("materials", 0);
+  const rapidxml::xml_node<> * defines = root->first_node(XML_DEFINES.c_str());
+
+  // The document is only read from here on
+  std::vector<std::shared_ptr<NEMLModel>> res(mnames.size());
+  parallel_for(mnames.size(), nthreads, [&](size_t i)
+  {
+    const rapidxml::xml_node<> * found = root->first_node(mnames[i].c_str());
+    if (found == nullptr) throw NodeNotFound(mnames[i], 0);
+    // Separate models get separate objects
+    XMLDefinitions defs(defines);
+    res[i] = std::dynamic_pointer_cast<NEMLModel>(get_object(found, &defs));
+    if (res[i] == nullptr) {
+      throw InvalidType(found->name(), get_type_of_node(found), "NEMLModel");
+    }
+  });
+
+  return res;
+}
+
+XMLDefinitions::XMLDefinitions(const rapidxml::xml_node<> * defines,
+                               bool shared) :
+    defines_(defines), shared_(shared)
+{
+
+}
+
+const rapidxml::xml_node<> * XMLDefinitions::find(
+    const rapidxml::xml_node<> * node)
+{
+  const rapidxml::xml_node<> * root = node->document()->first_node("materials");
+  if (root == nullptr) return nullptr;
+  return root->first_node(XML_DEFINES.c_str());
+}
+
+const rapidxml::xml_node<> * XMLDefinitions::node(std::string name) const
+{
+  const rapidxml::xml_node<> * found = nullptr;
+  if (defines_ != nullptr) found = defines_->first_node(name.c_str());
+  if (found == nullptr) throw NodeNotFound(name, 0);
+  return found;
+}
+
+std::shared_ptr<NEMLObject> XMLDefinitions::object(std::string name)
+{
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  auto found = objects_.find(name);
+  if (found != objects_.end()) return found->second;
+
+  if (not active_.insert(name).second) throw CircularReference(name);
+  std::shared_ptr<NEMLObject> obj;
+  try {
+    obj = get_object(node(name), this);
+  }
+  catch (...) {
+    active_.erase(name);
+    throw;
+  }
+  active_.erase(name);
+
+  if (shared_) obj->set_shared_between_models();
+  objects_.insert(std::make_pair(name, obj));
+  return obj;
+}
+
+size_t XMLDefinitions::size() const
+{
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  return objects_.size();
+}
+
+std::unique_ptr<NEMLObject> get_object_unique(const rapidxml::xml_node<> * node,
+                                              XMLDefinitions * defs) {
+  if (defs == nullptr) {
+    XMLDefinitions local(XMLDefinitions::find(node));
+    return get_object_unique(node, &local);
+  }
+
+  // A reference can't be shared through a unique_ptr, so make a new one
+  std::string ref = get_reference(node);
+  if (not ref.empty()) {
+    return get_object_unique(defs->node(ref), defs);
+  }
+
   // Special case: could be a ConstantInterpolate
   std::string type = get_type_of_node(node);
   if (type == "none") {
     return neml::make_unique<ConstantInterpolate>(get_double(node));
   }
   else {
-    ParameterSet params = get_parameters(node);
+    ParameterSet params = get_parameters(node, defs);
     try {
       return Factory::Creator()->create_unique(params);
     }
@@ -71,21 +172,36 @@ std::unique_ptr<NEMLObject> get_object_unique(const rapidxml::xml_node<> * node)
   }
 }
 
-std::shared_ptr<NEMLObject> get_object(const rapidxml::xml_node<> * node)
+std::shared_ptr<NEMLObject> get_object(const rapidxml::xml_node<> * node,
+                                       XMLDefinitions * defs)
 {
+  if (defs == nullptr) {
+    XMLDefinitions local(XMLDefinitions::find(node));
+    return get_object(node, &local);
+  }
+
+  std::string ref = get_reference(node);
+  if (not ref.empty()) return defs->object(ref);
+
   // Special case: could be a ConstantInterpolate
   std::string type = get_type_of_node(node);
   if (type == "none") {
     return std::make_shared<ConstantInterpolate>(get_double(node));
   }
   else {
-    ParameterSet params = get_parameters(node);
+    ParameterSet params = get_parameters(node, defs);
     return Factory::Creator()->create(params);
   }
 }
 
-ParameterSet get_parameters(const rapidxml::xml_node<> * node)
+ParameterSet get_parameters(const rapidxml::xml_node<> * node,
+                            XMLDefinitions * defs)
 {
+  if (defs == nullptr) {
+    XMLDefinitions local(XMLDefinitions::find(node));
+    return get_parameters(node, &local);
+  }
+
   std::string type = get_type_of_node(node);
 
   // Needs to have a type at this point
@@ -110,27 +226,32 @@ ParameterSet get_parameters(const rapidxml::xml_node<> * node)
       throw UnknownParameterXML(node->name(), name);
     }
 
+    // Plain values just take the text of the definition
+    const rapidxml::xml_node<> * value = child;
+    std::string ref = get_reference(child);
+    if (not ref.empty()) value = defs->node(ref);
+
     switch (pset.get_object_type(name)) {
       case TYPE_DOUBLE:
-        pset.assign_parameter(name, get_double(child));
+        pset.assign_parameter(name, get_double(value));
         break;
       case TYPE_INT:
-        pset.assign_parameter(name, get_int(child));
+        pset.assign_parameter(name, get_int(value));
         break;
       case TYPE_BOOL:
-        pset.assign_parameter(name, get_bool(child));
+        pset.assign_parameter(name, get_bool(value));
         break;
       case TYPE_VEC_DOUBLE:
-        pset.assign_parameter(name, get_vector_double(child));
+        pset.assign_parameter(name, get_vector_double(value));
         break;
       case TYPE_NEML_OBJECT:
-        pset.assign_parameter(name, get_object(child));
+        pset.assign_parameter(name, get_object(child, defs));
         break;
       case TYPE_VEC_NEML_OBJECT:
-        pset.assign_parameter(name, get_vector_object(child));
+        pset.assign_parameter(name, get_vector_object(value, defs));
         break;
       case TYPE_STRING:
-        pset.assign_parameter(name, get_string(child));
+        pset.assign_parameter(name, get_string(value));
         break;
       default:
         throw std::runtime_error("Unrecognized object type!");
@@ -142,13 +263,18 @@ ParameterSet get_parameters(const rapidxml::xml_node<> * node)
 }
 
 std::vector<std::shared_ptr<NEMLObject>> get_vector_object(
-    const rapidxml::xml_node<> * node)
+    const rapidxml::xml_node<> * node, XMLDefinitions * defs)
 {
+  if (defs == nullptr) {
+    XMLDefinitions local(XMLDefinitions::find(node));
+    return get_vector_object(node, &local);
+  }
+
   std::vector<std::shared_ptr<NEMLObject>> joined;
   for (rapidxml::xml_node<> * child = node->first_node(); child; child = child->next_sibling()) {
     std::string name = (child)->name();
     if (name == "text") continue;
-    joined.push_back(get_object(child));
+    joined.push_back(get_object(child, defs));
   }
 
   return joined;
@@ -225,6 +351,13 @@ std::string get_type_of_node(const rapidxml::xml_node<> * node)
   return "none";
 }
 
+std::string get_reference(const rapidxml::xml_node<> * node)
+{
+  const rapidxml::xml_attribute<> * ref = node->first_attribute("ref");
+  if (ref == nullptr) return "";
+  return ref->value();
+}
+
 std::vector<double> split_string(std::string sval)
 {
   std::vector<std::string> splits;
@@ -242,15 +375,364 @@ std::vector<double> split_string(std::string sval)
 
 void print_model_names(std::string fname)
 {
-  rapidxml::file <> xmlFile(fname.c_str());
+  // Just listing names shouldn't leave an index next to the file
+  XMLLibrary library(fname, "", false);
+  for (auto & name : library.names()) {
+    printf("\t%s (%s)\n", name.c_str(), library.type(name).c_str());
+  }
+}
+
+namespace {
+
+const std::string INDEX_HEADER = "NEMLXMLINDEX 1";
+
+// Position of s in the data, starting at pos, or n if not found
+size_t find_text(const char * d, size_t n, size_t pos, const std::string & s)
+{
+  const char * res = std::search(d + pos, d + n, s.begin(), s.end());
+  return res - d;
+}
+
+// Position just after the end of s
+size_t skip_past(const char * d, size_t n, size_t pos, const std::string & s)
+{
+  size_t res = find_text(d, n, pos, s);
+  if (res == n) throw std::runtime_error("Unterminated XML markup");
+  return res + s.size();
+}
+
+bool starts_with(const char * d, size_t n, size_t pos, const std::string & s)
+{
+  return (pos + s.size() <= n) && std::equal(s.begin(), s.end(), d + pos);
+}
+
+bool is_space(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Position of the > closing the tag starting at pos, skipping quotes
+size_t tag_end(const char * d, size_t n, size_t pos)
+{
+  char quote = 0;
+  for (size_t i = pos; i < n; i++) {
+    if (quote) {
+      if (d[i] == quote) quote = 0;
+    }
+    else if (d[i] == '"' || d[i] == '\'') quote = d[i];
+    else if (d[i] == '>') return i;
+  }
+  throw std::runtime_error("Unterminated XML tag");
+}
+
+// Name and type attribute of the tag in [start, end)
+void tag_info(const char * d, size_t start, size_t end, std::string & name,
+              std::string & type)
+{
+  size_t i = start + 1;
+  while (i < end && !is_space(d[i]) && d[i] != '/') i++;
+  name.assign(d + start + 1, i - start - 1);
+
+  type = "none";
+  while (i < end) {
+    while (i < end && (is_space(d[i]) || d[i] == '/')) i++;
+    size_t ns = i;
+    while (i < end && d[i] != '=' && !is_space(d[i])) i++;
+    std::string attr(d + ns, i - ns);
+    while (i < end && d[i] != '"' && d[i] != '\'') i++;
+    if (i >= end) break;
+    char quote = d[i++];
+    size_t vs = i;
+    while (i < end && d[i] != quote) i++;
+    if (attr == "type") {
+      type.assign(d + vs, i - vs);
+      return;
+    }
+    i++;
+  }
+}
+
+long long modification_time(const std::string & fname)
+{
+  struct stat st;
+  if (stat(fname.c_str(), &st) != 0) return -1;
+  return (long long) st.st_mtime;
+}
+
+} // namespace
+
+XMLLibrary::XMLLibrary(std::string fname, std::string index,
+                       bool save_index, bool share_definitions) :
+    fname_(fname), index_(index.empty() ? fname + ".index" : index),
+    save_index_(save_index), share_definitions_(share_definitions), file_(neml::make_unique<MappedFile>(fname)), reused_(false),
+    defines_(nullptr)
+{
+  size_t size = file_->size();
+  long long mtime = modification_time(fname_);
+
+  reused_ = read_index_(size, mtime);
+  if (not reused_) {
+    build_index_();
+    write_index_(size, mtime, hash_());
+  }
+
+  lookup_.reserve(entries_.size());
+  for (size_t i = 0; i < entries_.size(); i++) {
+    // Same as first_node: the first node with the name wins
+    if (entries_[i].name == XML_DEFINES) {
+      if (defines_ == nullptr) defines_ = &entries_[i];
+      continue;
+    }
+    lookup_.insert(std::make_pair(entries_[i].name, i));
+  }
+}
+
+std::vector<std::string> XMLLibrary::names() const
+{
+  std::vector<std::string> res;
+  for (auto & e : entries_) {
+    if (e.name != XML_DEFINES) res.push_back(e.name);
+  }
+  return res;
+}
+
+std::string XMLLibrary::type(std::string mname) const
+{
+  return entry_(mname).type;
+}
+
+std::shared_ptr<NEMLModel> XMLLibrary::parse(std::string mname) const
+{
+  return parse_unique(mname);
+}
+
+std::unique_ptr<NEMLModel> XMLLibrary::parse_unique(std::string mname) const
+{
+  const Entry & e = entry_(mname);
+
+  // rapidxml parses in place, so copy just this model
+  std::vector<char> text(file_->data() + e.start, file_->data() + e.end);
+  text.push_back('\0');
   rapidxml::xml_document<> doc;
-  doc.parse<0>(xmlFile.data());
+  doc.parse<0>(text.data());
+  const rapidxml::xml_node<> * found = doc.first_node();
 
-  const rapidxml::xml_node<> * root = doc.first_node("materials");
-  for (rapidxml::xml_node<> * model_node = root->first_node(); model_node; model_node = model_node->next_sibling())
-	{
-    printf("\t%s (%s)\n", model_node->name(), model_node->first_attribute("type")->value());
+  std::unique_ptr<NEMLObject> obj;
+  if (share_definitions_) {
+    obj = get_object_unique(found, &definitions_());
+  }
+  else {
+    XMLDefinitions defs(defines_node_());
+    obj = get_object_unique(found, &defs);
+  }
+
+  auto res = std::unique_ptr<NEMLModel>(dynamic_cast<NEMLModel*>(obj.get()));
+  if (res == nullptr) {
+    throw InvalidType(found->name(), get_type_of_node(found), "NEMLModel");
+  }
+  obj.release();
+  return res;
+}
+
+bool XMLLibrary::index_reused() const
+{
+  return reused_;
+}
+
+bool XMLLibrary::read_index_(size_t size, long long mtime)
+{
+  // Mapped and split by hand, streams are slow enough to matter here
+  std::unique_ptr<MappedFile> index;
+  try {
+    index = neml::make_unique<MappedFile>(index_);
+  }
+  catch (FileMapError & e) {
+    return false;
+  }
+  const char * d = index->data();
+  size_t n = index->size();
+  size_t pos = 0;
+
+  auto token = [d, n, &pos](std::string & t)
+  {
+    while (pos < n && is_space(d[pos])) pos++;
+    size_t start = pos;
+    while (pos < n && !is_space(d[pos])) pos++;
+    t.assign(d + start, pos - start);
+    return not t.empty();
+  };
+  auto number = [d, n, &pos](unsigned long long & v)
+  {
+    while (pos < n && is_space(d[pos])) pos++;
+    size_t start = pos;
+    v = 0;
+    for (; pos < n && d[pos] >= '0' && d[pos] <= '9'; pos++) {
+      v = 10 * v + (d[pos] - '0');
+    }
+    return pos > start && (pos == n || is_space(d[pos]));
+  };
+
+  if (not starts_with(d, n, 0, INDEX_HEADER + "\n")) return false;
+  pos = INDEX_HEADER.size() + 1;
+
+  std::string smtime;
+  unsigned long long isize, ihash, count;
+  if (not (number(isize) && token(smtime) && number(ihash) && number(count)))
+    return false;
+  if (isize != size) return false;
+
+  std::vector<Entry> entries(count);
+  for (auto & e : entries) {
+    unsigned long long start, end;
+    if (not (token(e.name) && token(e.type) && number(start) && number(end)))
+      return false;
+    if (start >= end || end > size) return false;
+    e.start = start;
+    e.end = end;
+  }
+
+  // Touched but maybe not changed
+  if (smtime != std::to_string(mtime)) {
+    if (ihash != hash_()) return false;
+    entries_ = entries;
+    write_index_(size, mtime, ihash);
+  }
+
+  entries_ = entries;
+  return true;
+}
+
+void XMLLibrary::build_index_()
+{
+  const char * d = file_->data();
+  size_t n = file_->size();
+
+  entries_.clear();
+  int depth = 0;
+  bool root = false;
+  Entry current;
+  size_t pos = 0;
+  while (true) {
+    size_t lt = find_text(d, n, pos, "<");
+    if (lt == n) break;
+
+    if (starts_with(d, n, lt, "<!--")) {
+      pos = skip_past(d, n, lt, "-->");
+    }
+    else if (starts_with(d, n, lt, "<![CDATA[")) {
+      pos = skip_past(d, n, lt, "]]>");
+    }
+    else if (starts_with(d, n, lt, "<?")) {
+      pos = skip_past(d, n, lt, "?>");
+    }
+    else if (starts_with(d, n, lt, "<!")) {
+      pos = skip_past(d, n, lt, ">");
+    }
+    else if (starts_with(d, n, lt, "</")) {
+      pos = tag_end(d, n, lt) + 1;
+      depth--;
+      if (depth == 1) {
+        current.end = pos;
+        entries_.push_back(current);
+      }
+      else if (depth == 0) {
+        break;
+      }
+    }
+    else {
+      size_t gt = tag_end(d, n, lt);
+      bool closed = d[gt-1] == '/';
+      std::string name, type;
+      tag_info(d, lt, gt, name, type);
+      if (depth == 0) {
+        if (name != "materials") throw NodeNotFound("materials", 0);
+        root = true;
+        if (closed) break;
+      }
+      else if (depth == 1) {
+        current.name = name;
+        current.type = type;
+        current.start = lt;
+        current.end = gt + 1;
+        if (closed) entries_.push_back(current);
+      }
+      if (not closed) depth++;
+      pos = gt + 1;
+    }
+  }
+
+  if (not root) throw NodeNotFound("materials", 0);
+}
+
+void XMLLibrary::write_index_(size_t size, long long mtime, uint64_t hash) const
+{
+  if (not save_index_) return;
+
+  // Write and rename, so readers never see a partial index.  Not being
+  // able to save the index (say a read only directory) is not an error.
+  std::string temp = index_ + ".tmp" + std::to_string(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+  {
+    std::ofstream os(temp);
+    if (not os.good()) return;
+    os << INDEX_HEADER << std::endl;
+    os << size << " " << mtime << " " << hash << " " << entries_.size()
+        << std::endl;
+    for (auto & e : entries_) {
+      os << e.name << " " << e.type << " " << e.start << " " << e.end
+          << std::endl;
+    }
+    if (not os.good()) {
+      std::remove(temp.c_str());
+      return;
+    }
+  }
+  if (std::rename(temp.c_str(), index_.c_str()) != 0) {
+    std::remove(temp.c_str());
   }
 }
 
+uint64_t XMLLibrary::hash_() const
+{
+  // FNV-1a
+  uint64_t h = 14695981039346656037ULL;
+  const unsigned char * d = reinterpret_cast<const unsigned char*>(
+      file_->data());
+  for (size_t i = 0; i < file_->size(); i++) {
+    h ^= d[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+const XMLLibrary::Entry & XMLLibrary::entry_(std::string mname) const
+{
+  auto found = lookup_.find(mname);
+  if (found == lookup_.end()) throw NodeNotFound(mname, 0);
+  return entries_[found->second];
+}
+
+const rapidxml::xml_node<> * XMLLibrary::defines_node_() const
+{
+  std::call_once(defines_loaded_, [this]()
+  {
+    if (defines_ == nullptr) return;
+    defines_text_.assign(file_->data() + defines_->start,
+                         file_->data() + defines_->end);
+    defines_text_.push_back('\0');
+    defines_doc_ = neml::make_unique<rapidxml::xml_document<>>();
+    defines_doc_->parse<0>(defines_text_.data());
+  });
+  return defines_doc_ == nullptr ? nullptr : defines_doc_->first_node();
+}
+
+XMLDefinitions & XMLLibrary::definitions_() const
+{
+  std::call_once(defs_created_, [this]()
+  {
+    defs_ = neml::make_unique<XMLDefinitions>(defines_node_(), true);
+  });
+  return *defs_;
+}
+
 } // namespace neml
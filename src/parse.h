@@ -4,11 +4,17 @@
 #include "objects.h"
 #include "models.h"
 #include "damage.h"
+#include "mapped.h"
 
 #include "rapidxml.hpp"
 #include "rapidxml_utils.hpp"
 
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -17,23 +23,69 @@
 
 namespace neml {
 
+/// Name of the top level node holding shared definitions
+const std::string XML_DEFINES = "defines";
+
+/// Objects defined once, in the defines node at the top level of a file,
+/// and used anywhere by name with <parameter ref="name"/>.  Each
+/// definition becomes a single object shared by every reference to it.
+/// Objects can be created through one set of definitions from several
+/// threads at once.  Use one set of definitions per model unless the
+/// models are meant to share the objects, in which case pass shared so
+/// they are marked as shared_between_models.
+class XMLDefinitions {
+ public:
+  /// Definitions under a defines node (which may be nullptr)
+  XMLDefinitions(const rapidxml::xml_node<> * defines = nullptr,
+                 bool shared = false);
+  /// The defines node of the document holding node, or nullptr
+  static const rapidxml::xml_node<> * find(const rapidxml::xml_node<> * node);
+
+  /// The node a reference points to
+  const rapidxml::xml_node<> * node(std::string name) const;
+  /// The object for a definition, created the first time it's used
+  std::shared_ptr<NEMLObject> object(std::string name);
+  /// Number of definitions used so far
+  size_t size() const;
+
+ private:
+  const rapidxml::xml_node<> * defines_;
+  bool shared_;
+  std::map<std::string, std::shared_ptr<NEMLObject>> objects_;
+  std::set<std::string> active_;
+  // Recursive, as definitions can refer to other definitions
+  mutable std::recursive_mutex mutex_;
+};
+
 /// Parse from file to a shared_ptr
 std::shared_ptr<NEMLModel> parse_xml(std::string fname, std::string mname);
 
 /// Parse from file to a unique_ptr
 std::unique_ptr<NEMLModel> parse_xml_unique(std::string fname, std::string mname);
 
+/// Parse several models from one file, nthreads at a time (0 to use all
+/// the hardware threads).  The file is read once, but each model gets its
+/// own objects for the definitions in the defines node.
+std::vector<std::shared_ptr<NEMLModel>> parse_xml_parallel(
+    std::string fname, std::vector<std::string> mnames, unsigned nthreads = 0);
+
+// The definitions default to the ones in the document holding the node
+
 /// Extract a NEMLObject from a xml node as a unique_ptr
-std::unique_ptr<NEMLObject> get_object_unique(const rapidxml::xml_node<> * node);
+std::unique_ptr<NEMLObject> get_object_unique(const rapidxml::xml_node<> * node,
+                                              XMLDefinitions * defs = nullptr);
 
 /// Extract a NEMLObject from a xml node
-std::shared_ptr<NEMLObject> get_object(const rapidxml::xml_node<> * node);
+std::shared_ptr<NEMLObject> get_object(const rapidxml::xml_node<> * node,
+                                       XMLDefinitions * defs = nullptr);
 
 /// Actually get a valid parameter set from a node
-ParameterSet get_parameters(const rapidxml::xml_node<> * node);
+ParameterSet get_parameters(const rapidxml::xml_node<> * node,
+                            XMLDefinitions * defs = nullptr);
 
 /// Extract a vector of NEMLObjects from an xml node
-std::vector<std::shared_ptr<NEMLObject>> get_vector_object(const rapidxml::xml_node<> * node);
+std::vector<std::shared_ptr<NEMLObject>> get_vector_object(
+    const rapidxml::xml_node<> * node, XMLDefinitions * defs = nullptr);
 
 /// Extract a double from an xml node
 double get_double(const rapidxml::xml_node<> * node);
@@ -60,9 +112,79 @@ const rapidxml::xml_node<> * get_child(const rapidxml::xml_node<> * node, std::s
 /// Return the type of a node
 std::string get_type_of_node(const rapidxml::xml_node<> * node);
 
+/// Return the definition a node refers to, or "" if it's not a reference
+std::string get_reference(const rapidxml::xml_node<> * node);
+
 /// Helper to split strings
 std::vector<double> split_string(std::string sval);
 
+/// Loads single models out of a large XML library without parsing the
+/// whole file every time
+//  The library keeps an index giving the byte range of each top level
+//  model.  The index is saved next to the file (fname + ".index" by
+//  default) and reused as long as the file size and modification time
+//  match, or, if they changed, as long as the file contents hash still
+//  matches.  Loading a model then only parses that model's subtree.
+//  The file is memory mapped, not copied.  With save_index false an
+//  existing index is still used but nothing is written to disk.
+//
+//  The defines section is parsed the first time a model refers to it and
+//  kept.  By default each model gets its own objects for the definitions,
+//  so the models are independent.  With share_definitions each
+//  definition is instead one object shared by every model loaded from the
+//  library, which saves memory, but the shared objects are marked as
+//  shared_between_models and can't be tuned in place.
+//
+//  Models can be loaded from several threads at once.
+class XMLLibrary {
+ public:
+  /// Open the library, reading or rebuilding the index
+  XMLLibrary(std::string fname, std::string index = "",
+             bool save_index = true, bool share_definitions = false);
+
+  /// Names of all the models, in file order
+  std::vector<std::string> names() const;
+  /// The type attribute of a model
+  std::string type(std::string mname) const;
+
+  /// Parse a single model to a shared_ptr
+  std::shared_ptr<NEMLModel> parse(std::string mname) const;
+  /// Parse a single model to a unique_ptr
+  std::unique_ptr<NEMLModel> parse_unique(std::string mname) const;
+
+  /// Whether the saved index was used (rather than rebuilt)
+  bool index_reused() const;
+
+ private:
+  struct Entry {
+    std::string name, type;
+    size_t start, end;
+  };
+
+  bool read_index_(size_t size, long long mtime);
+  void build_index_();
+  void write_index_(size_t size, long long mtime, uint64_t hash) const;
+  uint64_t hash_() const;
+  const Entry & entry_(std::string mname) const;
+  const rapidxml::xml_node<> * defines_node_() const;
+  XMLDefinitions & definitions_() const;
+
+  std::string fname_, index_;
+  bool save_index_, share_definitions_;
+  std::unique_ptr<MappedFile> file_;
+  std::vector<Entry> entries_;
+  std::unordered_map<std::string, size_t> lookup_;
+  bool reused_;
+
+  // The defines section, loaded on demand
+  const Entry * defines_;
+  mutable std::once_flag defines_loaded_;
+  mutable std::vector<char> defines_text_;
+  mutable std::unique_ptr<rapidxml::xml_document<>> defines_doc_;
+  mutable std::once_flag defs_created_;
+  mutable std::unique_ptr<XMLDefinitions> defs_;
+};
+
 // Exceptions
 /// If a node is not found
 class NodeNotFound: public std::exception {
@@ -70,22 +192,21 @@ class NodeNotFound: public std::exception {
   NodeNotFound(std::string node_name, int line) :
       node_name_(node_name), line_(line)
   {
-  
+    std::stringstream ss;
+    ss << "Node with name " << node_name_
+        << " was not found near line " << line_ << "!";
+    msg_ = ss.str();
   };
 
   const char * what() const throw ()
   {
-    std::stringstream ss;
-
-    ss << "Node with name " << node_name_ 
-        << " was not found near line " << line_ << "!";
-
-    return ss.str().c_str();
+    return msg_.c_str();
   };
 
  private:
   std::string node_name_;
   int line_;
+  std::string msg_;
 };
 
 /// If a node is not unique (and it should be)
@@ -94,21 +215,20 @@ class DuplicateNode: public std::exception {
   DuplicateNode(std::string node_name, int line) :
       node_name_(node_name), line_(line)
   {
-
+    std::stringstream ss;
+    ss << "Multiple nodes with name " << node_name_ << " were found!";
+    msg_ = ss.str();
   };
 
     const char * what() const throw ()
     {
-      std::stringstream ss;
-
-      ss << "Multiple nodes with name " << node_name_ << " were found!";
-
-      return ss.str().c_str();
+      return msg_.c_str();
     };
 
   private:
     std::string node_name_;
     int line_;
+    std::string msg_;
 };
 
 /// If the object can't be converted
@@ -117,21 +237,20 @@ class InvalidType: public std::exception {
   InvalidType(std::string name, std::string type, std::string ctype) :
       name_(name), type_(type), ctype_(ctype)
   {
-
+    std::stringstream ss;
+    ss << "Node with name " << name_ << " and type " << type_
+        << "cannot be converted to the correct type " << ctype_ << "!";
+    msg_ = ss.str();
   };
 
   const char * what() const throw ()
   {
-    std::stringstream ss;
-
-    ss << "Node with name " << name_ << " and type " << type_ 
-        << "cannot be converted to the correct type " << ctype_ << "!";
-
-    return ss.str().c_str();
+    return msg_.c_str();
   };
 
  private:
   const std::string name_, type_, ctype_;
+  std::string msg_;
 };
 
 /// If a parameter doesn't exist
@@ -140,20 +259,19 @@ class UnknownParameterXML: public std::exception {
   UnknownParameterXML(std::string name, std::string param) :
       name_(name), param_(param)
   {
-
+    std::stringstream ss;
+    ss << "Object " << name_ << " does not have a parameter called " << param_ << "!";
+    msg_ = ss.str();
   };
 
   const char * what() const throw ()
   {
-    std::stringstream ss;
-
-    ss << "Object " << name_ << " does not have a parameter called " << param_ << "!";
-
-    return ss.str().c_str();
+    return msg_.c_str();
   };
 
  private:
   const std::string name_, param_;
+  std::string msg_;
 
 };
 
@@ -163,21 +281,41 @@ class UnregisteredXML: public std::exception {
   UnregisteredXML(std::string name, std::string type) :
       name_(name), type_(type)
   {
-
+    std::stringstream ss;
+    ss << "Node named " << name_ << " has an unregistered type of " << type_ << "!";
+    msg_ = ss.str();
   };
 
   const char * what() const throw ()
   {
-    std::stringstream ss;
-
-    ss << "Node named " << name_ << " has an unregistered type of " << type_ << "!";
-
-    return ss.str().c_str();
+    return msg_.c_str();
   };
 
  private:
   const std::string name_, type_;
+  std::string msg_;
+
+};
 
+/// A definition that (eventually) refers to itself
+class CircularReference: public std::exception {
+ public:
+  CircularReference(std::string name) :
+      name_(name)
+  {
+    std::stringstream ss;
+    ss << "Definition " << name_ << " refers to itself!";
+    msg_ = ss.str();
+  };
+
+  const char * what() const throw ()
+  {
+    return msg_.c_str();
+  };
+
+ private:
+  const std::string name_;
+  std::string msg_;
 };
 
 } // namespace neml
@@ -9,15 +9,33 @@ PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>)
 namespace neml {
 
 PYBIND11_MODULE(parse, m) {
+  py::module::import("neml.models");
+
   m.doc() = "Python wrapper to read XML input files.";
   
   m.def("parse_xml", &parse_xml);
+  m.def("parse_xml_parallel", &parse_xml_parallel,
+        "Parse several models from one file using several threads.",
+        py::arg("fname"), py::arg("mnames"), py::arg("nthreads") = 0,
+        py::call_guard<py::gil_scoped_release>());
+
+  py::class_<XMLLibrary>(m, "XMLLibrary")
+      .def(py::init<std::string, std::string, bool, bool>(),
+           py::arg("fname"), py::arg("index") = "",
+           py::arg("save_index") = true, py::arg("share_definitions") = false)
+      .def("names", &XMLLibrary::names, "The models in the file.")
+      .def("type", &XMLLibrary::type, "The type of a model.")
+      .def("parse", &XMLLibrary::parse, "Load a model.")
+      .def_property_readonly("index_reused", &XMLLibrary::index_reused,
+                             "True if an existing index was used.")
+      ;
 
   py::register_exception<NodeNotFound>(m, "NodeNotFound");
   py::register_exception<DuplicateNode>(m, "DuplicateNode");
   py::register_exception<InvalidType>(m, "InvalidType");
   py::register_exception<UnknownParameterXML>(m, "UnknownParameterXML");
   py::register_exception<UnregisteredXML>(m, "UnregisteredXML");
+  py::register_exception<CircularReference>(m, "CircularReference");
 }
 
 } // namespace neml
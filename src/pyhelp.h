@@ -10,6 +10,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <sstream>
 #include <stdexcept>
 
 #include "objects.h"
@@ -58,6 +59,155 @@ template<class T> py::array_t<T> alloc_mat(size_t m, size_t n)
   return arr;
 }
 
+// Allocate a new, zeroed array of any shape
+template<class T> py::array_t<T> alloc_array(std::vector<size_t> shape)
+{
+  // The bundled pybind11 can't compute the strides of a 0-d array
+  if (shape.empty()) {
+    auto arr = alloc_vec<T>(1);
+    return arr.attr("reshape")(py::tuple());
+  }
+  py::array_t<T> arr(std::vector<py::ssize_t>(shape.begin(), shape.end()));
+  std::fill(arr.mutable_data(), arr.mutable_data() + arr.size(), 0);
+  return arr;
+}
+
+// Check an array has the expected shape
+template<class T> void check_shape(const py::array & arr,
+                                   std::vector<size_t> shape,
+                                   std::string name)
+{
+  bool ok = (size_t) arr.ndim() == shape.size();
+  for (size_t i = 0; ok && i < shape.size(); i++) {
+    ok = (size_t) arr.shape(i) == shape[i];
+  }
+  if (not ok) {
+    std::stringstream ss;
+    ss << name << " should have shape (";
+    for (size_t i = 0; i < shape.size(); i++) {
+      ss << shape[i] << (i + 1 < shape.size() || shape.size() == 1 ? "," : "");
+    }
+    ss << ")";
+    throw std::invalid_argument(ss.str());
+  }
+}
+
+// Check if the memory of two arrays overlaps
+inline bool arrays_overlap(const py::array & a, const py::array & b)
+{
+  auto a0 = static_cast<const char*>(a.data());
+  auto b0 = static_cast<const char*>(b.data());
+  return a.nbytes() > 0 && b.nbytes() > 0 && a0 < b0 + b.nbytes() &&
+      b0 < a0 + a.nbytes();
+}
+
+// The zeroed output arrays for an update: new arrays if out is None or
+// otherwise the arrays in the tuple out, used in place.  Provided arrays
+// must be writeable, C contiguous arrays of T with the expected shapes
+// and must not overlap each other or any of the inputs, as they are
+// zeroed before the update reads the inputs.  They are zeroed as the
+// models do not set every entry of the outputs.
+template<class T> std::vector<py::array_t<T>> output_arrays(
+    py::object out, std::vector<std::vector<size_t>> shapes,
+    std::vector<std::string> names, std::vector<py::array> inputs = {})
+{
+  std::vector<py::array_t<T>> arrays;
+  if (out.is_none()) {
+    for (auto & shape : shapes) arrays.push_back(alloc_array<T>(shape));
+    return arrays;
+  }
+
+  if (not py::isinstance<py::tuple>(out) || 
+      py::len(out) != shapes.size()) {
+    std::stringstream ss;
+    ss << "out should be a tuple of " << shapes.size() << " arrays";
+    throw std::invalid_argument(ss.str());
+  }
+  py::tuple outs = out.cast<py::tuple>();
+  for (size_t i = 0; i < shapes.size(); i++) {
+    if (not py::isinstance<py::array_t<T>>(outs[i])) {
+      throw std::invalid_argument(names[i] + " should be an array of type " 
+                                  + std::string(py::str(py::dtype::of<T>())));
+    }
+    auto arr = py::reinterpret_borrow<py::array_t<T>>(outs[i]);
+    if (not (arr.flags() & py::array::c_style)) {
+      throw std::invalid_argument(names[i] + " should be C contiguous");
+    }
+    if (not arr.writeable()) {
+      throw std::invalid_argument(names[i] + " should be writeable");
+    }
+    check_shape<T>(arr, shapes[i], names[i]);
+    for (auto & other : arrays) {
+      if (arrays_overlap(arr, other)) {
+        throw std::invalid_argument(names[i] + " overlaps another output");
+      }
+    }
+    for (auto & input : inputs) {
+      if (arrays_overlap(arr, input)) {
+        throw std::invalid_argument(names[i] + " overlaps an input");
+      }
+    }
+    arrays.push_back(arr);
+  }
+  for (auto & arr : arrays) {
+    std::fill(arr.mutable_data(), arr.mutable_data() + arr.size(), 0);
+  }
+  return arrays;
+}
+
+// Broadcast the arguments against each other like numpy, except for the
+// trailing dimensions core[i] of argument i, which must match exactly.
+// Returns C contiguous double arrays and sets shape to the broadcast
+// leading shape.  Arrays that already have the full shape are not copied.
+inline std::vector<py::array_t<double, py::array::c_style | py::array::forcecast>>
+    broadcast_arrays(std::vector<py::object> args,
+                     std::vector<std::vector<size_t>> core,
+                     std::vector<std::string> names,
+                     std::vector<size_t> & shape)
+{
+  typedef py::array_t<double, py::array::c_style | py::array::forcecast> 
+      array;
+  auto np = py::module::import("numpy");
+
+  std::vector<array> arrays;
+  py::list leads;
+  for (size_t i = 0; i < args.size(); i++) {
+    auto arr = array::ensure(args[i]);
+    if (not arr) {
+      throw std::invalid_argument(names[i] + " should be an array of numbers");
+    }
+    size_t nc = core[i].size();
+    size_t nd = arr.ndim();
+    bool ok = nd >= nc;
+    for (size_t j = 0; ok && j < nc; j++) {
+      ok = (size_t) arr.shape(nd - nc + j) == core[i][j];
+    }
+    if (not ok) {
+      std::stringstream ss;
+      ss << names[i] << " should have shape (...";
+      for (auto d : core[i]) ss << "," << d;
+      ss << ")";
+      throw std::invalid_argument(ss.str());
+    }
+    py::list lead;
+    for (size_t j = 0; j < nd - nc; j++) lead.append(arr.shape(j));
+    leads.append(py::tuple(lead));
+    arrays.push_back(arr);
+  }
+
+  py::tuple common = np.attr("broadcast_shapes")(*leads);
+  shape.clear();
+  for (auto d : common) shape.push_back(d.cast<size_t>());
+
+  for (size_t i = 0; i < arrays.size(); i++) {
+    std::vector<size_t> full(shape);
+    full.insert(full.end(), core[i].begin(), core[i].end());
+    arrays[i] = array::ensure(np.attr("broadcast_to")(arrays[i], 
+                                                      py::cast(full)));
+  }
+  return arrays;
+}
+
 /// Map a python object into a parameter from a set
 void assign_python_parameter(ParameterSet & pset, std::string name, 
                              py::object value)
@@ -0,0 +1,94 @@
+#include "objects.h"
+
+#include "interpolate.h"
+#include "elasticity.h"
+#include "surfaces.h"
+#include "hardening.h"
+#include "ri_flow.h"
+#include "visco_flow.h"
+#include "general_flow.h"
+#include "creep.h"
+#include "models.h"
+#include "damage.h"
+
+namespace neml {
+
+void register_neml_objects(Factory & factory)
+{
+  // interpolate.h
+  factory.register_type<PolynomialInterpolate>();
+  factory.register_type<GenericPiecewiseInterpolate>();
+  factory.register_type<PiecewiseLinearInterpolate>();
+  factory.register_type<PiecewiseLogLinearInterpolate>();
+  factory.register_type<ConstantInterpolate>();
+  factory.register_type<ExpInterpolate>();
+  factory.register_type<MTSShearInterpolate>();
+
+  // elasticity.h
+  factory.register_type<IsotropicLinearElasticModel>();
+  factory.register_type<BlankElasticModel>();
+
+  // surfaces.h
+  factory.register_type<IsoKinJ2>();
+  factory.register_type<IsoJ2>();
+  factory.register_type<IsoKinJ2I1>();
+  factory.register_type<IsoJ2I1>();
+
+  // hardening.h
+  factory.register_type<LinearIsotropicHardeningRule>();
+  factory.register_type<InterpolatedIsotropicHardeningRule>();
+  factory.register_type<VoceIsotropicHardeningRule>();
+  factory.register_type<CombinedIsotropicHardeningRule>();
+  factory.register_type<LinearKinematicHardeningRule>();
+  factory.register_type<CombinedHardeningRule>();
+  factory.register_type<ConstantGamma>();
+  factory.register_type<SatGamma>();
+  factory.register_type<Chaboche>();
+
+  // ri_flow.h
+  factory.register_type<RateIndependentAssociativeFlow>();
+  factory.register_type<RateIndependentNonAssociativeHardening>();
+
+  // visco_flow.h
+  factory.register_type<GPowerLaw>();
+  factory.register_type<PerzynaFlowRule>();
+  factory.register_type<ConstantFluidity>();
+  factory.register_type<SaturatingFluidity>();
+  factory.register_type<ChabocheFlowRule>();
+  factory.register_type<YaguchiGr91FlowRule>();
+
+  // general_flow.h
+  factory.register_type<TVPFlowRule>();
+
+  // creep.h
+  factory.register_type<PowerLawCreep>();
+  factory.register_type<RegionKMCreep>();
+  factory.register_type<NortonBaileyCreep>();
+  factory.register_type<MukherjeeCreep>();
+  factory.register_type<GenericCreep>();
+  factory.register_type<BlackburnSinhCreep>();
+  factory.register_type<J2CreepModel>();
+
+  // models.h
+  factory.register_type<SmallStrainElasticity>();
+  factory.register_type<SmallStrainPerfectPlasticity>();
+  factory.register_type<SmallStrainRateIndependentPlasticity>();
+  factory.register_type<SmallStrainCreepPlasticity>();
+  factory.register_type<GeneralIntegrator>();
+  factory.register_type<KMRegimeModel>();
+  factory.register_type<MixedControlModel>();
+  factory.register_type<UniaxialModel>();
+
+  // damage.h
+  factory.register_type<CombinedDamageModel_sd>();
+  factory.register_type<ClassicalCreepDamageModel_sd>();
+  factory.register_type<VonMisesEffectiveStress>();
+  factory.register_type<HuddlestonEffectiveStress>();
+  factory.register_type<MaxPrincipalEffectiveStress>();
+  factory.register_type<MaxSeveralEffectiveStress>();
+  factory.register_type<ModularCreepDamageModel_sd>();
+  factory.register_type<NEMLPowerLawDamagedModel_sd>();
+  factory.register_type<NEMLExponentialWorkDamagedModel_sd>();
+}
+
+} // namespace neml
@@ -103,8 +103,6 @@ class RateIndependentAssociativeFlow: public RateIndependentFlowRule {
   std::shared_ptr<HardeningRule> hardening_;
 };
 
-static Register<RateIndependentAssociativeFlow> regRateIndependentAssociativeFlow;
-
 /// Associative plastic flow but non-associative hardening
 //    This is a general and fairly common case where the plastic flow rule
 //    (plastic strain rate evolution equation) is associative (normal) with
@@ -165,8 +163,6 @@ class RateIndependentNonAssociativeHardening: public RateIndependentFlowRule {
   std::shared_ptr<NonAssociativeHardening> hardening_;
 };
 
-static Register<RateIndependentNonAssociativeHardening> regRateIndependentNonAssociativeHardening;
-
 } // namespace neml
 
 #endif // RI_FLOW_H
@@ -0,0 +1,431 @@
+#include "serialize.h"
+
+#include "parse.h"
+#include "interpolate.h"
+
+#include "mapped.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace neml {
+
+namespace {
+
+const char MAGIC[8] = {'N', 'E', 'M', 'L', 'B', 'I', 'N', '\0'};
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+const size_t HEADER_SIZE = sizeof(MAGIC) + 4 * sizeof(uint32_t);
+// Name used in errors and the single root of in memory images
+const std::string MEMORY_IMAGE = "in memory";
+const std::string MEMORY_ROOT = "object";
+
+/// Binary output buffer
+class Buffer {
+ public:
+  template <typename T>
+  void put(const T & v)
+  {
+    const char * p = reinterpret_cast<const char*>(&v);
+    data_.insert(data_.end(), p, p + sizeof(T));
+  }
+
+  void put(const std::string & s)
+  {
+    put<uint32_t>(s.size());
+    data_.insert(data_.end(), s.begin(), s.end());
+  }
+
+  size_t size() const {return data_.size();};
+  const char * data() const {return data_.data();};
+
+ private:
+  std::vector<char> data_;
+};
+
+/// Flattens object graphs into records, children first
+class Writer {
+ public:
+  Writer(std::string fname) : fname_(fname) {};
+
+  uint32_t add(const std::shared_ptr<NEMLObject> & obj)
+  {
+    auto found = index_.find(obj.get());
+    if (found != index_.end()) return found->second;
+
+    ParameterSet params;
+    if (obj->parameter_set() != nullptr) {
+      params = *obj->parameter_set();
+    }
+    else if (auto c = std::dynamic_pointer_cast<ConstantInterpolate>(obj)) {
+      // The parsers make these directly from plain numbers
+      params = Factory::Creator()->provide_parameters("ConstantInterpolate");
+      params.assign_parameter("v", c->value(0.0));
+    }
+    else {
+      throw SerializationError(fname_,
+                               "cannot store an object not created by the Factory");
+    }
+
+    // Children first, so the record can refer to them by index
+    Buffer record;
+    record.put(params.type());
+    record.put<uint32_t>(params.param_names().size());
+    for (auto & name : params.param_names()) {
+      record.put(name);
+      ParamType type = params.get_object_type(name);
+      record.put<uint8_t>(type);
+      switch (type) {
+        case TYPE_DOUBLE:
+          record.put<double>(params.get_parameter<double>(name));
+          break;
+        case TYPE_INT:
+          record.put<int32_t>(params.get_parameter<int>(name));
+          break;
+        case TYPE_BOOL:
+          record.put<uint8_t>(params.get_parameter<bool>(name));
+          break;
+        case TYPE_VEC_DOUBLE:
+          {
+            auto v = params.get_parameter<std::vector<double>>(name);
+            record.put<uint32_t>(v.size());
+            for (auto x : v) record.put<double>(x);
+          }
+          break;
+        case TYPE_NEML_OBJECT:
+          record.put<uint32_t>(add(
+                  params.get_parameter<std::shared_ptr<NEMLObject>>(name)));
+          break;
+        case TYPE_VEC_NEML_OBJECT:
+          {
+            auto v = params.get_parameter<
+                std::vector<std::shared_ptr<NEMLObject>>>(name);
+            std::vector<uint32_t> inds;
+            for (auto & o : v) inds.push_back(add(o));
+            record.put<uint32_t>(inds.size());
+            for (auto i : inds) record.put<uint32_t>(i);
+          }
+          break;
+        case TYPE_STRING:
+          record.put(params.get_parameter<std::string>(name));
+          break;
+        default:
+          throw SerializationError(fname_, "unrecognized parameter type");
+      }
+    }
+
+    uint32_t ind = records_.size();
+    records_.push_back(record);
+    index_[obj.get()] = ind;
+    alive_.push_back(obj);
+    return ind;
+  }
+
+  void add_root(const std::string & name, const std::shared_ptr<NEMLObject> & obj)
+  {
+    roots_.push_back(std::make_pair(name, add(obj)));
+  }
+
+  /// The whole image
+  std::string image() const
+  {
+    Buffer head;
+    for (auto c : MAGIC) head.put<char>(c);
+    head.put<uint32_t>(BINARY_VERSION);
+    head.put<uint32_t>(BYTE_ORDER_MARK);
+    head.put<uint32_t>(records_.size());
+    head.put<uint32_t>(roots_.size());
+
+    Buffer roots;
+    for (auto & r : roots_) {
+      roots.put(r.first);
+      roots.put<uint32_t>(r.second);
+    }
+
+    uint64_t offset = head.size() + records_.size() * sizeof(uint64_t) +
+        roots.size();
+    for (auto & r : records_) {
+      head.put<uint64_t>(offset);
+      offset += r.size();
+    }
+
+    std::string res;
+    res.reserve(offset);
+    res.append(head.data(), head.size());
+    res.append(roots.data(), roots.size());
+    for (auto & r : records_) res.append(r.data(), r.size());
+    return res;
+  }
+
+  void write() const
+  {
+    std::string data = image();
+    std::ofstream os(fname_, std::ios::binary);
+    os.write(data.data(), data.size());
+    if (not os.good()) throw SerializationError(fname_, "write failed");
+  }
+
+ private:
+  std::string fname_;
+  std::vector<Buffer> records_;
+  std::map<const NEMLObject*, uint32_t> index_;
+  // Keep the objects alive so their addresses stay unique
+  std::vector<std::shared_ptr<NEMLObject>> alive_;
+  std::vector<std::pair<std::string,uint32_t>> roots_;
+};
+
+/// Creates objects straight from an image, only the ones asked for
+class Reader {
+ public:
+  /// Read a file
+  Reader(std::string fname) : fname_(fname), file_(open_(fname)),
+      data_(file_->data()), size_(file_->size())
+  {
+    setup_();
+  }
+
+  /// Read an image in memory, which must outlive the reader
+  Reader(std::string name, const char * data, size_t size) :
+      fname_(name), data_(data), size_(size)
+  {
+    setup_();
+  }
+
+  std::vector<std::string> names() const
+  {
+    std::vector<std::string> res;
+    for (auto & r : roots_) res.push_back(r.first);
+    return res;
+  }
+
+  /// The index of a named root
+  uint32_t root(const std::string & name) const
+  {
+    for (auto & r : roots_) {
+      if (r.first == name) return r.second;
+    }
+    throw SerializationError(fname_, "no model named " + name);
+  }
+
+  /// Parameters of an object, with the nested objects created
+  ParameterSet parameters(uint32_t i)
+  {
+    size_t opos = offsets_ + i * sizeof(uint64_t);
+    size_t pos = get_<uint64_t>(opos);
+
+    ParameterSet params = Factory::Creator()->provide_parameters(
+        get_string_(pos));
+    uint32_t np = get_<uint32_t>(pos);
+    for (uint32_t k = 0; k < np; k++) {
+      std::string name = get_string_(pos);
+      uint8_t type = get_<uint8_t>(pos);
+      if (not params.is_parameter(name) ||
+          params.get_object_type(name) != type) {
+        throw SerializationError(fname_, "parameter " + name +
+                                 " does not match object " + params.type());
+      }
+      switch (type) {
+        case TYPE_DOUBLE:
+          params.assign_parameter(name, get_<double>(pos));
+          break;
+        case TYPE_INT:
+          params.assign_parameter(name, (int) get_<int32_t>(pos));
+          break;
+        case TYPE_BOOL:
+          params.assign_parameter(name, (bool) get_<uint8_t>(pos));
+          break;
+        case TYPE_VEC_DOUBLE:
+          {
+            uint32_t n = get_<uint32_t>(pos);
+            std::vector<double> v(n);
+            for (uint32_t j = 0; j < n; j++) v[j] = get_<double>(pos);
+            params.assign_parameter(name, v);
+          }
+          break;
+        case TYPE_NEML_OBJECT:
+          params.assign_parameter(name, object(child_(pos, i)));
+          break;
+        case TYPE_VEC_NEML_OBJECT:
+          {
+            uint32_t n = get_<uint32_t>(pos);
+            std::vector<std::shared_ptr<NEMLObject>> v;
+            for (uint32_t j = 0; j < n; j++) v.push_back(object(child_(pos, i)));
+            params.assign_parameter(name, v);
+          }
+          break;
+        case TYPE_STRING:
+          params.assign_parameter(name, get_string_(pos));
+          break;
+        default:
+          throw SerializationError(fname_, "unrecognized parameter type");
+      }
+    }
+
+    return params;
+  }
+
+  /// Get (creating once) object i
+  std::shared_ptr<NEMLObject> object(uint32_t i)
+  {
+    if (objects_[i] == nullptr) {
+      ParameterSet params = parameters(i);
+      objects_[i] = Factory::Creator()->create(params);
+    }
+    return objects_[i];
+  }
+
+ private:
+  /// Check the header and read the roots
+  void setup_()
+  {
+    size_t pos = 0;
+    if (size_ < HEADER_SIZE ||
+        std::memcmp(data_, MAGIC, sizeof(MAGIC)) != 0) {
+      throw SerializationError(fname_, "not a binary model image");
+    }
+    pos += sizeof(MAGIC);
+    uint32_t version = get_<uint32_t>(pos);
+    if (version != BINARY_VERSION) {
+      throw SerializationError(fname_, "format version " +
+                               std::to_string(version) + " is not supported");
+    }
+    if (get_<uint32_t>(pos) != BYTE_ORDER_MARK) {
+      throw SerializationError(fname_, "written with a different byte order");
+    }
+    nobjects_ = get_<uint32_t>(pos);
+    uint32_t nroots = get_<uint32_t>(pos);
+
+    offsets_ = pos;
+    pos += nobjects_ * sizeof(uint64_t);
+    for (uint32_t i = 0; i < nroots; i++) {
+      std::string name = get_string_(pos);
+      uint32_t ind = get_<uint32_t>(pos);
+      if (ind >= nobjects_) throw SerializationError(fname_, "bad root index");
+      roots_.push_back(std::make_pair(name, ind));
+    }
+    objects_.resize(nobjects_);
+  }
+
+  static std::unique_ptr<MappedFile> open_(std::string fname)
+  {
+    try {
+      return neml::make_unique<MappedFile>(fname);
+    }
+    catch (FileMapError & e) {
+      throw SerializationError(fname, "cannot open file");
+    }
+  }
+
+  template <typename T>
+  T get_(size_t & pos) const
+  {
+    if (pos + sizeof(T) > size_) {
+      throw SerializationError(fname_, "file is truncated");
+    }
+    T v;
+    std::memcpy(&v, data_ + pos, sizeof(T));
+    pos += sizeof(T);
+    return v;
+  }
+
+  std::string get_string_(size_t & pos) const
+  {
+    uint32_t n = get_<uint32_t>(pos);
+    if (pos + n > size_) {
+      throw SerializationError(fname_, "file is truncated");
+    }
+    std::string s(data_ + pos, n);
+    pos += n;
+    return s;
+  }
+
+  // Children always come before their parents
+  uint32_t child_(size_t & pos, uint32_t parent) const
+  {
+    uint32_t c = get_<uint32_t>(pos);
+    if (c >= parent) throw SerializationError(fname_, "bad object index");
+    return c;
+  }
+
+ private:
+  std::string fname_;
+  std::unique_ptr<MappedFile> file_;
+  const char * data_;
+  size_t size_;
+  uint32_t nobjects_;
+  size_t offsets_;
+  std::vector<std::pair<std::string,uint32_t>> roots_;
+  std::vector<std::shared_ptr<NEMLObject>> objects_;
+};
+
+} // namespace
+
+void write_binary(std::string fname,
+                  const std::map<std::string,std::shared_ptr<NEMLObject>> &
+                  objects)
+{
+  Writer writer(fname);
+  for (auto & obj : objects) writer.add_root(obj.first, obj.second);
+  writer.write();
+}
+
+void xml_to_binary(std::string xml, std::string fname,
+                   std::vector<std::string> names)
+{
+  rapidxml::file <> xmlFile(xml.c_str());
+  rapidxml::xml_document<> doc;
+  doc.parse<0>(xmlFile.data());
+  const rapidxml::xml_node<> * root = doc.first_node("materials");
+
+  if (names.empty()) {
+    for (auto node = root->first_node(); node; node = node->next_sibling()) {
+      if (node->name() != XML_DEFINES) names.push_back(node->name());
+    }
+  }
+
+  // Shared definitions stay shared in the image
+  XMLDefinitions defs(root->first_node(XML_DEFINES.c_str()));
+  Writer writer(fname);
+  for (auto & name : names) {
+    const rapidxml::xml_node<> * node = root->first_node(name.c_str());
+    if (node == nullptr) throw NodeNotFound(name, 0);
+    writer.add_root(name, get_object(node, &defs));
+  }
+  writer.write();
+}
+
+std::shared_ptr<NEMLModel> parse_binary(std::string fname, std::string mname)
+{
+  return parse_binary_unique(fname, mname);
+}
+
+std::unique_ptr<NEMLModel> parse_binary_unique(std::string fname,
+                                               std::string mname)
+{
+  Reader reader(fname);
+  ParameterSet params = reader.parameters(reader.root(mname));
+  std::unique_ptr<NEMLObject> obj = Factory::Creator()->create_unique(params);
+  if (dynamic_cast<NEMLModel*>(obj.get()) == nullptr) {
+    throw InvalidType(mname, params.type(), "NEMLModel");
+  }
+  return std::unique_ptr<NEMLModel>(dynamic_cast<NEMLModel*>(obj.release()));
+}
+
+std::vector<std::string> binary_model_names(std::string fname)
+{
+  return Reader(fname).names();
+}
+
+std::string serialize_object(const std::shared_ptr<NEMLObject> & obj)
+{
+  Writer writer(MEMORY_IMAGE);
+  writer.add_root(MEMORY_ROOT, obj);
+  return writer.image();
+}
+
+std::shared_ptr<NEMLObject> deserialize_object(const std::string & image)
+{
+  Reader reader(MEMORY_IMAGE, image.data(), image.size());
+  return reader.object(reader.root(MEMORY_ROOT));
+}
+
+} // namespace neml
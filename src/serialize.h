@@ -0,0 +1,84 @@
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+
+#include "objects.h"
+#include "models.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <exception>
+
+namespace neml {
+
+// Binary model images
+//
+// A binary image stores the ParameterSets of a whole library of named
+// object graphs.  Loading one model maps the file into memory and creates
+// only the objects that model needs, with no text parsing.  Objects that
+// appear more than once in a graph are stored once and stay shared when
+// they are loaded.
+//
+// Layout (native byte order, checked when loading):
+//    header:   "NEMLBIN" + '\0', uint32 version, uint32 byte order mark,
+//              uint32 number of objects, uint32 number of named roots
+//    offsets:  uint64 file offset of each object record
+//    roots:    (uint32 length, name, uint32 object index) for each root
+//    records:  type string, uint32 number of parameters, then
+//              (name string, uint8 ParamType, value) for each parameter.
+//              Object parameters are indices of earlier records.
+
+/// Current version of the binary format
+const uint32_t BINARY_VERSION = 1;
+
+/// Write named objects, which must have been created by the Factory, to
+/// a binary image
+void write_binary(std::string fname,
+                  const std::map<std::string,std::shared_ptr<NEMLObject>> &
+                  objects);
+
+/// Convert models from an XML file to a binary image (all models if
+/// names is empty)
+void xml_to_binary(std::string xml, std::string fname,
+                   std::vector<std::string> names);
+
+/// Load a model from a binary image to a shared_ptr
+std::shared_ptr<NEMLModel> parse_binary(std::string fname, std::string mname);
+
+/// Load a model from a binary image to a unique_ptr
+std::unique_ptr<NEMLModel> parse_binary_unique(std::string fname,
+                                               std::string mname);
+
+/// The names of the models in a binary image
+std::vector<std::string> binary_model_names(std::string fname);
+
+/// A single object, which must have been created by the Factory, as a
+/// binary image in memory
+std::string serialize_object(const std::shared_ptr<NEMLObject> & obj);
+
+/// Create the object stored in memory by serialize_object
+std::shared_ptr<NEMLObject> deserialize_object(const std::string & image);
+
+/// Problem reading or writing a binary image
+class SerializationError: public std::exception {
+ public:
+  SerializationError(std::string fname, std::string problem) :
+      msg_("Binary image " + fname + ": " + problem)
+  {
+
+  };
+
+  const char * what() const throw ()
+  {
+    return msg_.c_str();
+  };
+
+ private:
+  std::string msg_;
+};
+
+} // namespace neml
+
+#endif // SERIALIZE_H
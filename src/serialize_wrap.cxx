@@ -0,0 +1,42 @@
+#include "pyhelp.h" // include first to avoid annoying redef warning
+
+#include "serialize.h"
+
+namespace py = pybind11;
+
+PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>)
+
+namespace neml {
+
+PYBIND11_MODULE(serialize, m) {
+  py::module::import("neml.objects");
+  py::module::import("neml.models");
+
+  m.doc() = "Binary model images for fast loading.";
+
+  m.def("write_binary", &write_binary, 
+        "Write a dictionary of named objects to a binary image.");
+  m.def("xml_to_binary", &xml_to_binary,
+        "Convert models from an XML file to a binary image.",
+        py::arg("xml"), py::arg("fname"), 
+        py::arg("names") = std::vector<std::string>());
+  m.def("parse_binary", &parse_binary, "Load a model from a binary image.");
+  m.def("binary_model_names", &binary_model_names, 
+        "The models in a binary image.");
+  m.def("dumps", 
+        [](std::shared_ptr<NEMLObject> obj) -> py::bytes
+        {
+          return py::bytes(serialize_object(obj));
+        }, "An object as a binary image in memory.");
+  m.def("loads",
+        [](py::bytes image) -> std::shared_ptr<NEMLObject>
+        {
+          return deserialize_object(image);
+        }, "Create an object from the result of dumps.");
+
+  m.attr("BINARY_VERSION") = BINARY_VERSION;
+
+  py::register_exception<SerializationError>(m, "SerializationError");
+}
+
+} // namespace neml
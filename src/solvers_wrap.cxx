@@ -45,7 +45,12 @@ PYBIND11_MODULE(solvers, m) {
         {
           auto x = alloc_vec<double>(system->nparams());
           
-          int ier = solve(system.get(), arr2ptr<double>(x), &ts, tol, miter, verbose);
+          auto x_ptr = x.mutable_data();
+          int ier;
+          {
+            py::gil_scoped_release release;
+            ier = solve(system.get(), x_ptr, &ts, tol, miter, verbose);
+          }
           py_error(ier);
 
           return x;
@@ -0,0 +1,151 @@
+#include "sparse.h"
+
+#include "nemlerror.h"
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+
+namespace neml {
+
+SkylineSolver::SkylineSolver(size_t n, const std::vector<size_t> & rows,
+                             const std::vector<size_t> & cols) :
+    perm_(n), iperm_(n), first_(n), start_(n + 1), work_(n)
+{
+  if (rows.size() != n + 1) {
+    throw std::invalid_argument("The sparsity needs n + 1 row pointers");
+  }
+
+  // Symmetric adjacency, without the diagonal
+  std::vector<std::vector<size_t>> adj(n);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t k = rows[i]; k < rows[i+1]; k++) {
+      size_t j = cols[k];
+      if (j >= n) {
+        throw std::invalid_argument("Column index out of range");
+      }
+      if (i == j) continue;
+      adj[i].push_back(j);
+      adj[j].push_back(i);
+    }
+  }
+  for (auto & a : adj) {
+    std::sort(a.begin(), a.end());
+    a.erase(std::unique(a.begin(), a.end()), a.end());
+  }
+
+  // Reverse Cuthill-McKee, starting each connected component from a node
+  // of minimum degree
+  std::vector<bool> seen(n, false);
+  std::vector<size_t> order;
+  order.reserve(n);
+  auto by_degree = [&](size_t a, size_t b)
+  {
+    return adj[a].size() < adj[b].size();
+  };
+  while (order.size() < n) {
+    size_t s = n;
+    for (size_t i = 0; i < n; i++) {
+      if (not seen[i] && (s == n || adj[i].size() < adj[s].size())) s = i;
+    }
+    std::deque<size_t> queue(1, s);
+    seen[s] = true;
+    while (not queue.empty()) {
+      size_t i = queue.front();
+      queue.pop_front();
+      order.push_back(i);
+      std::vector<size_t> next;
+      for (auto j : adj[i]) {
+        if (not seen[j]) {
+          seen[j] = true;
+          next.push_back(j);
+        }
+      }
+      std::stable_sort(next.begin(), next.end(), by_degree);
+      queue.insert(queue.end(), next.begin(), next.end());
+    }
+  }
+  for (size_t k = 0; k < n; k++) {
+    perm_[k] = order[n - 1 - k];
+    iperm_[perm_[k]] = k;
+  }
+
+  // Skyline profile
+  start_[0] = 0;
+  for (size_t j = 0; j < n; j++) {
+    first_[j] = j;
+    for (auto i : adj[perm_[j]]) first_[j] = std::min(first_[j], iperm_[i]);
+    start_[j+1] = start_[j] + (j - first_[j] + 1);
+  }
+  values_.resize(start_[n], 0.0);
+}
+
+void SkylineSolver::zero()
+{
+  std::fill(values_.begin(), values_.end(), 0.0);
+}
+
+void SkylineSolver::add(size_t i, size_t j, double v)
+{
+  values_[position(i, j)] += v;
+}
+
+size_t SkylineSolver::position(size_t i, size_t j) const
+{
+  size_t r = std::min(iperm_[i], iperm_[j]);
+  size_t c = std::max(iperm_[i], iperm_[j]);
+  if (r < first_[c]) {
+    throw std::invalid_argument("Entry outside of the sparsity pattern");
+  }
+  return start_[c] + (r - first_[c]);
+}
+
+int SkylineSolver::factor()
+{
+  // Column by column Crout factorization: the upper triangle is replaced
+  // by L^T and the diagonal by D
+  for (size_t j = 0; j < n(); j++) {
+    size_t mj = first_[j];
+    double * Kj = &values_[start_[j]];
+    for (size_t i = mj; i < j; i++) {
+      size_t mi = first_[i];
+      const double * Ki = &values_[start_[i]];
+      double s = 0.0;
+      for (size_t k = std::max(mi, mj); k < i; k++) {
+        s += Ki[k - mi] * Kj[k - mj];
+      }
+      Kj[i - mj] -= s;
+    }
+    double & Djj = Kj[j - mj];
+    for (size_t i = mj; i < j; i++) {
+      double g = Kj[i - mj];
+      Kj[i - mj] = g / values_[start_[i+1] - 1];
+      Djj -= g * Kj[i - mj];
+    }
+    if (Djj == 0.0) return LINALG_FAILURE;
+  }
+  return SUCCESS;
+}
+
+void SkylineSolver::solve(double * const b) const
+{
+  for (size_t k = 0; k < n(); k++) work_[k] = b[perm_[k]];
+
+  for (size_t j = 0; j < n(); j++) {
+    const double * Kj = &values_[start_[j]];
+    for (size_t i = first_[j]; i < j; i++) {
+      work_[j] -= Kj[i - first_[j]] * work_[i];
+    }
+  }
+  for (size_t j = 0; j < n(); j++) work_[j] /= values_[start_[j+1] - 1];
+  for (size_t j = n(); j-- > 0; ) {
+    const double * Kj = &values_[start_[j]];
+    for (size_t i = first_[j]; i < j; i++) {
+      work_[i] -= Kj[i - first_[j]] * work_[j];
+    }
+  }
+
+  for (size_t k = 0; k < n(); k++) b[perm_[k]] = work_[k];
+}
+
+} // namespace neml
@@ -0,0 +1,52 @@
+#ifndef SPARSE_H
+#define SPARSE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace neml {
+
+/// Sparse direct solver for symmetric systems with a fixed sparsity
+//  The rows are renumbered with the reverse Cuthill-McKee ordering and the
+//  matrix is stored as a skyline, column by column down to the first
+//  nonzero in the upper triangle.  The factorization is LDL^T without
+//  pivoting, so the matrix must be nonsingular in every leading block,
+//  which holds for the positive definite stiffness matrices of stable
+//  structures.
+class SkylineSolver {
+ public:
+  /// Setup from the sparsity of the matrix: the nonzero columns of
+  /// row i are cols[rows[i]] to cols[rows[i+1]-1], the diagonal is
+  /// always included
+  SkylineSolver(size_t n, const std::vector<size_t> & rows,
+                const std::vector<size_t> & cols);
+
+  /// Number of equations
+  size_t n() const {return perm_.size();};
+  /// Number of stored entries
+  size_t nstore() const {return values_.size();};
+
+  /// Zero the matrix
+  void zero();
+  /// Add v to entry (i,j), which is the same entry as (j,i)
+  void add(size_t i, size_t j, double v);
+  /// Position of entry (i,j) in the storage, for repeated assembly
+  size_t position(size_t i, size_t j) const;
+  /// Add v to the entry at a position from position()
+  void add_at(size_t k, double v) {values_[k] += v;};
+
+  /// Factor the assembled matrix in place
+  int factor();
+  /// Solve with the factored matrix, overwriting b with the solution
+  void solve(double * const b) const;
+
+ private:
+  std::vector<size_t> perm_, iperm_;
+  std::vector<size_t> first_, start_;
+  std::vector<double> values_;
+  mutable std::vector<double> work_;
+};
+
+} // namespace neml
+
+#endif // SPARSE_H
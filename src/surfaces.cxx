@@ -10,6 +10,18 @@
 
 namespace neml {
 
+int YieldSurface::f_vec(size_t n, const double * const s, 
+                        const double * const q, const double * const T, 
+                        double * const fv) const
+{
+  size_t nh = nhist();
+  for (size_t i = 0; i < n; i++) {
+    int ier = f(&s[i*6], &q[i*nh], T[i], fv[i]);
+    if (ier != 0) return ier;
+  }
+  return 0;
+}
+
 std::string IsoJ2::type()
 {
   return "IsoJ2";
@@ -50,6 +50,11 @@ class YieldSurface: public NEMLObject {
   /// Hessian dqds
   virtual int df_dqds(const double* const s, const double* const q, double T,
                 double * const ddf) const = 0;
+
+  /// Yield function at each of n points, stored one after the other in
+  /// s (6 each) and q (nhist each)
+  virtual int f_vec(size_t n, const double * const s, const double * const q,
+                    const double * const T, double * const fv) const;
 };
 
 /// Helper to reduce a isotropic + kinematic function to isotropic only
@@ -216,8 +221,6 @@ class IsoKinJ2: public YieldSurface {
  
 };
 
-static Register<IsoKinJ2> regIsoKinJ2;
-
 /// Just isotropic hardening with a von Mises surface
 //
 //  History variables are:
@@ -243,8 +246,6 @@ class IsoJ2: public IsoFunction<IsoKinJ2> {
   static ParameterSet parameters();
 };
 
-static Register<IsoJ2> regIsoJ2;
-
 /// Combined isotropic/kinematic hardening with some mean stress contribution
 //
 //  History variables are:
@@ -298,8 +299,6 @@ class IsoKinJ2I1: public YieldSurface {
  
 };
 
-static Register<IsoKinJ2I1> regIsoKinJ2I1;
-
 /// Isotropic only version of J2I1 surface
 class IsoJ2I1: public IsoFunction<IsoKinJ2I1, std::shared_ptr<Interpolate>,
     std::shared_ptr<Interpolate>> {
@@ -320,8 +319,6 @@ class IsoJ2I1: public IsoFunction<IsoKinJ2I1, std::shared_ptr<Interpolate>,
 
 };
 
-static Register<IsoJ2I1> regIsoJ2I1;
-
 } // namespace neml
 
 #endif // SURFACES_H
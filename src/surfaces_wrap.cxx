@@ -26,6 +26,26 @@ PYBIND11_MODULE(surfaces, m) {
 
             return fv;
            }, "Yield function")
+      .def("f_vec",
+           [](const YieldSurface & m, py::object s, py::object h, py::object T) -> py::array_t<double>
+           {
+            std::vector<size_t> shape;
+            auto args = broadcast_arrays({s, h, T}, {{6}, {m.nhist()}, {}},
+                                         {"s", "h", "T"}, shape);
+            auto fv = alloc_array<double>(shape);
+            auto args0_ptr = args[0].data();
+            auto args1_ptr = args[1].data();
+            auto args2_ptr = args[2].data();
+            auto fv_ptr = fv.mutable_data();
+            int ier;
+            {
+              py::gil_scoped_release release;
+              ier = m.f_vec(fv.size(), args0_ptr, args1_ptr, args2_ptr, fv_ptr);
+            }
+            py_error(ier);
+            return fv;
+           }, "Yield function for arrays of stresses (...,6), histories (...,nhist), and temperatures, broadcast against each other.",
+           py::arg("s"), py::arg("h"), py::arg("T"))
 
       .def("df_ds",
            [](const YieldSurface & m, py::array_t<double, py::array::c_style> s, py::array_t<double, py::array::c_style> h, double T) -> py::array_t<double>
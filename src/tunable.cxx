@@ -0,0 +1,149 @@
+#include "tunable.h"
+
+#include <stdexcept>
+
+namespace neml {
+
+namespace {
+
+std::string join(const std::string & path, const std::string & name)
+{
+  return path.empty() ? name : path + "." + name;
+}
+
+} // namespace
+
+TunableParameters::TunableParameters(std::shared_ptr<NEMLObject> object) :
+    object_(object)
+{
+  std::set<const NEMLObject*> visited;
+  add_(object_, "", visited);
+
+  for (size_t i = 0; i < names_.size(); i++) {
+    lookup_.insert(std::make_pair(names_[i], i));
+  }
+}
+
+size_t TunableParameters::size() const
+{
+  return names_.size();
+}
+
+const std::vector<std::string> & TunableParameters::names() const
+{
+  return names_;
+}
+
+std::vector<double> TunableParameters::values() const
+{
+  std::vector<double> res;
+  res.reserve(names_.size());
+  for (auto & e : entries_) {
+    std::vector<double> c = e.interpolate->constants();
+    res.insert(res.end(), c.begin(), c.end());
+  }
+  return res;
+}
+
+void TunableParameters::set_values(const std::vector<double> & values)
+{
+  if (values.size() != names_.size()) {
+    throw std::invalid_argument("Expected " + std::to_string(names_.size())
+                                + " values, got "
+                                + std::to_string(values.size()));
+  }
+
+  for (auto & e : entries_) {
+    e.interpolate->set_constants(std::vector<double>(
+            values.begin() + e.start, values.begin() + e.start + e.size));
+  }
+  changed_();
+}
+
+double TunableParameters::get(std::string name) const
+{
+  size_t i = index_(name);
+  const Entry & e = entries_[owner_[i]];
+  return e.interpolate->constants()[i - e.start];
+}
+
+void TunableParameters::set(std::string name, double value)
+{
+  size_t i = index_(name);
+  const Entry & e = entries_[owner_[i]];
+  std::vector<double> c = e.interpolate->constants();
+  c[i - e.start] = value;
+  e.interpolate->set_constants(c);
+  changed_();
+}
+
+void TunableParameters::add_(const std::shared_ptr<NEMLObject> & obj,
+                             const std::string & path,
+                             std::set<const NEMLObject*> & visited)
+{
+  if (obj == nullptr || not visited.insert(obj.get()).second) return;
+
+  // Changing these would quietly change the other models too, and their
+  // parameters_changed would never be called
+  if (obj->shared_between_models()) {
+    throw std::invalid_argument(
+        "The object " + path + " is shared with other models and can't be "
+        "changed in place");
+  }
+
+  if (auto interp = std::dynamic_pointer_cast<Interpolate>(obj)) {
+    std::vector<std::string> cnames = interp->constant_names();
+    if (not cnames.empty()) {
+      entries_.push_back({interp.get(), names_.size(), cnames.size()});
+      for (auto & c : cnames) {
+        // A single constant is just named for the interpolate
+        names_.push_back((cnames.size() == 1 && not path.empty()) ? path :
+                         join(path, c));
+        owner_.push_back(entries_.size() - 1);
+      }
+    }
+  }
+
+  std::shared_ptr<ParameterSet> params = obj->parameter_set();
+  if (params != nullptr) {
+    for (auto & name : params->param_names()) {
+      switch (params->get_object_type(name)) {
+        case TYPE_NEML_OBJECT:
+          add_(params->get_parameter<std::shared_ptr<NEMLObject>>(name),
+               join(path, name), visited);
+          break;
+        case TYPE_VEC_NEML_OBJECT:
+          {
+            auto v = params->get_parameter<
+                std::vector<std::shared_ptr<NEMLObject>>>(name);
+            for (size_t i = 0; i < v.size(); i++) {
+              add_(v[i], join(path, name) + "[" + std::to_string(i) + "]",
+                   visited);
+            }
+          }
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  objects_.push_back(obj.get());
+}
+
+size_t TunableParameters::index_(const std::string & name) const
+{
+  auto found = lookup_.find(name);
+  if (found == lookup_.end()) {
+    throw std::invalid_argument("No tunable parameter named " + name);
+  }
+  return found->second;
+}
+
+void TunableParameters::changed_()
+{
+  // objects_ has children before parents
+  for (auto obj : objects_) obj->parameters_changed();
+}
+
+} // namespace neml
@@ -0,0 +1,81 @@
+#ifndef TUNABLE_H
+#define TUNABLE_H
+
+#include "objects.h"
+#include "interpolate.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace neml {
+
+/// A flat, named vector of the constants in a model, which can be changed
+/// in place
+//  The constants are those of the Interpolate objects in the model, which
+//  covers every property given as a number or as a function of
+//  temperature.  Each is named by the path of parameter names leading to
+//  it from the model, for example "rule.flow.hardening.C[1]", with the
+//  name of the constant appended for interpolates with more than one
+//  (e.g. "elastic.m1.values[2]").  Objects shared by several parts of the
+//  model appear once.
+//
+//  Setting values changes the interpolates in place and keeps the
+//  parameters recorded by the Factory up to date.  Then every object in
+//  the model, children first, gets a call to parameters_changed to update
+//  anything it computed from the old values.  Anything holding on to the
+//  model sees the new values without rebuilding it.
+//
+//  Objects shared between separate models, by clone(share_constants =
+//  true) or an XMLLibrary sharing its definitions, can't be changed in
+//  place without also changing the other models, so a model that uses any
+//  of them is rejected.
+//
+//  The model is searched through the parameters recorded by the Factory,
+//  which covers models from XML and python.  Constants stored directly as
+//  doubles on an object, rather than through an Interpolate, can't be
+//  changed in place and are not included.
+class TunableParameters {
+ public:
+  TunableParameters(std::shared_ptr<NEMLObject> object);
+
+  /// The number of constants
+  size_t size() const;
+  /// The names of the constants
+  const std::vector<std::string> & names() const;
+  /// The current values of the constants
+  std::vector<double> values() const;
+  /// Set all the constants
+  void set_values(const std::vector<double> & values);
+
+  /// Get one constant
+  double get(std::string name) const;
+  /// Set one constant
+  void set(std::string name, double value);
+
+ private:
+  void add_(const std::shared_ptr<NEMLObject> & obj, const std::string & path,
+            std::set<const NEMLObject*> & visited);
+  size_t index_(const std::string & name) const;
+  void changed_();
+
+  /// An interpolate and the position of its constants in the flat vector
+  struct Entry {
+    Interpolate * interpolate;
+    size_t start, size;
+  };
+
+ private:
+  std::shared_ptr<NEMLObject> object_;
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, size_t> lookup_;
+  std::vector<Entry> entries_;
+  std::vector<size_t> owner_;
+  std::vector<NEMLObject*> objects_;
+};
+
+} // namespace neml
+
+#endif // TUNABLE_H
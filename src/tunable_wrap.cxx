@@ -0,0 +1,36 @@
+#include "pyhelp.h" // include first to avoid annoying redef warning
+
+#include "tunable.h"
+
+namespace py = pybind11;
+
+PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>)
+
+namespace neml {
+
+PYBIND11_MODULE(tunable, m) {
+  py::module::import("neml.objects");
+
+  m.doc() = "Change the constants of a model in place.";
+
+  py::class_<TunableParameters>(m, "TunableParameters")
+      .def(py::init<std::shared_ptr<NEMLObject>>(), py::arg("model"))
+      .def("__len__", &TunableParameters::size)
+      .def_property_readonly("names", &TunableParameters::names,
+                             "Names of the constants.")
+      .def_property("values",
+                    [](TunableParameters & t) -> py::array_t<double>
+                    {
+                      std::vector<double> v = t.values();
+                      auto arr = alloc_vec<double>(v.size());
+                      std::copy(v.begin(), v.end(), arr2ptr<double>(arr));
+                      return arr;
+                    },
+                    &TunableParameters::set_values,
+                    "Values of all the constants, as a flat array.")
+      .def("__getitem__", &TunableParameters::get)
+      .def("__setitem__", &TunableParameters::set)
+      ;
+}
+
+} // namespace neml
@@ -0,0 +1,390 @@
+#include "vessel.h"
+
+#include "nemlmath.h"
+#include "nemlerror.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace neml {
+
+namespace {
+
+// Integration points per block in the threaded material updates
+const size_t POINT_GRAIN = 8;
+
+// The linear shape functions and their derivatives in the natural
+// coordinate
+void shape(double xi, double * const N, double * const B)
+{
+  N[0] = (1.0 - xi) / 2.0;
+  N[1] = (1.0 + xi) / 2.0;
+  B[0] = -0.5;
+  B[1] = 0.5;
+}
+
+} // namespace
+
+AxisymmetricSection::AxisymmetricSection(
+    const std::vector<double> & mesh,
+    const std::vector<std::shared_ptr<NEMLModel>> & materials,
+    const std::vector<double> & points,
+    const std::vector<double> & weights,
+    bool constrained, unsigned nthreads) :
+      mesh_(mesh), materials_(materials), points_(points),
+      weights_(weights), constrained_(constrained), nthreads_(nthreads)
+{
+  if (mesh_.size() < 2) {
+    throw std::invalid_argument("The mesh needs at least two nodes");
+  }
+  if (materials_.size() != mesh_.size() - 1) {
+    throw std::invalid_argument(
+        "The mesh needs one material model per element");
+  }
+  if (points_.empty() || (points_.size() != weights_.size())) {
+    throw std::invalid_argument(
+        "The integration rule needs matching points and weights");
+  }
+  for (size_t e = 0; e < nelem(); e++) {
+    if (mesh_[e+1] <= mesh_[e]) {
+      throw std::invalid_argument("The node radii must be increasing");
+    }
+  }
+
+  offsets_.push_back(0);
+  for (auto & m : materials_) {
+    offsets_.push_back(offsets_.back() + m->nstore() * ngpts());
+  }
+
+  double N[2], B[2];
+  for (size_t e = 0; e < nelem(); e++) {
+    for (auto xi : points_) {
+      shape(xi, N, B);
+      radii_.push_back(N[0] * mesh_[e] + N[1] * mesh_[e+1]);
+    }
+  }
+}
+
+int AxisymmetricSection::init_store(double * const h) const
+{
+  for (size_t e = 0; e < nelem(); e++) {
+    size_t nh = materials_[e]->nstore();
+    for (size_t i = 0; i < ngpts(); i++) {
+      int ier = materials_[e]->init_store(&h[offsets_[e] + nh * i]);
+      if (ier != SUCCESS) return ier;
+    }
+  }
+  return SUCCESS;
+}
+
+int AxisymmetricSection::step(
+    double t_np1, double t_n,
+    const double * const T_np1, const double * const T_n,
+    double p_inner, double p_outer,
+    double * const x,
+    const double * const tstrain_n, const double * const mstrain_n,
+    const double * const stress_n, const double * const h_n,
+    double * const strain, double * const tstrain,
+    double * const mstrain, double * const estrain,
+    double * const stress, double * const h_np1,
+    double rtol, double atol, int ilimit) const
+{
+  size_t n = nnodes();
+  size_t npts = nelem() * ngpts();
+
+  std::vector<double> A(36 * npts);
+  std::vector<double> R(n + 1), dl(n - 1), d(n), du(n - 1), J12(n), J21(n);
+  std::vector<double> b(2 * n);
+  double J22;
+
+  if (constrained_) x[n] = 0.0;
+
+  int ier = update_points_(x, t_np1, t_n, T_np1, T_n, tstrain_n, mstrain_n,
+                           stress_n, h_n, strain, tstrain, mstrain, stress,
+                           h_np1, &A[0]);
+  if (ier != SUCCESS) return ier;
+  double nR = residual_(stress, &A[0], p_inner, p_outer, &R[0], &dl[0],
+                        &d[0], &du[0], &J12[0], &J21[0], J22);
+  double nR0 = nR;
+
+  int i = 0;
+  while ((nR > atol) && (nR / nR0 > rtol) && (i < ilimit)) {
+    if (constrained_) {
+      std::copy(R.begin(), R.begin() + n, b.begin());
+      ier = solve_tridiagonal(&dl[0], &d[0], &du[0], n, &b[0]);
+      if (ier != SUCCESS) return ier;
+      for (size_t j = 0; j < n; j++) x[j] -= b[j];
+    }
+    else {
+      // Condense out the axial strain: with a = B^-1 R1 and c = B^-1 J12
+      // the rank one update of B gives the displacement increment directly
+      if (J22 == 0.0) return LINALG_FAILURE;
+      std::copy(R.begin(), R.begin() + n, b.begin());
+      std::copy(J12.begin(), J12.end(), b.begin() + n);
+      ier = solve_tridiagonal(&dl[0], &d[0], &du[0], n, &b[0], 2);
+      if (ier != SUCCESS) return ier;
+      const double * a = &b[0];
+      const double * c = &b[n];
+      double vx = 0.0;
+      double vy = 0.0;
+      for (size_t j = 0; j < n; j++) {
+        vx += J21[j] * (a[j] - R[n] / J22 * c[j]);
+        vy -= J21[j] * c[j] / J22;
+      }
+      double f = vx / (1.0 + vy);
+      double x2 = R[n];
+      for (size_t j = 0; j < n; j++) {
+        double x1 = a[j] - R[n] / J22 * c[j] + f * c[j] / J22;
+        x[j] -= x1;
+        x2 -= J21[j] * x1;
+      }
+      x[n] -= x2 / J22;
+    }
+
+    ier = update_points_(x, t_np1, t_n, T_np1, T_n, tstrain_n, mstrain_n,
+                         stress_n, h_n, strain, tstrain, mstrain, stress,
+                         h_np1, &A[0]);
+    if (ier != SUCCESS) return ier;
+    nR = residual_(stress, &A[0], p_inner, p_outer, &R[0], &dl[0], &d[0],
+                   &du[0], &J12[0], &J21[0], J22);
+    i++;
+  }
+
+  if ((nR > atol) && (nR / nR0 > rtol)) return MAX_ITERATIONS;
+
+  std::vector<int> ierp(npts, SUCCESS);
+  parallel_for(npts, nthreads_, [&](size_t k)
+  {
+    size_t e = k / ngpts();
+    size_t j = k % ngpts();
+    const double * h = &h_np1[offsets_[e] + materials_[e]->nstore() * j];
+    double N[2], B[2];
+    shape(points_[j], N, B);
+    double T = N[0] * T_np1[e] + N[1] * T_np1[e+1];
+    ierp[k] = materials_[e]->elastic_strains(&stress[6*k], T, h,
+                                             &estrain[6*k]);
+  }, POINT_GRAIN);
+
+  return first_error(ierp);
+}
+
+int AxisymmetricSection::update_points_(
+    const double * const x, double t_np1, double t_n,
+    const double * const T_np1, const double * const T_n,
+    const double * const tstrain_n, const double * const mstrain_n,
+    const double * const stress_n, const double * const h_n,
+    double * const strain, double * const tstrain,
+    double * const mstrain, double * const stress,
+    double * const h_np1, double * const A) const
+{
+  size_t npts = nelem() * ngpts();
+  double ez = x[nnodes()];
+  std::vector<int> ier(npts, SUCCESS);
+
+  parallel_for(npts, nthreads_, [&](size_t k)
+  {
+    size_t e = k / ngpts();
+    size_t j = k % ngpts();
+    auto & mat = materials_[e];
+    size_t off = offsets_[e] + mat->nstore() * j;
+    double l = mesh_[e+1] - mesh_[e];
+    double r = radii_[k];
+
+    double N[2], B[2];
+    shape(points_[j], N, B);
+    double T = N[0] * T_np1[e] + N[1] * T_np1[e+1];
+    double Tn = N[0] * T_n[e] + N[1] * T_n[e+1];
+    double dth = mat->alpha(T) * (T - Tn);
+
+    double * ek = &strain[6*k];
+    std::fill(ek, ek + 6, 0.0);
+    ek[0] = (B[0] * x[e] + B[1] * x[e+1]) * 2.0 / l;
+    ek[1] = (N[0] * x[e] + N[1] * x[e+1]) / r;
+    ek[2] = ez;
+
+    for (size_t m = 0; m < 6; m++) {
+      tstrain[6*k+m] = tstrain_n[6*k+m] + ((m < 3) ? dth : 0.0);
+      mstrain[6*k+m] = ek[m] - tstrain[6*k+m];
+    }
+
+    std::fill(&stress[6*k], &stress[6*(k+1)], 0.0);
+    std::fill(&h_np1[off], &h_np1[off + mat->nstore()], 0.0);
+    std::fill(&A[36*k], &A[36*(k+1)], 0.0);
+    double u, p;
+    ier[k] = mat->update_sd(&mstrain[6*k], &mstrain_n[6*k], T, Tn, t_np1,
+                            t_n, &stress[6*k], &stress_n[6*k], &h_np1[off],
+                            &h_n[off], &A[36*k], u, 0.0, p, 0.0);
+  }, POINT_GRAIN);
+
+  return first_error(ier);
+}
+
+double AxisymmetricSection::residual_(
+    const double * const stress, const double * const A,
+    double p_inner, double p_outer, double * const R,
+    double * const dl, double * const d, double * const du,
+    double * const J12, double * const J21, double & J22) const
+{
+  size_t n = nnodes();
+  double ri = mesh_.front();
+  double ro = mesh_.back();
+  double t = ro - ri;
+
+  std::fill(R, R + n + 1, 0.0);
+  std::fill(dl, dl + n - 1, 0.0);
+  std::fill(d, d + n, 0.0);
+  std::fill(du, du + n - 1, 0.0);
+  std::fill(J12, J12 + n, 0.0);
+  std::fill(J21, J21 + n, 0.0);
+  J22 = 0.0;
+
+  // The axial load is the end cap force from the thick walled vessel
+  // formula
+  R[0] -= p_inner;
+  R[n-1] += p_outer;
+  R[n] -= (p_inner * ri * ri - p_outer * ro * ro) / (ro * ro - ri * ri);
+
+  double N[2], B[2], DE[2][2], J11[2][2];
+  for (size_t e = 0; e < nelem(); e++) {
+    double l = mesh_[e+1] - mesh_[e];
+    for (size_t j = 0; j < ngpts(); j++) {
+      size_t k = e * ngpts() + j;
+      const double * s = &stress[6*k];
+      const double * D = &A[36*k];
+      double r = radii_[k];
+      double f = weights_[j] * l / 2.0;
+      shape(points_[j], N, B);
+
+      for (size_t a = 0; a < 2; a++) {
+        DE[0][a] = B[a] * 2.0 / l;
+        DE[1][a] = N[a] / r;
+      }
+
+      for (size_t a = 0; a < 2; a++) {
+        R[e+a] += (s[0] * DE[0][a] + (s[1] - s[0]) * DE[1][a]) * f;
+        for (size_t c = 0; c < 2; c++) {
+          J11[a][c] = 0.0;
+          for (size_t m = 0; m < 2; m++) {
+            J11[a][c] += (DE[0][a] * D[CINDEX(0,m,6)] + DE[1][a] *
+                          (D[CINDEX(1,m,6)] - D[CINDEX(0,m,6)])) * DE[m][c];
+          }
+          J11[a][c] *= f;
+        }
+        J12[e+a] += (D[CINDEX(0,2,6)] * DE[0][a] + (D[CINDEX(1,2,6)] -
+                     D[CINDEX(0,2,6)]) * DE[1][a]) * f;
+        J21[e+a] += (D[CINDEX(2,0,6)] * DE[0][a] + D[CINDEX(2,1,6)] *
+                     DE[1][a]) / t * f;
+      }
+      R[n] += s[2] / t * f;
+      J22 += D[CINDEX(2,2,6)] / t * f;
+
+      du[e] += J11[0][1];
+      d[e] += J11[0][0];
+      d[e+1] += J11[1][1];
+      dl[e] += J11[1][0];
+    }
+  }
+
+  size_t nr = constrained_ ? n : n + 1;
+  return norm2_vec(R, nr);
+}
+
+BreeSection::BreeSection(
+    const std::vector<std::shared_ptr<NEMLModel>> & materials,
+    const std::vector<double> & areas, unsigned nthreads) :
+      areas_(areas), nthreads_(nthreads)
+{
+  if (materials.size() != areas.size()) {
+    throw std::invalid_argument("Each bar needs a material model and an area");
+  }
+  if (materials.empty()) {
+    throw std::invalid_argument("The problem needs at least one bar");
+  }
+
+  offsets_.push_back(0);
+  for (auto & m : materials) {
+    bars_.push_back(std::make_shared<UniaxialModel>(m, 1.0e-6, 1.0e-10, 20));
+    offsets_.push_back(offsets_.back() + bars_.back()->nstore());
+  }
+}
+
+int BreeSection::init_store(double * const h) const
+{
+  for (size_t i = 0; i < nbars(); i++) {
+    int ier = bars_[i]->init_store(&h[offsets_[i]]);
+    if (ier != SUCCESS) return ier;
+  }
+  return SUCCESS;
+}
+
+int BreeSection::step(
+    double t_np1, double t_n,
+    const double * const T_np1, const double * const T_n,
+    double force, double & e,
+    const double * const tstrain_n, const double * const mstrain_n,
+    const double * const stress_n, const double * const h_n,
+    const double * const u_n, const double * const p_n,
+    double * const tstrain, double * const mstrain,
+    double * const estrain, double * const stress,
+    double * const h_np1, double * const u_np1,
+    double * const p_np1,
+    double rtol, double atol, int miter) const
+{
+  size_t n = nbars();
+  std::vector<double> A(n);
+  std::vector<int> ier(n, SUCCESS);
+
+  for (size_t i = 0; i < n; i++) {
+    tstrain[i] = tstrain_n[i] +
+        bars_[i]->thermal_strain_increment(T_np1[i], T_n[i]);
+  }
+
+  auto RJ = [&](double & R, double & J) -> int
+  {
+    parallel_for(n, nthreads_, [&](size_t i)
+    {
+      mstrain[i] = e - tstrain[i];
+      std::fill(&h_np1[offsets_[i]], &h_np1[offsets_[i+1]], 0.0);
+      ier[i] = bars_[i]->update(mstrain[i], mstrain_n[i], T_np1[i], T_n[i],
+                                t_np1, t_n, stress[i], stress_n[i],
+                                &h_np1[offsets_[i]], &h_n[offsets_[i]],
+                                A[i], u_np1[i], u_n[i], p_np1[i], p_n[i]);
+    }, POINT_GRAIN);
+    R = -force;
+    J = 0.0;
+    for (size_t i = 0; i < n; i++) {
+      R += areas_[i] * stress[i];
+      J += areas_[i] * A[i];
+    }
+    return first_error(ier);
+  };
+
+  double R, J;
+  int ierr = RJ(R, J);
+  if (ierr != SUCCESS) return ierr;
+  double nR = fabs(R);
+  double nR0 = nR;
+
+  int i = 0;
+  while ((nR > rtol * nR0) && (nR > atol)) {
+    if (J == 0.0) return LINALG_FAILURE;
+    e -= R / J;
+    ierr = RJ(R, J);
+    if (ierr != SUCCESS) return ierr;
+    nR = fabs(R);
+    i++;
+    if (i > miter) return MAX_ITERATIONS;
+  }
+
+  for (size_t k = 0; k < n; k++) {
+    ierr = bars_[k]->elastic_strains(stress[k], T_np1[k],
+                                     &h_np1[offsets_[k]], estrain[k]);
+    if (ierr != SUCCESS) return ierr;
+  }
+
+  return SUCCESS;
+}
+
+} // namespace neml
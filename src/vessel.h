@@ -0,0 +1,141 @@
+#ifndef VESSEL_H
+#define VESSEL_H
+
+#include "models.h"
+
+#include <memory>
+#include <vector>
+
+namespace neml {
+
+/// One dimensional model of a section through a cylindrical vessel, under
+/// axisymmetry and generalized plane strain
+//  The native kernel behind neml.axisym.AxisymmetricProblem.  The unknowns
+//  are the radial displacements of the nodes followed by the axial strain.
+//  The object carries no state: each step takes the previous state and
+//  returns the next.  The material updates are run over all the
+//  integration points at once, on up to nthreads threads, and the
+//  displacements are found with a tridiagonal solve, corrected for the
+//  axial strain with the Sherman-Morrison formula.
+class AxisymmetricSection {
+ public:
+  /// Parameters are the node radii, one material model per element, the
+  /// integration points and weights on [-1,1], whether to constrain the
+  /// axial strain to zero, and the number of threads (0 for all)
+  AxisymmetricSection(const std::vector<double> & mesh,
+                      const std::vector<std::shared_ptr<NEMLModel>> & materials,
+                      const std::vector<double> & points,
+                      const std::vector<double> & weights,
+                      bool constrained = false, unsigned nthreads = 1);
+
+  /// Number of nodes
+  size_t nnodes() const {return mesh_.size();};
+  /// Number of elements
+  size_t nelem() const {return materials_.size();};
+  /// Number of integration points per element
+  size_t ngpts() const {return points_.size();};
+  /// Number of unknowns, the displacements plus the axial strain
+  size_t ndof() const {return nnodes() + 1;};
+  /// Total length of the stored variables of all the integration points
+  size_t nstore() const {return offsets_.back();};
+  /// Start of the stored variables of each element, plus the total
+  const std::vector<size_t> & offsets() const {return offsets_;};
+  /// Radius of each integration point
+  const std::vector<double> & radii() const {return radii_;};
+
+  /// Initialize the stored variables of all the integration points
+  int init_store(double * const h) const;
+
+  /// Update from the state at t_n to t_np1, given the nodal temperatures
+  /// and the pressures on the inner and outer surfaces.  x holds the
+  /// guess for the unknowns coming in and the solution going out.  The
+  /// strain-like and stress arrays have six entries per integration point.
+  int step(double t_np1, double t_n,
+           const double * const T_np1, const double * const T_n,
+           double p_inner, double p_outer,
+           double * const x,
+           const double * const tstrain_n, const double * const mstrain_n,
+           const double * const stress_n, const double * const h_n,
+           double * const strain, double * const tstrain,
+           double * const mstrain, double * const estrain,
+           double * const stress, double * const h_np1,
+           double rtol = 1.0e-6, double atol = 1.0e-8,
+           int ilimit = 10) const;
+
+ private:
+  int update_points_(const double * const x, double t_np1, double t_n,
+                     const double * const T_np1, const double * const T_n,
+                     const double * const tstrain_n,
+                     const double * const mstrain_n,
+                     const double * const stress_n, const double * const h_n,
+                     double * const strain, double * const tstrain,
+                     double * const mstrain, double * const stress,
+                     double * const h_np1, double * const A) const;
+  double residual_(const double * const stress, const double * const A,
+                   double p_inner, double p_outer, double * const R,
+                   double * const dl, double * const d, double * const du,
+                   double * const J12, double * const J21,
+                   double & J22) const;
+
+ private:
+  std::vector<double> mesh_;
+  std::vector<std::shared_ptr<NEMLModel>> materials_;
+  std::vector<double> points_, weights_;
+  bool constrained_;
+  unsigned nthreads_;
+
+  std::vector<size_t> offsets_;
+  std::vector<double> radii_;
+};
+
+/// The Bree problem: parallel bars sharing an axial strain, each
+/// representing a point through the wall of a vessel
+//  The native kernel behind neml.axisym.BreeProblem.  Each bar is a
+//  uniaxial condensation of its material model, with unit length and an
+//  area equal to its integration weight.  The bar updates are run on up
+//  to nthreads threads.
+class BreeSection {
+ public:
+  /// Parameters are one material per bar, the bar areas, and the number
+  /// of threads (0 for all)
+  BreeSection(const std::vector<std::shared_ptr<NEMLModel>> & materials,
+              const std::vector<double> & areas, unsigned nthreads = 1);
+
+  /// Number of bars
+  size_t nbars() const {return bars_.size();};
+  /// Total length of the stored variables of all the bars
+  size_t nstore() const {return offsets_.back();};
+  /// Start of the stored variables of each bar, plus the total
+  const std::vector<size_t> & offsets() const {return offsets_;};
+
+  /// Initialize the stored variables of all the bars
+  int init_store(double * const h) const;
+
+  /// Update from the state at t_n to t_np1, given the bar temperatures and
+  /// the total axial force.  e holds the guess for the axial strain
+  /// coming in and the solution going out.  The other arrays have one
+  /// entry per bar, except for the stored variables.
+  int step(double t_np1, double t_n,
+           const double * const T_np1, const double * const T_n,
+           double force, double & e,
+           const double * const tstrain_n, const double * const mstrain_n,
+           const double * const stress_n, const double * const h_n,
+           const double * const u_n, const double * const p_n,
+           double * const tstrain, double * const mstrain,
+           double * const estrain, double * const stress,
+           double * const h_np1, double * const u_np1,
+           double * const p_np1,
+           double rtol = 1.0e-6, double atol = 1.0e-8,
+           int miter = 50) const;
+
+ private:
+  std::vector<std::shared_ptr<UniaxialModel>> bars_;
+  std::vector<double> areas_;
+  unsigned nthreads_;
+
+  std::vector<size_t> offsets_;
+};
+
+} // namespace neml
+
+#endif // VESSEL_H
@@ -0,0 +1,201 @@
+#include "pyhelp.h" // include first to avoid annoying redef warning
+
+#include "vessel.h"
+
+namespace py = pybind11;
+
+PYBIND11_DECLARE_HOLDER_TYPE(T, std::shared_ptr<T>)
+
+namespace neml {
+
+namespace {
+
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> InArray;
+
+} // namespace
+
+PYBIND11_MODULE(vessel, m) {
+  py::module::import("neml.objects");
+  py::module::import("neml.models");
+
+  m.doc() = "Native kernels for the vessel section problems in neml.axisym.";
+
+  py::class_<AxisymmetricSection, std::shared_ptr<AxisymmetricSection>>(m,
+      "AxisymmetricSection")
+      .def(py::init<const std::vector<double> &,
+           const std::vector<std::shared_ptr<NEMLModel>> &,
+           const std::vector<double> &, const std::vector<double> &, bool,
+           unsigned>(), py::arg("mesh"), py::arg("materials"),
+           py::arg("points"), py::arg("weights"),
+           py::arg("constrained") = false, py::arg("nthreads") = 1)
+      .def_property_readonly("nnodes", &AxisymmetricSection::nnodes,
+                             "Number of nodes.")
+      .def_property_readonly("nelem", &AxisymmetricSection::nelem,
+                             "Number of elements.")
+      .def_property_readonly("ngpts", &AxisymmetricSection::ngpts,
+                             "Number of integration points per element.")
+      .def_property_readonly("nstore", &AxisymmetricSection::nstore,
+                             "Length of all the stored variables.")
+      .def_property_readonly("offsets",
+           [](const AxisymmetricSection & s) -> std::vector<size_t>
+           {
+            return s.offsets();
+           }, "Start of the stored variables of each element.")
+      .def_property_readonly("radii",
+           [](const AxisymmetricSection & s) -> py::array_t<double>
+           {
+            return py::array_t<double>(s.radii().size(), s.radii().data());
+           }, "Radius of each integration point.")
+      .def("init_store",
+           [](const AxisymmetricSection & s) -> py::array_t<double>
+           {
+            auto h = alloc_vec<double>(s.nstore());
+            py_error(s.init_store(arr2ptr<double>(h)));
+            return h;
+           }, "Initial stored variables of all the integration points.")
+      .def("step",
+           [](const AxisymmetricSection & s, double t_np1, double t_n,
+              InArray T_np1, InArray T_n, double p_inner, double p_outer,
+              InArray x0, InArray tstrain_n, InArray mstrain_n,
+              InArray stress_n, InArray h_n, double rtol, double atol,
+              int ilimit) -> py::tuple
+           {
+            size_t ne = s.nelem();
+            size_t ng = s.ngpts();
+            check_shape<double>(T_np1, {s.nnodes()}, "T_np1");
+            check_shape<double>(T_n, {s.nnodes()}, "T_n");
+            check_shape<double>(x0, {s.ndof()}, "x0");
+            check_shape<double>(tstrain_n, {ne, ng, 6}, "tstrain_n");
+            check_shape<double>(mstrain_n, {ne, ng, 6}, "mstrain_n");
+            check_shape<double>(stress_n, {ne, ng, 6}, "stress_n");
+            check_shape<double>(h_n, {s.nstore()}, "h_n");
+
+            auto x = alloc_vec<double>(s.ndof());
+            std::copy(x0.data(), x0.data() + s.ndof(), x.mutable_data());
+            auto strain = alloc_array<double>({ne, ng, 6});
+            auto tstrain = alloc_array<double>({ne, ng, 6});
+            auto mstrain = alloc_array<double>({ne, ng, 6});
+            auto estrain = alloc_array<double>({ne, ng, 6});
+            auto stress = alloc_array<double>({ne, ng, 6});
+            auto h = alloc_vec<double>(s.nstore());
+
+            auto T_np1_ptr = T_np1.data();
+            auto T_n_ptr = T_n.data();
+            auto x_ptr = x.mutable_data();
+            auto tstrain_n_ptr = tstrain_n.data();
+            auto mstrain_n_ptr = mstrain_n.data();
+            auto stress_n_ptr = stress_n.data();
+            auto h_n_ptr = h_n.data();
+            auto strain_ptr = strain.mutable_data();
+            auto tstrain_ptr = tstrain.mutable_data();
+            auto mstrain_ptr = mstrain.mutable_data();
+            auto estrain_ptr = estrain.mutable_data();
+            auto stress_ptr = stress.mutable_data();
+            auto h_ptr = h.mutable_data();
+            int ier;
+            {
+              py::gil_scoped_release release;
+              ier = s.step(t_np1, t_n, T_np1_ptr, T_n_ptr, p_inner, p_outer,
+                           x_ptr, tstrain_n_ptr, mstrain_n_ptr, stress_n_ptr,
+                           h_n_ptr, strain_ptr, tstrain_ptr, mstrain_ptr,
+                           estrain_ptr, stress_ptr, h_ptr, rtol, atol, ilimit);
+            }
+            py_error(ier);
+
+            return py::make_tuple(x, strain, tstrain, mstrain, estrain,
+                                  stress, h);
+           }, "Update to the next time, returning the unknowns, strains, "
+           "thermal strains, mechanical strains, elastic strains, stresses, "
+           "and stored variables.",
+           py::arg("t_np1"), py::arg("t_n"), py::arg("T_np1"), py::arg("T_n"),
+           py::arg("p_inner"), py::arg("p_outer"), py::arg("x0"),
+           py::arg("tstrain_n"), py::arg("mstrain_n"), py::arg("stress_n"),
+           py::arg("h_n"), py::arg("rtol") = 1.0e-6, py::arg("atol") = 1.0e-8,
+           py::arg("ilimit") = 10)
+      ;
+
+  py::class_<BreeSection, std::shared_ptr<BreeSection>>(m, "BreeSection")
+      .def(py::init<const std::vector<std::shared_ptr<NEMLModel>> &,
+           const std::vector<double> &, unsigned>(), py::arg("materials"),
+           py::arg("areas"), py::arg("nthreads") = 1)
+      .def_property_readonly("nbars", &BreeSection::nbars, "Number of bars.")
+      .def_property_readonly("nstore", &BreeSection::nstore,
+                             "Length of all the stored variables.")
+      .def_property_readonly("offsets",
+           [](const BreeSection & s) -> std::vector<size_t>
+           {
+            return s.offsets();
+           }, "Start of the stored variables of each bar.")
+      .def("init_store",
+           [](const BreeSection & s) -> py::array_t<double>
+           {
+            auto h = alloc_vec<double>(s.nstore());
+            py_error(s.init_store(arr2ptr<double>(h)));
+            return h;
+           }, "Initial stored variables of all the bars.")
+      .def("step",
+           [](const BreeSection & s, double t_np1, double t_n,
+              InArray T_np1, InArray T_n, double force, double e0,
+              InArray tstrain_n, InArray mstrain_n, InArray stress_n,
+              InArray h_n, InArray u_n, InArray p_n, double rtol,
+              double atol, int miter) -> py::tuple
+           {
+            size_t n = s.nbars();
+            check_shape<double>(T_np1, {n}, "T_np1");
+            check_shape<double>(T_n, {n}, "T_n");
+            check_shape<double>(tstrain_n, {n}, "tstrain_n");
+            check_shape<double>(mstrain_n, {n}, "mstrain_n");
+            check_shape<double>(stress_n, {n}, "stress_n");
+            check_shape<double>(h_n, {s.nstore()}, "h_n");
+            check_shape<double>(u_n, {n}, "u_n");
+            check_shape<double>(p_n, {n}, "p_n");
+
+            double e = e0;
+            auto tstrain = alloc_vec<double>(n);
+            auto mstrain = alloc_vec<double>(n);
+            auto estrain = alloc_vec<double>(n);
+            auto stress = alloc_vec<double>(n);
+            auto h = alloc_vec<double>(s.nstore());
+            auto u = alloc_vec<double>(n);
+            auto p = alloc_vec<double>(n);
+
+            auto T_np1_ptr = T_np1.data();
+            auto T_n_ptr = T_n.data();
+            auto tstrain_n_ptr = tstrain_n.data();
+            auto mstrain_n_ptr = mstrain_n.data();
+            auto stress_n_ptr = stress_n.data();
+            auto h_n_ptr = h_n.data();
+            auto u_n_ptr = u_n.data();
+            auto p_n_ptr = p_n.data();
+            auto tstrain_ptr = tstrain.mutable_data();
+            auto mstrain_ptr = mstrain.mutable_data();
+            auto estrain_ptr = estrain.mutable_data();
+            auto stress_ptr = stress.mutable_data();
+            auto h_ptr = h.mutable_data();
+            auto u_ptr = u.mutable_data();
+            auto p_ptr = p.mutable_data();
+            int ier;
+            {
+              py::gil_scoped_release release;
+              ier = s.step(t_np1, t_n, T_np1_ptr, T_n_ptr, force, e,
+                           tstrain_n_ptr, mstrain_n_ptr, stress_n_ptr, h_n_ptr,
+                           u_n_ptr, p_n_ptr, tstrain_ptr, mstrain_ptr,
+                           estrain_ptr, stress_ptr, h_ptr, u_ptr, p_ptr, rtol,
+                           atol, miter);
+            }
+            py_error(ier);
+
+            return py::make_tuple(e, tstrain, mstrain, estrain, stress, h, u,
+                                  p);
+           }, "Update to the next time, returning the axial strain and the "
+           "thermal strains, mechanical strains, elastic strains, stresses, "
+           "stored variables, energies, and dissipations of the bars.",
+           py::arg("t_np1"), py::arg("t_n"), py::arg("T_np1"), py::arg("T_n"),
+           py::arg("force"), py::arg("e0"), py::arg("tstrain_n"),
+           py::arg("mstrain_n"), py::arg("stress_n"), py::arg("h_n"),
+           py::arg("u_n"), py::arg("p_n"), py::arg("rtol") = 1.0e-6,
+           py::arg("atol") = 1.0e-8, py::arg("miter") = 50)
+      ;
+}
+
+} // namespace neml
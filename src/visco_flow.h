@@ -129,8 +129,6 @@ class GPowerLaw: public GFlow {
   const std::shared_ptr<const Interpolate> eta_;
 };
 
-static Register<GPowerLaw> regGPowerLaw;
-
 /// Perzyna associative viscoplasticity
 class PerzynaFlowRule : public ViscoPlasticFlowRule {
  public:
@@ -188,8 +186,6 @@ class PerzynaFlowRule : public ViscoPlasticFlowRule {
   std::shared_ptr<GFlow> g_;
 };
 
-static Register<PerzynaFlowRule> regPerzynaFlowRule;
-
 /// Various Chaboche type fluidity models.
 //
 //  These depend only on the equivalent plastic strain
@@ -223,8 +219,6 @@ class ConstantFluidity: public FluidityModel {
   const std::shared_ptr<const Interpolate> eta_;
 };
 
-static Register<ConstantFluidity> regConstantFluidity;
-
 /// Voce-like saturating fluidity
 class SaturatingFluidity: public FluidityModel {
  public:
@@ -250,8 +244,6 @@ class SaturatingFluidity: public FluidityModel {
   const std::shared_ptr<const Interpolate> K0_, A_, b_;
 };
 
-static Register<SaturatingFluidity> regSaturatingFluidity;
-
 /// Non-associative flow based on Chaboche's viscoplastic formulation
 //
 //  It uses an associative flow rule, a non-associative hardening rule 
@@ -337,8 +329,6 @@ class ChabocheFlowRule: public ViscoPlasticFlowRule {
   const bool recovery_;
 };
 
-static Register<ChabocheFlowRule> regChabocheFlowRule;
-
 /// Non-associative flow for Gr. 91 from Yaguchi & Takahashi (2000) + (2005)
 //
 //  A modified Chaboche rule with temperature interpolation even between
@@ -446,8 +436,6 @@ class YaguchiGr91FlowRule: public ViscoPlasticFlowRule {
   double log_tol_ = 1.0e-15;
 };
 
-static Register<YaguchiGr91FlowRule> regYaguchiGr91FlowRule;
-
 } // namespace neml
 
 #endif // VISCO_FLOW_H
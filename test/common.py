@@ -3,6 +3,8 @@ from __future__ import division
 import numpy as np
 import itertools
 
+from neml import models, elasticity, surfaces
+
 mandel = ((0,0),(1,1),(2,2),(1,2),(0,2),(0,1))
 mandel_mults = (1,1,1,np.sqrt(2),np.sqrt(2),np.sqrt(2))
 
@@ -244,3 +246,20 @@ def differentiate(fn, x0, eps = 1.5e-6):
 
 def make_dev(s):
   return s - np.array([1,1,1,0,0,0]) * np.sum(s[:3]) / 3.0
+
+def elastic_material(E = 200000.0, alpha = 0.0, nu = 0.3):
+  """
+    Small strain linear elastic material
+  """
+  elastic = elasticity.IsotropicLinearElasticModel(E, "youngs", nu,
+      "poissons")
+  return models.SmallStrainElasticity(elastic, alpha = alpha)
+
+def plastic_material(E = 200000.0, sY = 100.0, alpha = 0.0, nu = 0.3):
+  """
+    Small strain elastic-perfectly plastic material with a J2 surface
+  """
+  elastic = elasticity.IsotropicLinearElasticModel(E, "youngs", nu,
+      "poissons")
+  return models.SmallStrainPerfectPlasticity(elastic, surfaces.IsoJ2(), sY,
+      alpha = alpha)
@@ -0,0 +1,159 @@
+import sys
+sys.path.append('..')
+
+from neml import arbbar, barnetwork, uniaxial
+
+from common import elastic_material, plastic_material
+
+import unittest
+import numpy as np
+
+class TestThermalTriangle(unittest.TestCase):
+  """
+    Three bars with different expansion coefficients, from
+    examples/bar_verification.py
+  """
+  def setUp(self):
+    T1 = 0
+    T2 = 100.0
+    E1, E2, E3 = 100000.0, 150000.0, 200000.0
+    A1, A2, A3 = 1.5, 1.25, 1.0
+    l1, l2, l3 = 11.0, 5.0, 8.0
+    a1, a2, a3 = 1.0e-5, 1.7e-5, 1.9e-5
+
+    self.expected = (T2-T1)*E1*E2*A1*A2*(a1*l1 - a2*l2 - a3*l3) / (
+        A2*A3*l1*E2*E3 + A1*E1*(A2*l3*E2+A3*l2*E3))
+
+    T = lambda t: T1 + (T2-T1) * t
+
+    self.model = arbbar.BarModel()
+    self.model.add_node(1)
+    self.model.add_node(2)
+    self.model.add_node(3)
+    self.model.add_edge(1,3, object = arbbar.Bar(elastic_material(E1, a1),
+      A1, l1, T = T))
+    self.model.add_edge(1,2, object = arbbar.Bar(elastic_material(E2, a2),
+      A2, l2, T = T))
+    self.model.add_edge(2,3, object = arbbar.Bar(elastic_material(E3, a3),
+      A3, l3, T = T))
+    self.model.add_displacement_bc(3, lambda t: 0.0)
+
+  def test_solution(self):
+    self.model.solve(1.0)
+    self.assertTrue(np.isclose(self.model[2][3][0]['object'].mstrain[-1],
+      self.expected))
+
+  def test_history(self):
+    bar = self.model[2][3][0]['object']
+    self.assertEqual(len(bar.stress), 1)
+    for i in range(4):
+      self.model.solve(0.25)
+    self.assertEqual(len(bar.stress), 5)
+    self.assertEqual(bar.history.shape, (5, bar.mat.nstore))
+    self.assertTrue(np.allclose(bar.temperature, np.linspace(0, 100.0, 5)))
+    self.assertTrue(np.isclose(bar.mstrain[-1], self.expected))
+    self.assertTrue(np.allclose(self.model.time, np.linspace(0, 1, 5)))
+    self.assertEqual(len(self.model.nodes[2]['displacements']), 5)
+    self.assertEqual(self.model.gather_element('stress').shape, (3,5))
+
+class TestSeries(unittest.TestCase):
+  """
+    Bars in series under an end force
+  """
+  def setUp(self):
+    self.n = 10
+    self.F = 100.0
+    self.Es = np.linspace(100000.0, 200000.0, self.n)
+    self.As = np.linspace(1.0, 2.0, self.n)
+    self.ls = np.linspace(1.0, 3.0, self.n)
+
+  def build(self, **kwargs):
+    model = arbbar.BarModel(**kwargs)
+    for i in range(self.n):
+      model.add_edge(i, i+1, object = arbbar.Bar(
+        elastic_material(self.Es[i]), self.As[i], self.ls[i]))
+    model.add_displacement_bc(0, lambda t: 0.0)
+    model.add_force_bc(self.n, lambda t: self.F * t)
+    return model
+
+  def test_elastic(self):
+    model = self.build()
+    model.solve(1.0)
+    self.assertTrue(np.isclose(model.nodes[self.n]['displacements'][-1],
+      np.sum(self.F * self.ls / (self.Es * self.As))))
+    self.assertTrue(np.isclose(model.nodes[0]['forces'][-1], -self.F))
+    self.assertTrue(np.allclose(model.gather_element('stress')[:,-1],
+      self.F / self.As))
+
+  def test_energy(self):
+    model = self.build()
+    model.solve(1.0)
+    # Work done by the end force
+    work = self.F * model.nodes[self.n]['displacements'][-1] / 2.0
+    self.assertTrue(np.isclose(model.energy[-1], work))
+    self.assertTrue(np.isclose(model.dissipation[-1], 0.0))
+
+class TestNetwork(unittest.TestCase):
+  """
+    A plastic ladder with a thermal gradient and an imposed displacement
+  """
+  def setUp(self):
+    self.n = 50
+    self.mat = plastic_material(200000.0, 100.0, alpha = 1.0e-5)
+
+  def build(self, **kwargs):
+    model = arbbar.BarModel(**kwargs)
+    for i in range(self.n):
+      for a, b in ((i, i+1), (self.n+1+i, self.n+2+i), (i, self.n+2+i)):
+        model.add_edge(a, b, object = arbbar.Bar(self.mat, 1.0, 1.0,
+          T = lambda t, i = i: 2.0 * i * t))
+    model.add_displacement_bc(0, lambda t: 0.0)
+    model.add_displacement_bc(self.n+1, lambda t: 0.0)
+    model.add_displacement_bc(self.n, lambda t: 0.01 * t)
+    model.add_force_bc(2*self.n+1, lambda t: 10.0 * t)
+    return model
+
+  def run_model(self, **kwargs):
+    model = self.build(**kwargs)
+    for i in range(10):
+      model.solve(0.1)
+    return model
+
+  def test_equilibrium(self):
+    model = self.run_model()
+    free, fixed = model.free_fixed_nodes()
+    for k in free:
+      f = 10.0 if k == 2*self.n+1 else 0.0
+      self.assertTrue(np.isclose(model.nodes[k]['forces'][-1], f,
+        atol = 1.0e-6))
+    self.assertTrue(np.isclose(np.sum([model.nodes[k]['forces'][-1]
+      for k in fixed]), -10.0))
+    self.assertTrue(model.dissipation[-1] > 0.0)
+
+  def test_threads(self):
+    m1 = self.run_model()
+    m2 = self.run_model(nthreads = 2)
+    self.assertTrue(np.allclose(m1.gather_element('stress'),
+      m2.gather_element('stress'), rtol = 1.0e-12, atol = 1.0e-10))
+
+class TestErrors(unittest.TestCase):
+  def test_not_bar(self):
+    model = arbbar.BarModel()
+    model.add_edge(1, 2, object = 1.0)
+    with self.assertRaises(ValueError):
+      model.solve(1.0)
+
+  def test_singular(self):
+    model = arbbar.BarModel()
+    model.add_edge(1, 2, object = arbbar.Bar(elastic_material(100000.0),
+      1.0, 1.0))
+    model.add_force_bc(2, lambda t: 1.0)
+    with self.assertRaises(RuntimeError):
+      model.solve(1.0, ndiv = 1)
+
+  def test_kernel(self):
+    mat = uniaxial.UniaxialModel(elastic_material(100000.0))
+    with self.assertRaises(ValueError):
+      barnetwork.BarNetwork(2, [0, 2], [mat], [1.0], [1.0], [True, False])
+    with self.assertRaises(ValueError):
+      barnetwork.BarNetwork(2, [0, 1], [mat], [1.0], [-1.0], [True, False])
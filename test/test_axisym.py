@@ -0,0 +1,181 @@
+import sys
+sys.path.append('..')
+
+from neml import axisym, vessel
+
+from common import elastic_material, plastic_material
+
+import unittest
+import numpy as np
+
+class TestAxisymmetricElastic(unittest.TestCase):
+  """
+    Pressurized thick walled cylinder against the Lame solution
+  """
+  def setUp(self):
+    self.ri = 10.0
+    self.ro = 15.0
+    self.p = 50.0
+    self.nu = 0.3
+    self.mat = elastic_material(nu = self.nu)
+
+    self.A = self.p * self.ri**2.0 / (self.ro**2.0 - self.ri**2.0)
+    self.B = self.A * self.ro**2.0
+
+  def run_problem(self, constrained):
+    model = axisym.AxisymmetricProblem([self.ri, self.ro], [self.mat], [50],
+        lambda r, t: 0.0, lambda t: self.p * t, ngpts = 2,
+        constrained = constrained)
+    model.step(1.0)
+    return model
+
+  def check_inplane(self, model):
+    # Compare the element averages, the linear elements oscillate
+    # between the gauss points
+    r = np.mean(model.ri, axis = 1)
+    s = np.mean(model.stresses[-1], axis = 1)
+    self.assertTrue(np.allclose(s[:,0], self.A - self.B / r**2.0,
+      atol = 1.0e-2 * self.p))
+    self.assertTrue(np.allclose(s[:,1], self.A + self.B / r**2.0,
+      atol = 1.0e-2 * self.p))
+
+  def test_closed_end(self):
+    model = self.run_problem(False)
+    self.check_inplane(model)
+    self.assertTrue(np.allclose(np.mean(model.stresses[-1][:,:,2], axis = 1),
+      self.A, atol = 1.0e-2 * self.p))
+
+  def test_plane_strain(self):
+    model = self.run_problem(True)
+    self.check_inplane(model)
+    self.assertTrue(np.allclose(np.mean(model.stresses[-1][:,:,2], axis = 1),
+      2.0 * self.nu * self.A, atol = 1.0e-2 * self.p))
+    self.assertEqual(model.axialstrain[-1], 0.0)
+
+  def test_fields(self):
+    model = self.run_problem(False)
+    for f in ("strains", "tstrains", "mstrains", "estrains", "stresses"):
+      self.assertEqual(len(getattr(model, f)), 2)
+      self.assertEqual(getattr(model, f)[-1].shape, (50,2,6))
+    self.assertEqual(len(model.histories[-1]), 50)
+    self.assertEqual(model.displacements[-1].shape, (51,))
+    self.assertTrue(np.allclose(model.estrains[-1], model.mstrains[-1]))
+
+class TestAxisymmetricPlastic(unittest.TestCase):
+  """
+    Cyclic thermal gradient through a clad wall
+  """
+  def setUp(self):
+    self.rs = [10.0, 10.5, 15.0]
+    self.mats = [plastic_material(sY = 50.0, alpha = 1.5e-5),
+        plastic_material(alpha = 1.0e-5)]
+    self.ns = [2, 20]
+    self.T = axisym.generate_thickness_gradient(self.rs[0], self.rs[-1],
+        0.0, 200.0, 10.0, 10.0)
+    self.pressure = lambda t: 20.0
+    self.times = axisym.generate_standard_timesteps(0.0, 200.0, 10.0, 10.0,
+        10, 5, 2)
+
+  def run_problem(self, **kwargs):
+    model = axisym.AxisymmetricProblem(self.rs, self.mats, self.ns, self.T,
+        self.pressure, ngpts = 2, **kwargs)
+    for t in self.times[1:]:
+      model.step(t)
+    return model
+
+  def test_threads(self):
+    m1 = self.run_problem()
+    m2 = self.run_problem(nthreads = 2)
+    self.assertTrue(np.allclose(m1.stresses, m2.stresses, rtol = 1.0e-12,
+      atol = 1.0e-12))
+    self.assertTrue(np.allclose(m1.axialstrain, m2.axialstrain,
+      rtol = 1.0e-12, atol = 1.0e-16))
+
+  def test_plastic(self):
+    model = self.run_problem()
+    self.assertEqual(len(model.times), len(self.times))
+    self.assertTrue(np.allclose(model.times, self.times))
+    # The clad yields
+    ep = model.mstrains[-1] - model.estrains[-1]
+    self.assertTrue(np.max(np.abs(ep[:2])) > 1.0e-4)
+
+  def test_substep(self):
+    model = axisym.AxisymmetricProblem(self.rs, self.mats, self.ns, self.T,
+        self.pressure, ngpts = 2)
+    model.step(self.times[-1] / 4, ilimit = 3)
+    self.assertEqual(len(model.times), 2)
+    self.assertTrue(np.isclose(model.times[-1], self.times[-1] / 4))
+
+  def test_failure(self):
+    model = axisym.AxisymmetricProblem(self.rs, self.mats, self.ns, self.T,
+        lambda t: 1.0e4, ngpts = 2)
+    with self.assertRaises(RuntimeError):
+      model.step(1.0, max_div = 1)
+    self.assertEqual(len(model.times), 1)
+    self.assertEqual(len(model.histories), 1)
+
+class TestBree(unittest.TestCase):
+  """
+    Elastic Bree problem under a through wall temperature gradient
+  """
+  def setUp(self):
+    self.E = 200000.0
+    self.alpha = 1.0e-5
+    self.P = 50.0
+    self.mat = elastic_material(E = self.E, alpha = self.alpha)
+    self.T = lambda r, t: 100.0 * r * t
+
+  def test_elastic(self):
+    model = axisym.BreeProblem([1.0, 2.0], [self.mat], [10], self.T,
+        lambda t: self.P)
+    model.step(1.0)
+    T = np.array([self.T(x, 1.0) for x in model.ipoints])
+    Tbar = np.dot(model.weights, T) / np.sum(model.weights)
+    self.assertTrue(np.allclose(model.stresses[-1],
+      self.P + self.E * self.alpha * (Tbar - T)))
+    self.assertTrue(np.isclose(model.force[-1], self.P))
+    self.assertTrue(np.isclose(model.axialstrain[-1],
+      self.P / self.E + self.alpha * Tbar))
+
+  def test_rectangle(self):
+    model = axisym.BreeProblem([1.0, 2.0], [self.mat], [10], self.T,
+        lambda t: self.P, itype = "rectangle")
+    model.step(1.0)
+    self.assertTrue(np.isclose(np.dot(model.weights, model.stresses[-1]),
+      self.P))
+
+  def test_ratchet(self):
+    mat = plastic_material(alpha = self.alpha)
+    T = axisym.generate_thickness_gradient(1.0, 2.0, 0.0, 1500.0, 100.0,
+        0.0)
+    m1 = axisym.BreeProblem([1.0, 2.0], [mat], [10], T, lambda t: 60.0)
+    m2 = axisym.BreeProblem([1.0, 2.0], [mat], [10], T, lambda t: 60.0,
+        nthreads = 2)
+    times = axisym.generate_standard_timesteps(0.0, 1500.0, 100.0, 0.0, 10,
+        0, 4)
+    for t in times[1:]:
+      m1.step(t)
+      m2.step(t)
+    self.assertTrue(np.allclose(m1.stresses, m2.stresses))
+    # alpha E dT / sY = 3 and P / sY = 0.6 ratchets
+    e = np.array(m1.axialstrain)
+    self.assertTrue(e[-1] - e[-21] > 1.0e-4)
+    self.assertTrue(m1.work[-1] > 0.0)
+
+class TestErrors(unittest.TestCase):
+  def test_kernel(self):
+    mat = elastic_material()
+    with self.assertRaises(ValueError):
+      vessel.AxisymmetricSection([0.0, 1.0, 2.0], [mat], [0.0], [2.0])
+    with self.assertRaises(ValueError):
+      vessel.AxisymmetricSection([0.0, 1.0], [mat], [0.0], [1.0, 1.0])
+    with self.assertRaises(ValueError):
+      vessel.BreeSection([mat], [1.0, 2.0])
+
+  def test_shapes(self):
+    mat = elastic_material()
+    kernel = vessel.AxisymmetricSection([0.0, 1.0], [mat], [0.0], [2.0])
+    z = np.zeros((1,1,6))
+    with self.assertRaises(ValueError):
+      kernel.step(1.0, 0.0, np.zeros((3,)), np.zeros((2,)), 0.0, 0.0,
+          np.zeros((3,)), z, z, z, kernel.init_store())
@@ -0,0 +1,163 @@
+from neml import parse, cdrivers, ensemble, calibrate, tunable
+
+import unittest
+import numpy as np
+import scipy.optimize as opt
+
+class TestObjective(unittest.TestCase):
+  """
+    Residuals for synthetic data from the model itself
+  """
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", "test_j2iso")
+    self.names = ["flow.hardening.s0", "flow.hardening.K"]
+    self.p0 = np.array([100.0, 1000.0])
+    self.p = np.array([120.0, 800.0])
+
+    self.xs = np.linspace(0.001, 0.019, 10)
+    self.weights = [1.0, 4.0]
+    self.Ts = [300.0, 500.0]
+
+    self.objective = calibrate.CalibrationObjective(self.model, self.names,
+        nthreads = 2)
+    self.data = []
+    for T, w in zip(self.Ts, self.weights):
+      res = cdrivers.uniaxial_test(self.model, 1.0e-4, T = T, emax = 0.02,
+          nsteps = 20)
+      ys = np.interp(self.xs, res['strain'], res['stress'])
+      self.data.append(ys)
+      self.objective.add_dataset(ensemble.uniaxial_test(1.0e-4, T = T,
+        emax = 0.02, nsteps = 20), "strain", "stress", self.xs, ys,
+        weight = w)
+    res = cdrivers.strain_cyclic(self.model, 0.01, -1, 1.0e-4, 3, T = 500.0,
+        nsteps = 10)
+    self.data.append(res['max'])
+    self.objective.add_dataset(ensemble.strain_cyclic(0.01, -1, 1.0e-4, 3,
+      T = 500.0, nsteps = 10), None, "max", None, res['max'])
+
+  def simulate(self, p):
+    model = self.model.clone()
+    params = tunable.TunableParameters(model)
+    for n, v in zip(self.names, p):
+      params[n] = v
+    r = []
+    for T, w, ys in zip(self.Ts, self.weights, self.data):
+      res = cdrivers.uniaxial_test(model, 1.0e-4, T = T, emax = 0.02,
+          nsteps = 20)
+      r.append(np.sqrt(w) * (np.interp(self.xs, res['strain'],
+        res['stress']) - ys))
+    res = cdrivers.strain_cyclic(model, 0.01, -1, 1.0e-4, 3, T = 500.0,
+        nsteps = 10)
+    r.append(res['max'] - self.data[-1])
+    return np.concatenate(r)
+
+  def test_sizes(self):
+    self.assertEqual(self.objective.nparams, 2)
+    self.assertEqual(self.objective.ndatasets, 3)
+    self.assertEqual(self.objective.nresiduals, 23)
+    self.assertEqual(list(self.objective.offsets), [0, 10, 20, 23])
+
+  def test_exact(self):
+    self.assertTrue(np.allclose(self.objective.residuals(self.p0), 0.0))
+    self.assertTrue(np.isclose(self.objective(self.p0), 0.0))
+    self.assertEqual(list(self.objective.status), [0, 0, 0])
+
+  def test_residuals(self):
+    r = self.objective.residuals(self.p)
+    self.assertTrue(np.allclose(r, self.simulate(self.p)))
+    self.assertTrue(np.isclose(self.objective(self.p), np.sum(r**2.0)))
+    # The model itself is left alone
+    self.assertTrue(np.allclose([tunable.TunableParameters(self.model)[n]
+      for n in self.names], self.p0))
+
+  def test_jacobian(self):
+    h = 1.0e-6 * np.abs(self.p)
+    J = self.objective.jacobian(self.p)
+    self.assertEqual(J.shape, (23, 2))
+    r0 = self.simulate(self.p)
+    for j in range(2):
+      dp = np.copy(self.p)
+      dp[j] += h[j]
+      self.assertTrue(np.allclose(J[:,j], (self.simulate(dp) - r0) / h[j],
+        rtol = 1.0e-4, atol = 1.0e-6))
+    # Same answer with the residuals at p already computed
+    self.objective.residuals(self.p * 1.1)
+    self.objective.residuals(self.p)
+    self.assertTrue(np.allclose(self.objective.jacobian(self.p), J))
+
+  def test_fit(self):
+    sol = opt.least_squares(self.objective.residuals, self.p,
+        jac = self.objective.jacobian, x_scale = self.p0)
+    self.assertTrue(np.allclose(sol.x, self.p0, rtol = 1.0e-4))
+
+class TestFailures(unittest.TestCase):
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", "test_perfect")
+    self.objective = calibrate.CalibrationObjective(self.model, [],
+        penalty = 10.0)
+
+  def test_failed(self):
+    self.objective.add_dataset(ensemble.uniaxial_test(1.0e-4, T = 500.0,
+      emax = 0.01, nsteps = 10), "strain", "stress", [0.005], [0.0])
+    self.objective.add_dataset(ensemble.stress_cyclic(150.0, -1, 1.0, 2,
+      T = 500.0), None, "max", None, [0.0, 0.0], weight = 4.0)
+    self.objective.add_dataset(ensemble.uniaxial_test(1.0e-4, T = 500.0,
+      emax = 0.01, nsteps = 10), "strain", "stress", [0.02], [0.0])
+    r = self.objective.residuals(np.zeros((0,)))
+    self.assertEqual(list(self.objective.status), [0, -3, -13])
+    res = cdrivers.uniaxial_test(self.model, 1.0e-4, T = 500.0, emax = 0.01,
+        nsteps = 10)
+    self.assertTrue(np.isclose(r[0], np.interp(0.005, res['strain'],
+      res['stress'])))
+    self.assertTrue(np.allclose(r[1:3], 20.0))
+    self.assertTrue(np.isclose(r[3], 10.0))
+    self.assertTrue("range" in self.objective.messages[2])
+
+  def test_failed_jacobian(self):
+    # The stress cycle fails at the yield stress p but not after the step
+    objective = calibrate.CalibrationObjective(self.model, ["ys.values[2]"],
+        penalty = 10.0)
+    objective.add_dataset(ensemble.uniaxial_test(1.0e-4, T = 500.0,
+      emax = 0.01, nsteps = 10), "strain", "stress", [0.005], [0.0])
+    objective.add_dataset(ensemble.stress_cyclic(150.0, -1, 1.0, 2,
+      T = 500.0), None, "max", None, [0.0, 0.0])
+    J = objective.jacobian(np.array([140.0]), rel_step = 0.1)
+    self.assertEqual(list(objective.status), [0, -3])
+    self.assertTrue(np.isclose(J[0,0], 1.0))
+    # No derivatives from differencing against the penalty
+    self.assertTrue(np.all(J[1:] == 0.0))
+
+  def test_missing(self):
+    self.objective.add_dataset(ensemble.uniaxial_test(1.0e-4, T = 500.0,
+      emax = 0.01, nsteps = 10), "strain", "nothing", [0.005], [0.0])
+    self.objective.residuals(np.zeros((0,)))
+    self.assertEqual(list(self.objective.status), [-13])
+    self.assertTrue("nothing" in self.objective.messages[0])
+
+class TestErrors(unittest.TestCase):
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", "test_j2iso")
+    self.test = ensemble.uniaxial_test(1.0e-4)
+
+  def test_names(self):
+    with self.assertRaises(ValueError):
+      calibrate.CalibrationObjective(self.model, ["bad"])
+    with self.assertRaises(ValueError):
+      calibrate.CalibrationObjective(self.model, ["flow.hardening.K",
+        "flow.hardening.K"])
+
+  def test_datasets(self):
+    objective = calibrate.CalibrationObjective(self.model,
+        ["flow.hardening.K"])
+    with self.assertRaises(ValueError):
+      objective.add_dataset(self.test, "strain", "stress", [0.01, 0.02],
+          [1.0])
+    with self.assertRaises(ValueError):
+      objective.add_dataset(self.test, "strain", "stress", [0.01], [1.0],
+          weight = -1.0)
+    with self.assertRaises(ValueError):
+      objective.add_dataset(ensemble.uniaxial_test(1.0e-4,
+        model = self.model), "strain", "stress", [0.01], [1.0])
+    objective.add_dataset(self.test, "strain", "stress", [0.01], [1.0])
+    with self.assertRaises(ValueError):
+      objective.residuals(np.zeros((2,)))
@@ -0,0 +1,137 @@
+from neml import parse, drivers, cdrivers
+
+import unittest
+import numpy as np
+
+def same(a, b):
+  if isinstance(a, bool):
+    return a == b
+  a = np.asarray(a, dtype = float)
+  b = np.asarray(b, dtype = float)
+  return a.shape == b.shape and np.allclose(a, b, rtol = 1.0e-5,
+      atol = 1.0e-8, equal_nan = True)
+
+class CompareDrivers(object):
+  """
+    The native loading programs give the same results as the python ones
+  """
+  def compare(self, name, *args, **kwargs):
+    a = getattr(drivers, name)(self.model, *args, **kwargs)
+    b = getattr(cdrivers, name)(self.model, *args, **kwargs)
+    self.assertEqual(sorted(a.keys()), sorted(b.keys()))
+    for k in a:
+      self.assertTrue(same(a[k], b[k]), msg = "%s: %s" % (name, k))
+    return b
+
+  def test_uniaxial(self):
+    res = self.compare("uniaxial_test", 1.0e-4, T = self.T, emax = 0.02,
+        nsteps = 50)
+    self.assertTrue(res['strain'].flags['C_CONTIGUOUS'])
+
+  def test_uniaxial_history(self):
+    h = self.model.init_store()
+    self.compare("uniaxial_test", 1.0e-3, T = self.T, emax = 0.01,
+        nsteps = 20, history = h, sdir = np.array([0,1.0,0,0,0,0]),
+        tdir = np.array([1.0,0,0,0,0,0]))
+
+  def test_strain_cyclic(self):
+    self.compare("strain_cyclic", 0.01, -0.5, 1.0e-4, 3, T = self.T,
+        nsteps = 20)
+
+  def test_strain_cyclic_hold(self):
+    self.compare("strain_cyclic", 0.01, -1, 1.0e-4, 2, T = self.T,
+        nsteps = 20, hold_time = [10.0, 5.0], n_hold = 5)
+    self.compare("strain_cyclic", 0.01, -1, 1.0e-4, 2, T = self.T,
+        nsteps = 20, hold_time = 10.0, n_hold = 5)
+
+  def test_stress_cyclic(self):
+    self.compare("stress_cyclic", self.smax, -0.5, 1.0, 3, T = self.T,
+        nsteps = 20, hold_time = 10.0, n_hold = 5)
+
+  def test_stress_relaxation(self):
+    self.compare("stress_relaxation", 0.01, 1.0e-4, 100.0, T = self.T,
+        nsteps = 20, nsteps_up = 20)
+    self.compare("stress_relaxation", 0.01, 1.0e-4, 100.0, T = self.T,
+        nsteps = 20, nsteps_up = 20, logspace = True, q = 2.0)
+
+  def test_creep(self):
+    self.compare("creep", self.smax, 10.0, 1000.0, T = self.T, nsteps = 20,
+        nsteps_up = 20)
+    self.compare("creep", self.smax, 10.0, 1000.0, T = self.T, nsteps = 20,
+        nsteps_up = 20, logspace = True)
+
+  def test_thermomechanical(self):
+    time = np.linspace(0, 1000.0, 40)
+    temperature = np.linspace(self.T, self.T + 100.0, 40)
+    strain = 0.005 * np.sin(time / 100.0)
+    self.compare("thermomechanical_strain_raw", time, temperature, strain,
+        substep = 2)
+
+  def test_rate_jump(self):
+    self.compare("rate_jump_test", [1.0e-4, 1.0e-2, 1.0e-3], T = self.T,
+        e_per = 0.005, nsteps_per = 20)
+    self.compare("rate_jump_test", [1.0e-4, 1.0e-2], T = self.T,
+        nsteps_per = 20, strains = [0.005, 0.01])
+
+  def test_steps(self):
+    d1 = drivers.Driver_sd(self.model, T_init = self.T)
+    d2 = cdrivers.Driver_sd(self.model, T_init = self.T)
+    sdir = np.array([1.0,0,0,0,0,0])
+    for d in (d1, d2):
+      d.strain_step(np.array([0.001,0,0,0,0,0]), 1.0, self.T + 10.0)
+      d.erate_step(sdir, 1.0e-4, 11.0, self.T + 20.0)
+      d.srate_sinc_step(sdir, 1.0, -10.0, self.T + 20.0)
+      d.stress_step(np.array([0,10.0,0,0,0,0]), 50.0, self.T)
+      d.strain_hold_step(1, 60.0, self.T)
+    self.assertTrue(same(d1.strain_int[-1], d2.strain))
+    self.assertTrue(same(d1.thermal_strain_int[-1], d2.thermal_strain))
+    self.assertTrue(same(d1.stress_int[-1], d2.stress))
+    self.assertTrue(same(d1.stored_int[-1], d2.history))
+    for k in ("t", "u", "p"):
+      self.assertTrue(same(getattr(d1, k), getattr(d2, k)))
+
+class TestJ2Iso(unittest.TestCase, CompareDrivers):
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", "test_j2iso")
+    self.T = 500.0
+    self.smax = 150.0
+
+class TestChaboche(unittest.TestCase, CompareDrivers):
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", "test_rd_chaboche")
+    self.T = 500.0
+    self.smax = 150.0
+
+class TestPowerDamage(unittest.TestCase, CompareDrivers):
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", "test_powerdamage")
+    self.T = 500.0
+    self.smax = 150.0
+
+class TestErrors(unittest.TestCase):
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", "test_perfect")
+
+  def test_direction(self):
+    with self.assertRaises(ValueError):
+      cdrivers.uniaxial_test(self.model, 1.0e-4, sdir = [1.0, 0.0])
+
+  def test_history(self):
+    with self.assertRaises(ValueError):
+      cdrivers.uniaxial_test(self.model, 1.0e-4,
+          history = np.zeros((self.model.nstore + 1,)))
+
+  def test_modulus(self):
+    d = cdrivers.Driver_sd(self.model)
+    with self.assertRaises(ValueError):
+      d.strain_hold_step(0, 1.0, 0.0, q = 2.0)
+
+  def test_first_half(self):
+    # Stress control past the limit load of perfect plasticity
+    with self.assertRaises(RuntimeError):
+      cdrivers.stress_cyclic(self.model, 150.0, -1, 1.0, 2, T = 500.0)
+
+  def test_creep_failure(self):
+    res = cdrivers.creep(self.model, 59.0, 1.0, 1000.0, T = 500.0,
+        nsteps = 10, nsteps_up = 10, elimit = 1.0e-4)
+    self.assertTrue(res['failed'])
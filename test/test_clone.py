@@ -0,0 +1,88 @@
+from neml import (models, elasticity, surfaces, hardening, ri_flow, 
+    interpolate, parse, tunable)
+
+import unittest
+import numpy as np
+
+from test_parse import CompareMats
+
+class TestCloneXML(CompareMats, unittest.TestCase):
+  def setUp(self):
+    self.model1 = parse.parse_xml("test/examples.xml", "test_rd_chaboche")
+    self.model2 = self.model1.clone()
+
+    self.T = 550.0
+    self.tmax = 10.0
+    self.nsteps = 50
+    self.emax = np.array([0.05,0,0,0.02,0,0.01])
+
+  def test_type(self):
+    self.assertEqual(type(self.model1), type(self.model2))
+
+class TestCloneShared(CompareMats, unittest.TestCase):
+  def setUp(self):
+    self.model1 = parse.parse_xml("test/examples.xml", "test_perzyna")
+    self.model2 = self.model1.clone(share_constants = True)
+
+    self.T = 300.0
+    self.tmax = 10.0
+    self.nsteps = 50
+    self.emax = np.array([0.05,0,0,0.02,0,0.01])
+
+class TestCloneOptions(unittest.TestCase):
+  def setUp(self):
+    elastic = elasticity.IsotropicLinearElasticModel(100000.0, "youngs", 0.3,
+        "poissons")
+    self.model = models.SmallStrainElasticity(elastic, tangent_outer = False)
+
+  def test_tangent_outer(self):
+    copy = self.model.clone()
+    B = copy.update_ld_inc(np.array([0.01,0,0,0,0,0]), np.zeros((6,)),
+        np.array([0,0,0.01]), np.zeros((3,)), 300.0, 300.0, 1.0, 0.0,
+        np.array([100.0,0,0,0,0,0]), copy.init_store(), 0.0, 0.0)[3]
+    self.assertTrue(np.allclose(B, 0.0))
+
+class TestSharing(unittest.TestCase):
+  def setUp(self):
+    self.C = interpolate.PolynomialInterpolate([1.0, 100000.0])
+    elastic = elasticity.IsotropicLinearElasticModel(self.C, "youngs", 0.3,
+        "poissons")
+    surface = surfaces.IsoJ2()
+    hrule = hardening.LinearIsotropicHardeningRule(100.0, self.C)
+    flow = ri_flow.RateIndependentAssociativeFlow(surface, hrule)
+    self.model = models.SmallStrainRateIndependentPlasticity(elastic, flow)
+
+  def test_deep(self):
+    copy = self.model.clone()
+    t = tunable.TunableParameters(copy)
+    t["elastic.m1.coefs[1]"] = 50000.0
+
+    # The copy keeps the sharing inside the graph
+    self.assertTrue(np.isclose(copy.elastic.E(0.0), 50000.0))
+    self.assertFalse("flow.hardening.K.coefs[1]" in t.names)
+
+    # But not with the original
+    self.assertTrue(np.isclose(self.model.elastic.E(0.0), 100000.0))
+    self.assertTrue(np.isclose(self.C(0.0), 100000.0))
+
+  def test_shared(self):
+    copy = self.model.clone(share_constants = True)
+    self.assertTrue(self.C.shared_between_models)
+
+    # Tuning either model would also change the other one
+    with self.assertRaises(ValueError):
+      tunable.TunableParameters(copy)
+    with self.assertRaises(ValueError):
+      tunable.TunableParameters(self.model)
+    self.assertTrue(np.isclose(self.C(0.0), 100000.0))
+
+  def test_shared_then_deep(self):
+    self.model.clone(share_constants = True)
+    copy = self.model.clone()
+    t = tunable.TunableParameters(copy)
+    t["elastic.m1.coefs[1]"] = 50000.0
+    self.assertTrue(np.isclose(self.C(0.0), 100000.0))
+
+  def test_interpolate(self):
+    self.assertTrue(isinstance(self.C.clone(), 
+      interpolate.PolynomialInterpolate))
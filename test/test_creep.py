@@ -49,6 +49,19 @@ class CommonScalarCreep(object):
     cderiv = self.model.dg_dT(self.s, self.e, self.t, self.T)
     self.assertTrue(np.isclose(nderiv, cderiv))
 
+  def test_g_vec(self):
+    """
+      Creep rate over arrays of inputs
+    """
+    s = self.s * np.array([0.5, 1.0, 1.5])[:,None]
+    T = self.T + np.array([0.0, 5.0])
+    g = self.model.g_vec(s, self.e, self.t, T)
+    self.assertEqual(g.shape, (3,2))
+    for i in range(3):
+      for j in range(2):
+        self.assertTrue(np.isclose(g[i,j], 
+          self.model.g(s[i,0], self.e, self.t, T[j])))
+
 class TestPowerLawCreep(unittest.TestCase, CommonScalarCreep):
   def setUp(self):
     self.A = 1.0e-6
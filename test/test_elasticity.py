@@ -21,6 +21,16 @@ class CommonElasticity(object):
     S = self.model.S(self.T)
     self.assertTrue(np.allclose(self.model.C(self.T), la.inv(S)))
 
+  def test_apply_C(self):
+    e = np.array([0.01,-0.02,0.005,0.001,-0.003,0.02])
+    self.assertTrue(np.allclose(self.model.apply_C(self.T, e),
+      np.dot(self.model.C(self.T), e)))
+
+  def test_apply_S(self):
+    s = np.array([100.0,-50.0,25.0,10.0,-30.0,200.0])
+    self.assertTrue(np.allclose(self.model.apply_S(self.T, s),
+      np.dot(self.model.S(self.T), s)))
+
 class TestIsotropicConstantModel(CommonElasticity, unittest.TestCase):
   def setUp(self):
     self.mu = 29000.0
@@ -74,3 +84,30 @@ class TestEquivalentDefinitions(unittest.TestCase):
     self.assertTrue(np.isclose(self.mu, self.model_GK.G(self.T)))
     self.assertTrue(np.isclose(self.K, self.model_Ev.K(self.T)))
     self.assertTrue(np.isclose(self.K, self.model_GK.K(self.T)))
+
+  def test_all_combinations(self):
+    vals = {"youngs": self.E, "poissons": self.nu, "shear": self.mu,
+        "bulk": self.K}
+    for t1 in vals.keys():
+      for t2 in vals.keys():
+        if t1 == t2:
+          continue
+        model = elasticity.IsotropicLinearElasticModel(vals[t1], t1,
+            vals[t2], t2)
+        self.assertTrue(np.isclose(self.mu, model.G(self.T)))
+        self.assertTrue(np.isclose(self.K, model.K(self.T)))
+
+class TestIsotropicTemperatureModel(CommonElasticity, unittest.TestCase):
+  def setUp(self):
+    self.T = 550.0
+    self.mu = interpolate.PiecewiseLinearInterpolate([300.0,800.0],
+        [60000.0,50000.0])
+    self.E = interpolate.PiecewiseLinearInterpolate([300.0,800.0],
+        [150000.0,120000.0])
+
+    self.model = elasticity.IsotropicLinearElasticModel(self.mu, 
+        "shear", self.E, "youngs")
+
+  def test_moduli(self):
+    self.assertTrue(np.isclose(self.model.G(self.T), 55000.0))
+    self.assertTrue(np.isclose(self.model.E(self.T), 135000.0))
@@ -0,0 +1,102 @@
+from neml import parse, cdrivers, ensemble, tunable
+
+import unittest
+import numpy as np
+
+class TestSweep(unittest.TestCase):
+  """
+    An ensemble gives the same results as running the cases one by one
+  """
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", "test_rd_chaboche")
+    self.Ts = [300.0, 400.0, 500.0, 600.0]
+    self.name = "rule.flow.hardening.iso.s0"
+    self.s0s = [50.0, 100.0, 150.0, 100.0, 50.0]
+
+  def test_temperatures(self):
+    cases = [ensemble.uniaxial_test(1.0e-4, T = T, emax = 0.02, nsteps = 20)
+        for T in self.Ts]
+    res = ensemble.run(self.model, cases, nthreads = 1)
+    self.assertTrue(np.all(res['status'] == 0))
+    self.assertEqual(res['stress'].shape, (len(self.Ts), 21))
+    for i, T in enumerate(self.Ts):
+      ref = cdrivers.uniaxial_test(self.model, 1.0e-4, T = T, emax = 0.02,
+          nsteps = 20)
+      self.assertTrue(np.allclose(res['stress'][i], ref['stress']))
+      self.assertTrue(np.isclose(res['yield'][i], ref['yield']))
+
+  def test_parameters(self):
+    values = tunable.TunableParameters(self.model).values
+    cases = [ensemble.uniaxial_test(1.0e-4, T = 500.0, emax = 0.02,
+      nsteps = 20, parameters = {self.name: s0}) for s0 in self.s0s]
+    res = ensemble.run(self.model, cases, nthreads = 2)
+    self.assertTrue(np.all(res['status'] == 0))
+    for i, s0 in enumerate(self.s0s):
+      model = self.model.clone()
+      tunable.TunableParameters(model)[self.name] = s0
+      ref = cdrivers.uniaxial_test(model, 1.0e-4, T = 500.0, emax = 0.02,
+          nsteps = 20)
+      self.assertTrue(np.allclose(res['stress'][i], ref['stress']))
+    # The original model is left alone
+    self.assertTrue(np.allclose(tunable.TunableParameters(self.model).values,
+      values))
+
+  def test_models(self):
+    before = tunable.TunableParameters(self.model)[self.name]
+    other = parse.parse_xml("test/examples.xml", "test_j2iso")
+    cases = [ensemble.uniaxial_test(1.0e-4, T = 500.0, emax = 0.02,
+      nsteps = 20, model = other), ensemble.uniaxial_test(1.0e-4, T = 500.0,
+        emax = 0.02, nsteps = 20, model = self.model,
+        parameters = {self.name: 50.0})]
+    res = ensemble.run(None, cases)
+    ref = cdrivers.uniaxial_test(other, 1.0e-4, T = 500.0, emax = 0.02,
+        nsteps = 20)
+    self.assertTrue(np.allclose(res['stress'][0], ref['stress']))
+    # The case's model is left alone
+    self.assertEqual(tunable.TunableParameters(self.model)[self.name], before)
+
+  def test_threads(self):
+    cases = [ensemble.uniaxial_test(1.0e-4, T = T, emax = 0.02, nsteps = 20,
+      parameters = {self.name: s0}) for T in self.Ts for s0 in self.s0s]
+    r1 = ensemble.run(self.model, cases, nthreads = 1)
+    r2 = ensemble.run(self.model, cases, nthreads = 3)
+    self.assertTrue(np.array_equal(r1['stress'], r2['stress']))
+
+  def test_stacking(self):
+    cases = [ensemble.uniaxial_test(1.0e-4, T = 500.0, emax = 0.02,
+      nsteps = 10), ensemble.strain_cyclic(0.01, -1, 1.0e-4, 2, T = 500.0,
+        nsteps = 10)]
+    res = ensemble.run(self.model, cases)
+    ref = cdrivers.strain_cyclic(self.model, 0.01, -1, 1.0e-4, 2, T = 500.0,
+        nsteps = 10)
+    n = len(ref['strain'])
+    self.assertEqual(res['strain'].shape, (2, n))
+    self.assertTrue(np.allclose(res['strain'][1], ref['strain']))
+    self.assertTrue(np.all(np.isnan(res['strain'][0,11:])))
+    self.assertTrue(np.array_equal(res['cycles'][1], ref['cycles']))
+    self.assertTrue(np.all(res['cycles'][0] == -1))
+    self.assertTrue(np.isnan(res['youngs'][1]))
+
+class TestFailures(unittest.TestCase):
+  """
+    A failed case does not stop the others
+  """
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", "test_perfect")
+
+  def test_isolated(self):
+    cases = [ensemble.stress_cyclic(50.0, -1, 1.0, 2, T = 500.0),
+        ensemble.stress_cyclic(150.0, -1, 1.0, 2, T = 500.0),
+        ensemble.uniaxial_test(1.0e-4, T = 500.0, parameters = {"bad": 1.0}),
+        ensemble.uniaxial_test(1.0e-4, T = 500.0, sdir = [1.0, 0.0])]
+    res = ensemble.run(self.model, cases, nthreads = 2)
+    self.assertEqual(list(res['status'][:3]), [0, -3, -13])
+    self.assertTrue(res['status'][3] != 0)
+    self.assertEqual(res['message'][0], "")
+    self.assertTrue("bad" in res['message'][2])
+    self.assertTrue(np.all(np.isfinite(res['stress'][0])))
+    self.assertTrue(np.all(np.isnan(res['stress'][1:])))
+
+  def test_no_model(self):
+    with self.assertRaises(ValueError):
+      ensemble.run(None, [ensemble.uniaxial_test(1.0e-4)])
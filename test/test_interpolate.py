@@ -16,6 +16,13 @@ class BaseInterpolate(object):
     nd = differentiate(lambda x: self.interpolate(x), self.x)
     self.assertTrue(np.isclose(d, nd, rtol = 1.0e-3))
 
+  def test_vec(self):
+    x = self.x * np.array([[0.9, 1.0], [1.05, 1.1], [0.95, 1.0]])
+    self.assertTrue(np.allclose(self.interpolate.value_vec(x),
+      np.vectorize(self.interpolate.value)(x)))
+    self.assertTrue(np.allclose(self.interpolate.derivative_vec(x),
+      np.vectorize(self.interpolate.derivative)(x)))
+
 class TestPolynomialInterpolate(unittest.TestCase, BaseInterpolate):
   def setUp(self):
     self.n = 5
@@ -148,3 +155,31 @@ class TestMTSInterpolate(unittest.TestCase, BaseInterpolate):
     should = self.y0 - self.D / (np.exp(self.x0 / self.x) - 1.0)
     act = self.interpolate(self.x)
     self.assertTrue(np.isclose(should, act))
+
+class TestSetConstants(unittest.TestCase):
+  def test_polynomial(self):
+    f = interpolate.PolynomialInterpolate([1.0, 2.0, 3.0])
+    self.assertEqual(f.constant_names, ["coefs[0]", "coefs[1]", "coefs[2]"])
+    f.set_constants([2.0, 0.0, 1.0])
+    self.assertTrue(np.isclose(f(2.0), 9.0))
+    self.assertTrue(np.isclose(f.derivative(2.0), 8.0))
+
+  def test_piecewise(self):
+    f = interpolate.PiecewiseLinearInterpolate([0.0, 1.0], [1.0, 2.0])
+    self.assertEqual(f.constants(), [0.0, 1.0, 1.0, 2.0])
+    f.set_constants([1.0, 0.0, 1.0, 2.0])
+    self.assertFalse(f.valid)
+    f.set_constants([0.0, 2.0, 1.0, 3.0])
+    self.assertTrue(f.valid)
+    self.assertTrue(np.isclose(f(1.0), 2.0))
+
+  def test_loglinear(self):
+    f = interpolate.PiecewiseLogLinearInterpolate([0.0, 1.0], [1.0, 10.0])
+    f.set_constants([0.0, 1.0, 1.0, 100.0])
+    self.assertEqual(f.constants(), [0.0, 1.0, 1.0, 100.0])
+    self.assertTrue(np.isclose(f(0.5), 10.0))
+
+  def test_wrong_size(self):
+    f = interpolate.ConstantInterpolate(1.0)
+    with self.assertRaises(ValueError):
+      f.set_constants([1.0, 2.0])
@@ -50,6 +50,16 @@ class CommonLD(object):
       self.assertTrue(np.allclose(A_np1, A_num, rtol = 1.0e-2))
       self.assertTrue(np.allclose(B_np1, B_num, rtol = 1.0e-2))
 
+  def test_skip_outer(self):
+    for c in self.conditions:
+      args = (c['d_np1'], c['d_n'], c['w_np1'], c['w_n'], c['T'], c['T'],
+          c['dt'], 0.0, c['stress_n'], c['hist_n'], 0.0, 0.0)
+      stress_full, _, A_full, B_full, _, _ = self.model.update_ld_inc(*args)
+      stress_j, _, A_j, B_j, _, _ = self.jaumann.update_ld_inc(*args)
+
+      self.assertTrue(np.allclose(stress_full, stress_j))
+      self.assertTrue(np.allclose(B_j, 0.0))
+
   def test_tangent_proportional(self):
     for dirs in self.directions:
       ddir = dirs['d']
@@ -98,6 +108,8 @@ class TestLinearElastic(CommonLD, unittest.TestCase):
     self.elastic = elasticity.IsotropicLinearElasticModel(self.E,
         "youngs", self.nu, "poissons")
     self.model = models.SmallStrainElasticity(self.elastic)
+    self.jaumann = models.SmallStrainElasticity(self.elastic,
+        tangent_outer = False)
     
     self.conditions = [
         {'hist_n': np.zeros((6,)),
@@ -139,6 +151,8 @@ class TestSimplePlastic(CommonLD, unittest.TestCase):
     hard = hardening.LinearIsotropicHardeningRule(self.sY, self.H)
     flow = ri_flow.RateIndependentAssociativeFlow(surf, hard)
     self.model = models.SmallStrainRateIndependentPlasticity(elastic, flow)
+    self.jaumann = models.SmallStrainRateIndependentPlasticity(elastic, flow,
+        tangent_outer = False)
 
     self.conditions = [
         {'hist_n': self.model.init_store(),
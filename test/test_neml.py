@@ -678,3 +678,101 @@ class TestKMSwitch(unittest.TestCase, CommonMatModel):
     h = np.array([40.0,20,-30,40.0,5.0,2.0,40.0])
     h[:6] = make_dev(h[:6])
     return h
+
+class CommonMixedControl(object):
+  """
+    Tests for models with stress controlled components
+  """
+  def test_zero_stress(self):
+    t_n = 0.0
+    strain_n = np.zeros((6,))
+    stress_n = np.zeros((6,))
+    hist_n = self.model.init_store()
+
+    for m in np.linspace(0,1,self.nsteps)[1:]:
+      t_np1 = self.tfinal * m
+      strain_np1 = self.efinal * m
+      stress_np1, hist_np1, A_np1, u_np1, p_np1 = self.model.update_sd(
+          strain_np1, strain_n, self.T, self.T, t_np1, t_n, stress_n, hist_n,
+          0.0, 0.0)
+      self.assertTrue(np.allclose(stress_np1[self.control], 0.0, 
+        atol = 1.0e-6))
+      self.assertTrue(np.allclose(A_np1[self.control], 0.0))
+      self.assertTrue(np.allclose(A_np1[:,self.control], 0.0))
+      strain_n = strain_np1
+      stress_n = stress_np1
+      hist_n = hist_np1
+      t_n = t_np1
+
+class TestMixedControlElastic(CommonMatModel, CommonMixedControl, 
+    unittest.TestCase):
+  """
+    Plane stress linear elasticity
+  """
+  def setUp(self):
+    self.E = 92000.0
+    self.nu = 0.3
+
+    self.mu = self.E/(2*(1+self.nu))
+    self.K = self.E/(3*(1-2*self.nu))
+
+    self.elastic = elasticity.IsotropicLinearElasticModel(self.mu,
+        "shear", self.K, "bulk")
+    self.base = models.SmallStrainElasticity(self.elastic)
+    self.control = [2,3,4]
+    self.model = models.MixedControlModel(self.base)
+
+    self.efinal = np.array([0.1,-0.05,0.02,-0.03,0.1,-0.15])
+    self.tfinal = 10.0
+    self.T = 300.0
+    self.nsteps = 10
+
+  def test_properties(self):
+    self.assertEqual(self.model.nhist, 3)
+    self.assertTrue(np.isclose(self.model.alpha(self.T),
+      self.base.alpha(self.T)))
+
+  def test_plane_stress_tangent(self):
+    s, h, A, u, p = self.model.update_sd(self.efinal, np.zeros((6,)), 
+        self.T, self.T, 1.0, 0.0, np.zeros((6,)), self.model.init_store(),
+        0.0, 0.0)
+    free = [0,1,5]
+    S = self.elastic.S(self.T)
+    C = la.inv(S[np.ix_(free,free)])
+    self.assertTrue(np.allclose(A[np.ix_(free,free)], C))
+    self.assertTrue(np.allclose(s[free], np.dot(C, self.efinal[free])))
+
+  def test_bad_control(self):
+    for control in ([6], [1,1], [0.5]):
+      with self.assertRaises(ValueError):
+        models.MixedControlModel(self.base, control = control)
+
+class TestMixedControlPlastic(CommonMatModel, CommonMixedControl,
+    unittest.TestCase):
+  """
+    Plastic model with an arbitrary set of controlled components
+  """
+  def setUp(self):
+    self.E = 92000.0
+    self.nu = 0.3
+
+    self.mu = self.E/(2*(1+self.nu))
+    self.K = self.E/(3*(1-2*self.nu))
+
+    self.elastic = elasticity.IsotropicLinearElasticModel(self.mu,
+        "shear", self.K, "bulk")
+
+    surface = surfaces.IsoJ2()
+    hrule = hardening.LinearIsotropicHardeningRule(180.0, self.E / 100)
+    flow = ri_flow.RateIndependentAssociativeFlow(surface, hrule)
+    base = models.SmallStrainRateIndependentPlasticity(self.elastic, flow,
+        check_kt = False)
+
+    self.control = [1,3]
+    self.model = models.MixedControlModel(base, control = self.control,
+        rtol = 1.0e-14, atol = 1.0e-12)
+
+    self.efinal = np.array([0.02,-0.01,0.005,-0.003,0.01,-0.015])
+    self.tfinal = 10.0
+    self.T = 300.0
+    self.nsteps = 10
@@ -322,6 +322,25 @@ class TestEigenstuff(unittest.TestCase):
     for nv, mv in zip(tvecs,vecs):
       self.assertTrue(np.allclose(nv,mv) or np.allclose(nv,-mv))
 
+  def test_eigenvalue_derivs_sym(self):
+    dvals = eigenvalue_derivs_sym(self.S)
+    for i in range(3):
+      nd = differentiate(lambda s: eigenvalues_sym(s)[i], self.S)
+      self.assertTrue(np.allclose(dvals[i], nd, rtol = 1.0e-4))
+
+  def test_repeated(self):
+    for S in [np.array([10.0,10.0,10.0,0,0,0]), 
+        np.array([10.0,10.0,-5.0,0,0,0]),
+        np.array([1.0,1.0,1.0,0,0,0]) + 1.0e-12 * self.S,
+        np.zeros((6,))]:
+      vals = eigenvalues_sym(S)
+      vecs = eigenvectors_sym(S)
+      F = usym(S)
+      self.assertTrue(np.allclose(vals, la.eigvalsh(F)))
+      self.assertTrue(np.allclose(np.dot(vecs, vecs.T), np.eye(3)))
+      for v, l in zip(vecs, vals):
+        self.assertTrue(np.allclose(np.dot(F, v), l * v))
+
 class TestInvariants(unittest.TestCase):
   def setUp(self):
     self.S = np.array([50.0,-25.0,100.0,30.0,-180.0,90.0])
@@ -341,3 +360,38 @@ class TestInvariants(unittest.TestCase):
   def test_I2_dev(self):
     v1 = 0.5*(np.trace(self.SF_dev)**2.0 - np.trace(np.dot(self.SF_dev, self.SF_dev)))
     self.assertTrue(np.isclose(v1, I2(dev_vec(self.S))))
+
+class TestFixedSize(unittest.TestCase):
+  """
+    Mandel sized operations go through the fixed size kernels
+  """
+  def setUp(self):
+    self.a = ra.random((6,))
+    self.b = ra.random((6,))
+    self.A = ra.random((6,6))
+    self.B = ra.random((6,6))
+
+  def test_add_sub(self):
+    self.assertTrue(np.allclose(add_vec(self.a, self.b), self.a + self.b))
+    self.assertTrue(np.allclose(sub_vec(self.a, self.b), self.a - self.b))
+
+  def test_dot(self):
+    self.assertTrue(np.isclose(dot_vec(self.a, self.b), np.dot(self.a, self.b)))
+
+  def test_outer(self):
+    self.assertTrue(np.allclose(outer_vec(self.a, self.b), 
+      np.outer(self.a, self.b)))
+    self.assertTrue(np.allclose(outer_update(self.a, self.b, 
+      np.copy(self.A)), self.A + np.outer(self.a, self.b)))
+    self.assertTrue(np.allclose(outer_update_minus(self.a, self.b, 
+      np.copy(self.A)), self.A - np.outer(self.a, self.b)))
+
+  def test_matvec(self):
+    self.assertTrue(np.allclose(mat_vec(self.A, self.b), 
+      np.dot(self.A, self.b)))
+    self.assertTrue(np.allclose(mat_vec_trans(self.A, self.b), 
+      np.dot(self.A.T, self.b)))
+
+  def test_matmat(self):
+    self.assertTrue(np.allclose(mat_mat(self.A, self.B), 
+      np.dot(self.A, self.B)))
@@ -1,7 +1,10 @@
-from neml import solvers, interpolate, models, elasticity, ri_flow, hardening, surfaces, parse, visco_flow, general_flow, creep, damage
+from neml import solvers, interpolate, models, elasticity, ri_flow, hardening, surfaces, parse, visco_flow, general_flow, creep, damage, drivers, tunable
 
 import unittest
 import numpy as np
+import os, os.path
+import shutil
+import tempfile
 
 class TestErrors(unittest.TestCase):
   def test_top(self):
@@ -395,3 +398,272 @@ class TestPerfectCreep(CompareMats, unittest.TestCase):
     cmodel = creep.J2CreepModel(smodel)
 
     self.model2 = models.SmallStrainCreepPlasticity(elastic, pmodel, cmodel)
+
+class TestXMLLibrary(unittest.TestCase):
+  def setUp(self):
+    self.dir = tempfile.TemporaryDirectory()
+    self.fname = os.path.join(self.dir.name, "examples.xml")
+    shutil.copy("test/examples.xml", self.fname)
+    self.names = ["test_j2iso", "test_rd_chaboche", "test_perzyna", 
+        "test_pcreep"]
+
+  def tearDown(self):
+    self.dir.cleanup()
+
+  def test_index(self):
+    library = parse.XMLLibrary(self.fname)
+    self.assertFalse(library.index_reused)
+    self.assertTrue(os.path.exists(self.fname + ".index"))
+    self.assertTrue(parse.XMLLibrary(self.fname).index_reused)
+
+  def test_names(self):
+    library = parse.XMLLibrary(self.fname)
+    for n in self.names:
+      self.assertTrue(n in library.names())
+    self.assertEqual(library.type("test_j2iso"), 
+        "SmallStrainRateIndependentPlasticity")
+
+  def test_missing(self):
+    library = parse.XMLLibrary(self.fname)
+    with self.assertRaises(parse.NodeNotFound):
+      library.parse("not_a_model")
+
+  def test_changed(self):
+    parse.XMLLibrary(self.fname)
+    with open(self.fname, 'a') as f:
+      f.write("\n<!-- changed -->\n")
+    library = parse.XMLLibrary(self.fname)
+    self.assertFalse(library.index_reused)
+    self.assertTrue("test_j2iso" in library.names())
+
+  def test_touched(self):
+    parse.XMLLibrary(self.fname)
+    st = os.stat(self.fname)
+    os.utime(self.fname, (st.st_atime + 10, st.st_mtime + 10))
+    self.assertTrue(parse.XMLLibrary(self.fname).index_reused)
+
+  def test_custom_index(self):
+    index = os.path.join(self.dir.name, "other.index")
+    parse.XMLLibrary(self.fname, index)
+    self.assertTrue(os.path.exists(index))
+    self.assertTrue(parse.XMLLibrary(self.fname, index).index_reused)
+
+  def test_no_save(self):
+    library = parse.XMLLibrary(self.fname, save_index = False)
+    self.assertTrue("test_j2iso" in library.names())
+    self.assertFalse(os.path.exists(self.fname + ".index"))
+    parse.XMLLibrary(self.fname)
+    self.assertTrue(parse.XMLLibrary(self.fname, 
+      save_index = False).index_reused)
+
+DEFINES = """<materials>
+  <defines>
+    <steel type="IsotropicLinearElasticModel">
+      <m1>150000.0</m1>
+      <m1_type>youngs</m1_type>
+      <m2>0.3</m2>
+      <m2_type>poissons</m2_type>
+    </steel>
+    <yield type="PiecewiseLinearInterpolate">
+      <points>100.0 300.0 500.0 700.0</points>
+      <values>1000.0 120.0 60.0 30.0</values>
+    </yield>
+    <hot>500.0</hot>
+    <loop type="SmallStrainPerfectPlasticity">
+      <elastic ref="steel"/>
+      <surface type="IsoJ2"/>
+      <ys ref="loop"/>
+    </loop>
+  </defines>
+
+  <shared type="SmallStrainPerfectPlasticity">
+    <elastic ref="steel"/>
+    <surface type="IsoJ2"/>
+    <ys ref="yield"/>
+  </shared>
+
+  <other type="SmallStrainPerfectPlasticity">
+    <elastic ref="steel"/>
+    <surface type="IsoJ2"/>
+    <ys ref="yield"/>
+  </other>
+
+  <inline type="SmallStrainPerfectPlasticity">
+    <elastic type="IsotropicLinearElasticModel">
+      <m1>150000.0</m1>
+      <m1_type>youngs</m1_type>
+      <m2>0.3</m2>
+      <m2_type>poissons</m2_type>
+    </elastic>
+    <surface type="IsoJ2"/>
+    <ys type="PiecewiseLinearInterpolate">
+      <points>100.0 300.0 500.0 700.0</points>
+      <values>1000.0 120.0 60.0 30.0</values>
+    </ys>
+  </inline>
+
+  <creep type="SmallStrainCreepPlasticity">
+    <elastic ref="steel"/>
+    <plastic type="SmallStrainPerfectPlasticity">
+      <elastic ref="steel"/>
+      <surface type="IsoJ2"/>
+      <ys ref="yield"/>
+    </plastic>
+    <creep type="J2CreepModel">
+      <rule type="PowerLawCreep">
+        <A>1.0e-10</A>
+        <n>5.0</n>
+      </rule>
+    </creep>
+  </creep>
+
+  <missing type="SmallStrainPerfectPlasticity">
+    <elastic ref="aluminum"/>
+    <surface type="IsoJ2"/>
+    <ys ref="yield"/>
+  </missing>
+
+  <circular type="SmallStrainPerfectPlasticity">
+    <elastic ref="steel"/>
+    <surface type="IsoJ2"/>
+    <ys ref="loop"/>
+  </circular>
+
+  <value type="SmallStrainPerfectPlasticity">
+    <elastic ref="steel"/>
+    <surface type="IsoJ2"/>
+    <ys ref="hot"/>
+  </value>
+</materials>
+"""
+
+class TestDefines(unittest.TestCase):
+  def setUp(self):
+    self.dir = tempfile.TemporaryDirectory()
+    self.fname = os.path.join(self.dir.name, "defines.xml")
+    with open(self.fname, 'w') as f:
+      f.write(DEFINES)
+
+  def tearDown(self):
+    self.dir.cleanup()
+
+  def stress(self, model):
+    res = drivers.uniaxial_test(model, 1.0e-4, T = 400.0, emax = 0.01)
+    return res['stress']
+
+  def test_same(self):
+    self.assertTrue(np.allclose(
+      self.stress(parse.parse_xml(self.fname, "shared")),
+      self.stress(parse.parse_xml(self.fname, "inline"))))
+
+  def test_shared_in_model(self):
+    # The two elastic models are one object, so one set of constants
+    model = parse.parse_xml(self.fname, "creep")
+    names = tunable.TunableParameters(model).names
+    self.assertTrue("elastic.m1" in names)
+    self.assertFalse("plastic.elastic.m1" in names)
+
+  def test_library(self):
+    library = parse.XMLLibrary(self.fname)
+    self.assertFalse("defines" in library.names())
+    with self.assertRaises(parse.NodeNotFound):
+      library.parse("defines")
+
+    self.assertTrue(np.allclose(self.stress(library.parse("shared")),
+      self.stress(parse.parse_xml(self.fname, "inline"))))
+
+  def test_isolated_in_library(self):
+    library = parse.XMLLibrary(self.fname)
+    other = library.parse("other")
+    before = self.stress(other)
+    one = tunable.TunableParameters(library.parse("shared"))
+    two = tunable.TunableParameters(other)
+    one["elastic.m1"] = 100000.0
+    one["ys.values[1]"] = 60.0
+    self.assertAlmostEqual(two["elastic.m1"], 150000.0)
+    self.assertAlmostEqual(two["ys.values[1]"], 120.0)
+    self.assertTrue(np.allclose(self.stress(other), before))
+
+  def test_shared_in_library(self):
+    library = parse.XMLLibrary(self.fname, share_definitions = True)
+    model = library.parse("shared")
+    self.assertTrue(np.allclose(self.stress(model),
+      self.stress(parse.parse_xml(self.fname, "inline"))))
+    with self.assertRaises(ValueError):
+      tunable.TunableParameters(model)
+
+  def test_missing(self):
+    with self.assertRaises(parse.NodeNotFound):
+      parse.parse_xml(self.fname, "missing")
+
+  def test_circular(self):
+    with self.assertRaises(parse.CircularReference):
+      parse.parse_xml(self.fname, "circular")
+
+  def test_value(self):
+    model = parse.parse_xml(self.fname, "value")
+    self.assertAlmostEqual(model.ys(300.0), 500.0)
+
+class TestParallel(unittest.TestCase):
+  def setUp(self):
+    self.names = ["test_j2iso", "test_rd_chaboche", "test_perzyna",
+        "test_pcreep", "test_perfect", "test_j2comb", "test_yaguchi"] * 3
+
+  def stress(self, model):
+    res = drivers.uniaxial_test(model, 1.0e-4, T = 500.0, emax = 0.01)
+    return res['stress']
+
+  def test_same(self):
+    models = parse.parse_xml_parallel("test/examples.xml", self.names, 4)
+    self.assertEqual(len(models), len(self.names))
+    for n, m in list(zip(self.names, models))[:7]:
+      self.assertTrue(np.allclose(self.stress(m), 
+        self.stress(parse.parse_xml("test/examples.xml", n))))
+
+  def test_distinct(self):
+    models = parse.parse_xml_parallel("test/examples.xml", self.names)
+    self.assertEqual(len(set(id(m) for m in models)), len(self.names))
+
+  def test_missing(self):
+    with self.assertRaises(parse.NodeNotFound):
+      parse.parse_xml_parallel("test/examples.xml", 
+          self.names + ["not_a_model"], 4)
+
+  def test_not_model(self):
+    with self.assertRaises(parse.InvalidType):
+      parse.parse_xml_parallel("test/examples.xml", 
+          ["test_badtop"] + self.names, 4)
+
+  def test_defines(self):
+    with tempfile.TemporaryDirectory() as d:
+      fname = os.path.join(d, "defines.xml")
+      with open(fname, 'w') as f:
+        f.write(DEFINES)
+      one, two = parse.parse_xml_parallel(fname, ["shared", "other"], 2)
+      tunable.TunableParameters(one)["elastic.m1"] = 100000.0
+      self.assertAlmostEqual(
+          tunable.TunableParameters(two)["elastic.m1"], 150000.0)
+
+class LibraryMats(CompareMats):
+  def setUp(self):
+    self.dir = tempfile.TemporaryDirectory()
+    fname = os.path.join(self.dir.name, "examples.xml")
+    shutil.copy("test/examples.xml", fname)
+    parse.XMLLibrary(fname)
+
+    self.model1 = parse.parse_xml("test/examples.xml", self.name)
+    self.model2 = parse.XMLLibrary(fname).parse(self.name)
+
+    self.T = 550.0
+    self.tmax = 10.0
+    self.nsteps = 50
+    self.emax = np.array([0.05,0,0,0.02,0,0.01])
+
+  def tearDown(self):
+    self.dir.cleanup()
+
+class TestLibraryRDChaboche(LibraryMats, unittest.TestCase):
+  name = "test_rd_chaboche"
+
+class TestLibraryPCreep(LibraryMats, unittest.TestCase):
+  name = "test_pcreep"
@@ -0,0 +1,155 @@
+from neml import (models, elasticity, surfaces, hardening, ri_flow, parse,
+    serialize, pickling, tunable, drivers)
+
+import unittest
+import numpy as np
+import os.path
+import pickle
+import tempfile
+from concurrent.futures import ProcessPoolExecutor
+
+from test_parse import CompareMats
+
+names = ["test_powerdamage", "test_j2iso", "test_j2isocomb", 
+    "test_creep_plasticity", "test_j2comb", "test_nonassri", "test_yaguchi",
+    "test_rd_chaboche", "test_perzyna", "test_perfect", "test_pcreep"]
+
+class TestBinaryImage(unittest.TestCase):
+  def setUp(self):
+    self.dir = tempfile.TemporaryDirectory()
+    self.fname = os.path.join(self.dir.name, "examples.nemlbin")
+    serialize.xml_to_binary("test/examples.xml", self.fname, names)
+
+  def tearDown(self):
+    self.dir.cleanup()
+
+  def test_names(self):
+    self.assertEqual(serialize.binary_model_names(self.fname), names)
+
+  def test_missing(self):
+    with self.assertRaises(serialize.SerializationError):
+      serialize.parse_binary(self.fname, "not_a_model")
+
+  def test_not_binary(self):
+    with self.assertRaises(serialize.SerializationError):
+      serialize.parse_binary("test/examples.xml", "test_j2iso")
+
+  def test_truncated(self):
+    with open(self.fname, 'rb') as f:
+      data = f.read()
+    bad = os.path.join(self.dir.name, "bad.nemlbin")
+    with open(bad, 'wb') as f:
+      f.write(data[:len(data)//2])
+    with self.assertRaises(serialize.SerializationError):
+      for n in names:
+        serialize.parse_binary(bad, n)
+
+  def test_models(self):
+    for n in names:
+      self.assertTrue(isinstance(serialize.parse_binary(self.fname, n), 
+        models.NEMLModel))
+
+class TestPythonObjects(CompareMats, unittest.TestCase):
+  def setUp(self):
+    elastic = elasticity.IsotropicLinearElasticModel(92000.0, "youngs",
+        0.3, "poissons")
+    surface = surfaces.IsoJ2()
+    hrule = hardening.LinearIsotropicHardeningRule(180.0, 1000.0)
+    flow = ri_flow.RateIndependentAssociativeFlow(surface, hrule)
+    self.model1 = models.SmallStrainRateIndependentPlasticity(elastic, flow)
+
+    self.dir = tempfile.TemporaryDirectory()
+    fname = os.path.join(self.dir.name, "python.nemlbin")
+    serialize.write_binary(fname, {"model": self.model1})
+    self.model2 = serialize.parse_binary(fname, "model")
+
+    self.T = 300.0
+    self.tmax = 10.0
+    self.nsteps = 100
+    self.emax = np.array([0.05,0,0,0,0,0])
+
+  def tearDown(self):
+    self.dir.cleanup()
+
+class CompareXML(CompareMats):
+  def setUp(self):
+    self.dir = tempfile.TemporaryDirectory()
+    fname = os.path.join(self.dir.name, "examples.nemlbin")
+    serialize.xml_to_binary("test/examples.xml", fname, [self.name])
+    self.model1 = parse.parse_xml("test/examples.xml", self.name)
+    self.model2 = serialize.parse_binary(fname, self.name)
+
+    self.T = 500.0
+    self.tmax = 10.0
+    self.nsteps = 50
+    self.emax = np.array([0.01,0,0,0,0,0])
+
+  def tearDown(self):
+    self.dir.cleanup()
+
+class TestChaboche(CompareXML, unittest.TestCase):
+  name = "test_rd_chaboche"
+
+class TestCreepPlasticity(CompareXML, unittest.TestCase):
+  name = "test_creep_plasticity"
+
+class TestPowerDamage(CompareXML, unittest.TestCase):
+  name = "test_powerdamage"
+
+class ComparePickled(CompareMats):
+  def setUp(self):
+    self.model1 = parse.parse_xml("test/examples.xml", self.name)
+    self.model2 = pickle.loads(pickle.dumps(self.model1))
+
+    self.T = 500.0
+    self.tmax = 10.0
+    self.nsteps = 50
+    self.emax = np.array([0.01,0,0,0,0,0])
+
+class TestPickledChaboche(ComparePickled, unittest.TestCase):
+  name = "test_rd_chaboche"
+
+class TestPickledPowerDamage(ComparePickled, unittest.TestCase):
+  name = "test_powerdamage"
+
+def stress(model):
+  return drivers.uniaxial_test(model, 1.0e-4, T = 500.0, emax = 0.01,
+      nsteps = 20)['stress']
+
+class TestPickle(unittest.TestCase):
+  def test_types(self):
+    for n in names:
+      model = parse.parse_xml("test/examples.xml", n)
+      self.assertIs(type(pickle.loads(pickle.dumps(model))), type(model))
+
+  def test_python_objects(self):
+    elastic = elasticity.IsotropicLinearElasticModel(92000.0, "youngs",
+        0.3, "poissons")
+    copy = pickle.loads(pickle.dumps(elastic))
+    self.assertTrue(np.array_equal(copy.C(300.0), elastic.C(300.0)))
+
+  def test_changed_constants(self):
+    model = parse.parse_xml("test/examples.xml", "test_j2iso")
+    tunable.TunableParameters(model)["elastic.m1"] = 123456.0
+    copy = pickle.loads(pickle.dumps(model))
+    self.assertEqual(tunable.TunableParameters(copy)["elastic.m1"], 123456.0)
+
+  def test_restore_class(self):
+    model = parse.parse_xml("test/examples.xml", "test_j2iso")
+    image = serialize.dumps(model)
+    self.assertIs(type(pickling.restore(models.NEMLModel, image)),
+        type(model))
+    with self.assertRaises(TypeError):
+      pickling.restore(elasticity.IsotropicLinearElasticModel, image)
+
+  def test_loads_bad(self):
+    with self.assertRaises(serialize.SerializationError):
+      serialize.loads(b"not an image")
+
+  def test_processes(self):
+    models = [parse.parse_xml("test/examples.xml", n) for n in 
+        ["test_j2iso", "test_rd_chaboche", "test_perzyna"]]
+    with ProcessPoolExecutor(2) as pool:
+      results = list(pool.map(stress, models))
+    for model, res in zip(models, results):
+      self.assertTrue(np.array_equal(stress(model), res))
@@ -49,6 +49,13 @@ class CommonYieldSurface(object):
     self.assertTrue(np.allclose(n_d,
       self.model.df_dqds(self.s, self.hist, self.T)))
 
+  def test_f_vec(self):
+    s = self.s * np.array([0.5, 1.0, -1.0, 2.0])[:,None]
+    f = self.model.f_vec(s, self.hist, self.T)
+    self.assertEqual(f.shape, (4,))
+    self.assertTrue(np.allclose(f, 
+      [self.model.f(si, self.hist, self.T) for si in s]))
+
 class TestIsoJ2(unittest.TestCase, CommonYieldSurface):
   def setUp(self):
     self.s = np.array([10.0,-50.0,250.0,25.0,33.0,-40.0])
@@ -0,0 +1,75 @@
+from neml import parse, drivers
+
+import unittest
+import numpy as np
+import os
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+def run(model):
+  return drivers.uniaxial_test(model, 1.0e-4, T = 550.0, emax = 0.05,
+      nsteps = 200)['stress']
+
+class TestThreadedDrivers(unittest.TestCase):
+  """
+    The model updates release the GIL, so python threads running separate
+    models overlap
+  """
+  def setUp(self):
+    self.n = 4
+    self.models = [parse.parse_xml("test/examples.xml", "test_rd_chaboche")
+        for i in range(self.n)]
+
+  def test_same(self):
+    serial = [run(m) for m in self.models]
+    with ThreadPoolExecutor(self.n) as pool:
+      threaded = list(pool.map(run, self.models))
+    for a, b in zip(serial, threaded):
+      self.assertTrue(np.array_equal(a, b))
+
+  @unittest.skipIf((os.cpu_count() or 1) < 2, "needs more than one core")
+  def test_speedup(self):
+    workers = min(self.n, os.cpu_count())
+
+    t = time.perf_counter()
+    for m in self.models:
+      run(m)
+    serial = time.perf_counter() - t
+
+    t = time.perf_counter()
+    with ThreadPoolExecutor(workers) as pool:
+      list(pool.map(run, self.models))
+    threaded = time.perf_counter() - t
+
+    self.assertLess(threaded, 0.8 * serial)
+
+class TestReleased(unittest.TestCase):
+  """
+    Python keeps running while another thread is inside a long update
+  """
+  def test_batch(self):
+    model = parse.parse_xml("test/examples.xml", "test_rd_chaboche")
+    n = 1000
+    rng = np.random.default_rng(0)
+    args = (rng.uniform(-0.01, 0.01, (n,6)), np.zeros((n,6)),
+        np.full((n,), 550.0), np.full((n,), 550.0), np.ones((n,)),
+        np.zeros((n,)), np.zeros((n,6)), np.array([model.init_store()] * n),
+        np.zeros((n,)), np.zeros((n,)))
+
+    t = time.perf_counter()
+    model.update_sd_vec(*args)
+    call = time.perf_counter() - t
+
+    worker = threading.Thread(target = model.update_sd_vec, args = args)
+    worker.start()
+    gap = 0.0
+    last = time.perf_counter()
+    while worker.is_alive():
+      now = time.perf_counter()
+      gap = max(gap, now - last)
+      last = now
+    worker.join()
+
+    # Holding the GIL would stall this thread for the whole call
+    self.assertLess(gap, 0.5 * call)
@@ -0,0 +1,113 @@
+from neml import (models, elasticity, surfaces, hardening, ri_flow, 
+    interpolate, parse, serialize, tunable)
+
+import unittest
+import numpy as np
+import os.path
+import tempfile
+
+from test_parse import CompareMats
+
+def make_model(E, nu, sy, Ts, Hs, cs, gs):
+  elastic = elasticity.IsotropicLinearElasticModel(E, "youngs", nu, 
+      "poissons")
+  surface = surfaces.IsoKinJ2()
+  iso = hardening.InterpolatedIsotropicHardeningRule(
+      interpolate.PiecewiseLinearInterpolate(Ts, Hs))
+  gammas = [hardening.ConstantGamma(g) for g in gs]
+  hmodel = hardening.Chaboche(iso, cs, gammas, [0.0] * len(cs), 
+      [1.0] * len(cs))
+  flow = ri_flow.RateIndependentNonAssociativeHardening(surface, hmodel)
+  return models.SmallStrainRateIndependentPlasticity(elastic, flow, 
+      alpha = sy)
+
+class TestNames(unittest.TestCase):
+  def setUp(self):
+    self.model = make_model(150000.0, 0.3, 1.0e-5, [0.0, 1.0], [100.0, 200.0],
+        [5.0, 10.0], [1000.0, 500.0])
+    self.tunable = tunable.TunableParameters(self.model)
+
+  def test_names(self):
+    names = self.tunable.names
+    self.assertEqual(len(self.tunable), len(names))
+    for n in ["elastic.m1", "elastic.m2", "alpha",
+        "flow.hardening.iso.flow.points[1]", 
+        "flow.hardening.iso.flow.values[0]",
+        "flow.hardening.C[1]", "flow.hardening.gmodels[0].g"]:
+      self.assertTrue(n in names, n)
+
+  def test_get(self):
+    self.assertTrue(np.isclose(self.tunable["elastic.m1"], 150000.0))
+    self.assertTrue(np.isclose(self.tunable["flow.hardening.C[1]"], 10.0))
+
+  def test_values(self):
+    v = self.tunable.values
+    self.assertEqual(len(v), len(self.tunable))
+    self.tunable.values = v * 1.1
+    self.assertTrue(np.allclose(self.tunable.values, v * 1.1))
+
+  def test_errors(self):
+    with self.assertRaises(ValueError):
+      self.tunable["not_a_parameter"]
+    with self.assertRaises(ValueError):
+      self.tunable.values = np.zeros((len(self.tunable)+1,))
+
+  def test_shared(self):
+    C = interpolate.ConstantInterpolate(10.0)
+    elastic = elasticity.IsotropicLinearElasticModel(C, "youngs", 0.3, 
+        "poissons")
+    surface = surfaces.IsoJ2()
+    hrule = hardening.LinearIsotropicHardeningRule(C, C)
+    flow = ri_flow.RateIndependentAssociativeFlow(surface, hrule)
+    model = models.SmallStrainRateIndependentPlasticity(elastic, flow)
+    t = tunable.TunableParameters(model)
+    self.assertEqual(len([n for n in t.names if n.endswith(".v")]), 0)
+    self.assertTrue("elastic.m1" in t.names)
+    self.assertFalse("flow.hardening.s0" in t.names)
+    t["elastic.m1"] = 20.0
+    self.assertTrue(np.isclose(C(0.0), 20.0))
+    self.assertTrue(np.isclose(elastic.E(0.0), 20.0))
+
+class TestInPlace(CompareMats, unittest.TestCase):
+  """
+    Change every constant of a model in place and compare with the same
+    model built from scratch with the new values
+  """
+  def setUp(self):
+    self.model1 = make_model(150000.0, 0.3, 1.0e-5, [0.0, 1.0], [100.0, 200.0],
+        [5.0, 10.0], [1000.0, 500.0])
+    self.model2 = make_model(100000.0, 0.25, 0.0, [0.0, 2.0], [150.0, 250.0],
+        [8.0, 12.0], [800.0, 400.0])
+
+    t1 = tunable.TunableParameters(self.model1)
+    t2 = tunable.TunableParameters(self.model2)
+    self.assertEqual(t1.names, t2.names)
+    t1.values = t2.values
+
+    self.T = 300.0
+    self.tmax = 10.0
+    self.nsteps = 50
+    self.emax = np.array([0.02,0,0,0.01,0,0])
+
+class TestRecorded(CompareMats, unittest.TestCase):
+  """
+    The parameters the Factory recorded follow the changes, so a saved
+    model has the new values
+  """
+  def setUp(self):
+    self.model1 = parse.parse_xml("test/examples.xml", "test_rd_chaboche")
+    t = tunable.TunableParameters(self.model1)
+    t.values = t.values * 1.05
+
+    self.dir = tempfile.TemporaryDirectory()
+    fname = os.path.join(self.dir.name, "model.nemlbin")
+    serialize.write_binary(fname, {"model": self.model1})
+    self.model2 = serialize.parse_binary(fname, "model")
+
+    self.T = 550.0
+    self.tmax = 10.0
+    self.nsteps = 50
+    self.emax = np.array([0.05,0,0,0.02,0,0.01])
+
+  def tearDown(self):
+    self.dir.cleanup()
@@ -1,12 +1,13 @@
 import sys
 sys.path.append('..')
 
-from neml import interpolate, solvers, models, elasticity, ri_flow, hardening, surfaces, visco_flow, general_flow, creep, uniaxial
+from neml import interpolate, solvers, models, elasticity, ri_flow, hardening, surfaces, visco_flow, general_flow, creep, uniaxial, parse
 from common import *
 
 import unittest
 import numpy as np
 import numpy.linalg as la
+import pickle
 
 class CommonUniaxial(object):
   """
@@ -80,3 +81,69 @@ class TestUniaxialRI(CommonUniaxial, unittest.TestCase):
     self.dT = 0.0
     self.T0 = 0.0
     self.nsteps = 100
+
+class TestNative(unittest.TestCase):
+  """
+    The native wrapper against the 3D model it wraps
+  """
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", "test_rd_chaboche")
+    self.umodel = uniaxial.UniaxialModel(self.model)
+    self.T = 500.0
+
+  def run_steps(self, umodel, n = 20):
+    h = umodel.init_store()
+    e = 0.0
+    s = 0.0
+    u = 0.0
+    p = 0.0
+    res = []
+    for i in range(n):
+      s, h, A, u, p = umodel.update(e + 0.001, e, self.T, self.T,
+          i + 1.0, float(i), s, h, u, p)
+      e += 0.001
+      res.append((e, s, np.copy(h), A, u, p))
+    return res
+
+  def test_store(self):
+    self.assertEqual(self.umodel.nstore, self.model.nstore + 5)
+    self.assertEqual(self.umodel.nhist, self.model.nhist)
+    self.assertTrue(np.allclose(self.umodel.init_store()[5:],
+      self.model.init_store()))
+
+  def test_uniaxial(self):
+    # Each step from the stored state of the last one
+    e_n = np.zeros((6,))
+    s_n = np.zeros((6,))
+    h_n = self.model.init_store()
+    t_n = 0.0
+    for e, s, h, A, u, p in self.run_steps(self.umodel):
+      e_np1 = np.concatenate(([e], h[:5]))
+      s_np1, h_np1, A_np1, u_np1, p_np1 = self.model.update_sd(e_np1, e_n,
+          self.T, self.T, t_n + 1.0, t_n, s_n, h_n, 0.0, 0.0)
+      self.assertTrue(np.allclose(s_np1[1:], 0.0, atol = 1.0e-3))
+      self.assertTrue(np.isclose(s_np1[0], s))
+      self.assertTrue(np.allclose(h_np1, h[5:]))
+      e_n = e_np1
+      s_n = np.array([s,0,0,0,0,0])
+      h_n = h[5:]
+      t_n += 1.0
+
+  def test_elastic_strains(self):
+    h = self.umodel.init_store()
+    E = self.model.elastic_strains(np.array([100.0,0,0,0,0,0]), self.T,
+        h[5:])[0]
+    self.assertTrue(np.isclose(self.umodel.elastic_strains(100.0, self.T, h),
+      E))
+
+  def test_pickle(self):
+    copy = pickle.loads(pickle.dumps(self.umodel))
+    self.assertIsInstance(copy, models.UniaxialModel)
+    for a, b in zip(self.run_steps(self.umodel), self.run_steps(copy)):
+      for x, y in zip(a, b):
+        self.assertTrue(np.allclose(x, y))
+
+  def test_bad_history(self):
+    with self.assertRaises(ValueError):
+      self.umodel.update(0.001, 0.0, self.T, self.T, 1.0, 0.0, 0.0,
+          self.model.init_store(), 0.0, 0.0)
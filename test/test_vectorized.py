@@ -0,0 +1,178 @@
+from neml import models, parse
+
+import unittest
+import numpy as np
+
+class VectorizedUpdate(object):
+  """
+    Batch updates must match calling the single point update on each row
+  """
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", self.name)
+    self.n = 37
+    rng = np.random.default_rng(42)
+    self.e_n = rng.uniform(-0.002, 0.002, (self.n,6))
+    self.e_np1 = self.e_n + rng.uniform(-0.01, 0.01, (self.n,6))
+    self.w_n = rng.uniform(-0.001, 0.001, (self.n,3))
+    self.w_np1 = self.w_n + rng.uniform(-0.001, 0.001, (self.n,3))
+    self.T_n = np.linspace(300.0, 500.0, self.n)
+    self.T_np1 = self.T_n + 10.0
+    self.t_n = np.zeros((self.n,))
+    self.t_np1 = np.linspace(1.0, 10.0, self.n)
+    self.s_n = np.zeros((self.n,6))
+    self.h_n = np.array([self.model.init_store() for i in range(self.n)])
+    self.u_n = np.zeros((self.n,))
+    self.p_n = np.zeros((self.n,))
+
+  def loop_sd(self):
+    res = [self.model.update_sd(self.e_np1[i], self.e_n[i], self.T_np1[i],
+      self.T_n[i], self.t_np1[i], self.t_n[i], self.s_n[i], self.h_n[i],
+      self.u_n[i], self.p_n[i]) for i in range(self.n)]
+    return [np.array(v) for v in zip(*res)]
+
+  def loop_ld(self):
+    res = [self.model.update_ld_inc(self.e_np1[i], self.e_n[i],
+      self.w_np1[i], self.w_n[i], self.T_np1[i],
+      self.T_n[i], self.t_np1[i], self.t_n[i], self.s_n[i], self.h_n[i],
+      self.u_n[i], self.p_n[i]) for i in range(self.n)]
+    return [np.array(v) for v in zip(*res)]
+
+  def vec_sd(self, nthreads = 1):
+    return self.model.update_sd_vec(self.e_np1, self.e_n, self.T_np1,
+        self.T_n, self.t_np1, self.t_n, self.s_n, self.h_n, self.u_n,
+        self.p_n, nthreads = nthreads)
+
+  def test_sd(self):
+    for a, b in zip(self.vec_sd(), self.loop_sd()):
+      self.assertEqual(a.shape, b.shape)
+      self.assertTrue(np.allclose(a, b))
+
+  def test_sd_threads(self):
+    for a, b in zip(self.vec_sd(4), self.vec_sd(1)):
+      self.assertTrue(np.array_equal(a, b))
+
+  def test_ld(self):
+    vec = self.model.update_ld_inc_vec(self.e_np1, self.e_n, self.w_np1,
+        self.w_n, self.T_np1, self.T_n, self.t_np1, self.t_n, self.s_n,
+        self.h_n, self.u_n, self.p_n, nthreads = 3)
+    for a, b in zip(vec, self.loop_ld()):
+      self.assertEqual(a.shape, b.shape)
+      self.assertTrue(np.allclose(a, b))
+
+  def test_bad_shape(self):
+    with self.assertRaises(ValueError):
+      self.model.update_sd_vec(self.e_np1, self.e_n, self.T_np1[:-1],
+          self.T_n, self.t_np1, self.t_n, self.s_n, self.h_n, self.u_n,
+          self.p_n)
+    with self.assertRaises(ValueError):
+      self.model.update_sd_vec(self.e_np1, self.e_n, self.T_np1,
+          self.T_n, self.t_np1, self.t_n, self.s_n, self.h_n[:,:-1],
+          self.u_n, self.p_n)
+
+  def test_empty(self):
+    s, h, A, u, p = self.model.update_sd_vec(np.zeros((0,6)),
+        np.zeros((0,6)), np.zeros((0,)), np.zeros((0,)), np.zeros((0,)),
+        np.zeros((0,)), np.zeros((0,6)), np.zeros((0,self.model.nstore)),
+        np.zeros((0,)), np.zeros((0,)))
+    self.assertEqual(A.shape, (0,6,6))
+
+  def test_out(self):
+    out = (np.full((self.n,6), np.nan), np.empty((self.n,self.model.nstore)),
+        np.empty((self.n,6,6)), np.empty((self.n,)), np.empty((self.n,)))
+    res = self.model.update_sd_vec(self.e_np1, self.e_n, self.T_np1,
+        self.T_n, self.t_np1, self.t_n, self.s_n, self.h_n, self.u_n,
+        self.p_n, out = out)
+    for a, b, c in zip(res, out, self.vec_sd()):
+      self.assertIs(a, b)
+      self.assertTrue(np.array_equal(a, c))
+
+class OutputBuffers(object):
+  """
+    Single point updates write into the arrays given in out
+  """
+  def setUp(self):
+    self.model = parse.parse_xml("test/examples.xml", self.name)
+    self.e_np1 = np.array([0.01, -0.005, -0.005, 0.001, 0.0, 0.002])
+    self.e_n = np.zeros((6,))
+    self.w_np1 = np.array([0.001, 0.0, -0.001])
+    self.w_n = np.zeros((3,))
+    self.s_n = np.zeros((6,))
+    self.h_n = self.model.init_store()
+    self.args = (self.e_np1, self.e_n, 400.0, 400.0, 1.0, 0.0, self.s_n,
+        self.h_n, 0.0, 0.0)
+
+  def buffers(self):
+    return (np.full((6,), np.nan), np.full((self.model.nstore,), np.nan),
+        np.full((6,6), np.nan))
+
+  def test_sd(self):
+    out = self.buffers()
+    res = self.model.update_sd(*self.args, out = out)
+    for a, b in zip(res[:3], out):
+      self.assertIs(a, b)
+    for a, b in zip(res, self.model.update_sd(*self.args)):
+      self.assertTrue(np.array_equal(a, b))
+
+  def test_reuse(self):
+    out = self.buffers()
+    self.model.update_sd(*self.args, out = out)
+    res = self.model.update_sd(self.e_np1 / 2, *self.args[1:], out = out)
+    ref = self.model.update_sd(self.e_np1 / 2, *self.args[1:])
+    for a, b in zip(res, ref):
+      self.assertTrue(np.array_equal(a, b))
+
+  def test_ld(self):
+    out = self.buffers() + (np.empty((6,3)),)
+    args = (self.e_np1, self.e_n, self.w_np1, self.w_n) + self.args[2:]
+    res = self.model.update_ld_inc(*args, out = out)
+    for a, b in zip(res[:4], out):
+      self.assertIs(a, b)
+    for a, b in zip(res, self.model.update_ld_inc(*args)):
+      self.assertTrue(np.array_equal(a, b))
+
+  def test_bad(self):
+    s, h, A = self.buffers()
+    bad = [
+        (s, h),
+        (s[:5], h, A),
+        (s, h, A.T),
+        (s.astype(np.float32), h, A),
+        (np.zeros((12,))[::2], h, A),
+        (s, h, A.reshape((36,)))
+        ]
+    s.setflags(write = False)
+    bad.append((s, h, A))
+    for out in bad:
+      with self.assertRaises(ValueError):
+        self.model.update_sd(*self.args, out = out)
+
+  def test_overlap(self):
+    s, h, A = self.buffers()
+    # Outputs that are inputs, an output containing an input, and two
+    # outputs sharing memory
+    s_n = np.zeros((6,6))
+    args = self.args[:6] + (s_n[0],) + self.args[7:]
+    bad = [
+        (s_n[0], h, A),
+        (s, self.h_n, A),
+        (s, h, s_n),
+        (A[0], h, A)
+        ]
+    for out in bad:
+      with self.assertRaises(ValueError):
+        self.model.update_sd(*args, out = out)
+
+class TestOutputJ2Iso(OutputBuffers, unittest.TestCase):
+  name = "test_j2iso"
+
+class TestOutputChaboche(OutputBuffers, unittest.TestCase):
+  name = "test_rd_chaboche"
+
+class TestVectorizedJ2Iso(VectorizedUpdate, unittest.TestCase):
+  name = "test_j2iso"
+
+class TestVectorizedChaboche(VectorizedUpdate, unittest.TestCase):
+  name = "test_rd_chaboche"
+
+class TestVectorizedCreep(VectorizedUpdate, unittest.TestCase):
+  name = "test_pcreep"
@@ -0,0 +1,143 @@
+// Regression check for nemlgen: every model from the XML file that was
+// compiled in with the generated code must reproduce the interpreted model.
+// Reports which models nemlgen actually specialized, and fails if any of
+// the models named on the command line fell back to the runtime objects.
+//
+// Usage: codegen_check input.xml [specialized_model ...]
+
+#include "parse.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <typeinfo>
+#include <vector>
+
+using namespace neml;
+
+namespace {
+
+double rel_diff(const std::vector<double> & a, const std::vector<double> & b)
+{
+  double num = 0.0;
+  double den = 0.0;
+  for (size_t i = 0; i < a.size(); i++) {
+    num = std::max(num, std::fabs(a[i] - b[i]));
+    den = std::max(den, std::fabs(b[i]));
+  }
+  return num / std::max(den, 1.0e-12);
+}
+
+// Stress, history, and tangent from a strain controlled cycle
+struct Results {
+  int ier;
+  std::vector<double> s, h, A, up;
+};
+
+Results run(NEMLModel & model)
+{
+  const int steps = 100;
+  const double dir[6] = {1.0, -0.45, -0.35, 0.2, -0.1, 0.15};
+  const double T = 500.0;
+  int nh = model.nstore();
+
+  Results res;
+  res.s.assign(6 * (steps + 1), 0.0);
+  res.h.assign(nh * (steps + 1), 0.0);
+  res.A.assign(36 * steps, 0.0);
+  res.up.assign(2 * (steps + 1), 0.0);
+  res.ier = model.init_store(&res.h[0]);
+
+  double e_n[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  for (int i = 1; i <= steps && res.ier == 0; i++) {
+    double e_np1[6];
+    double f = 0.005 * std::sin(4.0 * M_PI * i / steps);
+    for (int j = 0; j < 6; j++) e_np1[j] = f * dir[j];
+    res.ier = model.update_sd(e_np1, e_n, T, T, i, i - 1,
+                              &res.s[6*i], &res.s[6*(i-1)],
+                              &res.h[nh*i], &res.h[nh*(i-1)],
+                              &res.A[36*(i-1)],
+                              res.up[2*i], res.up[2*(i-1)],
+                              res.up[2*i+1], res.up[2*(i-1)+1]);
+    std::copy(e_np1, e_np1 + 6, e_n);
+  }
+
+  return res;
+}
+
+}
+
+int main(int argc, char ** argv)
+{
+  if (argc < 2) {
+    std::cerr << "Usage: codegen_check input.xml [specialized_model ...]"
+        << std::endl;
+    return 1;
+  }
+  std::string fname = argv[1];
+  std::set<std::string> required(argv + 2, argv + argc);
+
+  rapidxml::file<> xmlFile(fname.c_str());
+  rapidxml::xml_document<> doc;
+  doc.parse<0>(xmlFile.data());
+  const rapidxml::xml_node<> * root = doc.first_node("materials");
+
+  int nchecked = 0;
+  int nfailed = 0;
+  int nspecial = 0;
+  for (auto node = root->first_node(); node; node = node->next_sibling()) {
+    std::string name = node->name();
+
+    // Only the models nemlgen wrote out
+    ParameterSet params;
+    try {
+      params = Factory::Creator()->provide_parameters(name);
+    }
+    catch (UnregisteredError & e) {
+      continue;
+    }
+
+    auto generated = Factory::Creator()->create_unique<NEMLModel>(params);
+    auto interpreted = parse_xml_unique(fname, name);
+
+    // A fallback rebuilds the same runtime class as the interpreted model
+    bool special = typeid(*generated) != typeid(*interpreted);
+    if (special) {
+      nspecial++;
+      required.erase(name);
+    }
+
+    Results a = run(*generated);
+    Results b = run(*interpreted);
+
+    double diff = 0.0;
+    bool ok = (a.ier == b.ier) && (a.h.size() == b.h.size());
+    if (ok) {
+      diff = std::max({rel_diff(a.s, b.s), rel_diff(a.h, b.h),
+                      rel_diff(a.A, b.A), rel_diff(a.up, b.up)});
+      ok = diff <= 1.0e-8;
+    }
+
+    std::cout << (ok ? "ok     " : "FAILED ") << name
+        << (special ? " (specialized" : " (interpreted") << ", difference "
+        << diff << ")" << std::endl;
+    nchecked++;
+    if (!ok) nfailed++;
+  }
+
+  if (nchecked == 0) {
+    std::cerr << "No generated models found" << std::endl;
+    return 1;
+  }
+
+  std::cout << nspecial << " of " << nchecked << " models specialized"
+      << std::endl;
+
+  for (auto & name : required) {
+    std::cerr << "FAILED " << name << " was not specialized" << std::endl;
+    nfailed++;
+  }
+
+  return nfailed == 0 ? 0 : 1;
+}
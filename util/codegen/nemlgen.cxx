@@ -0,0 +1,409 @@
+// Ahead of time code generator for models defined in XML
+//
+// Usage: nemlgen [--strict] [--quiet] input.xml output.cxx [model1 ...]
+//
+// Reads each model (every model in the file if none are given), walks
+// the object graph the Factory built, and writes a translation unit that
+//   1) rebuilds the model with all the parameters hard wired as constants
+//   2) uses the compile time versions of the components in compose.h
+//      when every component in the model has one, so the whole stress
+//      update is inlined, and falls back to the interpreted objects if not
+//      (with a warning, unless --quiet, or an error with --strict)
+//   3) registers the result with the Factory under the model name, so
+//      Factory::Creator()->create(provide_parameters("model")) gives the
+//      usual NEMLModel
+
+#include "parse.h"
+#include "interpolate.h"
+
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace neml;
+
+namespace {
+
+/// Exact text for a double literal
+std::string literal(double v)
+{
+  if (std::isnan(v)) return "std::numeric_limits<double>::quiet_NaN()";
+  if (std::isinf(v)) {
+    return std::string(v < 0 ? "-" : "") +
+        "std::numeric_limits<double>::infinity()";
+  }
+  std::ostringstream ss;
+  ss << std::setprecision(17) << v;
+  std::string res = ss.str();
+  if (res.find_first_of(".e") == std::string::npos) res += ".0";
+  return res;
+}
+
+/// Quoted C++ string
+std::string literal(const std::string & v)
+{
+  std::ostringstream ss;
+  ss << "std::string(\"";
+  for (char c : v) {
+    if (c == '"' || c == '\\') ss << '\\' << c;
+    else if (c == '\n') ss << "\\n";
+    else ss << c;
+  }
+  ss << "\")";
+  return ss.str();
+}
+
+/// Valid identifier from a model name
+std::string identifier(const std::string & name)
+{
+  std::string res;
+  for (char c : name) {
+    res += (std::isalnum((unsigned char) c) ? c : '_');
+  }
+  return res;
+}
+
+/// The recorded parameters of an object, if it has them
+bool recorded(const std::shared_ptr<NEMLObject> & obj, ParameterSet & params)
+{
+  if (obj == nullptr || obj->parameter_set() == nullptr) return false;
+  params = *obj->parameter_set();
+  return true;
+}
+
+/// The recorded parameters of a nested object
+bool nested(ParameterSet & params, const std::string & name,
+            ParameterSet & res)
+{
+  return recorded(params.get_parameter<std::shared_ptr<NEMLObject>>(name),
+                  res);
+}
+
+/// Template expression for a component in compose.h, returns false if
+/// some part of the model does not have a compile time version
+bool compose_expr(ParameterSet & params, std::string & expr)
+{
+  static const std::map<std::string,std::string> leaves = {
+    {"IsoKinJ2", "compose::IsoKinJ2"},
+    {"VoceIsotropicHardeningRule", "compose::Voce"},
+    {"LinearIsotropicHardeningRule", "compose::LinearIso"},
+    {"LinearKinematicHardeningRule", "compose::LinearKin"},
+    {"ConstantGamma", "compose::ConstantGamma"},
+    {"SatGamma", "compose::SatGamma"},
+    {"ConstantFluidity", "compose::ConstantFluidity"},
+    {"SaturatingFluidity", "compose::SaturatingFluidity"},
+    {"GPowerLaw", "compose::GPowerLaw"}};
+
+  // Template with nested objects as the arguments
+  auto templated = [&params, &expr](const std::string & name,
+                                    const std::vector<std::string> & args)
+  {
+    std::vector<std::string> exprs;
+    for (auto & arg : args) {
+      ParameterSet np;
+      std::string e;
+      if (!nested(params, arg, np) || !compose_expr(np, e)) return false;
+      exprs.push_back(e);
+    }
+    expr = "compose::" + name + "<";
+    for (size_t i = 0; i < exprs.size(); i++) {
+      expr += (i > 0 ? ", " : "") + exprs[i];
+    }
+    expr += ">";
+    return true;
+  };
+
+  const std::string & type = params.type();
+
+  auto leaf = leaves.find(type);
+  if (leaf != leaves.end()) {
+    expr = leaf->second;
+    return true;
+  }
+  else if (type == "GeneralIntegrator") {
+    return templated("Integrator", {"rule"});
+  }
+  else if (type == "TVPFlowRule") {
+    ParameterSet ep;
+    if (!nested(params, "elastic", ep) ||
+        ep.type() != "IsotropicLinearElasticModel") return false;
+    return templated("TVP", {"flow"});
+  }
+  else if (type == "ChabocheFlowRule") {
+    return templated("ChabocheFlow", {"surface", "hardening", "fluidity"});
+  }
+  else if (type == "PerzynaFlowRule") {
+    return templated("PerzynaFlow", {"surface", "hardening", "g"});
+  }
+  else if (type == "CombinedHardeningRule") {
+    return templated("Combined", {"iso", "kin"});
+  }
+  else if (type == "Chaboche") {
+    ParameterSet ip;
+    std::string iso;
+    if (!nested(params, "iso", ip) || !compose_expr(ip, iso)) return false;
+    auto gmodels = params.get_parameter<
+        std::vector<std::shared_ptr<NEMLObject>>>("gmodels");
+    if (gmodels.empty()) return false;
+    std::string gamma;
+    for (auto & g : gmodels) {
+      ParameterSet gp;
+      std::string e;
+      if (!recorded(g, gp) || !compose_expr(gp, e)) return false;
+      if (!gamma.empty() && gamma != e) return false;
+      gamma = e;
+    }
+    expr = "compose::Chaboche<" + iso + ", " +
+        std::to_string(gmodels.size()) + ", " + gamma + ">";
+    return true;
+  }
+
+  return false;
+}
+
+/// Writes the statements that rebuild an object graph
+class Writer {
+ public:
+  Writer(std::ostream & os) : os_(os), count_(0) {};
+
+  /// Write out the parameter set and return its variable name
+  std::string parameters(ParameterSet & params)
+  {
+    std::vector<std::pair<std::string,std::string>> values;
+    for (auto & name : params.param_names()) {
+      values.push_back(std::make_pair(name, value_(params, name)));
+    }
+    std::string var = "p" + std::to_string(count_++);
+    os_ << "  ParameterSet " << var << " = f->provide_parameters("
+        << literal(params.type()) << ");" << std::endl;
+    for (auto & v : values) {
+      os_ << "  " << var << ".assign_parameter(" << literal(v.first) << ", "
+          << v.second << ");" << std::endl;
+    }
+    return var;
+  }
+
+ private:
+  std::string value_(ParameterSet & params, const std::string & name)
+  {
+    switch (params.get_object_type(name)) {
+      case TYPE_DOUBLE:
+        return literal(params.get_parameter<double>(name));
+      case TYPE_INT:
+        return "int(" + std::to_string(params.get_parameter<int>(name)) + ")";
+      case TYPE_BOOL:
+        return params.get_parameter<bool>(name) ? "true" : "false";
+      case TYPE_VEC_DOUBLE:
+        {
+          auto v = params.get_parameter<std::vector<double>>(name);
+          std::string res = "std::vector<double>{";
+          for (size_t i = 0; i < v.size(); i++) {
+            res += (i > 0 ? ", " : "") + literal(v[i]);
+          }
+          return res + "}";
+        }
+      case TYPE_NEML_OBJECT:
+        return object_(params.get_parameter<std::shared_ptr<NEMLObject>>(
+                name));
+      case TYPE_VEC_NEML_OBJECT:
+        {
+          auto v = params.get_parameter<
+              std::vector<std::shared_ptr<NEMLObject>>>(name);
+          std::string res = "std::vector<std::shared_ptr<NEMLObject>>{";
+          for (size_t i = 0; i < v.size(); i++) {
+            res += (i > 0 ? ", " : "") + object_(v[i]);
+          }
+          return res + "}";
+        }
+      case TYPE_STRING:
+        return literal(params.get_parameter<std::string>(name));
+      default:
+        throw std::runtime_error("Unrecognized object type!");
+    }
+  }
+
+  // Each object is only built once, so shared objects stay shared
+  std::string object_(const std::shared_ptr<NEMLObject> & obj)
+  {
+    auto found = objects_.find(obj.get());
+    if (found != objects_.end()) return found->second;
+
+    std::string value;
+    ParameterSet params;
+    if (recorded(obj, params)) {
+      value = "f->create(" + parameters(params) + ")";
+    }
+    else if (auto c = std::dynamic_pointer_cast<ConstantInterpolate>(obj)) {
+      value = "std::make_shared<ConstantInterpolate>(" +
+          literal(c->value(0.0)) + ")";
+    }
+    else {
+      throw std::runtime_error(
+          "Cannot generate code for an object not created by the Factory");
+    }
+
+    std::string var = "o" + std::to_string(count_++);
+    os_ << "  std::shared_ptr<NEMLObject> " << var << " = " << value << ";"
+        << std::endl;
+    objects_[obj.get()] = var;
+    return var;
+  }
+
+ private:
+  std::ostream & os_;
+  int count_;
+  std::map<const NEMLObject*, std::string> objects_;
+};
+
+/// Every model in the file
+std::vector<std::string> model_names(const std::string & fname)
+{
+  rapidxml::file<> xmlFile(fname.c_str());
+  rapidxml::xml_document<> doc;
+  doc.parse<0>(xmlFile.data());
+  const rapidxml::xml_node<> * root = doc.first_node("materials");
+
+  std::vector<std::string> names;
+  for (auto node = root->first_node(); node; node = node->next_sibling()) {
+    if (node->name() != XML_DEFINES) names.push_back(node->name());
+  }
+  return names;
+}
+
+/// Write the code for one model, returns true if it was specialized
+bool generate(std::ostream & os, const std::string & name,
+              std::shared_ptr<NEMLModel> model)
+{
+  ParameterSet params;
+  if (!recorded(model, params)) {
+    throw std::runtime_error("Model was not created by the Factory");
+  }
+
+  std::string expr;
+  bool special = compose_expr(params, expr);
+  std::string id = identifier(name);
+
+  os << "// " << name << ": " << params.type() << std::endl;
+  os << "ParameterSet params_" << id << "()" << std::endl;
+  os << "{" << std::endl;
+  os << "  Factory * f = Factory::Creator();" << std::endl;
+  Writer writer(os);
+  std::string var = writer.parameters(params);
+  os << "  return " << var << ";" << std::endl;
+  os << "}" << std::endl << std::endl;
+
+  os << "struct Generated_" << id << " {" << std::endl;
+  os << "  static std::string type() {return " << literal(name) << ";};"
+      << std::endl;
+  os << "  static ParameterSet parameters() {return ParameterSet(type());};"
+      << std::endl;
+  os << "  static std::unique_ptr<NEMLObject> initialize(ParameterSet & params)"
+      << std::endl;
+  os << "  {" << std::endl;
+  os << "    ParameterSet model = params_" << id << "();" << std::endl;
+  if (special) {
+    os << "    return neml::make_unique<compose::Model<" << expr << ">>(model);"
+        << std::endl;
+  }
+  else {
+    os << "    return Factory::Creator()->create_unique(model);" << std::endl;
+  }
+  os << "  }" << std::endl;
+  os << "};" << std::endl << std::endl;
+  os << "static Register<Generated_" << id << "> regGenerated_" << id << ";"
+      << std::endl << std::endl;
+
+  return special;
+}
+
+}
+
+int main(int argc, char ** argv)
+{
+  std::vector<std::string> args(argv + 1, argv + argc);
+  bool strict = false;
+  bool quiet = false;
+  while (!args.empty() && (args[0] == "--strict" || args[0] == "--quiet")) {
+    if (args[0] == "--strict") strict = true;
+    else quiet = true;
+    args.erase(args.begin());
+  }
+
+  if (args.size() < 2) {
+    std::cerr << "Usage: nemlgen [--strict] [--quiet] input.xml output.cxx "
+        << "[model ...]" << std::endl;
+    return 1;
+  }
+
+  std::string fname = args[0];
+  std::string oname = args[1];
+
+  std::vector<std::string> names(args.begin() + 2, args.end());
+  bool all = names.empty();
+  if (all) names = model_names(fname);
+
+  std::ostringstream body;
+  int nmodels = 0;
+  int ninterpreted = 0;
+  for (auto & name : names) {
+    std::shared_ptr<NEMLModel> model;
+    try {
+      model = parse_xml(fname, name);
+    }
+    catch (std::exception & e) {
+      // Only complain about the models the user asked for
+      if (!all) {
+        std::cerr << "Cannot read model " << name << ": " << e.what()
+            << std::endl;
+        return 1;
+      }
+      std::cout << "skipped     " << name << std::endl;
+      continue;
+    }
+    bool special = generate(body, name, model);
+    std::cout << (special ? "specialized " : "interpreted ") << name
+        << std::endl;
+    if (!special) {
+      if (!quiet) {
+        std::cerr << "warning: " << name << " has components without a "
+            << "compile time version, it uses the runtime objects"
+            << std::endl;
+      }
+      ninterpreted++;
+    }
+    nmodels++;
+  }
+
+  if (nmodels == 0) {
+    std::cerr << "No models to generate" << std::endl;
+    return 1;
+  }
+
+  if (strict && ninterpreted > 0) {
+    std::cerr << ninterpreted << " of " << nmodels
+        << " models could not be specialized" << std::endl;
+    return 1;
+  }
+
+  std::ofstream os(oname);
+  os << "// Generated by nemlgen from " << fname << ", do not edit"
+      << std::endl << std::endl;
+  os << "#include \"compose.h\"" << std::endl;
+  os << "#include \"interpolate.h\"" << std::endl << std::endl;
+  os << "#include <limits>" << std::endl << std::endl;
+  os << "namespace neml {" << std::endl << std::endl;
+  os << "namespace {" << std::endl << std::endl;
+  os << body.str();
+  os << "}" << std::endl << std::endl;
+  os << "}" << std::endl;
+
+  return os.good() ? 0 : 1;
+}